@@ -0,0 +1,144 @@
+/** @file
+ * @brief Файл, содержащий микро- и макробенчмарки бэкенда игры Змейка
+ */
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "../brick_game/snake/snake_controller.h"
+
+/**
+ * @brief Выбирает безопасное направление движения змейки
+ * @details Простой автопилот для макробенчмарков: если следующий шаг змейки
+ * приводит к столкновению с границей поля или телом, перебирает остальные
+ * направления и выбирает первое допустимое
+ * @param snake Ссылка на змейку
+ */
+static void steer(s21::Snake &snake) {
+  const s21::Snake::Direction directions[] = {
+      s21::Snake::kDown, s21::Snake::kRight, s21::Snake::kUp,
+      s21::Snake::kLeft};
+  auto blocked = [&snake]() {
+    auto next = snake.nextStep();
+    bool is_blocked = next.first < 1 || next.first > WIDTH * 2 ||
+                      next.second < 1 || next.second > HEIGHT;
+    for (const auto &body : snake.getSnakeBody()) {
+      if (body == next) {
+        is_blocked = true;
+      }
+    }
+    return is_blocked;
+  };
+  for (int i = 0; i < 4 && blocked(); i++) {
+    snake.setDirection(directions[i]);
+  }
+}
+
+/**
+ * @brief Бенчмарк движения змейки
+ * @details Аргумент - длина змейки. Змейка движется вниз без ограничений поля,
+ * поэтому измеряется только стоимость перемещения тела
+ */
+static void BM_SnakeMove(benchmark::State &state) {
+  s21::Snake snake(1, 1);
+  while (static_cast<int>(snake.getSnakeBody().size()) < state.range(0)) {
+    snake.grow();
+  }
+  for (auto _ : state) {
+    snake.move();
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SnakeMove)->Arg(4)->Arg(16)->Arg(64)->Arg(200);
+
+/**
+ * @brief Бенчмарк генерации яблока
+ * @details Аргумент - процент заполнения допустимых для яблока клеток телом
+ * змейки. Чем плотнее поле, тем больше попыток требуется для выбора свободной
+ * клетки
+ */
+static void BM_SpawnApple(benchmark::State &state) {
+  std::vector<std::pair<int, int>> snake_body;
+  int cells = WIDTH * (HEIGHT - 2);
+  int filled = cells * state.range(0) / 100;
+  for (int i = 0; i < filled; i++) {
+    snake_body.push_back({(i % WIDTH) * 2 + 1, i / WIDTH + 1});
+  }
+  s21::Apple apple;
+  for (auto _ : state) {
+    apple.spawnApple(snake_body);
+    benchmark::DoNotOptimize(apple.getAppleX());
+  }
+}
+BENCHMARK(BM_SpawnApple)->Arg(0)->Arg(25)->Arg(50)->Arg(75)->Arg(95);
+
+/**
+ * @brief Бенчмарк обновления игрового поля
+ * @details Аргумент - длина змейки. Змейка укладывается на поле "змейкой"
+ * (построчно), после чего поле перестраивается на каждой итерации
+ */
+static void BM_UpdateField(benchmark::State &state) {
+  s21::SnakeModel model;
+  s21::Snake &snake = model.getSnake();
+  snake.setDirection(s21::Snake::kRight);
+  while (static_cast<int>(snake.getSnakeBody().size()) < state.range(0)) {
+    steer(snake);
+    snake.grow();
+  }
+  GameInfo_t *stats = model.getGameInfo_t();
+  for (auto _ : state) {
+    model.updateField(*stats);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_UpdateField)->Arg(4)->Arg(50)->Arg(150);
+
+/**
+ * @brief Макробенчмарк игрового такта
+ * @details Каждая итерация - полный такт игры, как в игровом цикле консольной
+ * версии: перестроение поля и вызов snakeMechanics с истёкшим таймером.
+ * Змейкой управляет простой автопилот, после проигрыша модель создаётся заново
+ */
+static void BM_SnakeTick(benchmark::State &state) {
+  auto model = std::make_unique<s21::SnakeModel>();
+  for (auto _ : state) {
+    s21::SnakeModel::SnakeInfo_t *game_state = model->getSnakeInfo_t();
+    GameInfo_t stats = *model->getGameInfo_t();
+    model->updateField(stats);
+    steer(model->getSnake());
+    game_state->set_time = 0;
+    model->snakeMechanics(game_state->game_status);
+    if (game_state->game_status == kGameOver ||
+        game_state->game_status == kWin) {
+      state.PauseTiming();
+      model = std::make_unique<s21::SnakeModel>();
+      state.ResumeTiming();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SnakeTick);
+
+/**
+ * @brief Бенчмарк снимка и восстановления состояния игры
+ * @details Аргумент - длина змейки. Каждая итерация сохраняет снимок модели и
+ * восстанавливает его обратно
+ */
+static void BM_SnakeSnapshotRestore(benchmark::State &state) {
+  s21::SnakeModel model;
+  s21::Snake &snake = model.getSnake();
+  snake.setDirection(s21::Snake::kRight);
+  while (static_cast<int>(snake.getSnakeBody().size()) < state.range(0)) {
+    steer(snake);
+    snake.grow();
+  }
+  s21::SnakeModel::SnakeSnapshot_t snapshot;
+  for (auto _ : state) {
+    model.snapshot(&snapshot);
+    model.restore(snapshot);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SnakeSnapshotRestore)->Arg(4)->Arg(50)->Arg(150);
+
+BENCHMARK_MAIN();
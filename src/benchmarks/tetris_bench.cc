@@ -0,0 +1,433 @@
+/** @file
+ * @brief Файл, содержащий микро- и макробенчмарки бэкенда игры Тетрис
+ */
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "../brick_game/api/brick_game_loader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "../brick_game/common/frame_codec.h"
+#include "../brick_game/tetris/tetris_backend.h"
+#include "../brick_game/tetris/tetris_batch.h"
+#include "../brick_game/tetris/tetris_battle.h"
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief Очищает игровое поле
+ * @details Заполняет все ячейки поля значением EMPTY_CELL, пересчитывает высоты
+ * столбцов и сбрасывает статус игры, чтобы макробенчмарки могли продолжать
+ * работу после проигрыша без повторного выделения памяти
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+static void clearBoard(TetrisInfo_t *game_state) {
+  for (int y = 0; y <= HEIGHT; y++) {
+    for (int x = 0; x <= WIDTH * 2; x++) {
+      game_state->game_info.field[y][x] = EMPTY_CELL;
+    }
+  }
+  game_state->game_status = kStart;
+  game_state->game_info.score = 0;
+  initHeights(game_state);
+}
+
+/**
+ * @brief Строит на поле "стакан" заданной высоты
+ * @details Заполняет нижние строки поля статичными клетками, оставляя в каждой
+ * строке одну пустую клетку, чтобы строки не считались заполненными, и
+ * пересчитывает высоты столбцов
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param stack_height Количество заполняемых строк
+ */
+static void buildStack(TetrisInfo_t *game_state, int stack_height) {
+  for (int y = HEIGHT; y > HEIGHT - stack_height; y--) {
+    for (int x = 1; x <= WIDTH; x++) {
+      game_state->game_info.field[y][x] =
+          (x == 1 + y % WIDTH) ? EMPTY_CELL : STATIC_CELL;
+    }
+  }
+  initHeights(game_state);
+}
+
+/**
+ * @brief Ставит на поле фигуру заданного типа в стартовую позицию
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param type Номер фигуры
+ */
+static void placeFigure(TetrisInfo_t *game_state, int type) {
+  initFigure(&game_state->figure, type);
+  game_state->figure.x = (WIDTH - game_state->figure.width) / 2 + 1;
+  game_state->figure.y = 1;
+}
+
+/**
+ * @brief Бенчмарк проверки столкновений
+ * @details Аргумент - высота "стакана", над которым проверяется фигура
+ */
+static void BM_CheckCollision(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  buildStack(game_state, state.range(0));
+  placeFigure(game_state, 4);
+  game_state->figure.y = HEIGHT - state.range(0) - 2;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        checkCollision(&game_state->game_info, &game_state->figure, 0, 1));
+  }
+  removeGameInfo_t();
+}
+BENCHMARK(BM_CheckCollision)->Arg(0)->Arg(5)->Arg(10)->Arg(15);
+
+/**
+ * @brief Бенчмарк удаления заполненных линий
+ * @details Аргумент - количество одновременно удаляемых линий (от 1 до 4).
+ * Перед каждой итерацией над линиями строится "стакан" из 10 строк, чтобы
+ * удаление сдвигало реальное содержимое поля
+ */
+static void BM_RemoveLine(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  int lines = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    clearBoard(game_state);
+    buildStack(game_state, 10);
+    for (int y = HEIGHT; y > HEIGHT - lines; y--) {
+      for (int x = 1; x <= WIDTH; x++) {
+        game_state->game_info.field[y][x] = STATIC_CELL;
+      }
+    }
+    state.ResumeTiming();
+    removeLine(game_state);
+  }
+  removeGameInfo_t();
+}
+BENCHMARK(BM_RemoveLine)->DenseRange(1, 4);
+
+/**
+ * @brief Бенчмарк уплотнения поля произвольной высоты
+ * @details Первый аргумент - количество строк поля (20, 200 или 2000), второй
+ * - количество заполненных строк, удаляемых за один вызов compactField.
+ * Заполненные строки равномерно распределены по "стакану" высотой в половину
+ * поля
+ */
+static void BM_CompactField(benchmark::State &state) {
+  int height = state.range(0);
+  int lines = state.range(1);
+  int **field = NULL;
+  createMatrix(height + 1, WIDTH + 1, &field);
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int y = height; y > height / 2; y--) {
+      bool full = (height - y) % (height / 2 / lines) == 0 &&
+                  (height - y) / (height / 2 / lines) < lines;
+      for (int x = 1; x <= WIDTH; x++) {
+        field[y][x] = (full || x != 1 + y % WIDTH) ? STATIC_CELL : EMPTY_CELL;
+      }
+    }
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(compactField(field, height, WIDTH));
+  }
+  removeMatrix(field, height + 1);
+}
+BENCHMARK(BM_CompactField)
+    ->ArgsProduct({{HEIGHT, HEIGHT * 10, HEIGHT * 100}, {1, 4}});
+
+/**
+ * @brief Бенчмарк поворота фигуры
+ * @details Аргумент - номер фигуры. Фигура вращается в центре пустого поля,
+ * каждые четыре поворота она возвращается в исходное положение
+ */
+static void BM_RotateFigure(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  placeFigure(game_state, state.range(0));
+  game_state->figure.y = HEIGHT / 2;
+  for (auto _ : state) {
+    rotateFigure(game_state);
+    benchmark::ClobberMemory();
+  }
+  removeGameInfo_t();
+}
+BENCHMARK(BM_RotateFigure)->DenseRange(0, FIGURES_COUNT - 1);
+
+/**
+ * @brief Бенчмарк поворота фигуры с отталкиванием SRS в плотном "стакане"
+ * @details Первый аргумент - номер фигуры, второй - высота "стакана". Фигура
+ * лежит на "стакане", поэтому поворот перебирает проверки отталкивания из
+ * таблиц SRS. Перед каждым поворотом фигура возвращается в исходное
+ * положение копированием структуры. Счётчик rotations_per_second показывает,
+ * сколько поворотов укладывается в секунду
+ */
+static void BM_RotateDense(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  buildStack(game_state, state.range(1));
+  placeFigure(game_state, state.range(0));
+  game_state->figure.y = HEIGHT - state.range(1) - game_state->figure.height;
+  Figure_t figure = game_state->figure;
+  for (auto _ : state) {
+    game_state->figure = figure;
+    rotateFigure(game_state);
+    benchmark::ClobberMemory();
+  }
+  state.counters["rotations_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  removeGameInfo_t();
+}
+BENCHMARK(BM_RotateDense)->ArgsProduct({{0, 4}, {0, 10, HEIGHT - 4}});
+
+/**
+ * @brief Бенчмарк мгновенного падения фигуры
+ * @details Аргумент - высота "стакана", на который падает фигура из стартовой
+ * позиции
+ */
+static void BM_MoveDown(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  buildStack(game_state, state.range(0));
+  placeFigure(game_state, 4);
+  for (auto _ : state) {
+    game_state->figure.y = 1;
+    moveDown(game_state);
+    benchmark::ClobberMemory();
+  }
+  removeGameInfo_t();
+}
+BENCHMARK(BM_MoveDown)->Arg(0)->Arg(5)->Arg(10)->Arg(15);
+
+/**
+ * @brief Макробенчмарк игрового такта
+ * @details Каждая итерация - полный такт игры, как в игровом цикле консольной
+ * версии: отрисовка фигуры в поле, её удаление и вызов tetrisMechanics с
+ * истёкшим таймером (фигура опускается или прикрепляется, удаляются линии и
+ * появляется новая фигура). После проигрыша поле очищается
+ */
+static void BM_TetrisTick(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  for (auto _ : state) {
+    GameInfo_t stats = updateCurrentState();
+    updateField(&stats, &game_state->figure, MOVING_CELL);
+    benchmark::DoNotOptimize(stats.field);
+    updateField(&stats, &game_state->figure, EMPTY_CELL);
+    game_state->set_time = 0;
+    tetrisMechanics(game_state);
+    if (game_state->game_status == kGameOver ||
+        game_state->game_status == kWin) {
+      clearBoard(game_state);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  removeGameInfo_t();
+}
+BENCHMARK(BM_TetrisTick);
+
+/**
+ * @brief Макробенчмарк падения фигуры с мгновенным сбросом
+ * @details Каждая итерация - сдвиг фигуры, мгновенное падение и такт, в
+ * котором фигура прикрепляется к полю. Нагрузка соответствует быстрой игре,
+ * при которой каждая фигура сбрасывается сразу после появления
+ */
+static void BM_TetrisHardDropTick(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  int column = 0;
+  for (auto _ : state) {
+    int shift = column++ % WIDTH - WIDTH / 2;
+    for (int i = 0; i < shift; i++) {
+      moveRight(game_state);
+    }
+    for (int i = 0; i > shift; i--) {
+      moveLeft(game_state);
+    }
+    moveDown(game_state);
+    game_state->set_time = 0;
+    tetrisMechanics(game_state);
+    if (game_state->game_status == kGameOver ||
+        game_state->game_status == kWin) {
+      clearBoard(game_state);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  removeGameInfo_t();
+}
+BENCHMARK(BM_TetrisHardDropTick);
+
+/**
+ * @brief Бенчмарк снимка и восстановления состояния игры
+ * @details Каждая итерация сохраняет снимок состояния с "стаканом" из 10 строк
+ * и восстанавливает его обратно
+ */
+static void BM_TetrisSnapshotRestore(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  buildStack(game_state, 10);
+  TetrisSnapshot_t snapshot;
+  for (auto _ : state) {
+    tetrisSnapshot(game_state, &snapshot);
+    tetrisRestore(game_state, &snapshot);
+    benchmark::ClobberMemory();
+  }
+  removeGameInfo_t();
+}
+BENCHMARK(BM_TetrisSnapshotRestore);
+
+/**
+ * @brief Бенчмарк кодирования кадра
+ * @details Каждая итерация кодирует ключевой кадр с "стаканом" из 10 строк и
+ * разностный кадр после сдвига фигуры на одну клетку вниз. Счётчики
+ * показывают размеры обоих кадров в байтах
+ */
+static void BM_FrameEncodeDelta(benchmark::State &state) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  clearBoard(game_state);
+  buildStack(game_state, 10);
+  placeFigure(game_state, 2);
+  GameInfo_t *stats = &game_state->game_info;
+  uint8_t prev[FRAME_KEY_SIZE];
+  uint8_t curr[FRAME_KEY_SIZE];
+  uint8_t delta[FRAME_DELTA_MAX_SIZE];
+  int size = 0;
+  for (auto _ : state) {
+    updateField(stats, &game_state->figure, MOVING_CELL);
+    frameEncode(stats, kStart, prev);
+    updateField(stats, &game_state->figure, EMPTY_CELL);
+    game_state->figure.y++;
+    updateField(stats, &game_state->figure, MOVING_CELL);
+    frameEncode(stats, kStart, curr);
+    updateField(stats, &game_state->figure, EMPTY_CELL);
+    game_state->figure.y--;
+    size = frameDelta(prev, curr, delta);
+    benchmark::DoNotOptimize(size);
+  }
+  state.counters["key_bytes"] = FRAME_KEY_SIZE;
+  state.counters["delta_bytes"] = size;
+  removeGameInfo_t();
+}
+BENCHMARK(BM_FrameEncodeDelta);
+
+/**
+ * @brief Макробенчмарк такта сражения
+ * @details Каждая итерация - один такт сражения из state.range(0) полей: на
+ * каждом поле фигура сдвигается и мгновенно падает, а затем планировщик
+ * делает шаг на всех полях (фигуры прикрепляются, линии удаляются и
+ * отправляются соперникам мусорными линиями). После окончания сражения оно
+ * создаётся заново вне замера. Счётчик boards_per_second показывает,
+ * сколько шагов полей укладывается в секунду
+ */
+static void BM_BattleTick(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  Battle_t battle;
+  createBattle(&battle, count, 21);
+  long long now = 0;
+  int column = 0;
+  for (auto _ : state) {
+    int shift = column++ % WIDTH - WIDTH / 2;
+    for (int i = 0; i < count; i++) {
+      UserAction_t action = shift < 0 ? Left : Right;
+      for (int j = 0; j < abs(shift + i % 3); j++) {
+        battleInput(&battle, i, action, now);
+      }
+      battleInput(&battle, i, HardDrop, now);
+    }
+    now += START_SPEED;
+    benchmark::DoNotOptimize(battleStep(&battle, now));
+    if (battleIsOver(&battle)) {
+      state.PauseTiming();
+      removeBattle(&battle);
+      createBattle(&battle, count, static_cast<unsigned int>(column));
+      state.ResumeTiming();
+    }
+  }
+  state.counters["boards_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * count,
+      benchmark::Counter::kIsRate);
+  removeBattle(&battle);
+}
+BENCHMARK(BM_BattleTick)->Arg(2)->Arg(64)->Arg(256);
+
+/**
+ * @brief Макробенчмарк шага пакетного движка
+ * @details Каждая итерация - один шаг batchStep на state.range(0) полях: на
+ * каждом поле фигура сдвигается в свой столбец, а каждая четвёртая падает
+ * мгновенно, поэтому часть полей на каждом шаге прикрепляет фигуры и удаляет
+ * линии. Поля с оконченной игрой начинают новую игру внутри замера. Счётчик
+ * boards_per_second показывает, сколько шагов полей укладывается в секунду
+ */
+static void BM_BatchStep(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  TetrisBatch_t batch;
+  createBatch(&batch, count, 21);
+  unsigned int seed = 0;
+  long long step = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) {
+      if (batch.y[i] == 1) {
+        batchInput(&batch, i, (i + step) % 2 ? Left : Right);
+      } else if ((i + step) % 4 == 0) {
+        batchInput(&batch, i, HardDrop);
+      }
+    }
+    benchmark::DoNotOptimize(batchStep(&batch));
+    for (int i = 0; i < count; i++) {
+      if (batch.status[i] != kStart) {
+        batchReset(&batch, i, seed++);
+      }
+    }
+    step++;
+  }
+  state.counters["boards_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * count,
+      benchmark::Counter::kIsRate);
+  removeBatch(&batch);
+}
+BENCHMARK(BM_BatchStep)->Arg(1024)->Arg(4096);
+
+/**
+ * @brief Макробенчмарк игры через C ABI библиотеки libbrickgame
+ * @details Каждая итерация - команда, шаг игры и кодирование кадра через
+ * таблицу функций BrickGameApi_t. Если переменная окружения BRICKGAME_ENGINE
+ * содержит путь к другой сборке библиотеки, то таблица берётся из неё (см.
+ * brickGameOpen), что позволяет сравнить две версии движка одним
+ * бенчмарком. Аргумент - номер игры (BRICKGAME_TETRIS или
+ * BRICKGAME_SNAKE)
+ * @param state Состояние бенчмарка
+ */
+static void BM_ApiGame(benchmark::State &state) {
+  BrickGameLib_t lib = {nullptr, brickGameApi()};
+  const char *engine = std::getenv("BRICKGAME_ENGINE");
+  if (engine != nullptr && brickGameOpen(engine, &lib) != START) {
+    state.SkipWithError("couldn't load BRICKGAME_ENGINE");
+  } else {
+    const BrickGameApi_t *api = lib.api;
+    int game_type = static_cast<int>(state.range(0));
+    BrickGame_t *game = api->create(game_type, 1);
+    const UserAction_t tetris_actions[] = {Left, Right, Action, HardDrop};
+    const UserAction_t snake_actions[] = {Left, Up, Right, Down};
+    const UserAction_t *actions =
+        game_type == BRICKGAME_TETRIS ? tetris_actions : snake_actions;
+    uint8_t frame[FRAME_KEY_SIZE];
+    int i = 0;
+    for (auto _ : state) {
+      if (api->status(game) != kStart) {
+        state.PauseTiming();
+        api->destroy(game);
+        game = api->create(game_type, static_cast<unsigned int>(i));
+        state.ResumeTiming();
+      }
+      api->input(game, actions[i++ % 4], false);
+      api->step(game);
+      benchmark::DoNotOptimize(api->frame(game, frame));
+    }
+    api->destroy(game);
+    brickGameClose(&lib);
+  }
+}
+BENCHMARK(BM_ApiGame)->Arg(BRICKGAME_TETRIS)->Arg(BRICKGAME_SNAKE);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+/** @file
+ * @brief Файл, содержащий реализацию C ABI библиотеки libbrickgame
+ */
+#include "brick_game_api.h"
+
+#include <new>
+
+extern "C" {
+#include "game_module.h"
+}
+
+/**
+ * @brief Состояние игры, скрытое за дескриптором BrickGame_t
+ * @details module - игровой модуль из реестра (game_module.h), state -
+ * состояние, созданное функцией create модуля
+ */
+struct BrickGame {
+  const GameModule_t *module;
+  void *state;
+};
+
+/**
+ * @brief Создаёт игру
+ * @details Модуль игры ищется в реестре по номеру. Очерёдность фигур Тетриса
+ * и появление яблок Змейки задаются состоянием генератора seed, поэтому две
+ * игры с одинаковым seed и одинаковыми командами проходят одинаково
+ * @param game Номер игры (BRICKGAME_TETRIS, BRICKGAME_SNAKE или номер
+ * зарегистрированного модуля)
+ * @param seed Состояние генератора случайных чисел
+ * @return Дескриптор игры или NULL, если номер игры неизвестен или память не
+ * выделена
+ */
+BrickGame_t *brickGameCreate(int game, unsigned int seed) {
+  const GameModule_t *module = findGameModule(game);
+  BrickGame_t *handle = nullptr;
+  if (module != nullptr) {
+    handle = new (std::nothrow) BrickGame{module, nullptr};
+  }
+  if (handle != nullptr) {
+    handle->state = module->create(seed);
+    if (handle->state == nullptr) {
+      delete handle;
+      handle = nullptr;
+    }
+  }
+  return handle;
+}
+
+/**
+ * @brief Удаляет игру и освобождает занятую ею память
+ * @param game Дескриптор игры (NULL допускается)
+ */
+void brickGameDestroy(BrickGame_t *game) {
+  if (game != nullptr) {
+    game->module->destroy(game->state);
+  }
+  delete game;
+}
+
+/**
+ * @brief Обработка команды пользователя
+ * @details Команда Terminate сразу завершает игру, остальные команды
+ * выполняет модуль игры
+ * @param game Дескриптор игры
+ * @param action Команда пользователя
+ * @param hold Индикатор зажатия клавиши (ускорение Змейки)
+ */
+void brickGameInput(BrickGame_t *game, UserAction_t action, bool hold) {
+  game->module->input(game->state, action, hold);
+}
+
+/**
+ * @brief Выполняет один шаг игры без учёта времени
+ * @details Фигура Тетриса опускается на строку или фиксируется, Змейка
+ * делает один шаг. Шаг не выполняется во время паузы и после окончания игры.
+ * Шаг не читает часы, поэтому последовательность шагов и команд
+ * воспроизводится одинаково в любой версии библиотеки
+ * @param game Дескриптор игры
+ */
+void brickGameStep(BrickGame_t *game) { game->module->step(game->state); }
+
+/**
+ * @brief Выполняет такт игры по текущему времени
+ * @details Повторяет шаг игрового цикла фронтендов: модуль сам определяет,
+ * наступило ли время шага
+ * @param game Дескриптор игры
+ */
+void brickGameTick(BrickGame_t *game) { game->module->tick(game->state); }
+
+/**
+ * @brief Кодирует состояние игры в ключевой кадр
+ * @details Кадр строится модулем игры так же, как в сессиях игрового сервера
+ * @param game Дескриптор игры
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ * @return Размер кадра в байтах
+ */
+int brickGameFrame(BrickGame_t *game, uint8_t *frame) {
+  return game->module->frame(game->state, frame);
+}
+
+/**
+ * @brief Геттер статуса игры
+ * @param game Дескриптор игры
+ * @return Статус игры
+ */
+GameStatus_t brickGameStatus(const BrickGame_t *game) {
+  return game->module->status(game->state);
+}
+
+/**
+ * @brief Считает контрольную сумму полного состояния игры
+ * @details Сумма не зависит от времени и рекорда, поэтому две сборки
+ * библиотеки, получившие одинаковые seed и команды, дают одинаковые суммы
+ * после каждого шага (см. lockstep.h)
+ * @param game Дескриптор игры
+ * @return Контрольная сумма или 0, если модуль игры её не считает
+ */
+unsigned long long brickGameChecksum(const BrickGame_t *game) {
+  return game->module->checksum != nullptr
+             ? game->module->checksum(game->state)
+             : 0;
+}
+
+/**
+ * @brief Подключает игру к журналу событий
+ * @details Игра пишет в журнал появление и фиксацию фигур или появление
+ * яблок (см. event_log.h). Если модуль игры не пишет событий, вызов ничего
+ * не делает
+ * @param game Дескриптор игры
+ * @param events Указатель на источник событий или NULL, чтобы отключить
+ * запись
+ */
+void brickGameEvents(BrickGame_t *game, GameEvents_t *events) {
+  if (game->module->events != nullptr) {
+    game->module->events(game->state, events);
+  }
+}
+
+/**
+ * @brief Возвращает таблицу функций библиотеки
+ * @details Функция ищется по имени BRICKGAME_API_SYMBOL при загрузке
+ * библиотеки через dlopen
+ * @return Указатель на статическую таблицу функций
+ */
+const BrickGameApi_t *brickGameApi(void) {
+  static const BrickGameApi_t api = {
+      BRICKGAME_API_VERSION, sizeof(BrickGameApi_t), brickGameCreate,
+      brickGameDestroy,      brickGameInput,         brickGameStep,
+      brickGameTick,         brickGameFrame,         brickGameStatus,
+      brickGameChecksum,     brickGameEvents};
+  return &api;
+}
@@ -0,0 +1,91 @@
+/** @file
+ * @brief Заголовочный файл, определяющий C ABI библиотеки libbrickgame
+ * @details Библиотека собирает движки обеих игр в один разделяемый объект и
+ * даёт к ним доступ через непрозрачный дескриптор BrickGame_t: игра
+ * создаётся, получает команды, выполняет шаги и отдаёт своё состояние
+ * ключевым кадром (см. frame_codec.h). Набор функций также доступен таблицей
+ * BrickGameApi_t, которую возвращает brickGameApi. Таблицу можно получить из
+ * библиотеки, загруженной через dlopen (см. brick_game_loader.h), поэтому
+ * несколько версий движка можно загрузить одновременно и сравнить. Игры
+ * берутся из реестра игровых модулей (см. game_module.h), номера
+ * BRICKGAME_TETRIS и BRICKGAME_SNAKE совпадают с номерами встроенных модулей.
+ *
+ * При несовместимом изменении функций или таблицы увеличивается
+ * BRICKGAME_API_VERSION, и вместе с ним меняется soname библиотеки. Новые
+ * функции добавляются только в конец таблицы
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_API_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_API_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../common/common_specification.h"
+#include "../common/event_log.h"
+
+#define BRICKGAME_API_VERSION 1
+#define BRICKGAME_API_SYMBOL "brickGameApi"
+
+#define BRICKGAME_TETRIS 0
+#define BRICKGAME_SNAKE 1
+
+#define BRICKGAME_API_MIN_SIZE offsetof(BrickGameApi_t, checksum)
+
+#define BRICKGAME_EXPORT __attribute__((visibility("default")))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Непрозрачный дескриптор игры
+ */
+typedef struct BrickGame BrickGame_t;
+
+/**
+ * @brief Таблица функций библиотеки
+ * @details version - версия ABI библиотеки, size - размер таблицы в байтах,
+ * по нему можно проверить, есть ли в таблице функции, добавленные позже.
+ * Таблица первой сборки библиотеки заканчивается функцией status
+ * (BRICKGAME_API_MIN_SIZE байт), функции checksum и events добавлены позже
+ */
+typedef struct {
+  int version;
+  int size;
+  BrickGame_t *(*create)(int game, unsigned int seed);
+  void (*destroy)(BrickGame_t *game);
+  void (*input)(BrickGame_t *game, UserAction_t action, bool hold);
+  void (*step)(BrickGame_t *game);
+  void (*tick)(BrickGame_t *game);
+  int (*frame)(BrickGame_t *game, uint8_t *frame);
+  GameStatus_t (*status)(const BrickGame_t *game);
+  unsigned long long (*checksum)(const BrickGame_t *game);
+  void (*events)(BrickGame_t *game, GameEvents_t *events);
+} BrickGameApi_t;
+
+// GAME INITIALIZATION & REMOVAL FUNCS
+BRICKGAME_EXPORT BrickGame_t *brickGameCreate(int game, unsigned int seed);
+BRICKGAME_EXPORT void brickGameDestroy(BrickGame_t *game);
+
+// GAME LOGIC
+BRICKGAME_EXPORT void brickGameInput(BrickGame_t *game, UserAction_t action,
+                                     bool hold);
+BRICKGAME_EXPORT void brickGameStep(BrickGame_t *game);
+BRICKGAME_EXPORT void brickGameTick(BrickGame_t *game);
+
+// GAME STATE
+BRICKGAME_EXPORT int brickGameFrame(BrickGame_t *game, uint8_t *frame);
+BRICKGAME_EXPORT GameStatus_t brickGameStatus(const BrickGame_t *game);
+BRICKGAME_EXPORT unsigned long long brickGameChecksum(const BrickGame_t *game);
+
+// EVENT LOG
+BRICKGAME_EXPORT void brickGameEvents(BrickGame_t *game, GameEvents_t *events);
+
+// FUNCTION TABLE
+BRICKGAME_EXPORT const BrickGameApi_t *brickGameApi(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_API_H_
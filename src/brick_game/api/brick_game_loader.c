@@ -0,0 +1,65 @@
+/** @file
+ * @brief Файл, содержащий функции загрузки библиотеки libbrickgame через
+ * dlopen
+ */
+#include "brick_game_loader.h"
+
+#include <dlfcn.h>
+#include <stddef.h>
+
+/**
+ * @brief Загружает библиотеку
+ * @details Библиотека подходит, если она экспортирует функцию
+ * BRICKGAME_API_SYMBOL и её версия ABI совпадает с BRICKGAME_API_VERSION.
+ * Таблица может быть короче текущей, если библиотека собрана до появления
+ * функций из конца таблицы: наличие такой функции проверяет brickGameHas.
+ * Неподходящая библиотека сразу закрывается
+ * @param path Путь к файлу библиотеки
+ * @param lib Указатель на структуру BrickGameLib_t, которая заполняется при
+ * успешной загрузке и обнуляется при ошибке
+ * @return START, если библиотека загружена, иначе STOP
+ */
+int brickGameOpen(const char *path, BrickGameLib_t *lib) {
+  int status = STOP;
+  lib->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  lib->api = NULL;
+  if (lib->handle != NULL) {
+    const BrickGameApi_t *(*get_api)(void) = NULL;
+    *(void **)&get_api = dlsym(lib->handle, BRICKGAME_API_SYMBOL);
+    if (get_api != NULL) {
+      lib->api = get_api();
+    }
+    if (lib->api != NULL && lib->api->version == BRICKGAME_API_VERSION &&
+        lib->api->size >= (int)BRICKGAME_API_MIN_SIZE) {
+      status = START;
+    } else {
+      brickGameClose(lib);
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Закрывает библиотеку
+ * @details Игры, созданные через таблицу функций библиотеки, должны быть
+ * удалены до её закрытия
+ * @param lib Указатель на структуру BrickGameLib_t
+ */
+void brickGameClose(BrickGameLib_t *lib) {
+  if (lib->handle != NULL) {
+    dlclose(lib->handle);
+  }
+  lib->handle = NULL;
+  lib->api = NULL;
+}
+
+/**
+ * @brief Проверяет, есть ли в таблице функций функция с заданным смещением
+ * @param api Указатель на таблицу функций
+ * @param offset Смещение поля функции в BrickGameApi_t (offsetof)
+ * @return true, если таблица содержит это поле и оно заполнено
+ */
+bool brickGameHas(const BrickGameApi_t *api, size_t offset) {
+  return api->size >= (int)(offset + sizeof(void *)) &&
+         *(void *const *)((const char *)api + offset) != NULL;
+}
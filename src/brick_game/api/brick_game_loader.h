@@ -0,0 +1,37 @@
+/** @file
+ * @brief Заголовочный файл, определяющий загрузку библиотеки libbrickgame
+ * через dlopen
+ * @details Загрузчик открывает заданную сборку библиотеки и получает из неё
+ * таблицу функций BrickGameApi_t. Библиотека собирается с -Bsymbolic и
+ * открывается с RTLD_LOCAL, поэтому каждая загруженная сборка вызывает
+ * собственный движок, даже если программа уже связана с другой версией
+ * libbrickgame. Так две версии движка можно сравнить в одном процессе
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_LOADER_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_LOADER_H_
+
+#include "brick_game_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Загруженная библиотека
+ * @details handle - дескриптор dlopen, api - таблица функций библиотеки
+ */
+typedef struct {
+  void *handle;
+  const BrickGameApi_t *api;
+} BrickGameLib_t;
+
+// LIBRARY LOADING FUNCS
+int brickGameOpen(const char *path, BrickGameLib_t *lib);
+void brickGameClose(BrickGameLib_t *lib);
+bool brickGameHas(const BrickGameApi_t *api, size_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_LOADER_H_
@@ -0,0 +1,91 @@
+/** @file
+ * @brief Файл, содержащий сценарий проверки детерминизма сборок
+ * libbrickgame
+ */
+#include "brick_game_lockstep.h"
+
+#include "brick_game_loader.h"
+
+/**
+ * @brief Выбирает команду сценария
+ * @details Команда выбирается генератором randomNumber из набора команд игры
+ * (Up в Тетрисе и Start в Змейке ничего не делают)
+ * @param game Номер игры
+ * @param script Указатель на состояние генератора команд
+ * @return Команда пользователя
+ */
+UserAction_t brickGameScriptAction(int game, unsigned int *script) {
+  const UserAction_t tetris_actions[] = {Left, Right, Action, Down,
+                                         HardDrop, Hold, Up, Up};
+  const UserAction_t snake_actions[] = {Left, Right, Up, Down,
+                                        Start, Start, Start, Start};
+  const UserAction_t *actions =
+      game == BRICKGAME_SNAKE ? snake_actions : tetris_actions;
+  return actions[randomNumber(script) % 8];
+}
+
+/**
+ * @brief Проводит одну игру сценария и передаёт её суммы в поток
+ * @details Команды выбираются функцией brickGameScriptAction генератором с
+ * состоянием seed. Игра идёт до её окончания, до steps шагов или до первого
+ * несовпадения суммы в режиме проверки
+ * @param api Указатель на таблицу функций библиотеки
+ * @param game Номер игры
+ * @param seed Состояние генератора игры и генератора команд
+ * @param steps Наибольшее количество шагов
+ * @param lockstep Указатель на поток контрольных сумм
+ * @param position Указатель на место первого расхождения, заполняется при
+ * несовпадении суммы
+ * @return START, если все суммы записаны или совпали, иначе STOP (также
+ * если игру не удалось создать или библиотека не считает суммы)
+ */
+int brickGameLockstep(const BrickGameApi_t *api, int game, unsigned int seed,
+                      int steps, Lockstep_t *lockstep,
+                      LockstepPosition_t *position) {
+  int status = STOP;
+  BrickGame_t *handle = NULL;
+  if (brickGameHas(api, offsetof(BrickGameApi_t, checksum))) {
+    handle = api->create(game, seed);
+  }
+  if (handle != NULL) {
+    unsigned int script = seed;
+    int step = 0;
+    status = lockstepPush(lockstep, api->checksum(handle));
+    while (status == START && step < steps && api->status(handle) == kStart) {
+      api->input(handle, brickGameScriptAction(game, &script), false);
+      api->step(handle);
+      step++;
+      status = lockstepPush(lockstep, api->checksum(handle));
+    }
+    if (status != START) {
+      *position = (LockstepPosition_t){game, seed, step};
+    }
+    api->destroy(handle);
+  }
+  return status;
+}
+
+/**
+ * @brief Проводит весь сценарий проверки
+ * @details Для Тетриса и Змейки проводится по games игр с seed от 0 до
+ * games - 1, все суммы передаются в один поток. Сценарий останавливается на
+ * первом расхождении
+ * @param api Указатель на таблицу функций библиотеки
+ * @param games Количество игр каждого вида
+ * @param steps Наибольшее количество шагов одной игры
+ * @param lockstep Указатель на поток контрольных сумм
+ * @param position Указатель на место первого расхождения
+ * @return START, если все суммы записаны или совпали, иначе STOP
+ */
+int brickGameLockstepRun(const BrickGameApi_t *api, int games, int steps,
+                         Lockstep_t *lockstep, LockstepPosition_t *position) {
+  int status = START;
+  const int types[] = {BRICKGAME_TETRIS, BRICKGAME_SNAKE};
+  for (int type = 0; type < 2 && status == START; type++) {
+    for (int i = 0; i < games && status == START; i++) {
+      status = brickGameLockstep(api, types[type], (unsigned int)i, steps,
+                                 lockstep, position);
+    }
+  }
+  return status;
+}
@@ -0,0 +1,49 @@
+/** @file
+ * @brief Заголовочный файл, определяющий проверку детерминизма сборок
+ * libbrickgame по потоку контрольных сумм
+ * @details Сценарий проверки - набор игр, каждая из которых создаётся по
+ * номеру игры и seed и получает команды из генератора randomNumber с тем же
+ * seed. После создания игры и после каждого шага в поток (см. lockstep.h)
+ * передаётся контрольная сумма состояния. Сценарий выполняется только
+ * через таблицу функций BrickGameApi_t, поэтому поток, записанный одной
+ * сборкой библиотеки, можно проверить другой сборкой, загруженной через
+ * brickGameOpen
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_LOCKSTEP_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_LOCKSTEP_H_
+
+#include "../common/common_back.h"
+#include "../common/lockstep.h"
+#include "brick_game_api.h"
+
+#define LOCKSTEP_GAMES 16
+#define LOCKSTEP_STEPS 5000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Место первого расхождения потоков
+ * @details game и seed - игра сценария, step - номер шага (0 - сумма сразу
+ * после создания игры)
+ */
+typedef struct {
+  int game;
+  unsigned int seed;
+  int step;
+} LockstepPosition_t;
+
+// SCENARIO
+UserAction_t brickGameScriptAction(int game, unsigned int *script);
+int brickGameLockstep(const BrickGameApi_t *api, int game, unsigned int seed,
+                      int steps, Lockstep_t *lockstep,
+                      LockstepPosition_t *position);
+int brickGameLockstepRun(const BrickGameApi_t *api, int games, int steps,
+                         Lockstep_t *lockstep, LockstepPosition_t *position);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_LOCKSTEP_H_
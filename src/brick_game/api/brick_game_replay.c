@@ -0,0 +1,94 @@
+/** @file
+ * @brief Файл, содержащий запись и воспроизведение игр
+ */
+#include "brick_game_replay.h"
+
+#include "../common/frame_codec.h"
+#include "brick_game_loader.h"
+#include "brick_game_lockstep.h"
+
+/**
+ * @brief Получает счёт игры из её ключевого кадра
+ * @param api Указатель на таблицу функций библиотеки
+ * @param handle Дескриптор игры
+ * @return Счёт игры
+ */
+static int gameScore(const BrickGameApi_t *api, BrickGame_t *handle) {
+  uint8_t frame[FRAME_KEY_SIZE];
+  api->frame(handle, frame);
+  return frameScore(frame);
+}
+
+/**
+ * @brief Проводит игру сценария проверки детерминизма и записывает её
+ * @details Команды выбираются функцией brickGameScriptAction генератором с
+ * состоянием seed, как в сценарии brickGameLockstep. Игра идёт до её
+ * окончания или до steps шагов, итоговый счёт сохраняется в запись. Если
+ * передан источник событий и библиотека их пишет, игра подключается к
+ * журналу событий
+ * @param api Указатель на таблицу функций библиотеки
+ * @param game Номер игры
+ * @param seed Состояние генератора игры и генератора команд
+ * @param steps Наибольшее количество шагов
+ * @param replay Указатель на запись, созданную функцией createReplay; её
+ * прежнее содержимое заменяется
+ * @param events Указатель на источник событий или NULL
+ * @return START в случае успеха, STOP если игра не создана или память не
+ * выделена
+ */
+int brickGameRecord(const BrickGameApi_t *api, int game, unsigned int seed,
+                    int steps, Replay_t *replay, GameEvents_t *events) {
+  int status = STOP;
+  BrickGame_t *handle = api->create(game, seed);
+  replay->game = game;
+  replay->seed = seed;
+  replay->score = 0;
+  replay->steps = 0;
+  if (handle != NULL) {
+    unsigned int script = seed;
+    status = START;
+    if (events != NULL && brickGameHas(api, offsetof(BrickGameApi_t, events))) {
+      api->events(handle, events);
+    }
+    while (status == START && replay->steps < steps &&
+           api->status(handle) == kStart) {
+      UserAction_t action = brickGameScriptAction(game, &script);
+      status = replayPush(replay, (uint8_t)action);
+      api->input(handle, action, false);
+      api->step(handle);
+    }
+    replay->score = gameScore(api, handle);
+    api->destroy(handle);
+  }
+  return status;
+}
+
+/**
+ * @brief Воспроизводит запись
+ * @details На каждом шаге выполняется записанная команда (кроме
+ * REPLAY_IDLE) и шаг игры
+ * @param api Указатель на таблицу функций библиотеки
+ * @param replay Указатель на запись
+ * @param score Указатель на переменную, в которую записывается итоговый
+ * счёт
+ * @return START в случае успеха, STOP если игра не создана
+ */
+int brickGamePlay(const BrickGameApi_t *api, const Replay_t *replay,
+                  int *score) {
+  int status = STOP;
+  BrickGame_t *handle = api->create(replay->game, replay->seed);
+  if (handle != NULL) {
+    for (int i = 0; i < replay->steps; i++) {
+      uint8_t command = replay->commands[i];
+      if (command != REPLAY_IDLE) {
+        api->input(handle, (UserAction_t)(command & ~REPLAY_HOLD),
+                   command & REPLAY_HOLD);
+      }
+      api->step(handle);
+    }
+    *score = gameScore(api, handle);
+    api->destroy(handle);
+    status = START;
+  }
+  return status;
+}
@@ -0,0 +1,32 @@
+/** @file
+ * @brief Заголовочный файл, определяющий запись и воспроизведение игр через
+ * таблицу функций libbrickgame
+ * @details Запись игры (см. replay_archive.h) хранит номер игры, seed и
+ * команды шагов. Игра воспроизводится созданием игры по номеру и seed и
+ * выполнением на каждом шаге записанной команды и brickGameStep, поэтому
+ * запись, сделанная одной сборкой библиотеки, воспроизводится любой другой
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_REPLAY_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_REPLAY_H_
+
+#include "../common/replay_archive.h"
+#include "brick_game_api.h"
+
+#define ARCHIVE_GAMES 1000
+#define ARCHIVE_STEPS 5000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// RECORDING & PLAYBACK
+int brickGameRecord(const BrickGameApi_t *api, int game, unsigned int seed,
+                    int steps, Replay_t *replay, GameEvents_t *events);
+int brickGamePlay(const BrickGameApi_t *api, const Replay_t *replay,
+                  int *score);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_BRICK_GAME_REPLAY_H_
@@ -0,0 +1,107 @@
+/** @file
+ * @brief Файл, содержащий реестр игровых модулей
+ */
+#include "game_module.h"
+
+#include <ctype.h>
+#include <stddef.h>
+
+/**
+ * @brief Реестр игровых модулей
+ */
+typedef struct {
+  int count;
+  bool is_ready;
+  const GameModule_t *modules[GAME_MODULE_MAX];
+} GameRegistry_t;
+
+/**
+ * @brief Возвращает реестр модулей
+ * @details При первом обращении в реестр добавляются встроенные модули
+ * Тетриса и Змейки
+ * @return Указатель на статический реестр
+ */
+static GameRegistry_t *getGameRegistry() {
+  static GameRegistry_t registry = {0, false, {NULL}};
+  if (!registry.is_ready) {
+    registry.is_ready = true;
+    registerGameModule(tetrisModule());
+    registerGameModule(snakeModule());
+  }
+  return &registry;
+}
+
+/**
+ * @brief Добавляет модуль в реестр
+ * @details Модуль не добавляется, если реестр заполнен, номер игры или
+ * клавиша выбора уже заняты другим модулем или у модуля нет обязательных
+ * функций. Реестр хранит указатель, поэтому модуль должен существовать до
+ * конца работы программы
+ * @param module Указатель на модуль
+ * @return START, если модуль добавлен, иначе STOP
+ */
+int registerGameModule(const GameModule_t *module) {
+  GameRegistry_t *registry = getGameRegistry();
+  int status = START;
+  if (module == NULL || registry->count >= GAME_MODULE_MAX ||
+      module->create == NULL || module->destroy == NULL ||
+      module->input == NULL || module->step == NULL ||
+      module->tick == NULL || module->frame == NULL ||
+      module->status == NULL || findGameModule(module->id) != NULL ||
+      findGameModuleByKey(module->key) != NULL) {
+    status = STOP;
+  } else {
+    registry->modules[registry->count++] = module;
+  }
+  return status;
+}
+
+/**
+ * @brief Ищет модуль по номеру игры
+ * @param id Номер игры
+ * @return Указатель на модуль или NULL, если модуля с таким номером нет
+ */
+const GameModule_t *findGameModule(int id) {
+  GameRegistry_t *registry = getGameRegistry();
+  const GameModule_t *module = NULL;
+  for (int i = 0; i < registry->count && module == NULL; i++) {
+    if (registry->modules[i]->id == id) {
+      module = registry->modules[i];
+    }
+  }
+  return module;
+}
+
+/**
+ * @brief Ищет модуль по клавише выбора в меню
+ * @param key Код клавиши (регистр букв не учитывается)
+ * @return Указатель на модуль или NULL, если клавиша не выбирает игру
+ */
+const GameModule_t *findGameModuleByKey(int key) {
+  GameRegistry_t *registry = getGameRegistry();
+  const GameModule_t *module = NULL;
+  int lower = key >= 0 && key <= 255 ? tolower(key) : key;
+  for (int i = 0; i < registry->count && module == NULL; i++) {
+    if (registry->modules[i]->key == lower) {
+      module = registry->modules[i];
+    }
+  }
+  return module;
+}
+
+/**
+ * @brief Геттер количества модулей в реестре
+ * @return Количество модулей
+ */
+int gameModuleCount(void) { return getGameRegistry()->count; }
+
+/**
+ * @brief Возвращает модуль по его месту в реестре
+ * @param index Номер модуля в порядке регистрации
+ * @return Указатель на модуль или NULL, если номер вне реестра
+ */
+const GameModule_t *gameModuleAt(int index) {
+  GameRegistry_t *registry = getGameRegistry();
+  return index >= 0 && index < registry->count ? registry->modules[index]
+                                                : NULL;
+}
@@ -0,0 +1,90 @@
+/** @file
+ * @brief Заголовочный файл, определяющий интерфейс игрового модуля и реестр
+ * модулей
+ * @details Игровой модуль описывает игру набором функций: создание по
+ * состоянию генератора, команды, шаг без учёта времени, такт по текущему
+ * времени, сериализация состояния и кодирование ключевого кадра (см.
+ * frame_codec.h). Модули хранятся в реестре, из которого их берут общие части
+ * программы: C ABI библиотеки (brick_game_api.h), меню и общий игровой цикл
+ * консольной версии, меню и общий виджет десктопной версии, сессии игрового
+ * сервера (планировщик тактов, запись кадров и рассылка). Новая игра
+ * добавляется одним модулем и вызовом registerGameModule, без изменения этих
+ * частей.
+ *
+ * Номера 0 (Тетрис) и 1 (Змейка) заняты встроенными модулями, номер 2
+ * занят сражением на игровом сервере, поэтому новые модули используют номера
+ * начиная с GAME_MODULE_FIRST_FREE
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_GAME_MODULE_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_GAME_MODULE_H_
+
+#include <stdint.h>
+
+#include "../common/common_specification.h"
+#include "../common/event_log.h"
+
+#define GAME_MODULE_TETRIS 0
+#define GAME_MODULE_SNAKE 1
+#define GAME_MODULE_FIRST_FREE 3
+#define GAME_MODULE_MAX 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Подсказки для отрисовки игры модуля
+ * @details has_next - кадр содержит следующую фигуру, start_speed - интервал
+ * шага в начале игры в миллисекундах, controls - краткое описание управления
+ * для меню
+ */
+typedef struct {
+  bool has_next;
+  int start_speed;
+  const char *controls;
+} GameModuleHints_t;
+
+/**
+ * @brief Игровой модуль
+ * @details id - номер игры, name - название для меню, key - клавиша выбора
+ * игры в меню (строчная буква), state_size - размер сериализованного
+ * состояния в байтах. Функции получают состояние, созданное функцией create.
+ * checksum - контрольная сумма полного состояния для проверки детерминизма
+ * (см. lockstep.h), необязательна. events подключает игру к журналу
+ * событий (см. event_log.h) или отключает её при NULL, необязательна
+ */
+typedef struct {
+  int id;
+  const char *name;
+  int key;
+  int state_size;
+  GameModuleHints_t hints;
+  void *(*create)(unsigned int seed);
+  void (*destroy)(void *state);
+  void (*input)(void *state, UserAction_t action, bool hold);
+  void (*step)(void *state);
+  void (*tick)(void *state);
+  void (*serialize)(const void *state, uint8_t *buffer);
+  void (*deserialize)(void *state, const uint8_t *buffer);
+  int (*frame)(void *state, uint8_t *frame);
+  GameStatus_t (*status)(const void *state);
+  unsigned long long (*checksum)(const void *state);
+  void (*events)(void *state, GameEvents_t *events);
+} GameModule_t;
+
+// REGISTRY FUNCS
+int registerGameModule(const GameModule_t *module);
+const GameModule_t *findGameModule(int id);
+const GameModule_t *findGameModuleByKey(int key);
+int gameModuleCount(void);
+const GameModule_t *gameModuleAt(int index);
+
+// BUILT-IN MODULES
+const GameModule_t *tetrisModule(void);
+const GameModule_t *snakeModule(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_API_GAME_MODULE_H_
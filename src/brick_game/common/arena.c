@@ -0,0 +1,104 @@
+/** @file
+ * @brief Файл, содержащий функции арены
+ */
+#include "arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Создаёт арену
+ * @details Блок памяти выделяется один раз и заполняется нулями
+ * @param arena Указатель на структуру Arena_t
+ * @param capacity Размер блока в байтах (см. arenaSize и arenaMatrixSize)
+ * @return START, если память выделена, и STOP в противном случае
+ */
+int createArena(Arena_t *arena, size_t capacity) {
+  arena->memory = (uint8_t *)calloc(capacity > 0 ? capacity : 1, 1);
+  arena->capacity = arena->memory != NULL ? capacity : 0;
+  arena->used = 0;
+  return arena->memory != NULL ? START : STOP;
+}
+
+/**
+ * @brief Освобождает всю память арены за O(1)
+ * @details Блок памяти остаётся выделенным, поэтому арену можно сразу
+ * использовать для следующей игры. Указатели, полученные из арены раньше,
+ * становятся недействительными
+ * @param arena Указатель на структуру Arena_t
+ */
+void resetArena(Arena_t *arena) { arena->used = 0; }
+
+/**
+ * @brief Возвращает блок памяти арены системе
+ * @param arena Указатель на структуру Arena_t
+ */
+void removeArena(Arena_t *arena) {
+  free(arena->memory);
+  arena->memory = NULL;
+  arena->capacity = 0;
+  arena->used = 0;
+}
+
+/**
+ * @brief Вычисляет, сколько места в арене займёт блок
+ * @param size Размер блока в байтах
+ * @return Размер, округлённый вверх до кратного ARENA_ALIGN
+ */
+size_t arenaSize(size_t size) {
+  return (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+/**
+ * @brief Берёт из арены блок памяти
+ * @details Блок выравнивается по ARENA_ALIGN и заполняется нулями, как после
+ * calloc
+ * @param arena Указатель на структуру Arena_t
+ * @param size Размер блока в байтах
+ * @return Указатель на блок или NULL, если в арене не хватает места
+ */
+void *arenaAlloc(Arena_t *arena, size_t size) {
+  void *block = NULL;
+  size_t need = arenaSize(size);
+  if (arena->memory != NULL && need <= arena->capacity - arena->used) {
+    block = arena->memory + arena->used;
+    arena->used += need;
+    memset(block, 0, size);
+  }
+  return block;
+}
+
+/**
+ * @brief Вычисляет, сколько места в арене займёт матрица
+ * @param height Размер матрицы по вертикали
+ * @param width Размер матрицы по горизонтали
+ * @return Размер массива строк и клеток матрицы в байтах
+ */
+size_t arenaMatrixSize(int height, int width) {
+  return arenaSize((size_t)height * sizeof(int *)) +
+         arenaSize((size_t)height * (size_t)width * sizeof(int));
+}
+
+/**
+ * @brief Берёт из арены двумерную матрицу
+ * @details Матрица устроена так же, как матрица createMatrix (массив
+ * указателей на строки), но клетки всех строк лежат в одном непрерывном
+ * блоке
+ * @param arena Указатель на структуру Arena_t
+ * @param height Размер матрицы по вертикали
+ * @param width Размер матрицы по горизонтали
+ * @return Указатель на матрицу, заполненную нулями, или NULL, если в арене
+ * не хватает места
+ */
+int **arenaMatrix(Arena_t *arena, int height, int width) {
+  int **matrix = NULL;
+  if (arenaMatrixSize(height, width) <= arena->capacity - arena->used) {
+    matrix = (int **)arenaAlloc(arena, (size_t)height * sizeof(int *));
+    int *cells =
+        (int *)arenaAlloc(arena, (size_t)height * (size_t)width * sizeof(int));
+    for (int y = 0; y < height; y++) {
+      matrix[y] = cells + (size_t)y * (size_t)width;
+    }
+  }
+  return matrix;
+}
@@ -0,0 +1,42 @@
+/** @file
+ * @brief Заголовочный файл, определяющий арену - область памяти игры
+ * @details Арена выделяется одним блоком при создании игры, размер блока
+ * вычисляется заранее по размерам поля. Части состояния (матрицы поля,
+ * массивы пакетного движка) берутся из арены сдвигом указателя и не
+ * освобождаются по отдельности: вся память игры освобождается одним вызовом
+ * removeArena, а resetArena за O(1) готовит арену к следующей игре без
+ * повторного выделения памяти
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_ARENA_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_specification.h"
+
+#define ARENA_ALIGN 16
+
+/**
+ * @brief Арена
+ * @details memory - блок памяти размером capacity байт, used - занятая
+ * часть блока (кратна ARENA_ALIGN)
+ */
+typedef struct {
+  uint8_t *memory;
+  size_t capacity;
+  size_t used;
+} Arena_t;
+
+// ARENA INITIALIZATION & REMOVAL FUNCS
+int createArena(Arena_t *arena, size_t capacity);
+void resetArena(Arena_t *arena);
+void removeArena(Arena_t *arena);
+
+// ALLOCATION FUNCS
+size_t arenaSize(size_t size);
+void *arenaAlloc(Arena_t *arena, size_t size);
+size_t arenaMatrixSize(int height, int width);
+int **arenaMatrix(Arena_t *arena, int height, int width);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_ARENA_H_
@@ -31,4 +31,45 @@ void setSpeed(int *level, int *speed) {
     *level = 10;
     *speed = START_SPEED * 0.05;
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Генерирует псевдослучайное число
+ * @details Функция продвигает состояние генератора seed на постоянный шаг и
+ * перемешивает его (алгоритм splitmix32). Всё состояние генератора хранится в
+ * одной переменной игры, поэтому его можно сохранить в снимок состояния и
+ * восстановить, получив ту же последовательность чисел
+ * @param seed Указатель на состояние генератора
+ * @return Псевдослучайное неотрицательное число
+ */
+int randomNumber(unsigned int *seed) {
+  *seed += 0x9E3779B9u;
+  unsigned int z = *seed;
+  z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+  z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+  z ^= z >> 16;
+  return (int)(z >> 1);
+}
+
+/**
+ * @brief Возвращает ключ Зобриста для элемента игрового состояния
+ * @details Ключ - псевдослучайное 64-битное число, однозначно определяемое
+ * видом элемента и двумя его параметрами (например, координатами клетки).
+ * Ключи вычисляются перемешиванием splitmix64, поэтому таблицы ключей не нужны
+ * и подходят для любых размеров поля. Хеш состояния - это XOR ключей всех его
+ * элементов, поэтому при изменении элемента хеш обновляется двумя операциями
+ * XOR
+ * @param kind Вид элемента
+ * @param a Первый параметр элемента
+ * @param b Второй параметр элемента
+ * @return Ключ элемента
+ */
+unsigned long long zobristKey(int kind, int a, int b) {
+  unsigned long long z = ((unsigned long long)(kind & 0xFFFF) << 48) ^
+                         ((unsigned long long)(a & 0xFFFFFF) << 24) ^
+                         (unsigned long long)(b & 0xFFFFFF);
+  z += 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
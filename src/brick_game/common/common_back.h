@@ -14,4 +14,10 @@ long long setTime();
 // SPEED UPDATER
 void setSpeed(int *level, int *speed);
 
+// RANDOM NUMBER GENERATOR
+int randomNumber(unsigned int *seed);
+
+// ZOBRIST HASHING
+unsigned long long zobristKey(int kind, int a, int b);
+
 #endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_COMMON_BACK_H_
\ No newline at end of file
@@ -24,6 +24,7 @@
 #define EMPTY_CELL 0
 #define MOVING_CELL 1
 #define STATIC_CELL 2
+#define GHOST_CELL 3
 
 /**
  * @brief Структура, хранящая информацию о пользовательских командах
@@ -36,7 +37,9 @@ typedef enum {
   Right,
   Up,
   Down,
-  Action
+  Action,
+  HardDrop,
+  Hold
 } UserAction_t;
 
 /**
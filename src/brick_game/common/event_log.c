@@ -0,0 +1,231 @@
+/** @file
+ * @brief Файл, содержащий столбцовый журнал игровых событий
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "event_log.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Открывает журнал для дозаписи
+ * @param log Указатель на структуру EventLog_t
+ * @param path Путь к файлу журнала
+ * @return START в случае успеха, STOP если файл не открыт или память не
+ * выделена
+ */
+int createEventLog(EventLog_t *log, const char *path) {
+  log->rows = 0;
+  log->columns = (int32_t(*)[EVENT_BLOCK_ROWS])malloc(
+      EVENT_COLUMNS * sizeof(*log->columns));
+  log->file = log->columns != NULL ? fopen(path, "ab") : NULL;
+  int status = log->file != NULL ? START : STOP;
+  if (status != START) {
+    free(log->columns);
+    log->columns = NULL;
+  }
+  return status;
+}
+
+/**
+ * @brief Дописывает неполный блок и закрывает журнал
+ * @param log Указатель на структуру EventLog_t
+ * @return START в случае успеха, STOP если блок не записан
+ */
+int removeEventLog(EventLog_t *log) {
+  int status = STOP;
+  if (log->file != NULL) {
+    status = eventLogFlush(log);
+    if (fclose(log->file) != 0) {
+      status = STOP;
+    }
+  }
+  free(log->columns);
+  *log = (EventLog_t){NULL, NULL, 0};
+  return status;
+}
+
+/**
+ * @brief Добавляет строку в журнал
+ * @details Значения раскладываются по столбцам текущего блока. Заполненный
+ * блок сразу пишется в файл
+ * @param log Указатель на открытый журнал
+ * @param row Строка из EVENT_COLUMNS значений
+ * @return START в случае успеха, STOP если блок не записан
+ */
+int eventLogAppend(EventLog_t *log, const int32_t *row) {
+  int status = START;
+  for (int c = 0; c < EVENT_COLUMNS; c++) {
+    log->columns[c][log->rows] = row[c];
+  }
+  log->rows++;
+  if (log->rows == EVENT_BLOCK_ROWS) {
+    status = eventLogFlush(log);
+  }
+  return status;
+}
+
+/**
+ * @brief Пишет текущий блок в файл
+ * @details Перед столбцами записываются их наименьшие и наибольшие значения.
+ * Пустой блок не пишется
+ * @param log Указатель на открытый журнал
+ * @return START в случае успеха, STOP если блок не записан
+ */
+int eventLogFlush(EventLog_t *log) {
+  int status = START;
+  if (log->rows > 0) {
+    uint8_t header[EVENT_HEADER_SIZE] = {'B', 'G', 'E', 'V', EVENT_VERSION};
+    int32_t bounds[2][EVENT_COLUMNS];
+    uint32_t fields[2] = {(uint32_t)log->rows, EVENT_BYTE_ORDER};
+    for (int c = 0; c < EVENT_COLUMNS; c++) {
+      const int32_t *column = log->columns[c];
+      int32_t min = column[0];
+      int32_t max = column[0];
+      for (int i = 1; i < log->rows; i++) {
+        min = column[i] < min ? column[i] : min;
+        max = column[i] > max ? column[i] : max;
+      }
+      bounds[0][c] = min;
+      bounds[1][c] = max;
+    }
+    memcpy(header + 8, fields, sizeof(fields));
+    memcpy(header + 16, bounds, sizeof(bounds));
+    bool is_written =
+        fwrite(header, 1, sizeof(header), log->file) == sizeof(header);
+    for (int c = 0; c < EVENT_COLUMNS && is_written; c++) {
+      is_written = fwrite(log->columns[c], sizeof(int32_t), log->rows,
+                          log->file) == (size_t)log->rows;
+    }
+    status = is_written ? START : STOP;
+    log->rows = 0;
+  }
+  return status;
+}
+
+/**
+ * @brief Подключает игру к журналу
+ * @param events Указатель на источник событий игры
+ * @param log Указатель на открытый журнал
+ * @param session Номер игры в журнале
+ * @param game Номер игрового модуля
+ */
+void startGameEvents(GameEvents_t *events, EventLog_t *log, int session,
+                     int game) {
+  *events = (GameEvents_t){log, session, game, 0, 0};
+}
+
+/**
+ * @brief Записывает событие игры
+ * @details Для фиксации фигуры и появления яблока EVENT_THINK - количество
+ * шагов игры с предыдущего появления фигуры или яблока. Появление фигуры
+ * или яблока начинает отсчёт заново. Ошибка записи блока не прерывает игру:
+ * событие теряется, а журнал продолжает работу
+ * @param events Указатель на источник событий игры
+ * @param kind Вид события
+ * @param piece Номер фигуры или длина змейки
+ * @param rotation Поворот фигуры или направление змейки
+ * @param x Положение по горизонтали
+ * @param y Положение по вертикали
+ * @param lines Количество удалённых линий
+ * @param score Изменение счёта
+ */
+void gameEvent(GameEvents_t *events, int kind, int piece, int rotation, int x,
+               int y, int lines, int score) {
+  int32_t think = kind == EVENT_SPAWN ? 0 : events->tick - events->spawn_tick;
+  if (kind != EVENT_LOCK) {
+    events->spawn_tick = events->tick;
+  }
+  const int32_t row[EVENT_COLUMNS] = {
+      events->tick, events->session, events->game, kind,  piece, rotation,
+      x,            y,               lines,        score, think};
+  if (events->log != NULL) {
+    eventLogAppend(events->log, row);
+  }
+}
+
+/**
+ * @brief Открывает журнал для чтения
+ * @details Файл отображается в память только для чтения. Пустой файл
+ * открывается как журнал без блоков
+ * @param file Указатель на структуру EventFile_t
+ * @param path Путь к файлу журнала
+ * @return START в случае успеха, STOP если файл не открыт
+ */
+int openEventFile(EventFile_t *file, const char *path) {
+  int status = STOP;
+  *file = (EventFile_t){NULL, 0};
+  int fd = open(path, O_RDONLY);
+  struct stat info;
+  if (fd >= 0 && fstat(fd, &info) == 0) {
+    status = START;
+    if (info.st_size > 0) {
+      void *map =
+          mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {
+        status = STOP;
+      } else {
+        file->map = (const uint8_t *)map;
+        file->size = (size_t)info.st_size;
+        posix_madvise(map, file->size, POSIX_MADV_SEQUENTIAL);
+      }
+    }
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+  return status;
+}
+
+/**
+ * @brief Закрывает журнал
+ * @param file Указатель на структуру EventFile_t
+ */
+void closeEventFile(EventFile_t *file) {
+  if (file->map != NULL) {
+    munmap((void *)file->map, file->size);
+  }
+  *file = (EventFile_t){NULL, 0};
+}
+
+/**
+ * @brief Читает блок журнала
+ * @details Столбцы блока указывают прямо в отображение файла. Блок с
+ * неверным заголовком, другим порядком байтов или обрезанный блок не
+ * читается
+ * @param file Указатель на открытый журнал
+ * @param offset Указатель на смещение блока, после чтения указывает на
+ * следующий блок
+ * @param block Указатель на структуру EventBlock_t
+ * @return START, если блок прочитан, STOP в конце файла или если блок
+ * повреждён
+ */
+int eventBlock(const EventFile_t *file, size_t *offset, EventBlock_t *block) {
+  int status = STOP;
+  if (*offset <= file->size && file->size - *offset >= EVENT_HEADER_SIZE) {
+    const uint8_t *header = file->map + *offset;
+    uint32_t fields[2];
+    memcpy(fields, header + 8, sizeof(fields));
+    size_t size =
+        EVENT_HEADER_SIZE + (size_t)fields[0] * EVENT_COLUMNS * sizeof(int32_t);
+    if (memcmp(header, "BGEV", 4) == 0 && header[4] == EVENT_VERSION &&
+        fields[1] == EVENT_BYTE_ORDER && fields[0] > 0 &&
+        fields[0] <= EVENT_BLOCK_ROWS && file->size - *offset >= size) {
+      const int32_t *data = (const int32_t *)(header + EVENT_HEADER_SIZE);
+      block->rows = (int)fields[0];
+      memcpy(block->min, header + 16, sizeof(block->min));
+      memcpy(block->max, header + 16 + sizeof(block->min), sizeof(block->max));
+      for (int c = 0; c < EVENT_COLUMNS; c++) {
+        block->columns[c] = data + (size_t)c * block->rows;
+      }
+      *offset += size;
+      status = START;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,139 @@
+/** @file
+ * @brief Заголовочный файл, определяющий столбцовый журнал игровых событий
+ * @details Журнал собирает события игр для анализа баланса: появление и
+ * фиксацию фигур Тетриса и появление яблок Змейки. Каждое событие - строка
+ * из EVENT_COLUMNS целых чисел (см. EventColumn_t). Строки накапливаются в
+ * памяти по столбцам и пишутся в файл блоками до EVENT_BLOCK_ROWS строк:
+ * - заголовок блока (EVENT_HEADER_SIZE байт): "BGEV", версия (1 байт), 3
+ * резервных байта, количество строк (4 байта), метка порядка байтов
+ * EVENT_BYTE_ORDER (4 байта);
+ * - наименьшие и наибольшие значения столбцов блока (по EVENT_COLUMNS
+ * чисел);
+ * - столбцы подряд, по 4 байта на значение.
+ *
+ * Файл открывается только на дозапись, поэтому журналы нескольких запусков
+ * складываются в один файл. Числа пишутся в порядке байтов машины, который
+ * проверяется по метке, поэтому читатель отображает файл в память и отдаёт
+ * столбцы блока как массивы int32_t без копирования и разбора. Проход по
+ * столбцу компилятор векторизует, а блоки, диапазон значений которых не
+ * подходит под условие, пропускаются по наименьшим и наибольшим значениям
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_EVENT_LOG_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_EVENT_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "common_specification.h"
+
+#define EVENT_VERSION 1
+#define EVENT_BLOCK_ROWS 4096
+#define EVENT_BYTE_ORDER 0x01020304
+#define EVENT_HEADER_SIZE (16 + 2 * 4 * EVENT_COLUMNS)
+#define EVENT_LOG_ENV "BRICKGAME_EVENTS"
+
+#define EVENT_SPAWN 0
+#define EVENT_LOCK 1
+#define EVENT_APPLE 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Столбцы журнала
+ * @details EVENT_TICK - номер шага игры, EVENT_SESSION - номер игры в
+ * журнале, EVENT_GAME - номер игрового модуля, EVENT_KIND - вид события
+ * (EVENT_SPAWN, EVENT_LOCK, EVENT_APPLE), EVENT_PIECE - номер фигуры (для
+ * яблока - длина змейки), EVENT_ROTATION - поворот фигуры (для яблока -
+ * направление змейки), EVENT_X и EVENT_Y - положение фигуры или нового
+ * яблока, EVENT_LINES - количество удалённых линий, EVENT_SCORE - изменение
+ * счёта, EVENT_THINK - время от появления фигуры или предыдущего яблока в
+ * шагах игры (по EVENT_TICK). Время считается по часам самой игры, а не
+ * машины, поэтому оно одинаково в консольной игре и в игре, которую
+ * проводит без задержек brickGameStep
+ */
+typedef enum {
+  EVENT_TICK,
+  EVENT_SESSION,
+  EVENT_GAME,
+  EVENT_KIND,
+  EVENT_PIECE,
+  EVENT_ROTATION,
+  EVENT_X,
+  EVENT_Y,
+  EVENT_LINES,
+  EVENT_SCORE,
+  EVENT_THINK,
+  EVENT_COLUMNS
+} EventColumn_t;
+
+/**
+ * @brief Журнал, открытый для записи
+ * @details columns - буфер текущего блока, rows - количество строк в нём
+ */
+typedef struct {
+  FILE *file;
+  int32_t (*columns)[EVENT_BLOCK_ROWS];
+  int rows;
+} EventLog_t;
+
+/**
+ * @brief Источник событий одной игры
+ * @details log - журнал (NULL - события не пишутся), session и game -
+ * значения столбцов EVENT_SESSION и EVENT_GAME, tick - номер шага игры,
+ * spawn_tick - шаг появления фигуры или яблока, от которого считается
+ * EVENT_THINK
+ */
+typedef struct GameEvents {
+  EventLog_t *log;
+  int session;
+  int game;
+  int tick;
+  int spawn_tick;
+} GameEvents_t;
+
+/**
+ * @brief Блок журнала, открытого для чтения
+ * @details rows - количество строк, min и max - наименьшие и наибольшие
+ * значения столбцов, columns - столбцы в отображении файла
+ */
+typedef struct {
+  int rows;
+  int32_t min[EVENT_COLUMNS];
+  int32_t max[EVENT_COLUMNS];
+  const int32_t *columns[EVENT_COLUMNS];
+} EventBlock_t;
+
+/**
+ * @brief Журнал, открытый для чтения
+ * @details map - отображение файла размером size байт
+ */
+typedef struct {
+  const uint8_t *map;
+  size_t size;
+} EventFile_t;
+
+// LOG INITIALIZATION & REMOVAL
+int createEventLog(EventLog_t *log, const char *path);
+int removeEventLog(EventLog_t *log);
+
+// LOG WRITING
+int eventLogAppend(EventLog_t *log, const int32_t *row);
+int eventLogFlush(EventLog_t *log);
+void startGameEvents(GameEvents_t *events, EventLog_t *log, int session,
+                     int game);
+void gameEvent(GameEvents_t *events, int kind, int piece, int rotation, int x,
+               int y, int lines, int score);
+
+// LOG READING
+int openEventFile(EventFile_t *file, const char *path);
+void closeEventFile(EventFile_t *file);
+int eventBlock(const EventFile_t *file, size_t *offset, EventBlock_t *block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_EVENT_LOG_H_
@@ -0,0 +1,331 @@
+/** @file
+ * @brief Файл, содержащий функции кодирования и чтения кадров игры
+ */
+#include "frame_codec.h"
+
+#include <string.h>
+
+#define FRAME_ROW_MASK ((1 << WIDTH) - 1)
+#define FRAME_PLANE_BIT 10
+#define FRAME_ROW_SHIFT 11
+#define FRAME_MAX_WORD 0xFFFF
+#define FRAME_MAX_TRIPLE 0xFFFFFF
+
+_Static_assert(WIDTH <= FRAME_PLANE_BIT && HEIGHT <= 32,
+               "frame entries hold 10 cells and 5-bit row numbers");
+
+/**
+ * @brief Записывает число в буфер в порядке little-endian
+ * @details Значения, не помещающиеся в заданное количество байт,
+ * ограничиваются максимальным значением
+ * @param out Указатель на первый байт числа
+ * @param value Число
+ * @param size Количество байт
+ * @param max Максимальное значение, которое помещается в size байт
+ */
+static void putNumber(uint8_t *out, int value, int size, int max) {
+  int number = value < 0 ? 0 : (value > max ? max : value);
+  for (int i = 0; i < size; i++) {
+    out[i] = (uint8_t)(number >> (i * 8));
+  }
+}
+
+/**
+ * @brief Читает число из буфера в порядке little-endian
+ * @param data Указатель на первый байт числа
+ * @param size Количество байт
+ * @return Прочитанное число
+ */
+static int getNumber(const uint8_t *data, int size) {
+  int number = 0;
+  for (int i = 0; i < size; i++) {
+    number |= data[i] << (i * 8);
+  }
+  return number;
+}
+
+/**
+ * @brief Читает маску клеток строки из битовой плоскости
+ * @details При WIDTH <= 10 строка начинается с чётного бита и всегда
+ * умещается в два соседних байта
+ * @param plane Указатель на битовую плоскость
+ * @param y Номер строки
+ * @return Маска клеток строки (бит x соответствует клетке x)
+ */
+static int getRow(const uint8_t *plane, int y) {
+  int bit = y * WIDTH;
+  int byte = bit >> 3;
+  int word = plane[byte];
+  if (byte + 1 < FRAME_PLANE_SIZE) {
+    word |= plane[byte + 1] << 8;
+  }
+  return (word >> (bit & 7)) & FRAME_ROW_MASK;
+}
+
+/**
+ * @brief Инвертирует клетки строки в битовой плоскости
+ * @param plane Указатель на битовую плоскость
+ * @param y Номер строки
+ * @param mask Маска клеток, которые нужно инвертировать
+ */
+static void flipRow(uint8_t *plane, int y, int mask) {
+  int bit = y * WIDTH;
+  int byte = bit >> 3;
+  int word = (mask & FRAME_ROW_MASK) << (bit & 7);
+  plane[byte] ^= (uint8_t)word;
+  if (byte + 1 < FRAME_PLANE_SIZE) {
+    plane[byte + 1] ^= (uint8_t)(word >> 8);
+  }
+}
+
+/**
+ * @brief Кодирует состояние игры в ключевой кадр
+ * @details Поле GameInfo_t читается так же, как его рисует интерфейс: клетки
+ * с координатами от 1 до HEIGHT и от 1 до WIDTH. Если поле или следующая
+ * фигура не созданы (NULL), то соответствующая часть кадра остаётся пустой
+ * @param stats Указатель на структуру GameInfo_t
+ * @param status Текущий статус игры
+ * @param frame Буфер размером не менее FRAME_KEY_SIZE байт
+ * @return Размер записанного кадра (FRAME_KEY_SIZE)
+ */
+int frameEncode(const GameInfo_t *stats, GameStatus_t status, uint8_t *frame) {
+  memset(frame, 0, FRAME_KEY_SIZE);
+  frame[0] = FRAME_VERSION << 4 | FRAME_KEY;
+  uint8_t *data = frame + 1;
+  data[0] = (uint8_t)((status & 0x0F) | (stats->pause & 0x0F) << 4);
+  putNumber(data + 1, stats->level, 1, 0xFF);
+  putNumber(data + 2, stats->speed, 2, FRAME_MAX_WORD);
+  putNumber(data + 4, stats->score, 3, FRAME_MAX_TRIPLE);
+  putNumber(data + 7, stats->high_score, 3, FRAME_MAX_TRIPLE);
+  int next = 0;
+  for (int y = 0; y < 4 && stats->next != NULL; y++) {
+    for (int x = 0; x < 4; x++) {
+      if (stats->next[y][x]) {
+        next |= 1 << (y * 4 + x);
+      }
+    }
+  }
+  putNumber(data + 10, next, 2, FRAME_MAX_WORD);
+  uint8_t *low = frame + FRAME_FIELD_OFFSET;
+  uint8_t *high = low + FRAME_PLANE_SIZE;
+  for (int y = 0; y < HEIGHT && stats->field != NULL; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      int cell = stats->field[y + 1][x + 1];
+      int bit = y * WIDTH + x;
+      low[bit >> 3] |= (uint8_t)((cell & 1) << (bit & 7));
+      high[bit >> 3] |= (uint8_t)(((cell >> 1) & 1) << (bit & 7));
+    }
+  }
+  return FRAME_KEY_SIZE;
+}
+
+/**
+ * @brief Кодирует разностный кадр между двумя ключевыми кадрами
+ * @details Для каждой строки каждой плоскости, которая отличается в двух
+ * кадрах, записывается одна запись с маской изменившихся клеток. Статистика
+ * записывается, только если она изменилась. Сдвиг фигуры на одну клетку
+ * меняет 2-4 строки одной плоскости, поэтому типичный разностный кадр
+ * занимает от 5 до 9 байт
+ * @param prev Предыдущий ключевой кадр
+ * @param curr Текущий ключевой кадр
+ * @param delta Буфер размером не менее FRAME_DELTA_MAX_SIZE байт
+ * @return Размер записанного кадра или 0, если кадры совпадают
+ */
+int frameDelta(const uint8_t *prev, const uint8_t *curr, uint8_t *delta) {
+  int size = 1;
+  int stats = memcmp(prev + 1, curr + 1, FRAME_STATS_SIZE) != 0;
+  delta[0] = FRAME_VERSION << 4 | (stats ? FRAME_DELTA_STATS : FRAME_DELTA);
+  if (stats) {
+    memcpy(delta + size, curr + 1, FRAME_STATS_SIZE);
+    size += FRAME_STATS_SIZE;
+  }
+  int entries = 0;
+  for (int plane = 0; plane < 2; plane++) {
+    const uint8_t *a = prev + FRAME_FIELD_OFFSET + plane * FRAME_PLANE_SIZE;
+    const uint8_t *b = curr + FRAME_FIELD_OFFSET + plane * FRAME_PLANE_SIZE;
+    for (int y = 0; y < HEIGHT; y++) {
+      int mask = getRow(a, y) ^ getRow(b, y);
+      if (mask) {
+        putNumber(delta + size,
+                  mask | plane << FRAME_PLANE_BIT | y << FRAME_ROW_SHIFT,
+                  FRAME_ENTRY_SIZE, FRAME_MAX_WORD);
+        size += FRAME_ENTRY_SIZE;
+        entries++;
+      }
+    }
+  }
+  return stats || entries ? size : 0;
+}
+
+/**
+ * @brief Проверяет корректность записи кадра
+ * @details Проверяются версия, тип, размер записи, статус игры и номера строк
+ * в записях разностного кадра
+ * @param data Указатель на запись
+ * @param size Размер записи в байтах
+ * @return START, если запись корректна, и STOP в противном случае
+ */
+int frameCheck(const uint8_t *data, int size) {
+  int status = STOP;
+  if (size >= 1 && frameVersion(data) == FRAME_VERSION) {
+    int type = frameType(data);
+    int offset = type == FRAME_DELTA ? 1 : FRAME_FIELD_OFFSET;
+    if (type == FRAME_KEY) {
+      status = size == FRAME_KEY_SIZE ? START : STOP;
+    } else if ((type == FRAME_DELTA || type == FRAME_DELTA_STATS) &&
+               size >= offset && (size - offset) % FRAME_ENTRY_SIZE == 0) {
+      status = START;
+      for (int i = offset; i < size && status == START; i += FRAME_ENTRY_SIZE) {
+        if ((getNumber(data + i, FRAME_ENTRY_SIZE) >> FRAME_ROW_SHIFT) >=
+            HEIGHT) {
+          status = STOP;
+        }
+      }
+    }
+    if (status == START && type != FRAME_DELTA && frameStatus(data) > kWin) {
+      status = STOP;
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Применяет запись к ключевому кадру на месте
+ * @details Ключевой кадр полностью заменяет содержимое frame, разностный кадр
+ * инвертирует клетки, указанные в его записях, и при необходимости заменяет
+ * статистику. Некорректная запись не применяется
+ * @param frame Ключевой кадр (FRAME_KEY_SIZE байт)
+ * @param delta Запись, полученная от frameEncode или frameDelta
+ * @param size Размер записи в байтах
+ * @return START, если запись применена, и STOP, если она некорректна
+ */
+int frameApply(uint8_t *frame, const uint8_t *delta, int size) {
+  int status = frameCheck(delta, size);
+  if (status == START && frameType(delta) == FRAME_KEY) {
+    memcpy(frame, delta, FRAME_KEY_SIZE);
+  } else if (status == START) {
+    int offset = 1;
+    if (frameType(delta) == FRAME_DELTA_STATS) {
+      memcpy(frame + 1, delta + 1, FRAME_STATS_SIZE);
+      offset += FRAME_STATS_SIZE;
+    }
+    for (int i = offset; i < size; i += FRAME_ENTRY_SIZE) {
+      int entry = getNumber(delta + i, FRAME_ENTRY_SIZE);
+      int plane = (entry >> FRAME_PLANE_BIT) & 1;
+      flipRow(frame + FRAME_FIELD_OFFSET + plane * FRAME_PLANE_SIZE,
+              entry >> FRAME_ROW_SHIFT, entry & FRAME_ROW_MASK);
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Геттер версии формата записи
+ * @param data Указатель на запись
+ * @return Версия формата
+ */
+int frameVersion(const uint8_t *data) { return data[0] >> 4; }
+
+/**
+ * @brief Геттер типа записи
+ * @param data Указатель на запись
+ * @return FRAME_KEY, FRAME_DELTA или FRAME_DELTA_STATS
+ */
+int frameType(const uint8_t *data) { return data[0] & 0x0F; }
+
+/**
+ * @brief Читает значение клетки поля из ключевого кадра
+ * @param frame Ключевой кадр
+ * @param y Номер строки (от 0 до HEIGHT - 1)
+ * @param x Номер столбца (от 0 до WIDTH - 1)
+ * @return Значение клетки (EMPTY_CELL, MOVING_CELL, STATIC_CELL или
+ * GHOST_CELL)
+ */
+int frameCell(const uint8_t *frame, int y, int x) {
+  const uint8_t *low = frame + FRAME_FIELD_OFFSET;
+  const uint8_t *high = low + FRAME_PLANE_SIZE;
+  int bit = y * WIDTH + x;
+  return ((low[bit >> 3] >> (bit & 7)) & 1) |
+         ((high[bit >> 3] >> (bit & 7)) & 1) << 1;
+}
+
+/**
+ * @brief Читает клетку следующей фигуры из ключевого кадра
+ * @param frame Ключевой кадр
+ * @param y Номер строки (от 0 до 3)
+ * @param x Номер столбца (от 0 до 3)
+ * @return MOVING_CELL, если клетка занята, иначе EMPTY_CELL
+ */
+int frameNext(const uint8_t *frame, int y, int x) {
+  return (getNumber(frame + 11, 2) >> (y * 4 + x)) & 1;
+}
+
+/**
+ * @brief Геттер счёта
+ * @param data Ключевой кадр или разностный кадр типа FRAME_DELTA_STATS
+ * @return Счёт
+ */
+int frameScore(const uint8_t *data) { return getNumber(data + 5, 3); }
+
+/**
+ * @brief Геттер рекорда
+ * @param data Ключевой кадр или разностный кадр типа FRAME_DELTA_STATS
+ * @return Рекорд
+ */
+int frameHighScore(const uint8_t *data) { return getNumber(data + 8, 3); }
+
+/**
+ * @brief Геттер уровня
+ * @param data Ключевой кадр или разностный кадр типа FRAME_DELTA_STATS
+ * @return Уровень
+ */
+int frameLevel(const uint8_t *data) { return data[2]; }
+
+/**
+ * @brief Геттер скорости
+ * @param data Ключевой кадр или разностный кадр типа FRAME_DELTA_STATS
+ * @return Скорость
+ */
+int frameSpeed(const uint8_t *data) { return getNumber(data + 3, 2); }
+
+/**
+ * @brief Геттер паузы
+ * @param data Ключевой кадр или разностный кадр типа FRAME_DELTA_STATS
+ * @return Значение паузы
+ */
+int framePause(const uint8_t *data) { return data[1] >> 4; }
+
+/**
+ * @brief Геттер статуса игры
+ * @param data Ключевой кадр или разностный кадр типа FRAME_DELTA_STATS
+ * @return Статус игры
+ */
+GameStatus_t frameStatus(const uint8_t *data) {
+  return (GameStatus_t)(data[1] & 0x0F);
+}
+
+/**
+ * @brief Распаковывает ключевой кадр в структуру GameInfo_t
+ * @details Матрицы field и next должны быть созданы вызывающей стороной
+ * (HEIGHT + 1 на WIDTH + 1 и 4 на 4). Клетки поля записываются с координатами
+ * от 1 до HEIGHT и от 1 до WIDTH, как их рисует интерфейс
+ * @param frame Ключевой кадр
+ * @param stats Указатель на структуру GameInfo_t
+ */
+void frameDecode(const uint8_t *frame, GameInfo_t *stats) {
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      stats->field[y + 1][x + 1] = frameCell(frame, y, x);
+    }
+  }
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      stats->next[y][x] = frameNext(frame, y, x);
+    }
+  }
+  stats->score = frameScore(frame);
+  stats->high_score = frameHighScore(frame);
+  stats->level = frameLevel(frame);
+  stats->speed = frameSpeed(frame);
+  stats->pause = framePause(frame);
+}
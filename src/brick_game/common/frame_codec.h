@@ -0,0 +1,68 @@
+/** @file
+ * @brief Заголовочный файл, определяющий компактный двоичный формат кадров
+ * игры
+ * @details Кадр - это запись фиксированной структуры без указателей, которую
+ * можно передать по сети или сохранить в файл. Первый байт записи содержит
+ * версию формата (старшие 4 бита) и тип записи (младшие 4 бита).
+ *
+ * Ключевой кадр (FRAME_KEY, FRAME_KEY_SIZE байт):
+ * - байт 0: версия и тип;
+ * - байты 1-12: статистика (FRAME_STATS_SIZE байт): статус игры и пауза,
+ * уровень, скорость (2 байта), счёт (3 байта), рекорд (3 байта), следующая
+ * фигура в виде 16-битной маски;
+ * - байты 13-62: поле, 2 бита на клетку, разложенные на две битовые
+ * плоскости по FRAME_PLANE_SIZE байт. Первая плоскость хранит младшие биты
+ * значений клеток, вторая - старшие. Клетка (y, x) занимает бит y * WIDTH + x
+ * каждой плоскости.
+ *
+ * Разностный кадр (FRAME_DELTA или FRAME_DELTA_STATS) описывает изменения
+ * относительно предыдущего ключевого кадра:
+ * - байт 0: версия и тип;
+ * - статистика, если тип FRAME_DELTA_STATS;
+ * - записи по FRAME_ENTRY_SIZE байт (little-endian): биты 0-9 - маска клеток
+ * строки, которые нужно инвертировать, бит 10 - номер плоскости, биты 11-15 -
+ * номер строки.
+ *
+ * Все многобайтовые числа хранятся в порядке little-endian
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_FRAME_CODEC_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_FRAME_CODEC_H_
+
+#include <stdint.h>
+
+#include "common_specification.h"
+
+#define FRAME_VERSION 1
+
+#define FRAME_KEY 1
+#define FRAME_DELTA 2
+#define FRAME_DELTA_STATS 3
+
+#define FRAME_STATS_SIZE 12
+#define FRAME_PLANE_SIZE ((HEIGHT * WIDTH + 7) / 8)
+#define FRAME_FIELD_OFFSET (1 + FRAME_STATS_SIZE)
+#define FRAME_KEY_SIZE (FRAME_FIELD_OFFSET + 2 * FRAME_PLANE_SIZE)
+#define FRAME_ENTRY_SIZE 2
+#define FRAME_DELTA_MAX_SIZE                                                   \
+  (FRAME_FIELD_OFFSET + 2 * HEIGHT * FRAME_ENTRY_SIZE)
+
+// FRAME ENCODING
+int frameEncode(const GameInfo_t *stats, GameStatus_t status, uint8_t *frame);
+int frameDelta(const uint8_t *prev, const uint8_t *curr, uint8_t *delta);
+int frameApply(uint8_t *frame, const uint8_t *delta, int size);
+int frameCheck(const uint8_t *data, int size);
+
+// ZERO-COPY READERS
+int frameVersion(const uint8_t *data);
+int frameType(const uint8_t *data);
+int frameCell(const uint8_t *frame, int y, int x);
+int frameNext(const uint8_t *frame, int y, int x);
+int frameScore(const uint8_t *data);
+int frameHighScore(const uint8_t *data);
+int frameLevel(const uint8_t *data);
+int frameSpeed(const uint8_t *data);
+int framePause(const uint8_t *data);
+GameStatus_t frameStatus(const uint8_t *data);
+void frameDecode(const uint8_t *frame, GameInfo_t *stats);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_FRAME_CODEC_H_
@@ -0,0 +1,119 @@
+/** @file
+ * @brief Файл, содержащий измеритель времени кадров
+ */
+#include "frame_meter.h"
+
+#include <string.h>
+#include <sys/time.h>
+
+/**
+ * @brief Начинает измерение с пустого окна
+ * @param meter Указатель на структуру FrameMeter_t
+ * @param now Текущее время в микросекундах
+ */
+void startFrameMeter(FrameMeter_t *meter, long long now) {
+  memset(meter, 0, sizeof(*meter));
+  meter->window_start = now;
+  meter->input = FRAME_METER_NO_INPUT;
+}
+
+/**
+ * @brief Возвращает текущее время в микросекундах
+ * @details Часы те же, что у setTime, но точнее: такт и отрисовка занимают
+ * меньше миллисекунды
+ * @return Текущее время в микросекундах
+ */
+long long frameMeterMicros() {
+  struct timeval timer;
+  gettimeofday(&timer, NULL);
+  return timer.tv_sec * 1000000LL + timer.tv_usec;
+}
+
+/**
+ * @brief Отмечает нажатие клавиши
+ * @details Запоминается только первое нажатие до показа кадра: следующие
+ * нажатия попадут на тот же кадр, а задержка считается для самого
+ * долгого ожидания
+ * @param meter Указатель на структуру FrameMeter_t
+ * @param now Время нажатия в микросекундах
+ */
+void frameMeterInput(FrameMeter_t *meter, long long now) {
+  if (meter->input == FRAME_METER_NO_INPUT) {
+    meter->input = now;
+  }
+}
+
+/**
+ * @brief Учитывает такты симуляции
+ * @param meter Указатель на структуру FrameMeter_t
+ * @param ticks Количество выполненных тактов
+ * @param time Время всех тактов в микросекундах
+ */
+void frameMeterTicks(FrameMeter_t *meter, int ticks, long long time) {
+  meter->ticks += ticks;
+  meter->tick_us += time;
+}
+
+/**
+ * @brief Учитывает показанный кадр
+ * @details Если до кадра была нажата клавиша, задержка от нажатия до
+ * показа учитывается в окне, и нажатие считается показанным
+ * @param meter Указатель на структуру FrameMeter_t
+ * @param render_time Время отрисовки кадра в микросекундах
+ * @param now Время показа кадра в микросекундах
+ */
+void frameMeterPresent(FrameMeter_t *meter, long long render_time,
+                       long long now) {
+  meter->renders++;
+  meter->render_us += render_time;
+  if (meter->input != FRAME_METER_NO_INPUT) {
+    long long latency = now - meter->input;
+    meter->inputs++;
+    meter->latency_us += latency;
+    if (latency > meter->max_latency_us) {
+      meter->max_latency_us = latency;
+    }
+    meter->input = FRAME_METER_NO_INPUT;
+  }
+}
+
+/**
+ * @brief Учитывает кадр, который не показывался
+ * @details Если экран после нажатия не изменился, нажатие не видно
+ * игроку, поэтому оно не учитывается в задержке и не ждёт следующего
+ * показанного кадра
+ * @param meter Указатель на структуру FrameMeter_t
+ */
+void frameMeterSkip(FrameMeter_t *meter) {
+  meter->input = FRAME_METER_NO_INPUT;
+}
+
+/**
+ * @brief Публикует значения окна, если оно закончилось
+ * @details Средние считаются по суммам окна, после чего начинается новое
+ * окно. Непоказанное нажатие переходит в новое окно
+ * @param meter Указатель на структуру FrameMeter_t
+ * @param now Текущее время в микросекундах
+ * @return true, если опубликованы новые значения, иначе false
+ */
+bool frameMeterUpdate(FrameMeter_t *meter, long long now) {
+  long long elapsed = now - meter->window_start;
+  bool is_published = elapsed >= FRAME_METER_PERIOD;
+  if (is_published) {
+    FrameReadout_t *readout = &meter->readout;
+    readout->tick_us =
+        meter->ticks > 0 ? (double)meter->tick_us / meter->ticks : 0.0;
+    readout->render_us =
+        meter->renders > 0 ? (double)meter->render_us / meter->renders : 0.0;
+    readout->fps = meter->renders * 1000000.0 / elapsed;
+    readout->latency_us =
+        meter->inputs > 0 ? (double)meter->latency_us / meter->inputs : 0.0;
+    readout->max_latency_us = meter->max_latency_us;
+    FrameReadout_t published = *readout;
+    long long input = meter->input;
+    startFrameMeter(meter, now);
+    meter->readout = published;
+    meter->input = input;
+  }
+  return is_published;
+}
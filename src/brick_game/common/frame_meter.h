@@ -0,0 +1,77 @@
+/** @file
+ * @brief Заголовочный файл, определяющий измеритель времени кадров для
+ * индикатора производительности фронтендов
+ * @details Фронтенд сообщает измерителю время тактов симуляции и отрисовки,
+ * моменты нажатия клавиш и моменты показа кадров. Задержка от клавиши до
+ * экрана оценивается от первого необработанного нажатия до показа
+ * следующего кадра: время, которое клавиша провела в буфере терминала или
+ * в очереди событий Qt до чтения фронтендом, не учитывается. Значения
+ * копятся за окно в FRAME_METER_PERIOD микросекунд и публикуются средними
+ * по окну, поэтому индикатор не мигает от кадра к кадру. Все времена - в
+ * микросекундах (см. frameMeterMicros). Время передаёт фронтенд, поэтому
+ * измеритель не зависит от ncurses или Qt
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_FRAME_METER_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_FRAME_METER_H_
+
+#include "common_specification.h"
+
+#define FRAME_METER_PERIOD 1000000LL
+#define FRAME_METER_NO_INPUT -1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Опубликованные значения индикатора
+ * @details tick_us - среднее время такта симуляции, render_us - среднее
+ * время отрисовки показанного кадра, fps - количество показанных кадров в
+ * секунду, latency_us и max_latency_us - средняя и наибольшая задержка от
+ * клавиши до экрана (0, если клавиш за окно не было)
+ */
+typedef struct {
+  double tick_us;
+  double render_us;
+  double fps;
+  double latency_us;
+  long long max_latency_us;
+} FrameReadout_t;
+
+/**
+ * @brief Измеритель времени кадров
+ * @details window_start - начало текущего окна, input - время первого
+ * нажатия, ещё не попавшего на экран (FRAME_METER_NO_INPUT, если таких
+ * нет), остальные поля - суммы и количества за текущее окно, readout -
+ * значения, опубликованные по прошлому окну
+ */
+typedef struct {
+  long long window_start;
+  long long input;
+  long long ticks;
+  long long tick_us;
+  long long renders;
+  long long render_us;
+  long long inputs;
+  long long latency_us;
+  long long max_latency_us;
+  FrameReadout_t readout;
+} FrameMeter_t;
+
+// METER INITIALIZATION
+void startFrameMeter(FrameMeter_t *meter, long long now);
+long long frameMeterMicros();
+
+// MEASUREMENTS
+void frameMeterInput(FrameMeter_t *meter, long long now);
+void frameMeterTicks(FrameMeter_t *meter, int ticks, long long time);
+void frameMeterPresent(FrameMeter_t *meter, long long render_time,
+                       long long now);
+void frameMeterSkip(FrameMeter_t *meter);
+bool frameMeterUpdate(FrameMeter_t *meter, long long now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_FRAME_METER_H_
@@ -0,0 +1,75 @@
+/** @file
+ * @brief Файл, содержащий функции очереди событий ввода
+ */
+#include "input_queue.h"
+
+/**
+ * @brief Инициализирует пустую очередь
+ * @param queue Указатель на структуру InputQueue_t
+ */
+void initInputQueue(InputQueue_t *queue) {
+  __atomic_store_n(&queue->head, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&queue->tail, 0, __ATOMIC_RELAXED);
+  queue->dropped = 0;
+}
+
+/**
+ * @brief Добавляет событие в очередь
+ * @details Вызывается только из потока, который пишет в очередь. Событие
+ * записывается в буфер до публикации нового значения tail, поэтому читатель
+ * никогда не увидит недописанное событие. Если очередь заполнена, то событие
+ * отбрасывается и учитывается в счётчике dropped
+ * @param queue Указатель на структуру InputQueue_t
+ * @param action Команда
+ * @param pressed true для нажатия клавиши, false для отпускания
+ * @param time Время события в миллисекундах
+ * @return START, если событие добавлено, и STOP, если очередь заполнена
+ */
+int pushInput(InputQueue_t *queue, UserAction_t action, bool pressed,
+              long long time) {
+  int status = START;
+  unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+  unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+  if (tail - head >= INPUT_QUEUE_SIZE) {
+    queue->dropped++;
+    status = STOP;
+  } else {
+    InputEvent_t *event = &queue->events[tail % INPUT_QUEUE_SIZE];
+    event->time = time;
+    event->action = action;
+    event->pressed = pressed;
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+  }
+  return status;
+}
+
+/**
+ * @brief Забирает самое раннее событие из очереди
+ * @details Вызывается только из потока, который читает очередь. Ячейка
+ * освобождается для писателя только после того, как событие скопировано
+ * @param queue Указатель на структуру InputQueue_t
+ * @param event Указатель на структуру, в которую копируется событие
+ * @return true, если событие получено, и false, если очередь пуста
+ */
+bool popInput(InputQueue_t *queue, InputEvent_t *event) {
+  bool is_popped = false;
+  unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+  unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+  if (head != tail) {
+    *event = queue->events[head % INPUT_QUEUE_SIZE];
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    is_popped = true;
+  }
+  return is_popped;
+}
+
+/**
+ * @brief Возвращает количество событий в очереди
+ * @param queue Указатель на структуру InputQueue_t
+ * @return Количество событий, ожидающих чтения
+ */
+int inputCount(const InputQueue_t *queue) {
+  unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+  unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+  return (int)(tail - head);
+}
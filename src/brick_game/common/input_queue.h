@@ -0,0 +1,53 @@
+/** @file
+ * @brief Заголовочный файл, определяющий очередь событий ввода
+ * @details Очередь хранит нажатия и отпускания клавиш вместе со временем
+ * события. Фронтенд кладёт в очередь все полученные события, а игра на
+ * каждом такте забирает их все и применяет по порядку, поэтому быстрые серии
+ * нажатий не теряются и не ждут следующего кадра. Очередь ограничена и не
+ * использует блокировок: один поток пишет, один поток читает, индексы
+ * читаются и записываются атомарно
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_INPUT_QUEUE_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_INPUT_QUEUE_H_
+
+#include "common_specification.h"
+
+#define INPUT_QUEUE_SIZE 64
+
+/**
+ * @brief Событие ввода
+ * @details time - время события в миллисекундах (см. setTime), pressed -
+ * true для нажатия клавиши и false для отпускания
+ */
+typedef struct {
+  long long time;
+  UserAction_t action;
+  bool pressed;
+} InputEvent_t;
+
+/**
+ * @brief Очередь событий ввода
+ * @details Кольцевой буфер из INPUT_QUEUE_SIZE событий (степень двойки).
+ * head - номер следующего события для чтения, tail - для записи; индексы
+ * только растут, а позиция в буфере - остаток от деления на размер. dropped
+ * считает события, которые не поместились в заполненную очередь
+ */
+typedef struct {
+  InputEvent_t events[INPUT_QUEUE_SIZE];
+  unsigned int head;
+  unsigned int tail;
+  unsigned int dropped;
+} InputQueue_t;
+
+// QUEUE INITIALIZATION
+void initInputQueue(InputQueue_t *queue);
+
+// PRODUCER
+int pushInput(InputQueue_t *queue, UserAction_t action, bool pressed,
+              long long time);
+
+// CONSUMER
+bool popInput(InputQueue_t *queue, InputEvent_t *event);
+int inputCount(const InputQueue_t *queue);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_INPUT_QUEUE_H_
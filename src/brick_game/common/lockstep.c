@@ -0,0 +1,180 @@
+/** @file
+ * @brief Файл, содержащий контрольные суммы и поток контрольных сумм
+ */
+#include "lockstep.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Добавляет число к контрольной сумме
+ * @details Число добавляется по байтам, начиная с младшего, шагом FNV-1a 64.
+ * Сумма новой игры начинается с CHECKSUM_INIT
+ * @param sum Текущая сумма
+ * @param value Число
+ * @return Новая сумма
+ */
+unsigned long long checksumInt(unsigned long long sum, long long value) {
+  unsigned long long bits = (unsigned long long)value;
+  for (int i = 0; i < 8; i++) {
+    sum = (sum ^ (bits & 0xFF)) * 1099511628211ULL;
+    bits >>= 8;
+  }
+  return sum;
+}
+
+/**
+ * @brief Создаёт пустой поток в режиме записи
+ * @param lockstep Указатель на структуру Lockstep_t
+ * @return START в случае успеха, STOP если память не выделена
+ */
+int createLockstep(Lockstep_t *lockstep) {
+  int status = START;
+  lockstep->mode = LOCKSTEP_RECORD;
+  lockstep->count = 0;
+  lockstep->position = 0;
+  lockstep->mismatch = LOCKSTEP_NO_MISMATCH;
+  lockstep->capacity = 1024;
+  lockstep->sums = (unsigned long long *)malloc(
+      lockstep->capacity * sizeof(unsigned long long));
+  if (lockstep->sums == NULL) {
+    lockstep->capacity = 0;
+    status = STOP;
+  }
+  return status;
+}
+
+/**
+ * @brief Освобождает память потока
+ * @param lockstep Указатель на структуру Lockstep_t
+ */
+void removeLockstep(Lockstep_t *lockstep) {
+  free(lockstep->sums);
+  lockstep->sums = NULL;
+  lockstep->count = 0;
+  lockstep->capacity = 0;
+}
+
+/**
+ * @brief Передаёт в поток сумму очередного такта
+ * @details В режиме записи сумма добавляется в конец потока, буфер при
+ * необходимости увеличивается вдвое. В режиме проверки сумма сравнивается с
+ * записанной суммой того же такта; номер первого несовпадения сохраняется в
+ * mismatch, суммы после конца записи считаются несовпадением
+ * @param lockstep Указатель на структуру Lockstep_t
+ * @param sum Контрольная сумма такта
+ * @return START, если сумма записана или совпала, иначе STOP
+ */
+int lockstepPush(Lockstep_t *lockstep, unsigned long long sum) {
+  int status = START;
+  if (lockstep->mode == LOCKSTEP_RECORD) {
+    if (lockstep->count == lockstep->capacity) {
+      unsigned long long *sums = (unsigned long long *)realloc(
+          lockstep->sums, 2 * lockstep->capacity * sizeof(unsigned long long));
+      if (sums == NULL) {
+        status = STOP;
+      } else {
+        lockstep->sums = sums;
+        lockstep->capacity *= 2;
+      }
+    }
+    if (status == START) {
+      lockstep->sums[lockstep->count++] = sum;
+    }
+  } else {
+    if (lockstep->position >= lockstep->count ||
+        lockstep->sums[lockstep->position] != sum) {
+      status = STOP;
+      if (lockstep->mismatch == LOCKSTEP_NO_MISMATCH) {
+        lockstep->mismatch = lockstep->position;
+      }
+    }
+    lockstep->position++;
+  }
+  return status;
+}
+
+/**
+ * @brief Проверяет, совпал ли поток с записью целиком
+ * @param lockstep Указатель на структуру Lockstep_t в режиме проверки
+ * @return true, если проверены все записанные суммы и несовпадений не было
+ */
+bool lockstepIsComplete(const Lockstep_t *lockstep) {
+  return lockstep->mismatch == LOCKSTEP_NO_MISMATCH &&
+         lockstep->position == lockstep->count;
+}
+
+/**
+ * @brief Сохраняет поток в файл
+ * @param lockstep Указатель на структуру Lockstep_t
+ * @param path Путь к файлу
+ * @return START в случае успеха, STOP если файл не записан
+ */
+int lockstepSave(const Lockstep_t *lockstep, const char *path) {
+  int status = STOP;
+  FILE *file = fopen(path, "wb");
+  if (file != NULL) {
+    uint8_t header[LOCKSTEP_HEADER_SIZE] = {'B', 'G', 'L', 'S',
+                                            LOCKSTEP_VERSION};
+    for (int i = 0; i < 4; i++) {
+      header[5 + i] = (uint8_t)((unsigned int)lockstep->count >> (8 * i));
+    }
+    bool is_written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    for (int i = 0; i < lockstep->count && is_written; i++) {
+      uint8_t data[8];
+      for (int j = 0; j < 8; j++) {
+        data[j] = (uint8_t)(lockstep->sums[i] >> (8 * j));
+      }
+      is_written = fwrite(data, 1, sizeof(data), file) == sizeof(data);
+    }
+    status = fclose(file) == 0 && is_written ? START : STOP;
+  }
+  return status;
+}
+
+/**
+ * @brief Загружает поток из файла в режиме проверки
+ * @details Файл с неверным заголовком или неполный файл не загружается
+ * @param lockstep Указатель на структуру Lockstep_t
+ * @param path Путь к файлу
+ * @return START в случае успеха, STOP если файл не прочитан
+ */
+int lockstepLoad(Lockstep_t *lockstep, const char *path) {
+  int status = STOP;
+  FILE *file = fopen(path, "rb");
+  lockstep->sums = NULL;
+  lockstep->count = 0;
+  lockstep->capacity = 0;
+  if (file != NULL) {
+    uint8_t header[LOCKSTEP_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) == sizeof(header) &&
+        header[0] == 'B' && header[1] == 'G' && header[2] == 'L' &&
+        header[3] == 'S' && header[4] == LOCKSTEP_VERSION) {
+      unsigned int count = 0;
+      for (int i = 0; i < 4; i++) {
+        count |= (unsigned int)header[5 + i] << (8 * i);
+      }
+      status = createLockstep(lockstep);
+      for (unsigned int i = 0; i < count && status == START; i++) {
+        uint8_t data[8];
+        unsigned long long sum = 0;
+        if (fread(data, 1, sizeof(data), file) != sizeof(data)) {
+          status = STOP;
+        } else {
+          for (int j = 0; j < 8; j++) {
+            sum |= (unsigned long long)data[j] << (8 * j);
+          }
+          status = lockstepPush(lockstep, sum);
+        }
+      }
+      if (status != START) {
+        removeLockstep(lockstep);
+      }
+    }
+    fclose(file);
+  }
+  lockstep->mode = LOCKSTEP_VERIFY;
+  lockstep->position = 0;
+  lockstep->mismatch = LOCKSTEP_NO_MISMATCH;
+  return status;
+}
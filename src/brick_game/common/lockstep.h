@@ -0,0 +1,65 @@
+/** @file
+ * @brief Заголовочный файл, определяющий контрольные суммы состояния игры и
+ * поток контрольных сумм для проверки детерминизма
+ * @details Движок считает контрольную сумму полного состояния игры после
+ * каждого такта. Суммы одной игры образуют поток: в режиме записи поток
+ * накапливается и сохраняется в файл, в режиме проверки каждая новая сумма
+ * сравнивается с записанной. Совпадение потоков доказывает, что две сборки
+ * движка (разные оптимизации, компиляторы, архитектуры) провели игру
+ * бит-в-бит одинаково; первое расхождение указывает такт, на котором сборки
+ * разошлись.
+ *
+ * Контрольная сумма - FNV-1a 64 по значениям полей, а не по байтам структур,
+ * поэтому не зависит от выравнивания и порядка байтов. Время (поля,
+ * заполненные setTime) и рекорд из файла в сумму не входят: они различаются
+ * между запусками и не влияют на ход игры при шагах без учёта времени.
+ *
+ * Файл потока: "BGLS", версия (1 байт), количество сумм (4 байта) и суммы
+ * (по 8 байт); числа записываются от младшего байта к старшему
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_LOCKSTEP_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_LOCKSTEP_H_
+
+#include <stdint.h>
+
+#include "common_specification.h"
+
+#define CHECKSUM_INIT 14695981039346656037ULL
+#define LOCKSTEP_VERSION 1
+#define LOCKSTEP_HEADER_SIZE 9
+#define LOCKSTEP_RECORD 0
+#define LOCKSTEP_VERIFY 1
+#define LOCKSTEP_NO_MISMATCH -1
+
+/**
+ * @brief Поток контрольных сумм
+ * @details mode - LOCKSTEP_RECORD или LOCKSTEP_VERIFY, sums - суммы
+ * (capacity - размер буфера), count - количество записанных сумм, position -
+ * номер следующей проверяемой суммы, mismatch - номер первой несовпавшей
+ * суммы или LOCKSTEP_NO_MISMATCH
+ */
+typedef struct {
+  int mode;
+  unsigned long long *sums;
+  int count;
+  int capacity;
+  int position;
+  int mismatch;
+} Lockstep_t;
+
+// CHECKSUM
+unsigned long long checksumInt(unsigned long long sum, long long value);
+
+// STREAM INITIALIZATION & REMOVAL
+int createLockstep(Lockstep_t *lockstep);
+void removeLockstep(Lockstep_t *lockstep);
+
+// STREAM LOGIC
+int lockstepPush(Lockstep_t *lockstep, unsigned long long sum);
+bool lockstepIsComplete(const Lockstep_t *lockstep);
+
+// STREAM FILES
+int lockstepSave(const Lockstep_t *lockstep, const char *path);
+int lockstepLoad(Lockstep_t *lockstep, const char *path);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_LOCKSTEP_H_
@@ -0,0 +1,220 @@
+/** @file
+ * @brief Файл, содержащий разметку фаз движка и встроенный сэмплер
+ */
+#define _XOPEN_SOURCE 700
+
+#include "profiler.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if defined(BRICKGAME_PROFILE) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PROFILE_USDT
+#endif
+#endif
+
+/**
+ * @brief Стек фаз потока
+ * @details depth может быть больше PROFILE_DEPTH, тогда фазы глубже не
+ * запоминаются, а стек в сэмпле обрезается
+ */
+typedef struct {
+  int depth;
+  unsigned char phases[PROFILE_DEPTH];
+} ProfileThread_t;
+
+static _Thread_local ProfileThread_t profile_thread
+    __attribute__((tls_model("initial-exec")));
+static ProfileStack_t profile_stacks[PROFILE_STACKS];
+static uint64_t profile_dropped = 0;
+static const char *profile_path = NULL;
+
+/**
+ * @brief Обработчик сигнала SIGPROF
+ * @param signal Номер сигнала
+ */
+static void profileSignal(int signal) {
+  (void)signal;
+  profileSample();
+}
+
+/**
+ * @brief Запускает сэмплер
+ * @details Таблица стеков очищается, обработчик SIGPROF снимает сэмпл раз в
+ * 1 / PROFILE_HZ секунды процессорного времени процесса, поэтому ожидание
+ * ввода и таймеров в профиль не попадает. При выходе из программы профиль
+ * пишется в path (см. stopProfiler). Повторный запуск не выполняется
+ * @param path Путь к файлу профиля или NULL, тогда сэмплер не запускается
+ * @return START, если сэмплер запущен, иначе STOP
+ */
+int startProfiler(const char *path) {
+  static bool is_registered = false;
+  int status = STOP;
+  if (path != NULL && profile_path == NULL) {
+    memset(profile_stacks, 0, sizeof(profile_stacks));
+    __atomic_store_n(&profile_dropped, 0, __ATOMIC_RELAXED);
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = profileSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    struct itimerval timer = {{0, 1000000 / PROFILE_HZ},
+                              {0, 1000000 / PROFILE_HZ}};
+    if (sigaction(SIGPROF, &action, NULL) == 0 &&
+        setitimer(ITIMER_PROF, &timer, NULL) == 0) {
+      profile_path = path;
+      status = START;
+      if (!is_registered) {
+        is_registered = atexit(stopProfiler) == 0;
+      }
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Останавливает сэмплер и пишет профиль
+ * @details Вызывается при выходе из программы, если сэмплер был запущен.
+ * Если профиль не записан или таблица стеков переполнилась, сообщение
+ * выводится в stderr
+ */
+void stopProfiler() {
+  if (profile_path != NULL) {
+    struct itimerval timer = {{0, 0}, {0, 0}};
+    setitimer(ITIMER_PROF, &timer, NULL);
+    signal(SIGPROF, SIG_IGN);
+    if (writeProfile(profile_path) != START) {
+      fprintf(stderr, "couldn't write profile %s\n", profile_path);
+    }
+    if (profile_dropped > 0) {
+      fprintf(stderr, "profile: %llu samples dropped\n",
+              (unsigned long long)profile_dropped);
+    }
+    profile_path = NULL;
+  }
+}
+
+/**
+ * @brief Снимает сэмпл стека фаз текущего потока
+ * @details Стек превращается в ключ: глубина в младших 4 битах, фазы по 4
+ * бита выше неё. Строка таблицы ищется открытой адресацией, свободная строка
+ * занимается атомарным сравнением с обменом, поэтому функцию можно вызывать
+ * из обработчика сигнала в любом потоке. Если таблица заполнена, сэмпл
+ * отбрасывается
+ */
+void profileSample() {
+  const ProfileThread_t *thread = &profile_thread;
+  int depth = thread->depth < PROFILE_DEPTH ? thread->depth : PROFILE_DEPTH;
+  uint64_t key = 1ULL << 63 | (uint64_t)depth;
+  for (int i = 0; i < depth; i++) {
+    key |= (uint64_t)(thread->phases[i] & 0xF) << (4 + 4 * i);
+  }
+  uint64_t slot = (key * 0x9E3779B97F4A7C15ULL) >> 32;
+  bool is_counted = false;
+  for (int probe = 0; probe < PROFILE_STACKS && !is_counted; probe++) {
+    ProfileStack_t *stack = &profile_stacks[(slot + probe) % PROFILE_STACKS];
+    uint64_t seen = 0;
+    if (__atomic_compare_exchange_n(&stack->key, &seen, key, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED) ||
+        seen == key) {
+      __atomic_fetch_add(&stack->samples, 1, __ATOMIC_RELAXED);
+      is_counted = true;
+    }
+  }
+  if (!is_counted) {
+    __atomic_fetch_add(&profile_dropped, 1, __ATOMIC_RELAXED);
+  }
+}
+
+/**
+ * @brief Пишет свёрнутые стеки
+ * @details Каждый стек - строка: PROFILE_ROOT, имена фаз от внешней к
+ * внутренней через ';' и количество сэмплов через пробел. Сэмплы вне
+ * размеченных фаз относятся к самому PROFILE_ROOT
+ * @param path Путь к файлу профиля
+ * @return START в случае успеха, STOP если файл не записан
+ */
+int writeProfile(const char *path) {
+  FILE *file = fopen(path, "w");
+  int status = file != NULL ? START : STOP;
+  for (int i = 0; i < PROFILE_STACKS && status == START; i++) {
+    uint64_t key = __atomic_load_n(&profile_stacks[i].key, __ATOMIC_RELAXED);
+    uint64_t samples =
+        __atomic_load_n(&profile_stacks[i].samples, __ATOMIC_RELAXED);
+    if (key != 0 && samples > 0) {
+      int depth = (int)(key & 0xF);
+      fputs(PROFILE_ROOT, file);
+      for (int d = 0; d < depth; d++) {
+        int phase = (int)(key >> (4 + 4 * d) & 0xF);
+        fprintf(file, ";%s", profilePhaseName(phase));
+      }
+      if (fprintf(file, " %llu\n", (unsigned long long)samples) < 0) {
+        status = STOP;
+      }
+    }
+  }
+  if (file != NULL && fclose(file) != 0) {
+    status = STOP;
+  }
+  return status;
+}
+
+/**
+ * @brief Отмечает вход в фазу
+ * @details Фаза записывается в стек до увеличения глубины, поэтому
+ * обработчик сигнала, прервавший функцию, видит целый стек. Функция не
+ * встраивается, чтобы на неё можно было поставить uprobe perf
+ * @param phase Номер фазы (ProfilePhase_t)
+ */
+__attribute__((noinline)) void profileEnter(int phase) {
+  ProfileThread_t *thread = &profile_thread;
+  if (thread->depth < PROFILE_DEPTH) {
+    thread->phases[thread->depth] = (unsigned char)phase;
+  }
+  __atomic_signal_fence(__ATOMIC_SEQ_CST);
+  thread->depth++;
+#ifdef PROFILE_USDT
+  DTRACE_PROBE1(brickgame, phase_enter, phase);
+#endif
+}
+
+/**
+ * @brief Отмечает выход из последней фазы, в которую вошёл поток
+ * @details Проба phase_leave, как и phase_enter, получает номер фазы: он
+ * читается из стека до уменьшения глубины. Для фазы глубже PROFILE_DEPTH,
+ * которой нет в стеке, передаётся -1. Функция не встраивается, чтобы на неё
+ * можно было поставить uprobe perf
+ */
+__attribute__((noinline)) void profileLeave() {
+  ProfileThread_t *thread = &profile_thread;
+#ifdef PROFILE_USDT
+  int phase = thread->depth > 0 && thread->depth <= PROFILE_DEPTH
+                  ? thread->phases[thread->depth - 1]
+                  : -1;
+#endif
+  if (thread->depth > 0) {
+    thread->depth--;
+  }
+#ifdef PROFILE_USDT
+  DTRACE_PROBE1(brickgame, phase_leave, phase);
+#endif
+}
+
+/**
+ * @brief Возвращает имя фазы в свёрнутом стеке
+ * @param phase Номер фазы
+ * @return Имя размеченной функции или "unknown"
+ */
+const char *profilePhaseName(int phase) {
+  static const char *const names[PROFILE_PHASES] = {
+      "drainInput",     "tetrisMechanics", "gravity",    "lock",
+      "removeLine",     "spawnFigure",     "snakeMechanics",
+      "snakeMove",      "spawnApple",      "render",     "drawObjects",
+      "paintEvent"};
+  return phase >= 0 && phase < PROFILE_PHASES ? names[phase] : "unknown";
+}
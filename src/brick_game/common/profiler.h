@@ -0,0 +1,94 @@
+/** @file
+ * @brief Заголовочный файл, определяющий фазы движка для профилирования
+ * @details Сборка с BRICKGAME_PROFILE (make profile) размечает фазы движков
+ * и фронтендов макросами PROFILE_ENTER и PROFILE_LEAVE, в обычной сборке
+ * макросы ничего не делают. Размеченная фаза:
+ * - кладётся в стек фаз потока, который при запуске с переменной окружения
+ * PROFILE_ENV=FILE раз в 1 / PROFILE_HZ секунды процессорного времени
+ * снимает встроенный сэмплер по сигналу SIGPROF. При выходе из программы
+ * в FILE пишется свёрнутый стек (folded stacks) для flamegraph.pl:
+ * строки вида "brickgame;tetrisMechanics;gravity;lock;removeLine 42";
+ * - отмечается для perf: если доступен заголовок sys/sdt.h, то пробами USDT
+ * brickgame:phase_enter и brickgame:phase_leave с номером фазы (-1 для
+ * фазы глубже PROFILE_DEPTH), иначе вызовами функций profileEnter и
+ * profileLeave, которые не встраиваются, поэтому на них ставятся uprobe
+ * ("perf probe -x build/libbrickgame.so.1 profileEnter phase=%di:s32").
+ *
+ * Стек фаз хранится отдельно для каждого потока, сэмплер считает стеки в
+ * таблице фиксированного размера без блокировок и выделения памяти, поэтому
+ * работает внутри обработчика сигнала
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_PROFILER_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_PROFILER_H_
+
+#include <stdint.h>
+
+#include "common_specification.h"
+
+#define PROFILE_ENV "BRICKGAME_PROFILE"
+#define PROFILE_HZ 997
+#define PROFILE_DEPTH 12
+#define PROFILE_STACKS 1024
+#define PROFILE_ROOT "brickgame"
+
+#ifdef BRICKGAME_PROFILE
+#define PROFILE_ENTER(phase) profileEnter(phase)
+#define PROFILE_LEAVE() profileLeave()
+#else
+#define PROFILE_ENTER(phase) ((void)0)
+#define PROFILE_LEAVE() ((void)0)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Фазы движков и фронтендов
+ * @details Номер фазы занимает 4 бита ключа стека, поэтому фаз не больше 15.
+ * Имена фаз в свёрнутом стеке - имена размеченных функций (см.
+ * profilePhaseName)
+ */
+typedef enum {
+  PROFILE_INPUT_DRAIN,
+  PROFILE_TETRIS_MECHANICS,
+  PROFILE_GRAVITY,
+  PROFILE_LOCK,
+  PROFILE_LINE_CLEAR,
+  PROFILE_SPAWN,
+  PROFILE_SNAKE_MECHANICS,
+  PROFILE_SNAKE_MOVE,
+  PROFILE_APPLE_SPAWN,
+  PROFILE_RENDER,
+  PROFILE_DRAW_OBJECTS,
+  PROFILE_PAINT_EVENT,
+  PROFILE_PHASES
+} ProfilePhase_t;
+
+/**
+ * @brief Строка таблицы стеков сэмплера
+ * @details key - фазы стека по 4 бита и глубина в младших 4 битах со
+ * старшим битом-меткой занятой строки (0 - строка свободна), samples -
+ * количество сэмплов этого стека
+ */
+typedef struct {
+  uint64_t key;
+  uint64_t samples;
+} ProfileStack_t;
+
+// SAMPLER
+int startProfiler(const char *path);
+void stopProfiler();
+void profileSample();
+int writeProfile(const char *path);
+
+// PHASE MARKERS
+void profileEnter(int phase);
+void profileLeave();
+const char *profilePhaseName(int phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_PROFILER_H_
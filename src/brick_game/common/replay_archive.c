@@ -0,0 +1,459 @@
+/** @file
+ * @brief Файл, содержащий записи игр и архив записей
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "replay_archive.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Записывает число в порядке little-endian
+ * @param data Буфер
+ * @param value Число
+ * @param bytes Количество байт
+ */
+static void putNumber(uint8_t *data, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    data[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+/**
+ * @brief Читает число в порядке little-endian
+ * @param data Буфер
+ * @param bytes Количество байт
+ * @return Число
+ */
+static uint64_t getNumber(const uint8_t *data, int bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= (uint64_t)data[i] << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Создаёт пустую запись игры
+ * @param replay Указатель на структуру Replay_t
+ * @param game Номер игры
+ * @param seed Состояние генератора игры
+ * @return START в случае успеха, STOP если память не выделена
+ */
+int createReplay(Replay_t *replay, int game, unsigned int seed) {
+  int status = START;
+  replay->game = game;
+  replay->seed = seed;
+  replay->score = 0;
+  replay->steps = 0;
+  replay->capacity = 1024;
+  replay->commands = (uint8_t *)malloc(replay->capacity);
+  if (replay->commands == NULL) {
+    replay->capacity = 0;
+    status = STOP;
+  }
+  return status;
+}
+
+/**
+ * @brief Освобождает память записи
+ * @param replay Указатель на структуру Replay_t
+ */
+void removeReplay(Replay_t *replay) {
+  free(replay->commands);
+  replay->commands = NULL;
+  replay->steps = 0;
+  replay->capacity = 0;
+}
+
+/**
+ * @brief Увеличивает буфер команд записи
+ * @param replay Указатель на структуру Replay_t
+ * @param steps Необходимое количество команд
+ * @return START в случае успеха, STOP если память не выделена
+ */
+static int reserveReplay(Replay_t *replay, int steps) {
+  int status = START;
+  if (steps > replay->capacity) {
+    int capacity = replay->capacity > 0 ? replay->capacity : 1024;
+    while (capacity < steps) {
+      capacity *= 2;
+    }
+    uint8_t *commands = (uint8_t *)realloc(replay->commands, capacity);
+    if (commands == NULL) {
+      status = STOP;
+    } else {
+      replay->commands = commands;
+      replay->capacity = capacity;
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Добавляет в запись команду очередного шага
+ * @details Буфер при необходимости увеличивается вдвое
+ * @param replay Указатель на структуру Replay_t
+ * @param command Номер UserAction_t (с флагом REPLAY_HOLD) или REPLAY_IDLE
+ * @return START в случае успеха, STOP если память не выделена
+ */
+int replayPush(Replay_t *replay, uint8_t command) {
+  int status = reserveReplay(replay, replay->steps + 1);
+  if (status == START) {
+    replay->commands[replay->steps++] = command;
+  }
+  return status;
+}
+
+/**
+ * @brief Сжимает команды записи кодированием серий
+ * @param commands Команды шагов
+ * @param steps Количество шагов
+ * @param data Буфер размером не меньше REPLAY_BOUND(steps) байт
+ * @return Размер сжатых данных в байтах
+ */
+size_t replayCompress(const uint8_t *commands, int steps, uint8_t *data) {
+  size_t size = 0;
+  int i = 0;
+  while (i < steps) {
+    int run = 1;
+    while (i + run < steps && commands[i + run] == commands[i]) {
+      run++;
+    }
+    data[size++] = commands[i];
+    unsigned int length = (unsigned int)run - 1;
+    do {
+      uint8_t byte = length & 0x7F;
+      length >>= 7;
+      data[size++] = length != 0 ? (byte | 0x80) : byte;
+    } while (length != 0);
+    i += run;
+  }
+  return size;
+}
+
+/**
+ * @brief Распаковывает команды записи
+ * @details Данные, которые обрываются посреди серии, содержат слишком
+ * длинную серию или дают не ровно steps команд, считаются повреждёнными
+ * @param data Сжатые данные
+ * @param size Размер сжатых данных в байтах
+ * @param commands Буфер размером steps байт
+ * @param steps Количество шагов записи
+ * @return START в случае успеха, STOP если данные повреждены
+ */
+int replayDecompress(const uint8_t *data, size_t size, uint8_t *commands,
+                     int steps) {
+  int status = START;
+  size_t position = 0;
+  int step = 0;
+  while (position < size && status == START) {
+    uint8_t command = data[position++];
+    uint64_t length = 0;
+    int shift = 0;
+    bool is_next = true;
+    while (is_next && status == START) {
+      if (position == size || shift > 28) {
+        status = STOP;
+      } else {
+        length |= (uint64_t)(data[position] & 0x7F) << shift;
+        is_next = data[position++] & 0x80;
+        shift += 7;
+      }
+    }
+    if (status == START && length >= (uint64_t)(steps - step)) {
+      status = STOP;
+    } else if (status == START) {
+      memset(commands + step, command, length + 1);
+      step += (int)length + 1;
+    }
+  }
+  return status == START && step == steps ? START : STOP;
+}
+
+/**
+ * @brief Создаёт архив и открывает его для записи
+ * @details Место заголовка заполняется нулями, заголовок записывается при
+ * закрытии архива
+ * @param writer Указатель на структуру ArchiveWriter_t
+ * @param path Путь к файлу архива
+ * @return START в случае успеха, STOP если файл не создан или память не
+ * выделена
+ */
+int createArchiveWriter(ArchiveWriter_t *writer, const char *path) {
+  uint8_t header[ARCHIVE_HEADER_SIZE] = {0};
+  writer->offset = ARCHIVE_HEADER_SIZE;
+  writer->count = 0;
+  writer->capacity = 1024;
+  writer->buffer = NULL;
+  writer->buffer_size = 0;
+  writer->index =
+      (ArchiveEntry_t *)malloc(writer->capacity * sizeof(ArchiveEntry_t));
+  writer->file = fopen(path, "wb");
+  int status = writer->index != NULL && writer->file != NULL &&
+                       fwrite(header, 1, sizeof(header), writer->file) ==
+                           sizeof(header)
+                   ? START
+                   : STOP;
+  if (status != START) {
+    if (writer->file != NULL) {
+      fclose(writer->file);
+    }
+    free(writer->index);
+    writer->file = NULL;
+    writer->index = NULL;
+    writer->capacity = 0;
+  }
+  return status;
+}
+
+/**
+ * @brief Сжимает запись и дописывает её в архив
+ * @param writer Указатель на структуру ArchiveWriter_t
+ * @param id Номер записи, уникальный в пределах архива
+ * @param replay Указатель на запись
+ * @return START в случае успеха, STOP если запись не записана
+ */
+int archiveWrite(ArchiveWriter_t *writer, uint64_t id, const Replay_t *replay) {
+  int status = START;
+  size_t bound = REPLAY_BOUND(replay->steps);
+  if (bound > writer->buffer_size) {
+    uint8_t *buffer = (uint8_t *)realloc(writer->buffer, bound);
+    if (buffer == NULL) {
+      status = STOP;
+    } else {
+      writer->buffer = buffer;
+      writer->buffer_size = bound;
+    }
+  }
+  if (status == START && writer->count == writer->capacity) {
+    ArchiveEntry_t *index = (ArchiveEntry_t *)realloc(
+        writer->index, 2 * writer->capacity * sizeof(ArchiveEntry_t));
+    if (index == NULL) {
+      status = STOP;
+    } else {
+      writer->index = index;
+      writer->capacity *= 2;
+    }
+  }
+  if (status == START) {
+    size_t size =
+        replayCompress(replay->commands, replay->steps, writer->buffer);
+    if (fwrite(writer->buffer, 1, size, writer->file) != size) {
+      status = STOP;
+    } else {
+      writer->index[writer->count++] = (ArchiveEntry_t){
+          id,          writer->offset, (uint32_t)size, replay->steps,
+          replay->seed, replay->score,  replay->game};
+      writer->offset += size;
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Сравнивает записи индекса по номеру
+ * @param a Указатель на первую запись
+ * @param b Указатель на вторую запись
+ * @return Отрицательное число, ноль или положительное число
+ */
+static int compareEntries(const void *a, const void *b) {
+  uint64_t first = ((const ArchiveEntry_t *)a)->id;
+  uint64_t second = ((const ArchiveEntry_t *)b)->id;
+  return (first > second) - (first < second);
+}
+
+/**
+ * @brief Записывает индекс и заголовок и закрывает архив
+ * @details Индекс сортируется по номеру записи. Если номера повторяются,
+ * заголовок не записывается и архив остаётся недействительным
+ * @param writer Указатель на структуру ArchiveWriter_t
+ * @return START в случае успеха, STOP если архив не записан
+ */
+int closeArchiveWriter(ArchiveWriter_t *writer) {
+  int status = writer->file != NULL ? START : STOP;
+  if (status == START) {
+    qsort(writer->index, writer->count, sizeof(ArchiveEntry_t),
+          compareEntries);
+  }
+  for (int i = 0; i < writer->count && status == START; i++) {
+    const ArchiveEntry_t *entry = &writer->index[i];
+    uint8_t data[ARCHIVE_ENTRY_SIZE] = {0};
+    putNumber(data, entry->id, 8);
+    putNumber(data + 8, entry->offset, 8);
+    putNumber(data + 16, entry->size, 4);
+    putNumber(data + 20, (uint32_t)entry->steps, 4);
+    putNumber(data + 24, entry->seed, 4);
+    putNumber(data + 28, (uint32_t)entry->score, 4);
+    putNumber(data + 32, (uint32_t)entry->game, 4);
+    if ((i > 0 && entry->id == writer->index[i - 1].id) ||
+        fwrite(data, 1, sizeof(data), writer->file) != sizeof(data)) {
+      status = STOP;
+    }
+  }
+  if (status == START) {
+    uint8_t header[ARCHIVE_HEADER_SIZE] = {'B', 'G', 'R', 'A',
+                                           ARCHIVE_VERSION};
+    putNumber(header + 8, (uint64_t)writer->count, 8);
+    putNumber(header + 16, writer->offset, 8);
+    status = fseek(writer->file, 0, SEEK_SET) == 0 &&
+                     fwrite(header, 1, sizeof(header), writer->file) ==
+                         sizeof(header)
+                 ? START
+                 : STOP;
+  }
+  if (writer->file != NULL && fclose(writer->file) != 0) {
+    status = STOP;
+  }
+  free(writer->index);
+  free(writer->buffer);
+  *writer = (ArchiveWriter_t){NULL, 0, NULL, 0, 0, NULL, 0};
+  return status;
+}
+
+/**
+ * @brief Открывает архив для чтения
+ * @details Файл отображается в память только для чтения и не читается
+ * целиком: ядро подгружает страницы при обращении. access подсказывает ядру
+ * порядок обращений: ARCHIVE_SCAN - последовательный проход по всем
+ * записям, ARCHIVE_RANDOM - выборка отдельных записей. Индекс подгружается
+ * заранее в обоих случаях. Архив с неверным заголовком или индексом не
+ * открывается
+ * @param archive Указатель на структуру Archive_t
+ * @param path Путь к файлу архива
+ * @param access ARCHIVE_SCAN или ARCHIVE_RANDOM
+ * @return START в случае успеха, STOP если архив не открыт
+ */
+int openArchive(Archive_t *archive, const char *path, int access) {
+  int status = STOP;
+  *archive = (Archive_t){NULL, 0, NULL, 0, 0};
+  int fd = open(path, O_RDONLY);
+  struct stat info;
+  if (fd >= 0 && fstat(fd, &info) == 0 &&
+      info.st_size >= ARCHIVE_HEADER_SIZE) {
+    void *map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      archive->map = (const uint8_t *)map;
+      archive->size = (size_t)info.st_size;
+      status = START;
+    }
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+  if (status == START) {
+    const uint8_t *header = archive->map;
+    uint64_t count = getNumber(header + 8, 8);
+    uint64_t index = getNumber(header + 16, 8);
+    if (memcmp(header, "BGRA", 4) != 0 || header[4] != ARCHIVE_VERSION ||
+        count > INT32_MAX || index < ARCHIVE_HEADER_SIZE ||
+        index > archive->size ||
+        (archive->size - index) != count * ARCHIVE_ENTRY_SIZE) {
+      closeArchive(archive);
+      status = STOP;
+    } else {
+      archive->index = archive->map + index;
+      archive->count = (int)count;
+      archive->data_end = index;
+      posix_madvise((void *)archive->map, archive->size,
+                    access == ARCHIVE_SCAN ? POSIX_MADV_SEQUENTIAL
+                                           : POSIX_MADV_RANDOM);
+      posix_madvise((void *)(archive->map + (index & ~(uint64_t)4095)),
+                    archive->size - (index & ~(uint64_t)4095),
+                    POSIX_MADV_WILLNEED);
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Закрывает архив
+ * @param archive Указатель на структуру Archive_t
+ */
+void closeArchive(Archive_t *archive) {
+  if (archive->map != NULL) {
+    munmap((void *)archive->map, archive->size);
+  }
+  *archive = (Archive_t){NULL, 0, NULL, 0, 0};
+}
+
+/**
+ * @brief Читает запись индекса по порядковому номеру
+ * @details Записи индекса упорядочены по номеру записи, поэтому проход по i
+ * от 0 до count - 1 перебирает записи архива по возрастанию номеров
+ * @param archive Указатель на открытый архив
+ * @param i Порядковый номер от 0 до count - 1
+ * @param entry Указатель на запись индекса
+ */
+void archiveEntry(const Archive_t *archive, int i, ArchiveEntry_t *entry) {
+  const uint8_t *data = archive->index + (size_t)i * ARCHIVE_ENTRY_SIZE;
+  entry->id = getNumber(data, 8);
+  entry->offset = getNumber(data + 8, 8);
+  entry->size = (uint32_t)getNumber(data + 16, 4);
+  entry->steps = (int)getNumber(data + 20, 4);
+  entry->seed = (unsigned int)getNumber(data + 24, 4);
+  entry->score = (int)getNumber(data + 28, 4);
+  entry->game = (int)getNumber(data + 32, 4);
+}
+
+/**
+ * @brief Ищет запись по номеру
+ * @details Двоичный поиск по индексу читает O(log count) записей индекса
+ * @param archive Указатель на открытый архив
+ * @param id Номер записи
+ * @param entry Указатель на запись индекса, заполняется при успехе
+ * @return START, если запись найдена, иначе STOP
+ */
+int archiveFind(const Archive_t *archive, uint64_t id, ArchiveEntry_t *entry) {
+  int status = STOP;
+  int low = 0;
+  int high = archive->count;
+  while (low < high && status == STOP) {
+    int middle = low + (high - low) / 2;
+    uint64_t key =
+        getNumber(archive->index + (size_t)middle * ARCHIVE_ENTRY_SIZE, 8);
+    if (key < id) {
+      low = middle + 1;
+    } else if (key > id) {
+      high = middle;
+    } else {
+      archiveEntry(archive, middle, entry);
+      status = START;
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Распаковывает запись архива
+ * @details Запись распаковывается прямо из отображения в буфер команд
+ * replay, который при необходимости увеличивается, поэтому проход по архиву
+ * может переиспользовать одну запись
+ * @param archive Указатель на открытый архив
+ * @param entry Указатель на запись индекса
+ * @param replay Указатель на запись, созданную функцией createReplay
+ * @return START в случае успеха, STOP если запись повреждена или память не
+ * выделена
+ */
+int archiveLoad(const Archive_t *archive, const ArchiveEntry_t *entry,
+                Replay_t *replay) {
+  int status = entry->offset >= ARCHIVE_HEADER_SIZE && entry->steps >= 0 &&
+                       entry->offset <= archive->data_end &&
+                       entry->size <= archive->data_end - entry->offset
+                   ? reserveReplay(replay, entry->steps)
+                   : STOP;
+  if (status == START) {
+    status = replayDecompress(archive->map + entry->offset, entry->size,
+                              replay->commands, entry->steps);
+  }
+  replay->game = entry->game;
+  replay->seed = entry->seed;
+  replay->score = entry->score;
+  replay->steps = status == START ? entry->steps : 0;
+  return status;
+}
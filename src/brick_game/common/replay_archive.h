@@ -0,0 +1,128 @@
+/** @file
+ * @brief Заголовочный файл, определяющий записи игр и архив записей с
+ * отображаемым в память индексом
+ * @details Игры движка детерминированы: игра, созданная по номеру и seed,
+ * проходит одинаково при одинаковых командах на каждом шаге (см.
+ * lockstep.h). Поэтому запись игры - это номер игры, seed и по одному байту
+ * команды на шаг: номер UserAction_t, флаг зажатия клавиши REPLAY_HOLD или
+ * REPLAY_IDLE для шага без команды. Команды сжимаются кодированием серий:
+ * байт команды и длина серии минус один в виде varint (по 7 бит, начиная с
+ * младших; старший бит байта означает продолжение).
+ *
+ * Архив хранит миллионы сжатых записей в одном файле:
+ * - заголовок (ARCHIVE_HEADER_SIZE байт): "BGRA", версия (1 байт), 3
+ * резервных байта, количество записей (8 байт), смещение индекса (8 байт);
+ * - сжатые записи подряд;
+ * - индекс в конце файла: записи по ARCHIVE_ENTRY_SIZE байт, отсортированные
+ * по номеру записи: номер (8 байт), смещение (8 байт), размер сжатой записи,
+ * количество шагов, seed, итоговый счёт, номер игры и резервное поле (по 4
+ * байта).
+ *
+ * Заголовок записывается последним, поэтому недописанный архив не
+ * открывается. Читатель отображает файл в память и не читает его целиком:
+ * запись находится двоичным поиском по индексу и распаковывается прямо из
+ * отображения. Все многобайтовые числа хранятся в порядке little-endian
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_REPLAY_ARCHIVE_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_REPLAY_ARCHIVE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "common_specification.h"
+
+#define REPLAY_IDLE 0x7F
+#define REPLAY_HOLD 0x80
+#define REPLAY_BOUND(steps) (2 * (size_t)(steps))
+
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER_SIZE 24
+#define ARCHIVE_ENTRY_SIZE 40
+#define ARCHIVE_SCAN 0
+#define ARCHIVE_RANDOM 1
+
+/**
+ * @brief Запись игры
+ * @details game - номер игры, seed - состояние генератора игры, score -
+ * итоговый счёт, commands - команды шагов (steps команд, capacity - размер
+ * буфера)
+ */
+typedef struct {
+  int game;
+  unsigned int seed;
+  int score;
+  int steps;
+  int capacity;
+  uint8_t *commands;
+} Replay_t;
+
+/**
+ * @brief Запись индекса архива
+ * @details id - номер записи, offset и size - смещение и размер сжатой
+ * записи в файле, остальные поля повторяют поля Replay_t
+ */
+typedef struct {
+  uint64_t id;
+  uint64_t offset;
+  uint32_t size;
+  int steps;
+  unsigned int seed;
+  int score;
+  int game;
+} ArchiveEntry_t;
+
+/**
+ * @brief Запись архива
+ * @details Сжатые записи пишутся в файл сразу, индекс накапливается в памяти
+ * (count записей, capacity - размер буфера) и пишется при закрытии. buffer -
+ * буфер сжатия размером buffer_size байт
+ */
+typedef struct {
+  FILE *file;
+  uint64_t offset;
+  ArchiveEntry_t *index;
+  int count;
+  int capacity;
+  uint8_t *buffer;
+  size_t buffer_size;
+} ArchiveWriter_t;
+
+/**
+ * @brief Архив, открытый для чтения
+ * @details map - отображение файла размером size байт, index - начало
+ * индекса в отображении, count - количество записей, data_end - смещение
+ * конца сжатых записей
+ */
+typedef struct {
+  const uint8_t *map;
+  size_t size;
+  const uint8_t *index;
+  int count;
+  uint64_t data_end;
+} Archive_t;
+
+// REPLAY INITIALIZATION & REMOVAL
+int createReplay(Replay_t *replay, int game, unsigned int seed);
+void removeReplay(Replay_t *replay);
+int replayPush(Replay_t *replay, uint8_t command);
+
+// REPLAY COMPRESSION
+size_t replayCompress(const uint8_t *commands, int steps, uint8_t *data);
+int replayDecompress(const uint8_t *data, size_t size, uint8_t *commands,
+                     int steps);
+
+// ARCHIVE WRITING
+int createArchiveWriter(ArchiveWriter_t *writer, const char *path);
+int archiveWrite(ArchiveWriter_t *writer, uint64_t id, const Replay_t *replay);
+int closeArchiveWriter(ArchiveWriter_t *writer);
+
+// ARCHIVE READING
+int openArchive(Archive_t *archive, const char *path, int access);
+void closeArchive(Archive_t *archive);
+void archiveEntry(const Archive_t *archive, int i, ArchiveEntry_t *entry);
+int archiveFind(const Archive_t *archive, uint64_t id, ArchiveEntry_t *entry);
+int archiveLoad(const Archive_t *archive, const ArchiveEntry_t *entry,
+                Replay_t *replay);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_COMMON_REPLAY_ARCHIVE_H_
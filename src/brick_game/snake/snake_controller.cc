@@ -18,18 +18,30 @@ SnakeController::SnakeController(SnakeModel *snake_model)
 SnakeController::~SnakeController() {}
 
 /**
- * @brief Функция, которая получает команду от пользователя
- * @details Функция получает команду от пользователя, используя функцию
- * getch. Затем при помощи функции setUserAction определяется, какая команда
- * была получена и присваивается значение структуре UserAction_t. Далее функция
- * вызывается userInput, чтобы обработать полученную команду
+ * @brief Функция, которая получает команды от пользователя
+ * @details Функция читает функцией getch нажатые клавиши, пока они есть.
+ * Ожиданием клавиш управляет планировщик кадров фронтенда (см. frame_loop.h):
+ * он ждёт клавишу не дольше конца кадра и оставляет timeout нулевым, поэтому
+ * функция timeout не меняет. Каждая клавиша превращается в команду функцией
+ * setUserAction и кладётся в очередь ввода вместе со временем нажатия.
+ * ncurses не сообщает об отпускании клавиш, поэтому кадр без нажатий
+ * считается отпусканием (ускорение змейки отменяется). Затем функция
+ * drainInput применяет все команды из очереди
  */
 void SnakeController::getUserInput() {
   SnakeModel::SnakeInfo_t *game_state = snake_model_->getSnakeInfo_t();
   int key = getch();
-  bool hold = false;
-  setUserAction(key, &game_state->action, &hold);
-  userInput(game_state->action, hold);
+  if (key == ERR) {
+    pushInput(&game_state->input, Start, false, setTime());
+  }
+  while (key != ERR) {
+    UserAction_t action = Start;
+    bool hold = false;
+    setUserAction(key, &action, &hold);
+    pushInput(&game_state->input, action, true, setTime());
+    key = getch();
+  }
+  drainInput();
 }
 
 /**
@@ -125,6 +137,56 @@ void SnakeController::userInput(UserAction_t action, bool hold) {
   }
 }
 
+/**
+ * @brief Применяет все команды из очереди ввода игры
+ * @details События применяются в порядке поступления. Если к моменту
+ * нажатия клавиши уже наступило время очередного шага змейки, то сначала
+ * выполняется этот шаг, поэтому два быстрых поворота подряд не сливаются в
+ * один. Нажатие клавиши текущего направления ускоряет змейку, отпускание
+ * клавиши отменяет ускорение. В action остаётся последняя применённая
+ * команда (Start, если команд не было). После команды Terminate очередь
+ * больше не читается
+ */
+void SnakeController::drainInput() {
+  SnakeModel::SnakeInfo_t *game_state = snake_model_->getSnakeInfo_t();
+  GameInfo_t *stats = snake_model_->getGameInfo_t();
+  InputEvent_t event;
+  PROFILE_ENTER(PROFILE_INPUT_DRAIN);
+  game_state->action = Start;
+  while (game_state->action != Terminate &&
+         game_state->game_status == kStart &&
+         popInput(&game_state->input, &event)) {
+    if (!event.pressed) {
+      snake_model_->speedBoost(false);
+    } else {
+      if (!stats->pause && stats->score != SNAKE_MAX_SCORE &&
+          event.time - game_state->set_time >= game_state->game_info.speed) {
+        game_state->set_time = event.time;
+        snake_model_->snakeStep();
+      }
+      if (game_state->game_status == kStart) {
+        game_state->action = event.action;
+        userInput(event.action, isBoost(event.action));
+      }
+    }
+  }
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Проверяет, ускоряет ли команда змейку
+ * @param action Команда
+ * @return true, если команда совпадает с текущим направлением движения
+ * змейки, иначе false
+ */
+bool SnakeController::isBoost(UserAction_t action) {
+  Snake::Direction curr_dir = snake_model_->getSnake().getDirection();
+  return (curr_dir == Snake::kUp && action == Up) ||
+         (curr_dir == Snake::kDown && action == Down) ||
+         (curr_dir == Snake::kLeft && action == Left) ||
+         (curr_dir == Snake::kRight && action == Right);
+}
+
 /**
  * @brief Возвращает указатель на модель игры
  * @details Функция возвращает указатель на модель игры, с которой работает
@@ -7,7 +7,12 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#include "../common/arena.h"
 #include "../common/common_back.h"
+#include "../common/event_log.h"
+#include "../common/input_queue.h"
+#include "../common/lockstep.h"
+#include "../common/profiler.h"
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +34,8 @@ public:
   void getUserInput();
   void setUserAction(int key, UserAction_t *action, bool *hold);
   void userInput(UserAction_t action, bool hold);
+  void drainInput();
+  bool isBoost(UserAction_t action);
 
   // GETTERS
   SnakeModel *getModel() const;
@@ -7,14 +7,18 @@
 namespace s21 {
 /**
  * @brief Конструктор кдасса Snake
- * @details Змейка создается длиной 4 ячейки и начинает двигаться вниз по оси Y
+ * @details Змейка создается длиной 4 ячейки и начинает двигаться вниз по оси Y.
+ * Память под тело самой длинной змейки резервируется сразу, поэтому при росте
+ * вектор не перевыделяется
  * @param start_x Начальное положение на оси X
  * @param start_y Начальное положение на оси Y
  */
-Snake::Snake(int start_x, int start_y) : direction_(kDown) {
+Snake::Snake(int start_x, int start_y) : direction_(kDown), hash_(0) {
+  snake_body_.reserve(SNAKE_MAX_LENGTH + 1);
   for (int i = 0; i < 4; ++i) {
     snake_body_.push_back({start_x, start_y + i});
   }
+  rehash();
 }
 
 /**
@@ -33,6 +37,14 @@ const std::vector<std::pair<int, int>> &Snake::getSnakeBody() const {
  */
 Snake::Direction Snake::getDirection() const { return direction_; }
 
+/**
+ * @brief Геттер хеша змейки
+ * @details Возвращает хеш Зобриста змейки, который обновляется при каждом
+ * движении и смене направления
+ * @return Хеш змейки
+ */
+unsigned long long Snake::getHash() const { return hash_; }
+
 /**
  * @brief Сеттер направления движения змейки
  * @details Изменяет текущее направление движения змейки на заданное новое
@@ -45,6 +57,8 @@ void Snake::setDirection(Direction new_dir) {
       (direction_ == kDown && new_dir != kUp) ||
       (direction_ == kLeft && new_dir != kRight) ||
       (direction_ == kRight && new_dir != kLeft)) {
+    hash_ ^= zobristKey(SNAKE_ZOBRIST_DIRECTION, direction_, 0) ^
+             zobristKey(SNAKE_ZOBRIST_DIRECTION, new_dir, 0);
     direction_ = new_dir;
   }
 }
@@ -80,29 +94,89 @@ std::pair<int, int> Snake::nextStep() const {
 /**
  * @brief Движение змейки
  * @details Эта функция перемещает змею по полю, добавляя к голове одну клетку и
- * удаляя одну клетку из хвоста
+ * удаляя одну клетку из хвоста. Из хеша убирается ключ связи хвоста со
+ * следующей клеткой
  */
 void Snake::move() {
   grow();
+  hash_ ^= linkKey(0);
   snake_body_.erase(snake_body_.begin());
 }
 
 /**
  * @brief Добавление новой клетки к змее
  * @details Добавляет к змее новую клетку, расположенную на следующей позиции
- * относительно текущей головы
+ * относительно текущей головы. В хеше ключ прежней головы заменяется ключом
+ * её связи с новой головой и ключом новой головы
  */
 void Snake::grow() {
   auto new_head = nextStep();
+  auto head = snake_body_.back();
+  hash_ ^= zobristKey(SNAKE_ZOBRIST_HEAD, head.first, head.second);
   snake_body_.push_back(new_head);
+  hash_ ^= linkKey(snake_body_.size() - 2) ^
+           zobristKey(SNAKE_ZOBRIST_HEAD, new_head.first, new_head.second);
+}
+
+/**
+ * @brief Ключ связи клетки змейки со следующей клеткой
+ * @details Каждая клетка, кроме головы, хешируется вместе с направлением на
+ * следующую клетку (в сторону головы). Набор таких связей однозначно задаёт
+ * форму змейки, а не только множество занятых клеток
+ * @param i Номер клетки от хвоста
+ * @return Ключ связи
+ */
+unsigned long long Snake::linkKey(size_t i) const {
+  const auto &from = snake_body_[i];
+  const auto &to = snake_body_[i + 1];
+  int link = (to.first > from.first)    ? kRight
+             : (to.first < from.first)  ? kLeft
+             : (to.second < from.second) ? kUp
+                                         : kDown;
+  return zobristKey(SNAKE_ZOBRIST_LINK, from.first * 4 + link, from.second);
+}
+
+/**
+ * @brief Пересчёт хеша змейки
+ * @details Вычисляет хеш Зобриста змейки заново: ключи связей всех клеток,
+ * ключ головы и ключ направления движения
+ */
+void Snake::rehash() {
+  auto head = snake_body_.back();
+  hash_ = zobristKey(SNAKE_ZOBRIST_HEAD, head.first, head.second) ^
+          zobristKey(SNAKE_ZOBRIST_DIRECTION, direction_, 0);
+  for (size_t i = 0; i + 1 < snake_body_.size(); ++i) {
+    hash_ ^= linkKey(i);
+  }
+}
+
+/**
+ * @brief Восстановление змейки из снимка
+ * @details Заменяет тело змейки переданными координатами (от хвоста к голове) и
+ * устанавливает направление движения без проверки на разворот. Уже выделенная
+ * под вектор память используется повторно
+ * @param body Массив координат клеток змейки
+ * @param length Количество клеток змейки
+ * @param direction Направление движения
+ */
+void Snake::restoreBody(const int (*body)[2], int length, Direction direction) {
+  snake_body_.clear();
+  for (int i = 0; i < length; ++i) {
+    snake_body_.push_back({body[i][0], body[i][1]});
+  }
+  direction_ = direction;
+  rehash();
 }
 
 /**
  * @brief Конструктор класса Apple
  * @details Инициализирует переменные apple_x_ и apple_y_ нулями (начальное
- * положение яблока до старта игры)
+ * положение яблока до старта игры) и задаёт начальное состояние генератора
+ * случайных чисел, которым выбирается положение яблока
  */
-Apple::Apple() : apple_x_(0), apple_y_(0) {}
+Apple::Apple()
+    : apple_x_(0), apple_y_(0), seed_(static_cast<unsigned int>(rand())),
+      hash_(zobristKey(SNAKE_ZOBRIST_APPLE, 0, 0)) {}
 
 /**
  * @brief Деструктор класса Apple
@@ -123,6 +197,36 @@ int Apple::getAppleX() const { return apple_x_; }
  */
 int Apple::getAppleY() const { return apple_y_; }
 
+/**
+ * @brief Геттер состояния генератора случайных чисел
+ * @details Возвращает состояние генератора, которым выбирается положение
+ * следующего яблока
+ * @return Состояние генератора
+ */
+unsigned int Apple::getSeed() const { return seed_; }
+
+/**
+ * @brief Геттер хеша яблока
+ * @details Возвращает ключ Зобриста текущего положения яблока
+ * @return Хеш яблока
+ */
+unsigned long long Apple::getHash() const { return hash_; }
+
+/**
+ * @brief Сеттер яблока
+ * @details Устанавливает координаты яблока и состояние генератора случайных
+ * чисел, например при восстановлении игры из снимка
+ * @param x X-координата яблока
+ * @param y Y-координата яблока
+ * @param seed Состояние генератора
+ */
+void Apple::setApple(int x, int y, unsigned int seed) {
+  apple_x_ = x;
+  apple_y_ = y;
+  seed_ = seed;
+  hash_ = zobristKey(SNAKE_ZOBRIST_APPLE, apple_x_, apple_y_);
+}
+
 /**
  * @brief Генерация новой позиции яблока
  * @details Генерирует новую позицию яблока, проверяя не пересекаются ли
@@ -130,12 +234,15 @@ int Apple::getAppleY() const { return apple_y_; }
  * @param snake_body Вектор змейки
  */
 void Apple::spawnApple(const std::vector<std::pair<int, int>> &snake_body) {
+  PROFILE_ENTER(PROFILE_APPLE_SPAWN);
   bool is_collision = true;
   while (is_collision) {
-    apple_x_ = (rand() % WIDTH) * 2 + 1;
-    apple_y_ = rand() % (HEIGHT - 2) + 1;
+    apple_x_ = (randomNumber(&seed_) % WIDTH) * 2 + 1;
+    apple_y_ = randomNumber(&seed_) % (HEIGHT - 2) + 1;
     is_collision = checkApplesPosition(snake_body);
   }
+  hash_ = zobristKey(SNAKE_ZOBRIST_APPLE, apple_x_, apple_y_);
+  PROFILE_LEAVE();
 }
 
 /**
@@ -163,49 +270,39 @@ bool Apple::checkApplesPosition(
 /**
  * @brief Конструктор класса SnakeModel
  * @details Инициализирует змейку, поле, яблоко, счет, уровень и другие
- * переменные игры. Создает двумерный массив field для хранения состояния поля,
- * инициализирует его значения нулями. Создает змейку в заданных координатах,
+ * переменные игры. Двумерный массив field для хранения состояния поля
+ * берётся из арены модели, которая выделяется одним блоком (см. arena.h), и
+ * заполняется нулями. Создает змейку в заданных координатах,
  * инициализирует переменные score, high_score, level, pause, speed, set_time и
  * current_speed и генерирует начальную позицию яблока
  */
-SnakeModel::SnakeModel() : snake_(7, 1) {
-  int status = START;
-  game_info.field = new int *[HEIGHT + 1];
-  if (game_info.field != nullptr) {
-    for (int i = 0; i < HEIGHT + 1 && status != STOP; ++i) {
-      game_info.field[i] = new int[WIDTH * 2 + 1]{};
-      if (game_info.field[i] == nullptr) {
-        status = STOP;
-      }
-    }
-    if (status != STOP) {
-      game_state.action = Start;
-      game_state.game_status = kStart;
-      game_info.score = 0;
-      game_info.high_score = getHighScore();
-      game_info.level = 1;
-      game_info.pause = 0;
-      game_info.speed = START_SPEED;
-      game_state.game_info = game_info;
-      game_state.current_speed = START_SPEED;
-      game_state.set_time = 0;
-      apple_.spawnApple(snake_.getSnakeBody());
-    }
+SnakeModel::SnakeModel() : snake_(7, 1), events_(nullptr) {
+  game_info.field = nullptr;
+  if (createArena(&arena_, arenaMatrixSize(HEIGHT + 1, WIDTH * 2 + 1)) ==
+      START) {
+    game_info.field = arenaMatrix(&arena_, HEIGHT + 1, WIDTH * 2 + 1);
+    game_state.action = Start;
+    initInputQueue(&game_state.input);
+    game_state.game_status = kStart;
+    game_info.score = 0;
+    game_info.high_score = getHighScore();
+    game_info.level = 1;
+    game_info.pause = 0;
+    game_info.speed = START_SPEED;
+    game_state.game_info = game_info;
+    game_state.current_speed = START_SPEED;
+    game_state.set_time = 0;
+    apple_.spawnApple(snake_.getSnakeBody());
   }
 }
 
 /**
  * @brief Деструктор класса SnakeModel
- * @details Освобождает память, выделенную под двумерный массив field и
+ * @details Освобождает арену, в которой лежит двумерный массив field, и
  * сохраняет текущий рекорд
  */
 SnakeModel::~SnakeModel() {
-  if (game_info.field != nullptr) {
-    for (int i = 0; i < HEIGHT + 1; ++i) {
-      delete[] game_info.field[i];
-    }
-    delete[] game_info.field;
-  }
+  removeArena(&arena_);
   setHighScore(game_info.high_score);
 }
 
@@ -232,6 +329,17 @@ GameInfo_t *SnakeModel::getGameInfo_t() { return &game_info; }
  */
 Snake &SnakeModel::getSnake() { return snake_; }
 
+/**
+ * @brief Геттер хеша игрового состояния
+ * @details Функция возвращает хеш Зобриста змейки и яблока. Хеши частей
+ * обновляются по мере изменения состояния, поэтому их объединение не требует
+ * обхода тела змейки
+ * @return Хеш игрового состояния
+ */
+unsigned long long SnakeModel::getHash() const {
+  return snake_.getHash() ^ apple_.getHash();
+}
+
 /**
  * @brief Основная логика игры
  * @details Функция snakeMechanics управляет ходом игры. Она проверяет,
@@ -241,11 +349,13 @@ Snake &SnakeModel::getSnake() { return snake_; }
  * @param game_status Указатель на GameStatus_t, хранящую статус игры
  */
 void SnakeModel::snakeMechanics(GameStatus_t &game_status) {
+  PROFILE_ENTER(PROFILE_SNAKE_MECHANICS);
   if (game_info.score == SNAKE_MAX_SCORE) {
     game_status = kWin;
   } else {
     continueOrNot(game_state.action, &game_state);
   }
+  PROFILE_LEAVE();
 }
 
 /**
@@ -291,9 +401,8 @@ void SnakeModel::fillField(GameInfo_t &stats, int x, int y) {
 /**
  * @brief Проверяет, необходимо ли продолжать игру
  * @details Если состояние action равно Terminate, то меняет статус игры на
- * "game over". Иначе, функция, используя функцию checkCollision (проверка на
- * столкновение), проверяет, может ли змея двигаться. Если движение невозможно
- * (столкновение с границами или телом), то статус игры меняется на "game over"
+ * "game over". Иначе функция snakeTick выполняет шаг змейки, если его время
+ * наступило
  * @param state Команда пользователя
  * @param game_state Указатель на структуру SnakeInfo_t, содержащую
  * информацию о текущем состоянии игры
@@ -302,25 +411,59 @@ void SnakeModel::continueOrNot(UserAction_t state, SnakeInfo_t *game_state) {
   if (state == Terminate) {
     game_state->game_status = kGameOver;
   } else {
-    GameInfo_t *stats = &game_state->game_info;
-    long long curr_time = setTime();
-    if (curr_time - game_state->set_time >= stats->speed) {
-      game_state->set_time = curr_time;
-      const auto &body = snake_.getSnakeBody();
-      auto head = body.back();
-      if (head.first == apple_.getAppleX() &&
-          head.second == apple_.getAppleY()) {
-        updateScore(&game_info);
-        apple_.spawnApple(body);
-      } else {
-        if (!checkCollision()) {
-          snake_.move();
-        } else {
-          game_state->game_status = kGameOver;
-        }
-      }
+    snakeTick(setTime());
+  }
+}
+
+/**
+ * @brief Выполняет шаг змейки, если его время наступило к моменту now
+ * @details Время берётся у вызывающей стороны, поэтому планировщик кадров
+ * может выполнить несколько тактов подряд по своим часам и догнать игру
+ * после задержки. Интервал шага - скорость из SnakeInfo_t
+ * @param now Время такта в миллисекундах
+ */
+void SnakeModel::snakeTick(long long now) {
+  if (now - game_state.set_time >= game_state.game_info.speed) {
+    game_state.set_time = now;
+    snakeStep();
+  }
+}
+
+/**
+ * @brief Выполняет один шаг змейки
+ * @details При столкновении статус игры меняется на "game over". Иначе,
+ * если голова змейки находится на яблоке, то змейка растёт на клетку вперёд
+ * и появляется новое яблоко, а если нет - сдвигается на клетку. Рост тоже
+ * проверяется на столкновение, иначе змейка, съевшая яблоко у стены или у
+ * своего тела, вырастала бы в стену или в себя. Если модель подключена к
+ * журналу, каждый вызов считается шагом игры, а появление нового яблока
+ * пишется событием EVENT_APPLE. Таймер шага не
+ * проверяется, поэтому функцию вызывает как continueOrNot, так и
+ * контроллер, когда шаг должен произойти раньше команды из очереди ввода
+ */
+void SnakeModel::snakeStep() {
+  PROFILE_ENTER(PROFILE_SNAKE_MOVE);
+  const auto &body = snake_.getSnakeBody();
+  auto head = body.back();
+  if (events_ != nullptr) {
+    events_->tick++;
+  }
+  if (checkCollision()) {
+    game_state.game_status = kGameOver;
+  } else if (head.first == apple_.getAppleX() &&
+             head.second == apple_.getAppleY()) {
+    int score = game_info.score;
+    updateScore(&game_info);
+    apple_.spawnApple(body);
+    if (events_ != nullptr) {
+      gameEvent(events_, EVENT_APPLE, static_cast<int>(body.size()),
+                snake_.getDirection(), apple_.getAppleX(), apple_.getAppleY(),
+                0, game_info.score - score);
     }
+  } else {
+    snake_.move();
   }
+  PROFILE_LEAVE();
 }
 
 /**
@@ -437,4 +580,116 @@ void SnakeModel::setHighScore(int high_score) {
     file.close();
   }
 }
-} // namespace s21
\ No newline at end of file
+
+/**
+ * @brief Сохраняет снимок состояния игры
+ * @details Функция копирует в структуру SnakeSnapshot_t тело и направление
+ * змейки, положение яблока, состояние генератора случайных чисел и статистику
+ * игры. Снимок предварительно обнуляется, чтобы одинаковые состояния давали
+ * побайтно одинаковые снимки
+ * @param snapshot Указатель на снимок, в который сохраняется состояние
+ */
+void SnakeModel::snapshot(SnakeSnapshot_t *snapshot) const {
+  std::memset(snapshot, 0, sizeof(*snapshot));
+  const auto &body = snake_.getSnakeBody();
+  int length = static_cast<int>(body.size());
+  if (length > SNAKE_MAX_LENGTH) {
+    length = SNAKE_MAX_LENGTH;
+  }
+  for (int i = 0; i < length; ++i) {
+    snapshot->body[i][0] = body[i].first;
+    snapshot->body[i][1] = body[i].second;
+  }
+  snapshot->length = length;
+  snapshot->direction = snake_.getDirection();
+  snapshot->apple_x = apple_.getAppleX();
+  snapshot->apple_y = apple_.getAppleY();
+  snapshot->apple_seed = apple_.getSeed();
+  snapshot->score = game_info.score;
+  snapshot->high_score = game_info.high_score;
+  snapshot->level = game_info.level;
+  snapshot->speed = game_info.speed;
+  snapshot->pause = game_info.pause;
+  snapshot->current_speed = game_state.current_speed;
+  snapshot->action = game_state.action;
+  snapshot->game_status = game_state.game_status;
+  snapshot->set_time = game_state.set_time;
+}
+
+/**
+ * @brief Восстанавливает состояние игры из снимка
+ * @details Функция переносит содержимое снимка в модель. Статистика
+ * записывается и в game_info, и в её копию внутри SnakeInfo_t, поле при этом
+ * не перевыделяется
+ * @param snapshot Снимок, из которого восстанавливается состояние
+ */
+void SnakeModel::restore(const SnakeSnapshot_t &snapshot) {
+  snake_.restoreBody(snapshot.body, snapshot.length, snapshot.direction);
+  apple_.setApple(snapshot.apple_x, snapshot.apple_y, snapshot.apple_seed);
+  game_info.score = snapshot.score;
+  game_info.high_score = snapshot.high_score;
+  game_info.level = snapshot.level;
+  game_info.speed = snapshot.speed;
+  game_info.pause = snapshot.pause;
+  game_state.game_info = game_info;
+  game_state.current_speed = snapshot.current_speed;
+  game_state.action = snapshot.action;
+  game_state.game_status = snapshot.game_status;
+  game_state.set_time = snapshot.set_time;
+}
+
+/**
+ * @brief Задаёт состояние генератора яблок и заново выбирает яблоко
+ * @details Первое яблоко появляется в конструкторе модели от генератора,
+ * начальное состояние которого берётся из rand(), и зависит от того, сколько
+ * моделей было создано в программе раньше. После вызова положение яблока и
+ * все следующие яблоки определяются только seed и телом змейки
+ * @param seed Состояние генератора случайных чисел
+ */
+void SnakeModel::seedApple(unsigned int seed) {
+  apple_.setApple(apple_.getAppleX(), apple_.getAppleY(), seed);
+  apple_.spawnApple(snake_.getSnakeBody());
+}
+
+/**
+ * @brief Считает контрольную сумму полного состояния игры
+ * @details В сумму входят тело змейки от хвоста к голове, направление,
+ * яблоко и состояние его генератора, статистика (кроме рекорда), скорость
+ * с учётом ускорения и статус игры. Время шага и рекорд не входят (см.
+ * lockstep.h)
+ * @return Контрольная сумма
+ */
+unsigned long long SnakeModel::checksum() const {
+  unsigned long long sum = CHECKSUM_INIT;
+  const auto &body = snake_.getSnakeBody();
+  sum = checksumInt(sum, static_cast<long long>(body.size()));
+  for (const auto &part : body) {
+    sum = checksumInt(sum, part.first);
+    sum = checksumInt(sum, part.second);
+  }
+  const long long state_data[] = {snake_.getDirection(),
+                                  apple_.getAppleX(),
+                                  apple_.getAppleY(),
+                                  apple_.getSeed(),
+                                  game_info.score,
+                                  game_info.level,
+                                  game_info.speed,
+                                  game_info.pause,
+                                  game_state.current_speed,
+                                  game_state.game_status};
+  for (long long value : state_data) {
+    sum = checksumInt(sum, value);
+  }
+  return sum;
+}
+
+/**
+ * @brief Подключает модель к журналу событий
+ * @details Источник событий принадлежит вызывающей стороне и должен жить,
+ * пока модель пишет события (см. event_log.h)
+ * @param events Указатель на источник событий или nullptr, чтобы отключить
+ * запись
+ */
+void SnakeModel::setEvents(GameEvents_t *events) { events_ = events; }
+
+} // namespace s21
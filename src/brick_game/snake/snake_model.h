@@ -9,6 +9,12 @@
 #include <vector>
 
 #define SNAKE_MAX_SCORE 196
+#define SNAKE_MAX_LENGTH (SNAKE_MAX_SCORE + 4)
+
+#define SNAKE_ZOBRIST_HEAD 0
+#define SNAKE_ZOBRIST_LINK 1
+#define SNAKE_ZOBRIST_DIRECTION 2
+#define SNAKE_ZOBRIST_APPLE 3
 
 namespace s21 {
 /** @class Snake
@@ -30,6 +36,7 @@ public:
   // GETTERS & SETTER
   const std::vector<std::pair<int, int>> &getSnakeBody() const;
   Direction getDirection() const;
+  unsigned long long getHash() const;
   void setDirection(Direction new_dir);
 
   // MOVING FUNCS
@@ -37,9 +44,17 @@ public:
   void move();
   void grow();
 
+  // RESTORE FUNC
+  void restoreBody(const int (*body)[2], int length, Direction direction);
+
 private:
   std::vector<std::pair<int, int>> snake_body_;
   Direction direction_;
+  unsigned long long hash_;
+
+  // HASHING FUNCS
+  unsigned long long linkKey(size_t i) const;
+  void rehash();
 };
 
 /** @class Apple
@@ -51,9 +66,12 @@ public:
   Apple();
   ~Apple();
 
-  // GETTERS
+  // GETTERS & SETTER
   int getAppleX() const;
   int getAppleY() const;
+  unsigned int getSeed() const;
+  unsigned long long getHash() const;
+  void setApple(int x, int y, unsigned int seed);
 
   // SPAWN FUNCS
   void spawnApple(const std::vector<std::pair<int, int>> &snake_body);
@@ -62,6 +80,8 @@ public:
 private:
   int apple_x_;
   int apple_y_;
+  unsigned int seed_;
+  unsigned long long hash_;
 };
 
 /** @class SnakeModel
@@ -74,12 +94,36 @@ public:
    */
   typedef struct {
     UserAction_t action;
+    InputQueue_t input;
     GameInfo_t game_info;
     GameStatus_t game_status;
     long long set_time;
     int current_speed;
   } SnakeInfo_t;
 
+  /**
+   * @brief Снимок состояния игры
+   * @details Структура фиксированного размера без указателей, поэтому снимок
+   * копируется одним memcpy. Тело змейки хранится от хвоста к голове
+   */
+  typedef struct {
+    int body[SNAKE_MAX_LENGTH][2];
+    int length;
+    Snake::Direction direction;
+    int apple_x;
+    int apple_y;
+    unsigned int apple_seed;
+    int score;
+    int high_score;
+    int level;
+    int speed;
+    int pause;
+    int current_speed;
+    UserAction_t action;
+    GameStatus_t game_status;
+    long long set_time;
+  } SnakeSnapshot_t;
+
   // CONSTRUCTOR & DESTRUCTOR
   SnakeModel();
   ~SnakeModel();
@@ -88,9 +132,12 @@ public:
   SnakeInfo_t *getSnakeInfo_t();
   GameInfo_t *getGameInfo_t();
   Snake &getSnake();
+  unsigned long long getHash() const;
 
   // GAME LOGIC
   void snakeMechanics(GameStatus_t &game_status);
+  void snakeStep();
+  void snakeTick(long long now);
   void updateField(GameInfo_t &stats);
 
   // SPEED BOOSTER
@@ -101,11 +148,24 @@ public:
   int getHighScore();
   void setHighScore(int high_score);
 
+  // SNAPSHOT & RESTORE
+  void snapshot(SnakeSnapshot_t *snapshot) const;
+  void restore(const SnakeSnapshot_t &snapshot);
+  void seedApple(unsigned int seed);
+
+  // CHECKSUM
+  unsigned long long checksum() const;
+
+  // EVENT LOG
+  void setEvents(GameEvents_t *events);
+
 private:
   GameInfo_t game_info;
   SnakeInfo_t game_state;
   Snake snake_;
   Apple apple_;
+  Arena_t arena_;
+  GameEvents_t *events_;
 
   // GAME LOGIC HELEPRS
   void fillField(GameInfo_t &stats, int x, int y);
@@ -0,0 +1,200 @@
+/** @file
+ * @brief Файл, содержащий игровой модуль Змейки
+ */
+#include <cstring>
+#include <new>
+
+extern "C" {
+#include "../api/game_module.h"
+#include "../common/frame_codec.h"
+}
+#include "snake_controller.h"
+
+namespace s21 {
+/**
+ * @brief Состояние игры модуля: модель и контроллер, как в сессии игрового
+ * сервера
+ */
+struct SnakeModuleState {
+  SnakeModel model;
+  SnakeController controller;
+  SnakeModuleState() : model(), controller(&model) {}
+};
+
+/**
+ * @brief Создаёт игру модуля
+ * @details Состояние генератора seed задаёт появление всех яблок, включая
+ * первое, поэтому игра не зависит от ранее созданных в программе моделей
+ * @param seed Состояние генератора случайных чисел
+ * @return Указатель на состояние или nullptr, если память не выделена
+ */
+static void *snakeModuleCreate(unsigned int seed) {
+  SnakeModuleState *state = new (std::nothrow) SnakeModuleState();
+  if (state != nullptr && state->model.getGameInfo_t()->field == nullptr) {
+    delete state;
+    state = nullptr;
+  }
+  if (state != nullptr) {
+    state->model.seedApple(seed);
+    state->model.getSnakeInfo_t()->set_time = setTime();
+  }
+  return state;
+}
+
+/**
+ * @brief Удаляет игру модуля
+ * @param state Указатель на состояние
+ */
+static void snakeModuleDestroy(void *state) {
+  delete static_cast<SnakeModuleState *>(state);
+}
+
+/**
+ * @brief Обработка команды пользователя
+ * @details Команда Terminate сразу завершает игру, остальные команды
+ * выполняются контроллером игры
+ * @param state Указатель на состояние
+ * @param action Команда пользователя
+ * @param hold Индикатор зажатия клавиши, соответствующей направлению движения
+ */
+static void snakeModuleInput(void *state, UserAction_t action, bool hold) {
+  SnakeModuleState *game = static_cast<SnakeModuleState *>(state);
+  SnakeModel::SnakeInfo_t *game_state = game->model.getSnakeInfo_t();
+  game_state->action = action;
+  if (action == Terminate) {
+    game_state->game_status = kGameOver;
+  } else {
+    game->controller.userInput(action, hold);
+  }
+}
+
+/**
+ * @brief Выполняет один шаг змейки без учёта времени
+ * @details Шаг не выполняется во время паузы и после окончания игры
+ * @param state Указатель на состояние
+ */
+static void snakeModuleStep(void *state) {
+  SnakeModel &model = static_cast<SnakeModuleState *>(state)->model;
+  SnakeModel::SnakeInfo_t *game_state = model.getSnakeInfo_t();
+  if (!model.getGameInfo_t()->pause && game_state->game_status == kStart) {
+    if (model.getGameInfo_t()->score == SNAKE_MAX_SCORE) {
+      game_state->game_status = kWin;
+    } else {
+      model.snakeStep();
+    }
+  }
+}
+
+/**
+ * @brief Выполняет такт игры по текущему времени
+ * @details Повторяет шаг игрового цикла консольной версии: во время паузы и
+ * после окончания игры ничего не происходит, иначе статистика копируется в
+ * SnakeInfo_t и вызывается snakeMechanics
+ * @param state Указатель на состояние
+ */
+static void snakeModuleTick(void *state) {
+  SnakeModuleState *game = static_cast<SnakeModuleState *>(state);
+  SnakeModel::SnakeInfo_t *game_state = game->model.getSnakeInfo_t();
+  GameInfo_t stats = game->controller.updateCurrentState();
+  if (!stats.pause && game_state->game_status == kStart) {
+    game_state->game_info = stats;
+    game->model.snakeMechanics(game_state->game_status);
+  }
+}
+
+/**
+ * @brief Сериализует состояние игры
+ * @param state Указатель на состояние
+ * @param buffer Буфер размером sizeof(SnakeModel::SnakeSnapshot_t) байт
+ */
+static void snakeModuleSerialize(const void *state, uint8_t *buffer) {
+  SnakeModel::SnakeSnapshot_t snapshot;
+  static_cast<const SnakeModuleState *>(state)->model.snapshot(&snapshot);
+  std::memcpy(buffer, &snapshot, sizeof(snapshot));
+}
+
+/**
+ * @brief Восстанавливает состояние игры из буфера
+ * @param state Указатель на состояние
+ * @param buffer Буфер, заполненный функцией snakeModuleSerialize
+ */
+static void snakeModuleDeserialize(void *state, const uint8_t *buffer) {
+  SnakeModel::SnakeSnapshot_t snapshot;
+  std::memcpy(&snapshot, buffer, sizeof(snapshot));
+  static_cast<SnakeModuleState *>(state)->model.restore(snapshot);
+}
+
+/**
+ * @brief Кодирует состояние игры в ключевой кадр
+ * @details Поле модели перестраивается функцией updateField. Следующей
+ * фигуры в Змейке нет, поэтому её часть кадра остаётся пустой
+ * @param state Указатель на состояние
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ * @return Размер кадра в байтах
+ */
+static int snakeModuleFrame(void *state, uint8_t *frame) {
+  SnakeModel &model = static_cast<SnakeModuleState *>(state)->model;
+  GameInfo_t *stats = model.getGameInfo_t();
+  model.updateField(*stats);
+  GameInfo_t info = *stats;
+  info.next = nullptr;
+  return frameEncode(&info, model.getSnakeInfo_t()->game_status, frame);
+}
+
+/**
+ * @brief Геттер статуса игры
+ * @details Геттер статуса модели не константный, поэтому константность
+ * состояния снимается; состояние не изменяется
+ * @param state Указатель на состояние
+ * @return Статус игры
+ */
+static GameStatus_t snakeModuleStatus(const void *state) {
+  SnakeModuleState *game = static_cast<SnakeModuleState *>(
+      const_cast<void *>(state));
+  return game->model.getSnakeInfo_t()->game_status;
+}
+
+/**
+ * @brief Считает контрольную сумму состояния игры
+ * @param state Указатель на состояние
+ * @return Контрольная сумма (см. SnakeModel::checksum)
+ */
+static unsigned long long snakeModuleChecksum(const void *state) {
+  return static_cast<const SnakeModuleState *>(state)->model.checksum();
+}
+
+/**
+ * @brief Подключает игру к журналу событий
+ * @param state Указатель на состояние
+ * @param events Указатель на источник событий или nullptr
+ */
+static void snakeModuleEvents(void *state, GameEvents_t *events) {
+  static_cast<SnakeModuleState *>(state)->model.setEvents(events);
+}
+
+} // namespace s21
+
+/**
+ * @brief Возвращает игровой модуль Змейки
+ * @return Указатель на статический модуль
+ */
+const GameModule_t *snakeModule(void) {
+  static const GameModule_t module = {
+      GAME_MODULE_SNAKE,
+      "SNAKE",
+      's',
+      sizeof(s21::SnakeModel::SnakeSnapshot_t),
+      {false, START_SPEED, "arrows turn, hold to speed up, space pauses"},
+      s21::snakeModuleCreate,
+      s21::snakeModuleDestroy,
+      s21::snakeModuleInput,
+      s21::snakeModuleStep,
+      s21::snakeModuleTick,
+      s21::snakeModuleSerialize,
+      s21::snakeModuleDeserialize,
+      s21::snakeModuleFrame,
+      s21::snakeModuleStatus,
+      s21::snakeModuleChecksum,
+      s21::snakeModuleEvents};
+  return &module;
+}
@@ -26,36 +26,49 @@ TetrisInfo_t *getTetrisInfo_t() {
  * @brief Инициализирует структуру TetrisInfo_t
  * @details Функция инициализирует структуру, содержащую состояние игры.
  * Устанавливает начальные значения для полей структуры, заполняет матрицы field
- * и next и заполняет массив figures порядковыми номерами фигур
+ * и next и заполняет массив figures порядковыми номерами фигур. Матрицы
+ * берутся из арены игры, которая выделяется одним блоком (см. arena.h)
  * @param game_state Указатель на структуру TetrisInfo_t
  * @return START, если инициализация прошла успешно, и STOP в противном случае
  */
 int createInfo_t(TetrisInfo_t *game_state) {
-  int status = START;
   GameInfo_t *stats = &game_state->game_info;
-  status = createMatrix(HEIGHT + 1, WIDTH * 2 + 1, &stats->field);
+  int status = createArena(&game_state->arena,
+                           arenaMatrixSize(HEIGHT + 1, WIDTH * 2 + 1) +
+                               arenaMatrixSize(4, 4));
+  stats->field = NULL;
+  stats->next = NULL;
+  game_state->events = NULL;
   if (status != STOP) {
-    status = createMatrix(4, 4, &stats->next);
-    if (status != STOP) {
-      game_state->action = Start;
-      game_state->game_status = kStart;
-      stats->score = 0;
-      stats->high_score = getHighScore();
-      stats->level = 1;
-      stats->speed = START_SPEED;
-      stats->pause = 0;
-      figureOrdering();
-      corrSpawn(game_state->figures, FIGURES_COUNT);
-      initNextFigure(&game_state->game_info);
-      spawnFigure(game_state);
-    }
+    stats->field = arenaMatrix(&game_state->arena, HEIGHT + 1, WIDTH * 2 + 1);
+    stats->next = arenaMatrix(&game_state->arena, 4, 4);
+    initHeights(game_state);
+    game_state->last_cleared = 0;
+    game_state->action = Start;
+    initInputQueue(&game_state->input);
+    setAutoShift(game_state, TETRIS_DAS_DELAY, TETRIS_ARR_INTERVAL);
+    setLockDelay(game_state, 0, TETRIS_LOCK_RESETS);
+    game_state->game_status = kStart;
+    stats->score = 0;
+    stats->high_score = getHighScore();
+    stats->level = 1;
+    stats->speed = START_SPEED;
+    stats->pause = 0;
+    game_state->seed = (unsigned int)rand();
+    orderFigures(game_state);
+    corrSpawn(game_state->figures, FIGURES_COUNT, &game_state->seed);
+    initQueue(game_state);
+    spawnFigure(game_state);
+    tetrisRehash(game_state);
   }
   return status;
 }
 
 /**
  * @brief Cоздает двумерную матрицу
- * @details Функция выделяет память для двумерной матрицы заданного размера
+ * @details Функция выделяет память для двумерной матрицы заданного размера,
+ * заполненной нулями. Если память выделить не удалось, то уже выделенные
+ * строки освобождаются, а указатель на матрицу становится NULL
  * @param height Размер матрицы по вертикали
  * @param width Размер матрицы по горизонтали
  * @param matrix Указатель на указатель на матрицу
@@ -63,14 +76,17 @@ int createInfo_t(TetrisInfo_t *game_state) {
  */
 int createMatrix(int height, int width, int ***matrix) {
   int status = START;
-  *matrix = (int **)malloc(height * sizeof(int *));
+  *matrix = (int **)calloc(height, sizeof(int *));
   if (*matrix != NULL) {
     for (int i = 0; i < height && !status; i++) {
-      (*matrix)[i] = (int *)malloc((width) * sizeof(int));
+      (*matrix)[i] = (int *)calloc(width, sizeof(int));
       if ((*matrix)[i] == NULL) {
         status = STOP;
       }
-      memset((*matrix)[i], 0, width * sizeof(int));
+    }
+    if (status == STOP) {
+      removeMatrix(*matrix, height);
+      *matrix = NULL;
     }
   } else {
     status = STOP;
@@ -86,20 +102,31 @@ int createMatrix(int height, int width, int ***matrix) {
  */
 void removeGameInfo_t() {
   TetrisInfo_t *game_state = getTetrisInfo_t();
-  GameInfo_t *stats = &game_state->game_info;
-  if (stats != NULL) {
-    removeMatrix(stats->field, HEIGHT + 1);
-    stats->field = NULL;
-    removeMatrix(stats->next, 4);
-    stats->next = NULL;
-    setHighScore(stats->high_score);
+  if (game_state != NULL) {
+    setHighScore(game_state->game_info.high_score);
+    removeInfo_t(game_state);
   }
 }
 
+/**
+ * @brief Освобождает память, занятую состоянием игры
+ * @details Функция освобождает арену игры, в которой лежат матрицы field и
+ * next структуры TetrisInfo_t, одним вызовом free. В отличие от
+ * removeGameInfo_t, работает с любым экземпляром игры (например, с сессией
+ * игрового сервера) и не сохраняет рекорд
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void removeInfo_t(TetrisInfo_t *game_state) {
+  GameInfo_t *stats = &game_state->game_info;
+  removeArena(&game_state->arena);
+  stats->field = NULL;
+  stats->next = NULL;
+}
+
 /**
  * @brief Очищает матрицу
- * @details Функция освобождает память, выделенную для матриц
- * field и next. Вспомогательная функция для removeGameInfo_t
+ * @details Функция освобождает память матрицы, созданной функцией
+ * createMatrix
  * @param matrix Указатель на указатель на матрицу
  * @param height Размер матрицы
  */
@@ -117,8 +144,15 @@ void removeMatrix(int **matrix, int height) {
  * @details Функция определяет порядок появления фигур, которые будут
  * использоваться в игре, заполняя массив figures порядковыми номерами фигур
  */
-void figureOrdering() {
-  TetrisInfo_t *game_state = getTetrisInfo_t();
+void figureOrdering() { orderFigures(getTetrisInfo_t()); }
+
+/**
+ * @brief Определяет порядок появления фигур в заданной игре
+ * @details Функция заполняет массив figures структуры TetrisInfo_t
+ * порядковыми номерами фигур
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void orderFigures(TetrisInfo_t *game_state) {
   game_state->curr_figure = FIGURES_COUNT;
   for (int i = 0; i < FIGURES_COUNT; i++) {
     game_state->figures[i] = i;
@@ -128,13 +162,16 @@ void figureOrdering() {
 /**
  * @brief Перемешивает очерёдность фигур
  * @details Функция перемешивает массив порядковых номеров figures
- * для того чтобы фигуры появлялись в случайном порядке
+ * для того чтобы фигуры появлялись в случайном порядке. Случайные числа берутся
+ * из генератора с состоянием seed, поэтому при одинаковом состоянии порядок
+ * фигур повторяется
  * @param figures Массив, содержащий порядковые номера фигур
  * @param count Количество фигур
+ * @param seed Указатель на состояние генератора случайных чисел
  */
-void corrSpawn(int *figures, int count) {
+void corrSpawn(int *figures, int count, unsigned int *seed) {
   for (int i = count - 1; i > 0; i--) {
-    int j = rand() % (i + 1);
+    int j = randomNumber(seed) % (i + 1);
     int temp = figures[i];
     figures[i] = figures[j];
     figures[j] = temp;
@@ -143,44 +180,100 @@ void corrSpawn(int *figures, int count) {
 
 /**
  * @brief Размещает фигуру на поле
- * @details Функция размещает фигуру на поле по заданным координатам и размерам
- * и инициализирует следующую фигуру
+ * @details Функция берёт первую фигуру из очереди queue, ставит её в
+ * начальном положении в стартовую позицию и дополняет очередь новой фигурой
+ * из набора (см. drawFigure). Если игра подключена к журналу, пишется
+ * событие EVENT_SPAWN
  * @param game_state Указатель на структуру TetrisInfo_t
  */
 void spawnFigure(TetrisInfo_t *game_state) {
-  for (int y = 0; y < 4; y++) {
-    for (int x = 0; x < 4; x++) {
-      game_state->figure.f[y][x] = game_state->game_info.next[y][x];
-    }
-  }
-  game_state->figure.width = game_state->next_figure.width;
-  game_state->figure.height = game_state->next_figure.height;
+  PROFILE_ENTER(PROFILE_SPAWN);
+  int type = game_state->queue[game_state->queue_head];
+  game_state->figure = *figureShape(type);
   game_state->figure.x = (WIDTH - game_state->figure.width) / 2 + 1;
   game_state->figure.y = 1;
-  initNextFigure(&game_state->game_info);
+  game_state->hash ^= figureHash(&game_state->figure);
+  game_state->queue_head = (game_state->queue_head + 1) % TETRIS_QUEUE_SIZE;
+  game_state->queue[(game_state->queue_head + TETRIS_PREVIEW - 1) %
+                    TETRIS_QUEUE_SIZE] = drawFigure(game_state);
+  unsigned long long bag_hash = bagHash(game_state);
+  game_state->hash ^= game_state->bag_hash ^ bag_hash;
+  game_state->bag_hash = bag_hash;
+  if (game_state->events != NULL) {
+    gameEvent(game_state->events, EVENT_SPAWN, type, 0, game_state->figure.x,
+              game_state->figure.y, 0, 0);
+  }
+  PROFILE_LEAVE();
 }
 
 /**
- * @brief Инициализирует следующую фигуру
- * @details Функция определяет фигуру, которая появится на поле следующей, и
- * заполняет матрицу next для предпросмотра в специальном окне. В случае если
- * все фигуры использованы, вызывается функция corrSpawn для нового определения
- * очерёдности
- * @param stats Указатель на структуру GameInfo_t
+ * @brief Заполняет очередь следующих фигур
+ * @details Очередь заполняется TETRIS_PREVIEW фигурами из набора, отложенной
+ * фигуры нет
+ * @param game_state Указатель на структуру TetrisInfo_t
  */
-void initNextFigure(GameInfo_t *stats) {
-  TetrisInfo_t *game_state = getTetrisInfo_t();
+void initQueue(TetrisInfo_t *game_state) {
+  game_state->queue_head = 0;
+  for (int i = 0; i < TETRIS_QUEUE_SIZE; i++) {
+    game_state->queue[i] = i < TETRIS_PREVIEW ? drawFigure(game_state) : 0;
+  }
+  game_state->hold = TETRIS_NO_HOLD;
+  game_state->hold_used = 0;
+  unsigned long long bag_hash = bagHash(game_state);
+  game_state->hash ^= game_state->bag_hash ^ bag_hash;
+  game_state->bag_hash = bag_hash;
+}
+
+/**
+ * @brief Выбирает следующую фигуру из набора
+ * @details Фигуры выдаются в порядке массива figures. В случае если все
+ * фигуры набора использованы, вызывается функция corrSpawn для нового
+ * определения очерёдности
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @return Номер фигуры
+ */
+int drawFigure(TetrisInfo_t *game_state) {
   if (game_state->curr_figure >= FIGURES_COUNT) {
-    corrSpawn(game_state->figures, FIGURES_COUNT);
+    corrSpawn(game_state->figures, FIGURES_COUNT, &game_state->seed);
     game_state->curr_figure = 0;
   }
-  int next_type = game_state->figures[game_state->curr_figure];
-  game_state->curr_figure++;
-  initFigure(&game_state->next_figure, next_type);
+  return game_state->figures[game_state->curr_figure++];
+}
+
+/**
+ * @brief Возвращает номер фигуры из очереди
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param index Позиция в очереди (0 - следующая фигура, не больше
+ * TETRIS_PREVIEW - 1)
+ * @return Номер фигуры
+ */
+int nextFigure(const TetrisInfo_t *game_state, int index) {
+  return game_state->queue[(game_state->queue_head + index) %
+                           TETRIS_QUEUE_SIZE];
+}
+
+/**
+ * @brief Заполняет матрицу следующей фигуры
+ * @details Функция заполняет матрицу next для предпросмотра следующей фигуры
+ * в специальном окне. Матрица заполняется не при появлении фигуры, а при
+ * запросе состояния игры (см. updateCurrentState)
+ * @param stats Указатель на структуру GameInfo_t
+ */
+void initNextFigure(GameInfo_t *stats) {
+  prepareNextFigure(getTetrisInfo_t(), stats);
+}
+
+/**
+ * @brief Заполняет матрицу следующей фигуры заданной игры
+ * @details Функция выполняет работу initNextFigure для любого экземпляра игры
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param stats Указатель на структуру GameInfo_t, матрица next которой
+ * заполняется
+ */
+void prepareNextFigure(TetrisInfo_t *game_state, GameInfo_t *stats) {
+  const Figure_t *shape = figureShape(nextFigure(game_state, 0));
   for (int y = 0; y < 4; y++) {
-    for (int x = 0; x < 4; x++) {
-      stats->next[y][x] = game_state->next_figure.f[y][x];
-    }
+    memcpy(stats->next[y], shape->f[y], 4 * sizeof(int));
   }
 }
 
@@ -193,6 +286,8 @@ void initNextFigure(GameInfo_t *stats) {
 void initFigure(Figure_t *figure, int type) {
   figure->width = 4;
   figure->height = 2;
+  figure->type = type;
+  figure->rotation = 0;
   switch (type) {
   case 0:
     lineFigure(figure);
@@ -236,16 +331,49 @@ void copyFigure(int src[4][4], int dst[4][4], int height, int width) {
   }
 }
 
+/**
+ * @brief Копирует в фигуру клетки начального положения фигуры заданного вида
+ * @details Копируются клетки в пределах ширины и высоты фигуры, как в
+ * функции copyFigure
+ * @param figure Указатель на инициализируемую структуру Figure_t
+ * @param type Номер фигуры
+ */
+void copyShape(Figure_t *figure, int type) {
+  const Figure_t *shape = figureShape(type);
+  for (int y = 0; y < figure->height; y++) {
+    for (int x = 0; x < figure->width; x++) {
+      figure->f[y][x] = shape->f[y][x];
+    }
+  }
+}
+
+/**
+ * @brief Возвращает фигуру заданного вида в начальном положении
+ * @details Постоянная таблица начальных положений всех фигур. По ней
+ * фигуры создаются при появлении на поле, а интерфейсы рисуют следующие и
+ * отложенную фигуры по их номерам без копирования матриц
+ * @param type Номер фигуры (от 0 до FIGURES_COUNT - 1)
+ * @return Указатель на фигуру из таблицы (координаты равны нулю)
+ */
+const Figure_t *figureShape(int type) {
+  static const Figure_t shapes[FIGURES_COUNT] = {
+      {.width = 4, .height = 2, .type = 0, .f = {{1, 1, 1, 1}}},
+      {.width = 4, .height = 2, .type = 1, .f = {{1, 1}, {1, 1}}},
+      {.width = 4, .height = 2, .type = 2, .f = {{1, 1}, {0, 1, 1}}},
+      {.width = 4, .height = 2, .type = 3, .f = {{0, 1, 1}, {1, 1}}},
+      {.width = 4, .height = 2, .type = 4, .f = {{0, 1}, {1, 1, 1}}},
+      {.width = 4, .height = 2, .type = 5, .f = {{1}, {1, 1, 1}}},
+      {.width = 4, .height = 2, .type = 6, .f = {{0, 0, 1}, {1, 1, 1}}}};
+  return &shapes[type >= 0 && type < FIGURES_COUNT ? type : 0];
+}
+
 /**
  * @brief Инициализирует фигуру "линия"
  * @details Эта функция инициализирует фигуру "линия". Готовая фигура копируется
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void lineFigure(Figure_t *figure) {
-  int f[4][4] = {{1, 1, 1, 1}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void lineFigure(Figure_t *figure) { copyShape(figure, 0); }
 
 /**
  * @brief Инициализирует фигуру "квадрат"
@@ -253,10 +381,7 @@ void lineFigure(Figure_t *figure) {
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void squareFigure(Figure_t *figure) {
-  int f[4][4] = {{1, 1, 0, 0}, {1, 1, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void squareFigure(Figure_t *figure) { copyShape(figure, 1); }
 
 /**
  * @brief Инициализирует фигуру "Z"
@@ -264,10 +389,7 @@ void squareFigure(Figure_t *figure) {
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void zFigure(Figure_t *figure) {
-  int f[4][4] = {{1, 1, 0, 0}, {0, 1, 1, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void zFigure(Figure_t *figure) { copyShape(figure, 2); }
 
 /**
  * @brief Инициализирует фигуру "S"
@@ -275,10 +397,7 @@ void zFigure(Figure_t *figure) {
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void sFigure(Figure_t *figure) {
-  int f[4][4] = {{0, 1, 1, 0}, {1, 1, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void sFigure(Figure_t *figure) { copyShape(figure, 3); }
 
 /**
  * @brief Инициализирует фигуру "T"
@@ -286,10 +405,7 @@ void sFigure(Figure_t *figure) {
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void tFigure(Figure_t *figure) {
-  int f[4][4] = {{0, 1, 0, 0}, {1, 1, 1, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void tFigure(Figure_t *figure) { copyShape(figure, 4); }
 
 /**
  * @brief Инициализирует фигуру "L"
@@ -297,10 +413,7 @@ void tFigure(Figure_t *figure) {
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void lFigure(Figure_t *figure) {
-  int f[4][4] = {{1, 0, 0, 0}, {1, 1, 1, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void lFigure(Figure_t *figure) { copyShape(figure, 5); }
 
 /**
  * @brief Инициализирует фигуру "J"
@@ -308,10 +421,7 @@ void lFigure(Figure_t *figure) {
  * в массив figure для отображения на поле
  * @param figure Указатель на инициализируемую структуру Figure_t
  */
-void jFigure(Figure_t *figure) {
-  int f[4][4] = {{0, 0, 1, 0}, {1, 1, 1, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
-  copyFigure(f, figure->f, figure->height, figure->width);
-}
+void jFigure(Figure_t *figure) { copyShape(figure, 6); }
 
 /**
  * @brief Возвращает информацию о текущем состоянии игры
@@ -325,6 +435,7 @@ void jFigure(Figure_t *figure) {
 GameInfo_t updateCurrentState() {
   TetrisInfo_t *game_state = getTetrisInfo_t();
   GameInfo_t *stats = &game_state->game_info;
+  prepareNextFigure(game_state, stats);
   return *stats;
 }
 
@@ -338,23 +449,21 @@ GameInfo_t updateCurrentState() {
  * информацию о текущем состоянии игры
  */
 void tetrisMechanics(TetrisInfo_t *game_state) {
+  PROFILE_ENTER(PROFILE_TETRIS_MECHANICS);
   if (game_state->game_info.score >= TETRIS_MAX_SCORE) {
     game_state->game_status = kWin;
   } else {
     continueOrNot(game_state->action, game_state);
   }
+  PROFILE_LEAVE();
 }
 
 /**
  * @brief Проверяет, необходимо ли продолжать игру
  * @details Если состояние action равно Terminate, то меняет статус игры на
- * "game over". Иначе, функция, используя функцию checkCollision (проверка на
- * столкновение), проверяет, можно ли сдвинуть фигуру вниз. Если фигура не может
- * быть сдвинута вниз, то функция updateField сохраняет упавшую фигуру и
- * обновляет игровое поле, функция removeLine проверяет, есть ли полные линии,
- * которые необходимо удалить, и затем вызывается функция spawnFigure для вызова
- * следующей фигуры. Если новая фигура не может быть сдвинута вниз (нет места на
- * поле), то статус игры меняется на "game over"
+ * "game over". Иначе, функция tetrisTick выполняет шаг фигуры вниз или
+ * фиксацию упавшей фигуры, если их время наступило. Текущее время читается
+ * только здесь, сам такт от часов не зависит
  * @param state Команда пользователя
  * @param game_state Указатель на структуру TetrisInfo_t, содержащую
  * информацию о текущем состоянии игры
@@ -363,23 +472,119 @@ void continueOrNot(UserAction_t state, TetrisInfo_t *game_state) {
   if (state == Terminate) {
     game_state->game_status = kGameOver;
   } else {
-    GameInfo_t *stats = &game_state->game_info;
-    Figure_t *figure = &game_state->figure;
-    long long curr_time = setTime();
-    if (curr_time - game_state->set_time >= stats->speed) {
-      game_state->set_time = curr_time;
-      if (!checkCollision(stats, figure, 0, 1)) {
-        figure->y++;
-      } else {
-        updateField(stats, figure, STATIC_CELL);
-        removeLine(game_state);
-        spawnFigure(game_state);
-        if (checkCollision(stats, figure, 0, 0)) {
-          game_state->game_status = kGameOver;
-        }
-      }
+    tetrisTick(game_state, setTime());
+  }
+}
+
+/**
+ * @brief Выполняет один шаг падения фигуры
+ * @details Если фигуру можно сдвинуть вниз, то она сдвигается на одну строку.
+ * Иначе фигура прикрепляется к полю, заполненные линии удаляются и появляется
+ * следующая фигура, для которой задержка фиксации начинается заново. Если
+ * новая фигура сталкивается с полем, то статус игры меняется на "game over".
+ * Функция не проверяет время и не обрабатывает команды, поэтому её вызывает
+ * как tetrisTick, так и планировщик, который шагает несколько игр за один
+ * такт (см. tetris_battle.h). Вызов считается шагом игры в журнале событий
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @return true, если фигура прикрепилась к полю, иначе false
+ */
+bool tetrisStep(TetrisInfo_t *game_state) {
+  GameInfo_t *stats = &game_state->game_info;
+  Figure_t *figure = &game_state->figure;
+  if (game_state->events != NULL) {
+    game_state->events->tick++;
+  }
+  bool is_locked = checkCollision(stats, figure, 0, 1);
+  if (!is_locked) {
+    shiftFigure(game_state, 0, 1);
+  } else {
+    PROFILE_ENTER(PROFILE_LOCK);
+    updateField(stats, figure, STATIC_CELL);
+    updateHeights(game_state, figure);
+    lockFigureHash(game_state, figure);
+    removeLine(game_state);
+    game_state->hold_used = 0;
+    spawnFigure(game_state);
+    game_state->lock_active = 0;
+    game_state->lock_resets = 0;
+    if (checkCollision(stats, figure, 0, 0)) {
+      game_state->game_status = kGameOver;
+    }
+    PROFILE_LEAVE();
+  }
+  return is_locked;
+}
+
+/**
+ * @brief Выполняет такт игры в момент now
+ * @details Если фигура может опуститься и с прошлого шага прошло
+ * gravityInterval миллисекунд, то фигура опускается на строку. Если фигура
+ * стоит на опоре, то она фиксируется: при нулевой задержке фиксации - на
+ * очередном шаге, как в классическом Тетрисе, иначе - когда наступит время
+ * lock_time. Отсчёт задержки начинается в том такте, в котором фигура
+ * впервые оказалась на опоре, а сдвиги и повороты откладывают фиксацию (см.
+ * resetLockDelay). Время передаётся параметром, поэтому такт можно выполнить
+ * для любого момента, например для времени события ввода
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param now Время такта в миллисекундах
+ */
+void tetrisTick(TetrisInfo_t *game_state, long long now) {
+  PROFILE_ENTER(PROFILE_GRAVITY);
+  GameInfo_t *stats = &game_state->game_info;
+  Figure_t *figure = &game_state->figure;
+  if (game_state->game_status == kStart) {
+    bool is_due = now - game_state->set_time >= gravityInterval(game_state);
+    bool is_step = is_due;
+    if (checkCollision(stats, figure, 0, 1) && game_state->lock_delay > 0) {
+      is_step = game_state->lock_active && now >= game_state->lock_time;
+    }
+    if (is_step) {
+      game_state->set_time = now;
+      tetrisStep(game_state);
+    }
+  }
+  if (game_state->game_status != kStart ||
+      !checkCollision(stats, figure, 0, 1)) {
+    game_state->lock_active = 0;
+  } else if (!game_state->lock_active) {
+    game_state->lock_active = 1;
+    game_state->lock_time = now + game_state->lock_delay;
+  }
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Возвращает интервал между шагами фигуры
+ * @details Пока зажата клавиша мягкого падения, фигура падает в
+ * TETRIS_SOFT_DROP_FACTOR раз быстрее, но не чаще раза в миллисекунду
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @return Интервал в миллисекундах
+ */
+int gravityInterval(const TetrisInfo_t *game_state) {
+  int interval = game_state->game_info.speed;
+  if (game_state->soft_drop) {
+    interval /= TETRIS_SOFT_DROP_FACTOR;
+    if (interval < 1) {
+      interval = 1;
     }
   }
+  return interval;
+}
+
+/**
+ * @brief Откладывает фиксацию фигуры после сдвига или поворота
+ * @details Если фигура стоит на опоре, то отсчёт задержки фиксации
+ * начинается заново от момента now. Одна фигура может отложить фиксацию не
+ * больше lock_limit раз, поэтому бесконечно удерживать её сдвигами нельзя
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param now Время сдвига или поворота в миллисекундах
+ */
+void resetLockDelay(TetrisInfo_t *game_state, long long now) {
+  if (game_state->lock_active &&
+      game_state->lock_resets < game_state->lock_limit) {
+    game_state->lock_time = now + game_state->lock_delay;
+    game_state->lock_resets++;
+  }
 }
 
 /**
@@ -444,18 +649,262 @@ bool checkCollision(GameInfo_t *stats, Figure_t *figure, int offset_x,
 }
 
 /**
- * @brief Функция, которая получает команду от пользователя
- * @details Функция получает команду от пользователя, используя функцию
- * getch. Затем при помощи функции setUserAction определяется, какая команда
- * была получена и присваивается значение структуре UserAction_t. Далее функция
- * вызывается userInput, чтобы обработать полученную команду
+ * @brief Инициализирует высоты столбцов поля
+ * @details Для каждого столбца находит самую верхнюю статичную клетку и
+ * сохраняет номер её строки в массив heights. Для пустого столбца сохраняется
+ * HEIGHT + 1 (строка под нижней границей поля). Функция сканирует поле целиком,
+ * поэтому используется только при создании игры или после изменения поля в
+ * обход механики игры
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void initHeights(TetrisInfo_t *game_state) {
+  for (int x = 0; x <= WIDTH + 1; x++) {
+    game_state->heights[x] = 1;
+  }
+  recountHeights(game_state);
+}
+
+/**
+ * @brief Обновляет высоты столбцов после прикрепления фигуры
+ * @details Для каждой клетки фигуры, попавшей в поле, поднимает поверхность
+ * соответствующего столбца до строки этой клетки. Стоимость пропорциональна
+ * количеству клеток фигуры, а не размеру поля
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param figure Указатель на прикреплённую фигуру
+ */
+void updateHeights(TetrisInfo_t *game_state, Figure_t *figure) {
+  for (int y = 0; y < figure->height; y++) {
+    for (int x = 0; x < figure->width; x++) {
+      int cell_x = figure->x + x;
+      int cell_y = figure->y + y;
+      if (figure->f[y][x] == MOVING_CELL && cell_x >= 1 && cell_x <= WIDTH &&
+          cell_y >= 1 && cell_y <= HEIGHT &&
+          cell_y < game_state->heights[cell_x]) {
+        game_state->heights[cell_x] = cell_y;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Пересчитывает высоты столбцов после удаления линий
+ * @details После удаления линий поверхность столбца может только опуститься,
+ * поэтому поиск верхней статичной клетки начинается с прежней высоты столбца.
+ * Стоимость пропорциональна количеству строк, на которое опустилась
+ * поверхность
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void recountHeights(TetrisInfo_t *game_state) {
+  int **field = game_state->game_info.field;
+  for (int x = 1; x <= WIDTH; x++) {
+    int y = game_state->heights[x] < 1 ? 1 : game_state->heights[x];
+    while (y <= HEIGHT && field[y][x] != STATIC_CELL) {
+      y++;
+    }
+    game_state->heights[x] = y;
+  }
+  game_state->heights[0] = HEIGHT + 1;
+  game_state->heights[WIDTH + 1] = HEIGHT + 1;
+}
+
+/**
+ * @brief Вычисляет расстояние, на которое может упасть фигура
+ * @details Для каждого столбца фигуры берётся её нижняя клетка (нижний
+ * профиль фигуры) и сравнивается с высотой столбца поля. Расстояние падения -
+ * минимальный зазор между профилем и поверхностью. Если фигура находится под
+ * нависающими клетками (ниже поверхности столбца) или частично за пределами
+ * поля, то расстояние определяется пошаговой проверкой столкновений
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param figure Указатель на фигуру
+ * @return Количество строк, на которое фигура может опуститься без
+ * столкновения
+ */
+int dropDistance(TetrisInfo_t *game_state, Figure_t *figure) {
+  int distance = HEIGHT + 1;
+  bool use_heights = true;
+  for (int x = 0; x < figure->width && use_heights; x++) {
+    int bottom = -1;
+    for (int y = 0; y < figure->height; y++) {
+      if (figure->f[y][x] == MOVING_CELL) {
+        if (figure->y + y < 0) {
+          use_heights = false;
+        }
+        bottom = y;
+      }
+    }
+    if (bottom >= 0 && use_heights) {
+      int cell_x = figure->x + x;
+      int cell_y = figure->y + bottom;
+      if (cell_x < 1 || cell_x > WIDTH ||
+          cell_y >= game_state->heights[cell_x]) {
+        use_heights = false;
+      } else if (game_state->heights[cell_x] - 1 - cell_y < distance) {
+        distance = game_state->heights[cell_x] - 1 - cell_y;
+      }
+    }
+  }
+  if (!use_heights) {
+    distance = 0;
+    while (!checkCollision(&game_state->game_info, figure, 0, distance + 1)) {
+      distance++;
+    }
+  }
+  return distance;
+}
+
+/**
+ * @brief Строит "призрак" текущей фигуры
+ * @details Копирует текущую фигуру и опускает копию на расстояние, которое
+ * вычисляет функция dropDistance. Призрак показывает, где окажется фигура
+ * после мгновенного падения
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param ghost Указатель на структуру Figure_t, в которую записывается призрак
+ */
+void getGhostFigure(TetrisInfo_t *game_state, Figure_t *ghost) {
+  *ghost = game_state->figure;
+  ghost->y += dropDistance(game_state, ghost);
+}
+
+/**
+ * @brief Пересчитывает хеш Зобриста состояния игры
+ * @details Хеш состояния складывается (XOR) из хеша статичных клеток поля,
+ * хеша текущей фигуры (форма и положение) и хеша очерёдности фигур. Во время
+ * игры хеш обновляется по мере изменения этих частей, а функция вычисляет его
+ * заново целиком и используется при создании игры, после изменения поля в
+ * обход механики игры и для проверки. Состояние генератора случайных чисел и
+ * статистика игры в хеш не входят
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void tetrisRehash(TetrisInfo_t *game_state) {
+  game_state->field_hash = fieldHash(&game_state->game_info, 1);
+  game_state->bag_hash = bagHash(game_state);
+  game_state->hash = game_state->field_hash ^ game_state->bag_hash ^
+                     figureHash(&game_state->figure);
+}
+
+/**
+ * @brief Вычисляет хеш статичных клеток поля
+ * @param stats Указатель на структуру GameInfo_t, содержащую поле
+ * @param from_y Первая строка, с которой начинается подсчёт (строки выше неё
+ * считаются пустыми)
+ * @return XOR ключей всех статичных клеток в строках от from_y до HEIGHT
+ */
+unsigned long long fieldHash(GameInfo_t *stats, int from_y) {
+  unsigned long long hash = 0;
+  for (int y = from_y < 1 ? 1 : from_y; y <= HEIGHT; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      if (stats->field[y][x] == STATIC_CELL) {
+        hash ^= zobristKey(ZOBRIST_STATIC, x, y);
+      }
+    }
+  }
+  return hash;
+}
+
+/**
+ * @brief Вычисляет хеш фигуры
+ * @details Хеш фигуры складывается из ключа её формы (матрица фигуры и её
+ * размеры, т.е. вид фигуры вместе с поворотом) и ключа её положения на поле.
+ * При сдвиге фигуры меняется только ключ положения
+ * @param figure Указатель на фигуру
+ * @return Хеш фигуры
+ */
+unsigned long long figureHash(Figure_t *figure) {
+  int shape = 0;
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      if (figure->f[y][x] == MOVING_CELL) {
+        shape |= 1 << (y * 4 + x);
+      }
+    }
+  }
+  return zobristKey(ZOBRIST_SHAPE, shape,
+                    figure->width * 4 + figure->height) ^
+         zobristKey(ZOBRIST_POSITION, figure->x, figure->y);
+}
+
+/**
+ * @brief Вычисляет хеш очерёдности фигур
+ * @details Учитываются ещё не выданные фигуры текущего набора, позиция в
+ * наборе, фигуры очереди queue (по их месту в очереди) и отложенная фигура
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @return Хеш очерёдности фигур
+ */
+unsigned long long bagHash(TetrisInfo_t *game_state) {
+  unsigned long long hash =
+      zobristKey(ZOBRIST_BAG_POSITION, game_state->curr_figure, 0) ^
+      zobristKey(ZOBRIST_HOLD, game_state->hold + 1, game_state->hold_used);
+  for (int i = game_state->curr_figure; i < FIGURES_COUNT; i++) {
+    hash ^= zobristKey(ZOBRIST_BAG, i, game_state->figures[i]);
+  }
+  for (int i = 0; i < TETRIS_PREVIEW; i++) {
+    hash ^= zobristKey(ZOBRIST_QUEUE, i, nextFigure(game_state, i));
+  }
+  return hash;
+}
+
+/**
+ * @brief Обновляет хеш после прикрепления фигуры к полю
+ * @details Убирает из хеша текущую фигуру и добавляет в хеш поля её клетки,
+ * ставшие статичными
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param figure Указатель на прикреплённую фигуру
+ */
+void lockFigureHash(TetrisInfo_t *game_state, Figure_t *figure) {
+  unsigned long long cells_hash = 0;
+  for (int y = 0; y < figure->height; y++) {
+    for (int x = 0; x < figure->width; x++) {
+      int cell_x = figure->x + x;
+      int cell_y = figure->y + y;
+      if (figure->f[y][x] == MOVING_CELL && cell_x >= 1 && cell_x <= WIDTH &&
+          cell_y >= 1 && cell_y <= HEIGHT) {
+        cells_hash ^= zobristKey(ZOBRIST_STATIC, cell_x, cell_y);
+      }
+    }
+  }
+  game_state->field_hash ^= cells_hash;
+  game_state->hash ^= cells_hash ^ figureHash(figure);
+}
+
+/**
+ * @brief Сдвигает текущую фигуру
+ * @details Изменяет координаты текущей фигуры и заменяет в хеше ключ её
+ * прежнего положения ключом нового. Проверка столкновений не выполняется
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param offset_x Смещение по оси X
+ * @param offset_y Смещение по оси Y
+ */
+void shiftFigure(TetrisInfo_t *game_state, int offset_x, int offset_y) {
+  Figure_t *figure = &game_state->figure;
+  game_state->hash ^= zobristKey(ZOBRIST_POSITION, figure->x, figure->y);
+  figure->x += offset_x;
+  figure->y += offset_y;
+  game_state->hash ^= zobristKey(ZOBRIST_POSITION, figure->x, figure->y);
+}
+
+/**
+ * @brief Функция, которая получает команды от пользователя
+ * @details Функция читает функцией getch нажатые клавиши, пока они есть.
+ * Ожиданием клавиш управляет планировщик кадров фронтенда (см. frame_loop.h):
+ * он ждёт клавишу не дольше конца кадра и оставляет timeout нулевым, поэтому
+ * функция timeout не меняет. Каждая клавиша превращается в команду функцией
+ * setUserAction и кладётся в очередь ввода игры вместе со временем нажатия.
+ * ncurses не сообщает об отпускании клавиш, поэтому за каждым нажатием сразу
+ * следует отпускание, и автоповтор сдвига в консоли задаёт терминал. Затем
+ * функция tetrisDrainInput применяет все команды из очереди
  */
 void getUserInput() {
   TetrisInfo_t *game_state = getTetrisInfo_t();
   int key = getch();
-  bool hold = false;
-  setUserAction(key, &game_state->action);
-  userInput(game_state->action, hold);
+  while (key != ERR) {
+    UserAction_t action = Up;
+    long long now = setTime();
+    setUserAction(key, &action);
+    pushInput(&game_state->input, action, true, now);
+    pushInput(&game_state->input, action, false, now);
+    key = getch();
+  }
+  tetrisDrainInput(game_state, setTime());
 }
 
 /**
@@ -465,9 +914,11 @@ void getUserInput() {
  * начата. Если пользователь нажал пробел или вверх, то фигура будет повернута.
  * Если пользователь нажал влево, то фигура будет сдвинута влево. Если
  * пользователь нажал вправо, то фигура будет сдвинута вправо. Если пользователь
- * нажал вниз, то фигура будет сдвинута вниз. Если пользователь нажал 'p' или
- * 'P', то игра будет приостановлена. Если пользователь нажал 'q', 'Q', или
- * ESCAPE, то игра будет остановлена.
+ * нажал вниз, то фигура будет сдвинута вниз на одну строку. Если пользователь
+ * нажал 'x' или 'X', то фигура мгновенно упадёт и зафиксируется. Если
+ * пользователь нажал 'c' или 'C', то фигура будет отложена. Если
+ * пользователь нажал 'p' или 'P', то игра будет приостановлена. Если
+ * пользователь нажал 'q', 'Q', или ESCAPE, то игра будет остановлена.
  * @param key Команда, полученная от пользователя
  * @param state Структура, которая хранит команду, полученную от пользователя
  */
@@ -489,6 +940,14 @@ void setUserAction(int key, UserAction_t *state) {
   case KEY_DOWN:
     *state = Down;
     break;
+  case 'x':
+  case 'X':
+    *state = HardDrop;
+    break;
+  case 'c':
+  case 'C':
+    *state = Hold;
+    break;
   case 'p':
   case 'P':
     *state = Pause;
@@ -520,28 +979,225 @@ void userInput(UserAction_t action, bool hold) {
   if (hold) {
     hold = false;
   }
-  TetrisInfo_t *game_state = getTetrisInfo_t();
-  GameInfo_t stats = updateCurrentState();
+  tetrisUserInput(getTetrisInfo_t(), action);
+}
+
+/**
+ * @brief Применяет все команды из очереди ввода игры
+ * @details События применяются в порядке поступления функцией
+ * tetrisKeyEvent. Перед каждым событием выполняются повторы сдвига, время
+ * которых наступило раньше события, и такт tetrisTick в момент события.
+ * Поэтому команда применяется к тому положению
+ * фигуры, которое игрок видел в момент нажатия. После очереди выполняются
+ * повторы сдвига до момента now. В game_state->action остаётся последняя
+ * нажатая команда (Up, если нажатий не было). После команды Terminate
+ * очередь больше не читается
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param now Текущее время в миллисекундах
+ */
+void tetrisDrainInput(TetrisInfo_t *game_state, long long now) {
+  PROFILE_ENTER(PROFILE_INPUT_DRAIN);
+  GameInfo_t *stats = &game_state->game_info;
+  InputEvent_t event;
+  game_state->action = Up;
+  while (game_state->action != Terminate &&
+         game_state->game_status == kStart &&
+         popInput(&game_state->input, &event)) {
+    tetrisAutoShift(game_state, event.time);
+    if (!stats->pause && stats->score < TETRIS_MAX_SCORE) {
+      tetrisTick(game_state, event.time);
+    }
+    if (game_state->game_status == kStart) {
+      if (event.pressed) {
+        game_state->action = event.action;
+      }
+      tetrisKeyEvent(game_state, &event);
+    }
+  }
+  tetrisAutoShift(game_state, now);
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Применяет событие ввода
+ * @details Нажатие клавиши сдвига сразу сдвигает фигуру и запускает
+ * автоповтор в этом направлении через das_delay миллисекунд. Повторные
+ * нажатия уже зажатой клавиши (автоповтор клавиатуры) игнорируются, поэтому
+ * скорость сдвига не зависит от настроек системы. Отпускание клавиши
+ * автоповтора останавливает его, а если зажата клавиша другого направления,
+ * то автоповтор переходит к ней с новой задержкой. Нажатие клавиши Down
+ * опускает фигуру на строку и включает мягкое падение до отпускания клавиши,
+ * повторные нажатия зажатой клавиши Down также игнорируются. Нажатия
+ * остальных клавиш передаются функции tetrisMove, пауза сбрасывает зажатые
+ * клавиши сдвига и мягкого падения
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param event Указатель на событие ввода
+ */
+void tetrisKeyEvent(TetrisInfo_t *game_state, const InputEvent_t *event) {
+  int key = 0;
+  if (event->action == Left) {
+    key = TETRIS_SHIFT_LEFT;
+  } else if (event->action == Right) {
+    key = TETRIS_SHIFT_RIGHT;
+  }
+  if (key == 0) {
+    if (!event->pressed) {
+      if (event->action == Down) {
+        game_state->soft_drop = 0;
+      }
+    } else if (event->action != Down || !game_state->soft_drop) {
+      if (event->action == Pause) {
+        game_state->shift_held = 0;
+        game_state->shift_action = Up;
+        game_state->soft_drop = 0;
+      } else if (event->action == Down) {
+        game_state->soft_drop = !game_state->game_info.pause;
+      }
+      tetrisMove(game_state, event->action, event->time);
+    }
+  } else if (event->pressed) {
+    if (!(game_state->shift_held & key)) {
+      game_state->shift_held |= key;
+      game_state->shift_action = event->action;
+      game_state->shift_time = event->time + game_state->das_delay;
+      tetrisMove(game_state, event->action, event->time);
+    }
+  } else {
+    game_state->shift_held &= ~key;
+    if (game_state->shift_action == event->action) {
+      game_state->shift_action = Up;
+      if (game_state->shift_held != 0) {
+        game_state->shift_action =
+            game_state->shift_held & TETRIS_SHIFT_LEFT ? Left : Right;
+        game_state->shift_time = event->time + game_state->das_delay;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Выполняет повторы сдвига фигуры
+ * @details Сдвигает фигуру в направлении автоповтора столько раз, сколько
+ * повторов должно было произойти к моменту now: каждый повтор имеет своё
+ * время, поэтому число сдвигов не зависит от частоты кадров. При нулевом
+ * интервале фигура сдвигается до упора. Если фигура упёрлась, то следующий
+ * повтор переносится на arr_interval после now, чтобы после появления новой
+ * фигуры повторы не выполнились все сразу. Во время паузы повторов нет
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param now Время в миллисекундах
+ */
+void tetrisAutoShift(TetrisInfo_t *game_state, long long now) {
+  bool is_blocked = false;
+  while (game_state->shift_action != Up && !is_blocked &&
+         !game_state->game_info.pause && game_state->game_status == kStart &&
+         game_state->shift_time <= now) {
+    is_blocked = !tetrisMove(game_state, game_state->shift_action,
+                             game_state->shift_time);
+    game_state->shift_time += game_state->arr_interval;
+    if (is_blocked) {
+      game_state->shift_time = now + game_state->arr_interval;
+    }
+  }
+}
+
+/**
+ * @brief Выполняет команду игрока в момент time
+ * @details Команда выполняется функцией tetrisUserInput. Если команда
+ * сдвинула или повернула фигуру, то фиксация фигуры откладывается функцией
+ * resetLockDelay
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param action Команда игрока
+ * @param time Время команды в миллисекундах
+ * @return true, если фигура сдвинулась или повернулась, иначе false
+ */
+bool tetrisMove(TetrisInfo_t *game_state, UserAction_t action, long long time) {
+  Figure_t figure = game_state->figure;
+  tetrisUserInput(game_state, action);
+  bool is_moved = memcmp(&figure, &game_state->figure, sizeof(figure)) != 0;
+  if (is_moved && (action == Left || action == Right || action == Action)) {
+    resetLockDelay(game_state, time);
+  }
+  return is_moved;
+}
+
+/**
+ * @brief Задаёт параметры автоповтора сдвига
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param delay Задержка перед первым повтором в миллисекундах
+ * @param interval Интервал между повторами в миллисекундах (0 - сдвиг до
+ * упора)
+ */
+void setAutoShift(TetrisInfo_t *game_state, int delay, int interval) {
+  game_state->das_delay = delay > 0 ? delay : 0;
+  game_state->arr_interval = interval > 0 ? interval : 0;
+  game_state->shift_held = 0;
+  game_state->shift_action = Up;
+  game_state->shift_time = 0;
+}
+
+/**
+ * @brief Задаёт параметры фиксации фигуры
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param delay Задержка фиксации фигуры на опоре в миллисекундах (0 -
+ * фиксация на ближайшем шаге)
+ * @param resets Сколько раз одна фигура может отложить фиксацию
+ */
+void setLockDelay(TetrisInfo_t *game_state, int delay, int resets) {
+  game_state->lock_delay = delay > 0 ? delay : 0;
+  game_state->lock_limit = resets > 0 ? resets : 0;
+  game_state->lock_resets = 0;
+  game_state->lock_active = 0;
+  game_state->lock_time = 0;
+  game_state->soft_drop = 0;
+}
+
+/**
+ * @brief Обработка ввода пользователя в заданной игре
+ * @details Функция выполняет работу userInput для любого экземпляра игры
+ * (например, для сессии игрового сервера). Команда Down опускает фигуру на
+ * одну строку, команда HardDrop опускает её до упора и сразу фиксирует,
+ * команда Hold откладывает фигуру (см. holdFigure). После окончания игры
+ * команды не выполняются: иначе HardDrop и Hold продолжали бы фиксировать и
+ * выдавать фигуры на законченном поле
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param action Обрабатываемая команда
+ */
+void tetrisUserInput(TetrisInfo_t *game_state, UserAction_t action) {
+  GameInfo_t *stats = &game_state->game_info;
+  if (game_state->game_status != kStart) {
+    action = Up;
+  }
   switch (action) {
   case Action:
     rotateFigure(game_state);
     break;
   case Pause:
-    stats.pause = !stats.pause;
+    stats->pause = !stats->pause;
     break;
   case Left:
-    if (!stats.pause) {
+    if (!stats->pause) {
       moveLeft(game_state);
     }
     break;
   case Right:
-    if (!stats.pause) {
+    if (!stats->pause) {
       moveRight(game_state);
     }
     break;
   case Down:
-    if (!stats.pause) {
-      moveDown(game_state);
+    if (!stats->pause &&
+        !checkCollision(stats, &game_state->figure, 0, 1)) {
+      shiftFigure(game_state, 0, 1);
+    }
+    break;
+  case HardDrop:
+    if (!stats->pause) {
+      hardDrop(game_state);
+    }
+    break;
+  case Hold:
+    if (!stats->pause) {
+      holdFigure(game_state);
     }
     break;
   case Start:
@@ -550,33 +1206,109 @@ void userInput(UserAction_t action, bool hold) {
   default:
     break;
   }
-  game_state->game_info = stats;
 }
 
 /**
  * @brief Функция, поворачивающая фигуру
- * @details Функция поворачивает фигуру на 90 градусов, путём перестановки
- * элементов фигуры в обратном порядке. Если после поворота фигура не поместится
- * на поле, то она останется на прежнем месте
+ * @details Функция поворачивает фигуру на 90 градусов по часовой стрелке по
+ * правилам Super Rotation System. Повёрнутую матрицу строит функция
+ * turnFigure, а функция srsOffset по очереди выдаёт смещения из таблиц SRS:
+ * первое ставит фигуру так, как она стоит в SRS после поворота, остальные
+ * дополнительно отталкивают её от стенок и упавших фигур. Фигура занимает
+ * первое положение без столкновения, а если такого нет, то остаётся на
+ * прежнем месте
  * @param game_state Информация о состоянии игры
  */
 void rotateFigure(TetrisInfo_t *game_state) {
   Figure_t *figure = &game_state->figure;
-  Figure_t temp_figure = *figure;
+  Figure_t temp_figure;
+  turnFigure(figure, &temp_figure);
+  bool is_rotated = false;
+  int offset_x = 0;
+  int offset_y = 0;
+  for (int kick = 0; !is_rotated && srsOffset(figure->type, figure->rotation,
+                                              kick, &offset_x, &offset_y);
+       kick++) {
+    if (!checkCollision(&game_state->game_info, &temp_figure, offset_x,
+                        offset_y)) {
+      temp_figure.x += offset_x;
+      temp_figure.y += offset_y;
+      game_state->hash ^= figureHash(figure) ^ figureHash(&temp_figure);
+      *figure = temp_figure;
+      is_rotated = true;
+    }
+  }
+}
+
+/**
+ * @brief Строит повёрнутую копию фигуры
+ * @details Поворачивает матрицу фигуры на 90 градусов путём перестановки
+ * элементов в обратном порядке, меняет местами ширину и высоту и
+ * увеличивает номер поворота. Положение фигуры не меняется, столкновения не
+ * проверяются
+ * @param figure Указатель на исходную фигуру
+ * @param turned Указатель на структуру, в которую записывается повёрнутая
+ * фигура
+ */
+void turnFigure(const Figure_t *figure, Figure_t *turned) {
   int temp_matrix[4][4] = {0};
-  int new_width = figure->height;
-  int new_height = figure->width;
   for (int y = 0; y < figure->height; y++) {
     for (int x = 0; x < figure->width; x++) {
       temp_matrix[x][figure->height - 1 - y] = figure->f[y][x];
     }
   }
-  temp_figure.width = new_width;
-  temp_figure.height = new_height;
-  memcpy(temp_figure.f, temp_matrix, sizeof(temp_matrix));
-  if (!checkCollision(&game_state->game_info, &temp_figure, 0, 0)) {
-    *figure = temp_figure;
+  *turned = *figure;
+  turned->width = figure->height;
+  turned->height = figure->width;
+  turned->rotation = (figure->rotation + 1) % 4;
+  memcpy(turned->f, temp_matrix, sizeof(temp_matrix));
+}
+
+/**
+ * @brief Возвращает смещение фигуры при повороте по правилам SRS
+ * @details Матрица, которую строит turnFigure, поворачивается вокруг своего
+ * левого верхнего угла, а в SRS фигура поворачивается внутри неподвижной
+ * рамки 3x3 (4x4 для линии). Таблица turn хранит сдвиг, который возвращает
+ * повёрнутую матрицу в рамку SRS, таблицы jlstz и line - пять проверок
+ * отталкивания (wall kicks) SRS для каждого поворота по часовой стрелке
+ * (ось y направлена вниз, как на поле). Квадрат в SRS не отталкивается,
+ * поэтому для него есть только первая проверка. Таблицы постоянные и не
+ * требуют выделения памяти
+ * @param type Номер фигуры
+ * @param rotation Номер поворота фигуры до поворота
+ * @param kick Номер проверки (от 0 до SRS_KICKS - 1)
+ * @param offset_x Указатель на смещение по горизонтали
+ * @param offset_y Указатель на смещение по вертикали
+ * @return true, если проверка с таким номером есть, иначе false
+ */
+bool srsOffset(int type, int rotation, int kick, int *offset_x,
+               int *offset_y) {
+  static const int turn[FIGURES_COUNT][4][2] = {
+      {{1, -1}, {-1, 1}, {1, -1}, {-1, 1}}, {{0, 0}, {-2, 0}, {2, -2}, {0, 2}},
+      {{1, 0}, {-2, 1}, {1, -2}, {0, 1}},   {{1, 0}, {-2, 1}, {1, -2}, {0, 1}},
+      {{1, 0}, {-2, 1}, {1, -2}, {0, 1}},   {{1, 0}, {-2, 1}, {1, -2}, {0, 1}},
+      {{1, 0}, {-2, 1}, {1, -2}, {0, 1}}};
+  static const int jlstz[4][SRS_KICKS][2] = {
+      {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}},
+      {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}},
+      {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}},
+      {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}};
+  static const int line[4][SRS_KICKS][2] = {
+      {{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}},
+      {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}},
+      {{0, 0}, {2, 0}, {-1, 0}, {2, -1}, {-1, 2}},
+      {{0, 0}, {1, 0}, {-2, 0}, {1, 2}, {-2, -1}}};
+  bool is_known = type >= 0 && type < FIGURES_COUNT;
+  int kicks = is_known && type != 1 ? SRS_KICKS : 1;
+  bool is_kick = kick >= 0 && kick < kicks;
+  if (is_kick) {
+    rotation &= 3;
+    const int *shift = is_known ? turn[type][rotation] : jlstz[0][0];
+    const int *wall = type == 0 ? line[rotation][kick] : jlstz[rotation][kick];
+    *offset_x = shift[0] + wall[0];
+    *offset_y = shift[1] + wall[1];
   }
+  return is_kick;
 }
 
 /**
@@ -591,7 +1323,7 @@ void moveLeft(TetrisInfo_t *game_state) {
   GameInfo_t *stats = &game_state->game_info;
   Figure_t *figure = &game_state->figure;
   if (!checkCollision(stats, figure, -1, 0)) {
-    figure->x--;
+    shiftFigure(game_state, -1, 0);
   }
 }
 
@@ -607,73 +1339,167 @@ void moveRight(TetrisInfo_t *game_state) {
   GameInfo_t *stats = &game_state->game_info;
   Figure_t *figure = &game_state->figure;
   if (!checkCollision(stats, figure, 1, 0)) {
-    figure->x++;
+    shiftFigure(game_state, 1, 0);
   }
 }
 
 /**
  * @brief Мгновенное падение фигуры
- * @details Функция перемещает фигуру вниз до ближайшей нижней границы, если это
- * возможно, т.е. до тех пор, пока не возникнет столкновение с нижней границей
- * поля или с уже упавшими фигурами. Функция увеличивает Y-координату фигуры на
- * величину смещения
+ * @details Функция перемещает фигуру вниз до ближайшей нижней границы, т.е. до
+ * столкновения с нижней границей поля или с уже упавшими фигурами. Расстояние
+ * падения вычисляется функцией dropDistance по высотам столбцов, без пошаговой
+ * проверки каждой строки
  * @param game_state Информация о состоянии игры
  */
 void moveDown(TetrisInfo_t *game_state) {
-  GameInfo_t *stats = &game_state->game_info;
   Figure_t *figure = &game_state->figure;
-  while (!checkCollision(stats, figure, 0, 1)) {
-    figure->y++;
+  shiftFigure(game_state, 0, dropDistance(game_state, figure));
+}
+
+/**
+ * @brief Мгновенно опускает фигуру и фиксирует её
+ * @details Фигура опускается функцией moveDown и сразу прикрепляется к полю
+ * функцией tetrisStep без задержки фиксации
+ * @param game_state Информация о состоянии игры
+ */
+void hardDrop(TetrisInfo_t *game_state) {
+  moveDown(game_state);
+  tetrisStep(game_state);
+}
+
+/**
+ * @brief Откладывает текущую фигуру
+ * @details Если отложенной фигуры нет, то текущая фигура откладывается, а
+ * на поле появляется следующая фигура из очереди. Иначе текущая и отложенная
+ * фигуры меняются местами, и отложенная фигура появляется в начальном
+ * положении в стартовой позиции. Откладывать фигуру можно один раз, пока она
+ * не прикрепится к полю. Если появившаяся фигура сталкивается с полем, то
+ * статус игры меняется на "game over"
+ * @param game_state Информация о состоянии игры
+ */
+void holdFigure(TetrisInfo_t *game_state) {
+  if (!game_state->hold_used) {
+    Figure_t *figure = &game_state->figure;
+    int type = figure->type;
+    game_state->hash ^= figureHash(figure);
+    if (game_state->hold == TETRIS_NO_HOLD) {
+      spawnFigure(game_state);
+    } else {
+      *figure = *figureShape(game_state->hold);
+      figure->x = (WIDTH - figure->width) / 2 + 1;
+      figure->y = 1;
+      game_state->hash ^= figureHash(figure);
+    }
+    game_state->hold = type;
+    game_state->hold_used = 1;
+    unsigned long long bag_hash = bagHash(game_state);
+    game_state->hash ^= game_state->bag_hash ^ bag_hash;
+    game_state->bag_hash = bag_hash;
+    game_state->lock_active = 0;
+    game_state->lock_resets = 0;
+    if (checkCollision(&game_state->game_info, figure, 0, 0)) {
+      game_state->game_status = kGameOver;
+    }
   }
 }
 
 /**
  * @brief Удаляет заполненные линии
- * @details Функция проходит по игровому полю и проверяет, присутствуют ли
- * заполненные линии и удаляет их, если они присутствуют. Незаполненные линии
- * смещаются вниз на количество очищенных линий. Если линии удалены, то функция
- * обновляет статистику игры, вызывая функцию updateScore
+ * @details Функция удаляет все заполненные линии за один проход по полю с
+ * помощью функции compactField. Незаполненные линии смещаются вниз на
+ * количество очищенных под ними линий. Если линии удалены, то функция
+ * пересчитывает высоты столбцов, хеш строк от вершины "стакана" до дна поля
+ * (строки выше пусты) и обновляет статистику игры, вызывая функцию
+ * updateScore. Количество удалённых линий сохраняется в last_cleared, по нему
+ * режим сражения определяет, сколько мусорных линий получит соперник.
+ * Функция вызывается сразу после фиксации фигуры, поэтому, если игра
+ * подключена к журналу, пишется событие EVENT_LOCK с положением
+ * зафиксированной фигуры, количеством линий и изменением счёта
  * @param game_state Информация о состоянии игры
  */
 void removeLine(TetrisInfo_t *game_state) {
+  PROFILE_ENTER(PROFILE_LINE_CLEAR);
   GameInfo_t *stats = &game_state->game_info;
-  int how_much = 0;
-  for (int y = HEIGHT; y > 0; y--) {
-    if (checkLine(stats, y)) {
-      how_much++;
-      for (int i = y; i > 1; i--) {
-        for (int x = 1; x <= WIDTH; x++) {
-          stats->field[i][x] = stats->field[i - 1][x];
-        }
-      }
-      for (int x = 1; x <= WIDTH; x++) {
-        stats->field[1][x] = EMPTY_CELL;
+  int score = stats->score;
+  int how_much = compactField(stats->field, HEIGHT, WIDTH);
+  game_state->last_cleared = how_much;
+  if (how_much > 0) {
+    recountHeights(game_state);
+    int top = HEIGHT + 1;
+    for (int x = 1; x <= WIDTH; x++) {
+      if (game_state->heights[x] < top) {
+        top = game_state->heights[x];
       }
-      y++;
     }
-  }
-  if (how_much > 0) {
+    unsigned long long field_hash = fieldHash(stats, top);
+    game_state->hash ^= game_state->field_hash ^ field_hash;
+    game_state->field_hash = field_hash;
     updateScore(stats, how_much);
   }
+  if (game_state->events != NULL) {
+    const Figure_t *figure = &game_state->figure;
+    gameEvent(game_state->events, EVENT_LOCK, figure->type, figure->rotation,
+              figure->x, figure->y, how_much, stats->score - score);
+  }
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Уплотняет поле, удаляя заполненные строки
+ * @details Функция проходит по строкам поля снизу вверх один раз. Незаполненные
+ * строки переносятся на свои новые места перестановкой указателей на строки,
+ * без копирования клеток, а строки заполненных линий поднимаются в верхнюю
+ * часть поля и очищаются. Стоимость пропорциональна количеству строк и не
+ * зависит от количества удаляемых линий
+ * @param field Матрица поля, строки которого нумеруются с 1 до height
+ * @param height Количество строк поля
+ * @param width Количество столбцов поля, столбцы нумеруются с 1 до width
+ * @return Количество удалённых строк
+ */
+int compactField(int **field, int height, int width) {
+  int write = height;
+  for (int read = height; read > 0; read--) {
+    if (!checkRow(field[read], width)) {
+      int *row = field[write];
+      field[write] = field[read];
+      field[read] = row;
+      write--;
+    }
+  }
+  for (int y = 1; y <= write; y++) {
+    memset(&field[y][1], 0, width * sizeof(int));
+  }
+  return write;
 }
 
 /**
  * @brief Проверяет, является ли линия заполненной
- * @details Функция проходит по заданной горизонтальной линии и проверяет,
- * заполнена ли она. Если линия заполнена, то функция возвращает true, иначе -
+ * @details Функция проверяет заполненность горизонтальной линии поля с помощью
+ * функции checkRow. Если линия заполнена, то функция возвращает true, иначе -
  * false
  * @param stats Информация о состоянии игры
  * @param y Номер линии, которую нужно проверить
  * @return true, если линия заполнена, false - если нет
  */
 bool checkLine(GameInfo_t *stats, int y) {
-  bool filled_line = true;
-  for (int x = 1; x <= WIDTH && filled_line != 0; x++) {
-    if (stats->field[y][x] == EMPTY_CELL) {
-      filled_line = false;
-    }
+  return checkRow(stats->field[y], WIDTH);
+}
+
+/**
+ * @brief Проверяет, заполнена ли строка поля
+ * @details Функция проходит по всем клеткам строки без ветвлений и досрочного
+ * выхода, накапливая результат сравнения. Такой цикл компилятор векторизует,
+ * сравнивая несколько клеток строки одной SIMD-инструкцией
+ * @param row Строка поля, клетки которой нумеруются с 1 до width
+ * @param width Количество клеток в строке
+ * @return true, если в строке нет пустых клеток, false - если есть
+ */
+bool checkRow(const int *row, int width) {
+  int empty_cells = 0;
+  for (int x = 1; x <= width; x++) {
+    empty_cells += row[x] == EMPTY_CELL;
   }
-  return filled_line;
+  return empty_cells == 0;
 }
 
 /**
@@ -703,6 +1529,65 @@ void updateScore(GameInfo_t *stats, int how_much) {
   setSpeed(&stats->level, &stats->speed);
 }
 
+/**
+ * @brief Добавляет мусорные линии в нижнюю часть поля
+ * @details Поле сдвигается вверх на rows строк перестановкой указателей на
+ * строки, без копирования клеток: верхние строки, которые уходят за пределы
+ * поля, становятся новыми нижними строками и заполняются статичными клетками
+ * везде, кроме столбца hole. Затем пересчитываются высоты столбцов и хеш поля.
+ * Если текущая фигура после сдвига поля сталкивается с ним, то она поднимается
+ * вверх. Если статичные клетки выходят за верхнюю границу поля или фигуру
+ * некуда поднять, то статус игры меняется на "game over"
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param rows Количество мусорных линий (не больше HEIGHT)
+ * @param hole Столбец без клетки в мусорных линиях (от 1 до WIDTH)
+ * @return START, если игра продолжается, и STOP, если игра проиграна
+ */
+int addGarbage(TetrisInfo_t *game_state, int rows, int hole) {
+  GameInfo_t *stats = &game_state->game_info;
+  int status = START;
+  if (rows > 0) {
+    int top = HEIGHT + 1;
+    for (int x = 1; x <= WIDTH; x++) {
+      if (game_state->heights[x] < top) {
+        top = game_state->heights[x];
+      }
+    }
+    if (top <= rows) {
+      status = STOP;
+    }
+    int *removed[HEIGHT];
+    for (int y = 0; y < rows; y++) {
+      removed[y] = stats->field[y + 1];
+    }
+    for (int y = 1; y <= HEIGHT - rows; y++) {
+      stats->field[y] = stats->field[y + rows];
+    }
+    for (int y = 0; y < rows; y++) {
+      int *row = removed[y];
+      for (int x = 1; x <= WIDTH; x++) {
+        row[x] = x == hole ? EMPTY_CELL : STATIC_CELL;
+      }
+      stats->field[HEIGHT - rows + 1 + y] = row;
+    }
+    initHeights(game_state);
+    unsigned long long field_hash = fieldHash(stats, 1);
+    game_state->hash ^= game_state->field_hash ^ field_hash;
+    game_state->field_hash = field_hash;
+    while (checkCollision(stats, &game_state->figure, 0, 0) &&
+           game_state->figure.y > 1) {
+      shiftFigure(game_state, 0, -1);
+    }
+    if (checkCollision(stats, &game_state->figure, 0, 0)) {
+      status = STOP;
+    }
+    if (status == STOP) {
+      game_state->game_status = kGameOver;
+    }
+  }
+  return status;
+}
+
 /**
  * @brief Получает high_score из файла
  * @details Функция читает максимальное количество очков после последней сессии
@@ -732,4 +1617,158 @@ void setHighScore(int high_score) {
     fprintf(file, "%d", high_score);
     fclose(file);
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Сохраняет снимок состояния игры
+ * @details Функция копирует в структуру TetrisSnapshot_t поле, текущую
+ * фигуру, очередь следующих фигур, отложенную фигуру, очерёдность фигур,
+ * состояние генератора случайных чисел, высоты столбцов, статистику игры и
+ * зажатые клавиши сдвига и мягкого падения. Снимок предварительно
+ * обнуляется, чтобы одинаковые состояния давали побайтно одинаковые снимки
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param snapshot Указатель на снимок, в который сохраняется состояние
+ */
+void tetrisSnapshot(const TetrisInfo_t *game_state,
+                    TetrisSnapshot_t *snapshot) {
+  const GameInfo_t *stats = &game_state->game_info;
+  memset(snapshot, 0, sizeof(*snapshot));
+  for (int y = 0; y <= HEIGHT; y++) {
+    memcpy(snapshot->field[y], stats->field[y], (WIDTH + 1) * sizeof(int));
+  }
+  snapshot->figure = game_state->figure;
+  memcpy(snapshot->queue, game_state->queue, sizeof(snapshot->queue));
+  snapshot->queue_head = game_state->queue_head;
+  snapshot->hold = game_state->hold;
+  snapshot->hold_used = game_state->hold_used;
+  memcpy(snapshot->figures, game_state->figures, sizeof(snapshot->figures));
+  snapshot->curr_figure = game_state->curr_figure;
+  snapshot->seed = game_state->seed;
+  memcpy(snapshot->heights, game_state->heights, sizeof(snapshot->heights));
+  snapshot->last_cleared = game_state->last_cleared;
+  snapshot->hash = game_state->hash;
+  snapshot->field_hash = game_state->field_hash;
+  snapshot->bag_hash = game_state->bag_hash;
+  snapshot->score = stats->score;
+  snapshot->high_score = stats->high_score;
+  snapshot->level = stats->level;
+  snapshot->speed = stats->speed;
+  snapshot->pause = stats->pause;
+  snapshot->action = game_state->action;
+  snapshot->game_status = game_state->game_status;
+  snapshot->set_time = game_state->set_time;
+  snapshot->shift_held = game_state->shift_held;
+  snapshot->shift_action = game_state->shift_action;
+  snapshot->shift_time = game_state->shift_time;
+  snapshot->soft_drop = game_state->soft_drop;
+  snapshot->lock_resets = game_state->lock_resets;
+  snapshot->lock_active = game_state->lock_active;
+  snapshot->lock_time = game_state->lock_time;
+}
+
+/**
+ * @brief Восстанавливает состояние игры из снимка
+ * @details Функция переносит содержимое снимка в уже созданную структуру
+ * TetrisInfo_t без выделения памяти: строки поля копируются в существующие
+ * матрицы, матрица next заполняется по сохранённой очереди фигур
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param snapshot Указатель на снимок, из которого восстанавливается состояние
+ */
+void tetrisRestore(TetrisInfo_t *game_state, const TetrisSnapshot_t *snapshot) {
+  GameInfo_t *stats = &game_state->game_info;
+  for (int y = 0; y <= HEIGHT; y++) {
+    memcpy(stats->field[y], snapshot->field[y], (WIDTH + 1) * sizeof(int));
+  }
+  game_state->figure = snapshot->figure;
+  memcpy(game_state->queue, snapshot->queue, sizeof(game_state->queue));
+  game_state->queue_head = snapshot->queue_head;
+  game_state->hold = snapshot->hold;
+  game_state->hold_used = snapshot->hold_used;
+  prepareNextFigure(game_state, stats);
+  memcpy(game_state->figures, snapshot->figures, sizeof(game_state->figures));
+  game_state->curr_figure = snapshot->curr_figure;
+  game_state->seed = snapshot->seed;
+  memcpy(game_state->heights, snapshot->heights, sizeof(game_state->heights));
+  game_state->last_cleared = snapshot->last_cleared;
+  game_state->hash = snapshot->hash;
+  game_state->field_hash = snapshot->field_hash;
+  game_state->bag_hash = snapshot->bag_hash;
+  stats->score = snapshot->score;
+  stats->high_score = snapshot->high_score;
+  stats->level = snapshot->level;
+  stats->speed = snapshot->speed;
+  stats->pause = snapshot->pause;
+  game_state->action = snapshot->action;
+  game_state->game_status = snapshot->game_status;
+  game_state->set_time = snapshot->set_time;
+  game_state->shift_held = snapshot->shift_held;
+  game_state->shift_action = snapshot->shift_action;
+  game_state->shift_time = snapshot->shift_time;
+  game_state->soft_drop = snapshot->soft_drop;
+  game_state->lock_resets = snapshot->lock_resets;
+  game_state->lock_active = snapshot->lock_active;
+  game_state->lock_time = snapshot->lock_time;
+}
+
+/**
+ * @brief Считает контрольную сумму полного состояния игры
+ * @details В сумму входят клетки поля, текущая фигура, видимая очередь
+ * фигур, отложенная фигура, очерёдность фигур и состояние генератора, высоты
+ * столбцов, хеш Зобриста, статистика (кроме рекорда), статус игры, зажатые
+ * клавиши сдвига и мягкого падения (от них зависят следующие сдвиг и шаг
+ * гравитации) и счётчики задержки фиксации. Времена событий и рекорд не
+ * входят (см. lockstep.h).
+ * Очередь учитывается от queue_head, поэтому сумма не зависит от того, где в
+ * кольце лежат фигуры
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @return Контрольная сумма
+ */
+unsigned long long tetrisChecksum(const TetrisInfo_t *game_state) {
+  const GameInfo_t *stats = &game_state->game_info;
+  const Figure_t *figure = &game_state->figure;
+  unsigned long long sum = CHECKSUM_INIT;
+  for (int y = 1; y <= HEIGHT; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      sum = checksumInt(sum, stats->field[y][x]);
+    }
+  }
+  int figure_data[] = {figure->x,      figure->y,     figure->width,
+                       figure->height, figure->type, figure->rotation};
+  for (int i = 0; i < 6; i++) {
+    sum = checksumInt(sum, figure_data[i]);
+  }
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      sum = checksumInt(sum, figure->f[y][x]);
+    }
+  }
+  for (int i = 0; i < TETRIS_PREVIEW; i++) {
+    sum = checksumInt(sum, nextFigure(game_state, i));
+  }
+  for (int i = 0; i < FIGURES_COUNT; i++) {
+    sum = checksumInt(sum, game_state->figures[i]);
+  }
+  for (int x = 0; x < WIDTH + 2; x++) {
+    sum = checksumInt(sum, game_state->heights[x]);
+  }
+  long long state_data[] = {game_state->hold,
+                            game_state->hold_used,
+                            game_state->curr_figure,
+                            game_state->seed,
+                            game_state->last_cleared,
+                            (long long)game_state->hash,
+                            stats->score,
+                            stats->level,
+                            stats->speed,
+                            stats->pause,
+                            game_state->game_status,
+                            game_state->shift_held,
+                            game_state->shift_action,
+                            game_state->soft_drop,
+                            game_state->lock_resets,
+                            game_state->lock_active};
+  for (size_t i = 0; i < sizeof(state_data) / sizeof(state_data[0]); i++) {
+    sum = checksumInt(sum, state_data[i]);
+  }
+  return sum;
+}
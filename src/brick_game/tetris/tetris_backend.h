@@ -8,36 +8,144 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../common/arena.h"
 #include "../common/common_back.h"
+#include "../common/event_log.h"
+#include "../common/input_queue.h"
+#include "../common/lockstep.h"
+#include "../common/profiler.h"
 
 #define FIGURES_COUNT 7
 #define TETRIS_MAX_SCORE 10000
+#define TETRIS_DAS_DELAY 170
+#define TETRIS_ARR_INTERVAL 50
+#define TETRIS_SHIFT_LEFT 1
+#define TETRIS_SHIFT_RIGHT 2
+#define TETRIS_LOCK_DELAY 500
+#define TETRIS_LOCK_RESETS 15
+#define TETRIS_SOFT_DROP_FACTOR 20
+#define SRS_KICKS 5
+#define TETRIS_PREVIEW 5
+#define TETRIS_QUEUE_SIZE 8
+#define TETRIS_NO_HOLD -1
+
+#define ZOBRIST_STATIC 0
+#define ZOBRIST_SHAPE 1
+#define ZOBRIST_POSITION 2
+#define ZOBRIST_BAG 3
+#define ZOBRIST_BAG_POSITION 4
+#define ZOBRIST_QUEUE 5
+#define ZOBRIST_HOLD 6
 
 /**
  * @brief Структура, хранящая информацию о текущей фигуре
+ * @details type - номер фигуры (см. initFigure), rotation - номер поворота
+ * от начального положения (от 0 до 3), по ним выбираются смещения поворота
+ * SRS (см. srsOffset)
  */
 typedef struct {
   int x;
   int y;
   int width;
   int height;
+  int type;
+  int rotation;
   int f[4][4];
 } Figure_t;
 
 /**
  * @brief Основная игровая структура
+ * @details das_delay и arr_interval - задержка перед автоповтором сдвига и
+ * интервал между повторами в миллисекундах. shift_held - маска зажатых
+ * клавиш сдвига (TETRIS_SHIFT_LEFT, TETRIS_SHIFT_RIGHT), shift_action -
+ * направление автоповтора (Up, если автоповтора нет), shift_time - время
+ * следующего повтора. soft_drop - зажата ли клавиша мягкого падения.
+ * lock_delay - задержка фиксации упавшей фигуры в миллисекундах (0 - фигура
+ * фиксируется на ближайшем шаге, как в классическом Тетрисе), lock_limit -
+ * сколько раз сдвиг или поворот может отложить фиксацию одной фигуры,
+ * lock_resets - сколько раз фиксация текущей фигуры уже откладывалась,
+ * lock_active - стоит ли фигура на опоре, lock_time - время фиксации.
+ * queue - кольцо номеров следующих фигур: TETRIS_PREVIEW фигур, начиная с
+ * queue[queue_head], остальные элементы не используются. hold - номер
+ * отложенной фигуры (TETRIS_NO_HOLD, если её нет), hold_used - откладывалась
+ * ли уже текущая фигура. events - источник событий для журнала (см.
+ * event_log.h), NULL - события не пишутся
  */
 typedef struct {
   UserAction_t action;
+  InputQueue_t input;
   GameInfo_t game_info;
   GameStatus_t game_status;
   Figure_t figure;
-  Figure_t next_figure;
+  int queue[TETRIS_QUEUE_SIZE];
+  int queue_head;
+  int hold;
+  int hold_used;
   int figures[FIGURES_COUNT];
   int curr_figure;
   long long set_time;
+  int das_delay;
+  int arr_interval;
+  int shift_held;
+  UserAction_t shift_action;
+  long long shift_time;
+  int soft_drop;
+  int lock_delay;
+  int lock_limit;
+  int lock_resets;
+  int lock_active;
+  long long lock_time;
+  int heights[WIDTH + 2];
+  int last_cleared;
+  unsigned int seed;
+  unsigned long long hash;
+  unsigned long long field_hash;
+  unsigned long long bag_hash;
+  Arena_t arena;
+  GameEvents_t *events;
 } TetrisInfo_t;
 
+/**
+ * @brief Снимок состояния игры
+ * @details Структура фиксированного размера без указателей, поэтому снимок
+ * копируется одним memcpy. Из поля сохраняются только строки 0..HEIGHT и
+ * столбцы 0..WIDTH, используемые игрой. Матрица next не сохраняется, так как
+ * она заполняется по очереди фигур queue. Зажатые клавиши сдвига и мягкого
+ * падения сохраняются вместе с состоянием, иначе после восстановления фигура
+ * продолжила бы сдвигаться или падать с ускорением
+ */
+typedef struct {
+  int field[HEIGHT + 1][WIDTH + 1];
+  Figure_t figure;
+  int queue[TETRIS_QUEUE_SIZE];
+  int queue_head;
+  int hold;
+  int hold_used;
+  int figures[FIGURES_COUNT];
+  int curr_figure;
+  unsigned int seed;
+  int heights[WIDTH + 2];
+  int last_cleared;
+  unsigned long long hash;
+  unsigned long long field_hash;
+  unsigned long long bag_hash;
+  int score;
+  int high_score;
+  int level;
+  int speed;
+  int pause;
+  UserAction_t action;
+  GameStatus_t game_status;
+  long long set_time;
+  int shift_held;
+  UserAction_t shift_action;
+  long long shift_time;
+  int soft_drop;
+  int lock_resets;
+  int lock_active;
+  long long lock_time;
+} TetrisSnapshot_t;
+
 // GAME ELEMENTS INITIALIZATION FUNCS
 TetrisInfo_t *getTetrisInfo_t();
 int createInfo_t(TetrisInfo_t *game_state);
@@ -45,15 +153,23 @@ int createMatrix(int height, int width, int ***matrix);
 
 // GAME ELEMENTS REMOVAL FUNCS
 void removeGameInfo_t();
+void removeInfo_t(TetrisInfo_t *game_state);
 void removeMatrix(int **matrix, int height);
 
 // FIGURES INITIALIZATION FUNCS
 void figureOrdering();
-void corrSpawn(int *figures, int count);
+void orderFigures(TetrisInfo_t *game_state);
+void corrSpawn(int *figures, int count, unsigned int *seed);
 void spawnFigure(TetrisInfo_t *game_state);
+void initQueue(TetrisInfo_t *game_state);
+int drawFigure(TetrisInfo_t *game_state);
+int nextFigure(const TetrisInfo_t *game_state, int index);
 void initNextFigure(GameInfo_t *stats);
+void prepareNextFigure(TetrisInfo_t *game_state, GameInfo_t *stats);
 void initFigure(Figure_t *figure, int type);
 void copyFigure(int src[4][4], int dst[4][4], int height, int width);
+void copyShape(Figure_t *figure, int type);
+const Figure_t *figureShape(int type);
 void lineFigure(Figure_t *figure);
 void squareFigure(Figure_t *figure);
 void zFigure(Figure_t *figure);
@@ -68,26 +184,68 @@ GameInfo_t updateCurrentState();
 // GAME LOGIC
 void tetrisMechanics(TetrisInfo_t *game_state);
 void continueOrNot(UserAction_t state, TetrisInfo_t *game_state);
+bool tetrisStep(TetrisInfo_t *game_state);
+void tetrisTick(TetrisInfo_t *game_state, long long now);
+int gravityInterval(const TetrisInfo_t *game_state);
+void resetLockDelay(TetrisInfo_t *game_state, long long now);
 void updateField(GameInfo_t *stats, Figure_t *figure, int cell_type);
 bool checkCollision(GameInfo_t *stats, Figure_t *figure, int offset_x,
                     int offset_y);
 
+// SURFACE HEIGHTS & DROP DISTANCE
+void initHeights(TetrisInfo_t *game_state);
+void updateHeights(TetrisInfo_t *game_state, Figure_t *figure);
+void recountHeights(TetrisInfo_t *game_state);
+int dropDistance(TetrisInfo_t *game_state, Figure_t *figure);
+void getGhostFigure(TetrisInfo_t *game_state, Figure_t *ghost);
+
+// ZOBRIST HASHING
+void tetrisRehash(TetrisInfo_t *game_state);
+unsigned long long fieldHash(GameInfo_t *stats, int from_y);
+unsigned long long figureHash(Figure_t *figure);
+unsigned long long bagHash(TetrisInfo_t *game_state);
+void lockFigureHash(TetrisInfo_t *game_state, Figure_t *figure);
+void shiftFigure(TetrisInfo_t *game_state, int offset_x, int offset_y);
+
 // USER'S COMMAND HANDLERS
 void getUserInput();
 void setUserAction(int key, UserAction_t *state);
 void userInput(UserAction_t action, bool hold);
+void tetrisDrainInput(TetrisInfo_t *game_state, long long now);
+void tetrisKeyEvent(TetrisInfo_t *game_state, const InputEvent_t *event);
+void tetrisAutoShift(TetrisInfo_t *game_state, long long now);
+bool tetrisMove(TetrisInfo_t *game_state, UserAction_t action, long long time);
+void setAutoShift(TetrisInfo_t *game_state, int delay, int interval);
+void setLockDelay(TetrisInfo_t *game_state, int delay, int resets);
+void tetrisUserInput(TetrisInfo_t *game_state, UserAction_t action);
+void holdFigure(TetrisInfo_t *game_state);
 void rotateFigure(TetrisInfo_t *game_state);
+void turnFigure(const Figure_t *figure, Figure_t *turned);
+bool srsOffset(int type, int rotation, int kick, int *offset_x, int *offset_y);
 void moveDown(TetrisInfo_t *game_state);
+void hardDrop(TetrisInfo_t *game_state);
 void moveLeft(TetrisInfo_t *game_state);
 void moveRight(TetrisInfo_t *game_state);
 
 // SCORE & LEVEL UPDATE FUNC
 void removeLine(TetrisInfo_t *game_state);
+int compactField(int **field, int height, int width);
 bool checkLine(GameInfo_t *stats, int y);
+bool checkRow(const int *row, int width);
 void updateScore(GameInfo_t *stats, int how_much);
 
+// GARBAGE LINES
+int addGarbage(TetrisInfo_t *game_state, int rows, int hole);
+
 // HIGH SCORE SETTER & GETTER
 int getHighScore();
 void setHighScore(int high_score);
 
+// SNAPSHOT & RESTORE
+void tetrisSnapshot(const TetrisInfo_t *game_state, TetrisSnapshot_t *snapshot);
+void tetrisRestore(TetrisInfo_t *game_state, const TetrisSnapshot_t *snapshot);
+
+// CHECKSUM
+unsigned long long tetrisChecksum(const TetrisInfo_t *game_state);
+
 #endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BACKEND_H_
\ No newline at end of file
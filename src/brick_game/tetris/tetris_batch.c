@@ -0,0 +1,422 @@
+/** @file
+ * @brief Файл, содержащий функции пакетного движка Тетриса
+ */
+#include "tetris_batch.h"
+
+/**
+ * @brief Создаёт пакет полей
+ * @details Выделяет одним блоком арену под массивы состояния полей (см.
+ * arena.h), строит таблицу форм фигур и начинает игру на каждом поле. Поле с
+ * номером i получает начальное состояние генератора случайных чисел seed + i
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param count Количество полей
+ * @param seed Начальное состояние генератора случайных чисел первого поля
+ * @return START, если создание прошло успешно, и STOP в противном случае
+ */
+int createBatch(TetrisBatch_t *batch, int count, unsigned int seed) {
+  int status = START;
+  size_t boards = count > 0 ? (size_t)count : 0;
+  memset(batch, 0, sizeof(*batch));
+  if (count < 1) {
+    status = STOP;
+  } else {
+    size_t ints = arenaSize(boards * sizeof(int));
+    status = createArena(
+        &batch->arena,
+        arenaSize(boards * BATCH_STRIDE * sizeof(uint16_t)) + 10 * ints +
+            arenaSize(boards * TETRIS_QUEUE_SIZE * sizeof(int)) +
+            arenaSize(boards * FIGURES_COUNT * sizeof(int)) +
+            arenaSize(boards * sizeof(unsigned int)) +
+            arenaSize(boards * sizeof(GameStatus_t)) + arenaSize(boards));
+  }
+  if (status == START) {
+    Arena_t *arena = &batch->arena;
+    batch->rows = (uint16_t *)arenaAlloc(
+        arena, boards * BATCH_STRIDE * sizeof(uint16_t));
+    batch->type = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->rotation = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->x = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->y = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->queue =
+        (int *)arenaAlloc(arena, boards * TETRIS_QUEUE_SIZE * sizeof(int));
+    batch->queue_head = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->figures =
+        (int *)arenaAlloc(arena, boards * FIGURES_COUNT * sizeof(int));
+    batch->curr_figure = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->seed =
+        (unsigned int *)arenaAlloc(arena, boards * sizeof(unsigned int));
+    batch->score = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->level = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->speed = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->last_cleared = (int *)arenaAlloc(arena, boards * sizeof(int));
+    batch->status =
+        (GameStatus_t *)arenaAlloc(arena, boards * sizeof(GameStatus_t));
+    batch->blocked = (uint8_t *)arenaAlloc(arena, boards);
+    batch->count = count;
+    initBatchShapes(batch);
+    for (int i = 0; i < count; i++) {
+      batchReset(batch, i, seed + (unsigned int)i);
+    }
+  } else {
+    removeBatch(batch);
+  }
+  return status;
+}
+
+/**
+ * @brief Строит таблицу форм фигур
+ * @details Формы строятся теми же функциями, что и фигуры скалярного движка:
+ * initFigure задаёт начальную форму, turnFigure - каждый следующий поворот,
+ * а смещения поворота берутся из таблиц srsOffset. Поэтому повороты в
+ * пакетном движке совпадают с rotateFigure
+ * @param batch Указатель на структуру TetrisBatch_t
+ */
+void initBatchShapes(TetrisBatch_t *batch) {
+  for (int type = 0; type < FIGURES_COUNT; type++) {
+    Figure_t figure;
+    memset(&figure, 0, sizeof(figure));
+    initFigure(&figure, type);
+    for (int rotation = 0; rotation < BATCH_ROTATIONS; rotation++) {
+      BatchShape_t *shape = &batch->shapes[type][rotation];
+      memset(shape, 0, sizeof(*shape));
+      shape->width = figure.width;
+      shape->height = figure.height;
+      shape->top = figure.height;
+      shape->left = figure.width;
+      for (int y = 0; y < figure.height; y++) {
+        for (int x = 0; x < figure.width; x++) {
+          if (figure.f[y][x] == MOVING_CELL) {
+            shape->rows[y] |= (uint16_t)(1 << x);
+            shape->top = y < shape->top ? y : shape->top;
+            shape->bottom = y;
+            shape->left = x < shape->left ? x : shape->left;
+            shape->right = x > shape->right ? x : shape->right;
+          }
+        }
+      }
+      while (shape->kick_count < SRS_KICKS &&
+             srsOffset(type, rotation, shape->kick_count,
+                       &shape->kicks[shape->kick_count][0],
+                       &shape->kicks[shape->kick_count][1])) {
+        shape->kick_count++;
+      }
+      Figure_t turned;
+      turnFigure(&figure, &turned);
+      figure = turned;
+    }
+  }
+}
+
+/**
+ * @brief Начинает новую игру на поле пакета
+ * @details Очищает поле и статистику и раздаёт фигуры так же, как
+ * createInfo_t и dealBoard: очерёдность фигур перемешивается по состоянию
+ * генератора seed, затем заполняется очередь следующих фигур и выбирается
+ * текущая фигура
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @param seed Состояние генератора случайных чисел
+ */
+void batchReset(TetrisBatch_t *batch, int board, unsigned int seed) {
+  uint16_t *rows = &batch->rows[board * BATCH_STRIDE];
+  for (int y = 0; y < HEIGHT; y++) {
+    rows[y] = BATCH_EMPTY_ROW;
+  }
+  for (int y = HEIGHT; y < BATCH_STRIDE; y++) {
+    rows[y] = BATCH_FULL_ROW;
+  }
+  int *figures = &batch->figures[board * FIGURES_COUNT];
+  for (int i = 0; i < FIGURES_COUNT; i++) {
+    figures[i] = i;
+  }
+  batch->curr_figure[board] = FIGURES_COUNT;
+  batch->seed[board] = seed;
+  corrSpawn(figures, FIGURES_COUNT, &batch->seed[board]);
+  batch->score[board] = 0;
+  batch->level[board] = 1;
+  batch->speed[board] = START_SPEED;
+  batch->last_cleared[board] = 0;
+  batch->status[board] = kStart;
+  int *queue = &batch->queue[board * TETRIS_QUEUE_SIZE];
+  batch->queue_head[board] = 0;
+  for (int i = 0; i < TETRIS_QUEUE_SIZE; i++) {
+    queue[i] = i < TETRIS_PREVIEW ? batchNextFigure(batch, board) : 0;
+  }
+  batchSpawn(batch, board);
+}
+
+/**
+ * @brief Освобождает память, занятую пакетом полей
+ * @details Все массивы пакета лежат в одной арене, поэтому память
+ * освобождается одним вызовом free
+ * @param batch Указатель на структуру TetrisBatch_t
+ */
+void removeBatch(TetrisBatch_t *batch) {
+  removeArena(&batch->arena);
+  memset(batch, 0, sizeof(*batch));
+}
+
+/**
+ * @brief Выполняет шаг всех полей пакета
+ * @details Шаг каждого поля совпадает с вызовом tetrisMechanics с истёкшим
+ * таймером: поле с максимальным счётом получает статус "win", иначе фигура
+ * опускается на строку или прикрепляется к полю. Шаг выполняется в три
+ * прохода по полям: проверка столкновения под фигурой для всех полей, сдвиг
+ * вниз всех незаблокированных фигур (цикл без ветвлений, который компилятор
+ * векторизует) и прикрепление заблокированных фигур, которое нужно лишь
+ * небольшой части полей. Поля с оконченной игрой не шагают
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @return Количество полей, на которых фигура прикрепилась к полю
+ */
+int batchStep(TetrisBatch_t *batch) {
+  int locked = 0;
+  for (int i = 0; i < batch->count; i++) {
+    if (batch->status[i] == kStart && batch->score[i] >= TETRIS_MAX_SCORE) {
+      batch->status[i] = kWin;
+    }
+    batch->blocked[i] =
+        batch->status[i] != kStart ||
+        batchCollision(batch, i, batch->rotation[i], batch->x[i],
+                       batch->y[i] + 1);
+  }
+  for (int i = 0; i < batch->count; i++) {
+    batch->y[i] += !batch->blocked[i];
+  }
+  for (int i = 0; i < batch->count; i++) {
+    if (batch->blocked[i] && batch->status[i] == kStart) {
+      batchLock(batch, i);
+      locked++;
+    }
+  }
+  return locked;
+}
+
+/**
+ * @brief Проверяет столкновение текущей фигуры поля
+ * @details Каждая строка маски фигуры сдвигается на столбец фигуры и
+ * сравнивается со строкой поля. Стенки и пол входят в строки поля, поэтому
+ * выход за границы поля тоже даёт пересечение масок. Результат совпадает с
+ * checkCollision для той же фигуры. Проверяются только строки матрицы с
+ * клетками фигуры
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @param rotation Номер поворота фигуры
+ * @param x Столбец фигуры (клетки фигуры не левее стенки)
+ * @param y Строка фигуры (клетки фигуры не выше первой строки поля)
+ * @return true, если столкновение произошло, и false в противном случае
+ */
+bool batchCollision(const TetrisBatch_t *batch, int board, int rotation,
+                    int x, int y) {
+  const BatchShape_t *shape = &batch->shapes[batch->type[board]][rotation];
+  const uint16_t *rows = &batch->rows[board * BATCH_STRIDE];
+  unsigned int hit = 0;
+  for (int r = shape->top; r <= shape->bottom; r++) {
+    hit |=
+        ((unsigned int)shape->rows[r] << (x + BATCH_SHIFT)) & rows[y - 1 + r];
+  }
+  return hit != 0;
+}
+
+/**
+ * @brief Проверяет, помещается ли фигура поля в заданном положении
+ * @details Сначала границы занятых клеток сравниваются с границами поля, и
+ * только положение внутри поля проверяется функцией batchCollision. Поэтому
+ * положение может быть любым, например смещённым отталкиванием SRS за
+ * пределы поля. Результат совпадает с отрицанием checkCollision
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @param rotation Номер поворота фигуры
+ * @param x Столбец фигуры
+ * @param y Строка фигуры
+ * @return true, если фигура помещается, иначе false
+ */
+bool batchFits(const TetrisBatch_t *batch, int board, int rotation, int x,
+               int y) {
+  const BatchShape_t *shape = &batch->shapes[batch->type[board]][rotation];
+  return x + shape->left >= 1 && x + shape->right <= WIDTH &&
+         y + shape->top >= 1 && y + shape->bottom <= HEIGHT &&
+         !batchCollision(batch, board, rotation, x, y);
+}
+
+/**
+ * @brief Прикрепляет текущую фигуру к полю
+ * @details Повторяет ветку прикрепления tetrisStep: клетки фигуры становятся
+ * статичными, заполненные линии удаляются, счёт обновляется функцией
+ * updateScore, и появляется следующая фигура. Если она сталкивается с полем,
+ * то статус поля меняется на "game over"
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ */
+void batchLock(TetrisBatch_t *batch, int board) {
+  const BatchShape_t *shape =
+      &batch->shapes[batch->type[board]][batch->rotation[board]];
+  uint16_t *rows = &batch->rows[board * BATCH_STRIDE];
+  for (int r = shape->top; r <= shape->bottom; r++) {
+    rows[batch->y[board] - 1 + r] |=
+        (uint16_t)(shape->rows[r] << (batch->x[board] + BATCH_SHIFT));
+  }
+  int cleared = batchCompact(rows);
+  batch->last_cleared[board] = cleared;
+  if (cleared > 0) {
+    GameInfo_t stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.score = batch->score[board];
+    stats.level = batch->level[board];
+    stats.speed = batch->speed[board];
+    updateScore(&stats, cleared);
+    batch->score[board] = stats.score;
+    batch->level[board] = stats.level;
+    batch->speed[board] = stats.speed;
+  }
+  batchSpawn(batch, board);
+  if (batchCollision(batch, board, batch->rotation[board], batch->x[board],
+                     batch->y[board])) {
+    batch->status[board] = kGameOver;
+  }
+}
+
+/**
+ * @brief Удаляет заполненные строки поля
+ * @details Проходит по строкам снизу вверх один раз, как compactField:
+ * незаполненные строки переносятся вниз на количество заполненных строк под
+ * ними, освободившиеся верхние строки очищаются
+ * @param rows Строки поля (HEIGHT строк сверху вниз)
+ * @return Количество удалённых строк
+ */
+int batchCompact(uint16_t *rows) {
+  int write = HEIGHT - 1;
+  for (int read = HEIGHT - 1; read >= 0; read--) {
+    if (rows[read] != BATCH_FULL_ROW) {
+      rows[write--] = rows[read];
+    }
+  }
+  for (int y = 0; y <= write; y++) {
+    rows[y] = BATCH_EMPTY_ROW;
+  }
+  return write + 1;
+}
+
+/**
+ * @brief Размещает следующую фигуру на поле
+ * @details Фигура берётся из начала очереди и появляется в том же месте, что
+ * и в spawnFigure, после чего очередь дополняется новой фигурой
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ */
+void batchSpawn(TetrisBatch_t *batch, int board) {
+  int *queue = &batch->queue[board * TETRIS_QUEUE_SIZE];
+  int head = batch->queue_head[board];
+  int type = queue[head];
+  batch->type[board] = type;
+  batch->rotation[board] = 0;
+  batch->x[board] = (WIDTH - batch->shapes[type][0].width) / 2 + 1;
+  batch->y[board] = 1;
+  head = (head + 1) % TETRIS_QUEUE_SIZE;
+  batch->queue_head[board] = head;
+  queue[(head + TETRIS_PREVIEW - 1) % TETRIS_QUEUE_SIZE] =
+      batchNextFigure(batch, board);
+}
+
+/**
+ * @brief Выбирает следующую фигуру поля
+ * @details Работает так же, как drawFigure: когда все фигуры набора
+ * выданы, очерёдность перемешивается функцией corrSpawn
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @return Номер фигуры
+ */
+int batchNextFigure(TetrisBatch_t *batch, int board) {
+  int *figures = &batch->figures[board * FIGURES_COUNT];
+  if (batch->curr_figure[board] >= FIGURES_COUNT) {
+    corrSpawn(figures, FIGURES_COUNT, &batch->seed[board]);
+    batch->curr_figure[board] = 0;
+  }
+  return figures[batch->curr_figure[board]++];
+}
+
+/**
+ * @brief Обрабатывает команду для поля пакета
+ * @details Команды работают так же, как в tetrisUserInput: Action
+ * поворачивает фигуру с отталкиванием SRS по таблице kicks формы (см.
+ * rotateFigure), Left и Right сдвигают
+ * её, Down опускает на одну строку, HardDrop мгновенно опускает и
+ * фиксирует. Остальные команды (в том числе Hold) игнорируются. Команды для
+ * поля с оконченной игрой не выполняются
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @param action Команда
+ */
+void batchInput(TetrisBatch_t *batch, int board, UserAction_t action) {
+  int rotation = batch->rotation[board];
+  int x = batch->x[board];
+  int y = batch->y[board];
+  if (batch->status[board] != kStart) {
+    action = Up;
+  }
+  if (action == Action) {
+    const BatchShape_t *shape = &batch->shapes[batch->type[board]][rotation];
+    int turned = (rotation + 1) % BATCH_ROTATIONS;
+    bool is_rotated = false;
+    for (int kick = 0; kick < shape->kick_count && !is_rotated; kick++) {
+      int kick_x = x + shape->kicks[kick][0];
+      int kick_y = y + shape->kicks[kick][1];
+      if (batchFits(batch, board, turned, kick_x, kick_y)) {
+        batch->rotation[board] = turned;
+        batch->x[board] = kick_x;
+        batch->y[board] = kick_y;
+        is_rotated = true;
+      }
+    }
+  } else if (action == Left || action == Right) {
+    int offset = action == Left ? -1 : 1;
+    if (!batchCollision(batch, board, rotation, x + offset, y)) {
+      batch->x[board] = x + offset;
+    }
+  } else if (action == Down) {
+    if (!batchCollision(batch, board, rotation, x, y + 1)) {
+      batch->y[board] = y + 1;
+    }
+  } else if (action == HardDrop) {
+    while (!batchCollision(batch, board, rotation, x, batch->y[board] + 1)) {
+      batch->y[board]++;
+    }
+    batchLock(batch, board);
+  }
+}
+
+/**
+ * @brief Строит текущую фигуру поля в формате скалярного движка
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @param figure Указатель на структуру Figure_t, в которую записывается
+ * фигура
+ */
+void batchFigure(const TetrisBatch_t *batch, int board, Figure_t *figure) {
+  const BatchShape_t *shape =
+      &batch->shapes[batch->type[board]][batch->rotation[board]];
+  memset(figure, 0, sizeof(*figure));
+  figure->x = batch->x[board];
+  figure->y = batch->y[board];
+  figure->width = shape->width;
+  figure->height = shape->height;
+  figure->type = batch->type[board];
+  figure->rotation = batch->rotation[board];
+  for (int y = 0; y < shape->height; y++) {
+    for (int x = 0; x < shape->width; x++) {
+      figure->f[y][x] = (shape->rows[y] >> x) & 1 ? MOVING_CELL : EMPTY_CELL;
+    }
+  }
+}
+
+/**
+ * @brief Возвращает значение клетки поля
+ * @param batch Указатель на структуру TetrisBatch_t
+ * @param board Номер поля
+ * @param y Строка (от 1 до HEIGHT)
+ * @param x Столбец (от 1 до WIDTH)
+ * @return STATIC_CELL, если клетка занята, иначе EMPTY_CELL
+ */
+int batchCell(const TetrisBatch_t *batch, int board, int y, int x) {
+  uint16_t row = batch->rows[board * BATCH_STRIDE + y - 1];
+  return (row >> (x + BATCH_SHIFT)) & 1 ? STATIC_CELL : EMPTY_CELL;
+}
@@ -0,0 +1,103 @@
+/** @file
+ * @brief Заголовочный файл, определяющий пакетный движок Тетриса
+ * @details Пакетный движок шагает сразу много полей (например, для обучения
+ * ботов или для сервера) по тем же правилам, что и tetrisMechanics, но хранит
+ * состояние полей в отдельных плотных массивах (structure of arrays). Строка
+ * поля - 16-битная маска: столбец x поля (от 1 до WIDTH) занимает бит
+ * x + BATCH_SHIFT, остальные биты строки всегда установлены и играют роль
+ * стенок. Под полем хранятся BATCH_FLOOR сплошных строк пола, поэтому
+ * проверка столкновения фигуры сводится к нескольким операциям AND без
+ * проверок границ. Сдвиг BATCH_SHIFT оставляет слева место для пустых
+ * столбцов матрицы фигуры, стоящей у левой стенки
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BATCH_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BATCH_H_
+
+#include <stdint.h>
+
+#include "tetris_backend.h"
+
+#define BATCH_SHIFT 3
+#define BATCH_FLOOR 4
+#define BATCH_STRIDE (HEIGHT + BATCH_FLOOR)
+#define BATCH_ROTATIONS 4
+#define BATCH_FULL_ROW 0xFFFF
+#define BATCH_EMPTY_ROW                                                        \
+  ((uint16_t)(BATCH_FULL_ROW & ~(((1 << WIDTH) - 1) << (1 + BATCH_SHIFT))))
+
+/**
+ * @brief Форма фигуры в одном из поворотов
+ * @details rows[y] - маска клеток строки y матрицы фигуры: клетка f[y][x]
+ * занимает бит x. top, bottom, left и right - первая и последняя занятые
+ * строки и столбцы матрицы. kicks - смещения поворота SRS из этого
+ * положения (см. srsOffset), kick_count - их количество
+ */
+typedef struct {
+  uint16_t rows[4];
+  int width;
+  int height;
+  int top;
+  int bottom;
+  int left;
+  int right;
+  int kicks[SRS_KICKS][2];
+  int kick_count;
+} BatchShape_t;
+
+/**
+ * @brief Состояние пакета полей
+ * @details Строки поля board занимают элементы rows с board * BATCH_STRIDE
+ * по board * BATCH_STRIDE + HEIGHT - 1 (строки поля сверху вниз), затем идут
+ * строки пола. Текущая фигура задаётся видом, номером поворота и
+ * координатами, как Figure_t в скалярном движке. Очерёдность фигур каждого
+ * поля хранится в figures по FIGURES_COUNT элементов, очередь следующих
+ * фигур - в queue по TETRIS_QUEUE_SIZE элементов с началом queue_head, как
+ * в TetrisInfo_t
+ */
+typedef struct {
+  int count;
+  BatchShape_t shapes[FIGURES_COUNT][BATCH_ROTATIONS];
+  uint16_t *rows;
+  int *type;
+  int *rotation;
+  int *x;
+  int *y;
+  int *queue;
+  int *queue_head;
+  int *figures;
+  int *curr_figure;
+  unsigned int *seed;
+  int *score;
+  int *level;
+  int *speed;
+  int *last_cleared;
+  GameStatus_t *status;
+  uint8_t *blocked;
+  Arena_t arena;
+} TetrisBatch_t;
+
+// BATCH INITIALIZATION & REMOVAL FUNCS
+int createBatch(TetrisBatch_t *batch, int count, unsigned int seed);
+void initBatchShapes(TetrisBatch_t *batch);
+void batchReset(TetrisBatch_t *batch, int board, unsigned int seed);
+void removeBatch(TetrisBatch_t *batch);
+
+// BATCH LOGIC
+int batchStep(TetrisBatch_t *batch);
+bool batchCollision(const TetrisBatch_t *batch, int board, int rotation,
+                    int x, int y);
+bool batchFits(const TetrisBatch_t *batch, int board, int rotation, int x,
+               int y);
+void batchLock(TetrisBatch_t *batch, int board);
+int batchCompact(uint16_t *rows);
+void batchSpawn(TetrisBatch_t *batch, int board);
+int batchNextFigure(TetrisBatch_t *batch, int board);
+
+// USER'S COMMAND HANDLERS
+void batchInput(TetrisBatch_t *batch, int board, UserAction_t action);
+
+// BOARD EXPORT
+void batchFigure(const TetrisBatch_t *batch, int board, Figure_t *figure);
+int batchCell(const TetrisBatch_t *batch, int board, int y, int x);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BATCH_H_
@@ -0,0 +1,263 @@
+/** @file
+ * @brief Файл, содержащий функции режима сражения в Тетрис
+ */
+#include "tetris_battle.h"
+
+/**
+ * @brief Создаёт сражение
+ * @details Выделяет одной ареной (см. arena.h) память под поля и массивы
+ * состояния полей и создаёт поля функцией createInfo_t. Все поля получают
+ * одинаковую очерёдность фигур, поэтому игроки находятся в равных условиях.
+ * Генератор случайных чисел сражения выбирает столбцы без клеток в мусорных
+ * линиях
+ * @param battle Указатель на структуру Battle_t
+ * @param count Количество полей (от 1 до BATTLE_MAX_BOARDS)
+ * @param seed Начальное состояние генератора случайных чисел
+ * @return START, если создание прошло успешно, и STOP в противном случае
+ */
+int createBattle(Battle_t *battle, int count, unsigned int seed) {
+  int status = START;
+  memset(battle, 0, sizeof(*battle));
+  if (count < 1 || count > BATTLE_MAX_BOARDS) {
+    status = STOP;
+  } else {
+    size_t boards = (size_t)count;
+    size_t ints = arenaSize(boards * sizeof(int));
+    status = createArena(&battle->arena,
+                         arenaSize(boards * sizeof(TetrisInfo_t)) +
+                             arenaSize(boards * sizeof(long long)) + 3 * ints);
+    if (status == START) {
+      Arena_t *arena = &battle->arena;
+      battle->boards =
+          (TetrisInfo_t *)arenaAlloc(arena, boards * sizeof(TetrisInfo_t));
+      battle->deadlines =
+          (long long *)arenaAlloc(arena, boards * sizeof(long long));
+      battle->alive = (int *)arenaAlloc(arena, boards * sizeof(int));
+      battle->pending = (int *)arenaAlloc(arena, boards * sizeof(int));
+      battle->sent = (int *)arenaAlloc(arena, boards * sizeof(int));
+    }
+    for (int i = 0; i < count && status == START; i++) {
+      status = createInfo_t(&battle->boards[i]);
+      battle->count = i + 1;
+      if (status == START) {
+        dealBoard(&battle->boards[i], seed);
+        battle->alive[i] = 1;
+      }
+    }
+  }
+  if (status == START) {
+    battle->alive_count = count;
+    battle->winner = BATTLE_NO_WINNER;
+    battle->seed = seed;
+  } else {
+    removeBattle(battle);
+  }
+  return status;
+}
+
+/**
+ * @brief Раздаёт фигуры полю сражения
+ * @details Заново определяет очерёдность фигур поля по заданному состоянию
+ * генератора, так же как это делает createInfo_t
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param seed Состояние генератора случайных чисел
+ */
+void dealBoard(TetrisInfo_t *game_state, unsigned int seed) {
+  game_state->seed = seed;
+  orderFigures(game_state);
+  corrSpawn(game_state->figures, FIGURES_COUNT, &game_state->seed);
+  initQueue(game_state);
+  spawnFigure(game_state);
+  tetrisRehash(game_state);
+}
+
+/**
+ * @brief Освобождает память, занятую сражением
+ * @param battle Указатель на структуру Battle_t
+ */
+void removeBattle(Battle_t *battle) {
+  if (battle->boards != NULL) {
+    for (int i = 0; i < battle->count; i++) {
+      removeInfo_t(&battle->boards[i]);
+    }
+  }
+  removeArena(&battle->arena);
+  memset(battle, 0, sizeof(*battle));
+}
+
+/**
+ * @brief Выполняет такт сражения
+ * @details Все поля шагают в одном такте: планировщик проходит по массиву
+ * моментов следующего шага и делает шаг функцией tetrisStep на каждом
+ * участвующем поле, время которого наступило. Если фигура прикрепилась к
+ * полю, то удалённые линии обрабатывает функция battleLock. Поля
+ * обрабатываются по порядку номеров, поэтому результат такта не зависит от
+ * времени вызова внутри такта. Во время паузы такт не выполняется
+ * @param battle Указатель на структуру Battle_t
+ * @param now Текущее время в миллисекундах
+ * @return Количество полей, сделавших шаг
+ */
+int battleStep(Battle_t *battle, long long now) {
+  int stepped = 0;
+  if (!battle->pause && !battleIsOver(battle)) {
+    for (int i = 0; i < battle->count; i++) {
+      if (battle->alive[i] && now >= battle->deadlines[i]) {
+        TetrisInfo_t *game_state = &battle->boards[i];
+        battle->deadlines[i] = now + game_state->game_info.speed;
+        if (tetrisStep(game_state)) {
+          battleLock(battle, i);
+        }
+        stepped++;
+      }
+    }
+  }
+  return stepped;
+}
+
+/**
+ * @brief Обрабатывает прикрепление фигуры к полю игрока
+ * @details Удалённые линии сначала гасят мусорные линии, ожидающие игрока, а
+ * остаток отправляется сопернику, которого выбирает функция battleTarget.
+ * Если игрок не удалил ни одной линии, то ожидающие его мусорные линии
+ * добавляются на поле функцией addGarbage. Если игра на поле окончена, то
+ * игрок выбывает
+ * @param battle Указатель на структуру Battle_t
+ * @param player Номер поля
+ */
+void battleLock(Battle_t *battle, int player) {
+  TetrisInfo_t *game_state = &battle->boards[player];
+  int attack = garbageLines(game_state->last_cleared);
+  int cancelled =
+      attack < battle->pending[player] ? attack : battle->pending[player];
+  battle->pending[player] -= cancelled;
+  attack -= cancelled;
+  int target = battleTarget(battle, player);
+  if (attack > 0 && target != player) {
+    battle->pending[target] += attack;
+    battle->sent[player] += attack;
+  }
+  if (game_state->last_cleared == 0 && battle->pending[player] > 0 &&
+      game_state->game_status != kGameOver) {
+    int rows = battle->pending[player] < HEIGHT ? battle->pending[player]
+                                                : HEIGHT;
+    int hole = randomNumber(&battle->seed) % WIDTH + 1;
+    battle->pending[player] = 0;
+    addGarbage(game_state, rows, hole);
+  }
+  if (game_state->game_status == kGameOver) {
+    battleEliminate(battle, player);
+  }
+}
+
+/**
+ * @brief Исключает игрока из сражения
+ * @details Поле игрока получает статус "game over" и больше не шагает. Если в
+ * сражении нескольких игроков остался один участник, то он объявляется
+ * победителем
+ * @param battle Указатель на структуру Battle_t
+ * @param player Номер поля
+ */
+void battleEliminate(Battle_t *battle, int player) {
+  if (battle->alive[player]) {
+    battle->alive[player] = 0;
+    battle->alive_count--;
+    battle->pending[player] = 0;
+    battle->boards[player].game_status = kGameOver;
+    if (battle->count > 1 && battle->alive_count == 1) {
+      for (int i = 0; i < battle->count; i++) {
+        if (battle->alive[i]) {
+          battle->winner = i;
+          battle->boards[i].game_status = kWin;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Выбирает соперника, который получит мусорные линии
+ * @details Соперником становится следующий по номеру участвующий игрок (по
+ * кругу), поэтому в сражении двух игроков они атакуют друг друга
+ * @param battle Указатель на структуру Battle_t
+ * @param player Номер атакующего поля
+ * @return Номер поля соперника или player, если соперников не осталось
+ */
+int battleTarget(const Battle_t *battle, int player) {
+  int target = player;
+  for (int i = 1; i < battle->count && target == player; i++) {
+    int candidate = (player + i) % battle->count;
+    if (battle->alive[candidate]) {
+      target = candidate;
+    }
+  }
+  return target;
+}
+
+/**
+ * @brief Вычисляет количество мусорных линий за удалённые линии
+ * @details Одна линия не атакует, две линии дают одну мусорную линию, три -
+ * две, четыре (Тетрис) - четыре
+ * @param cleared Количество удалённых линий
+ * @return Количество мусорных линий
+ */
+int garbageLines(int cleared) {
+  int lines = 0;
+  if (cleared == 2) {
+    lines = 1;
+  } else if (cleared == 3) {
+    lines = 2;
+  } else if (cleared >= 4) {
+    lines = 4;
+  }
+  return lines;
+}
+
+/**
+ * @brief Проверяет, окончено ли сражение
+ * @details Сражение нескольких игроков окончено, когда в нём остался один
+ * участник или не осталось ни одного, одиночная игра - когда её поле выбыло
+ * @param battle Указатель на структуру Battle_t
+ * @return true, если сражение окончено, иначе false
+ */
+bool battleIsOver(const Battle_t *battle) {
+  return battle->alive_count <= (battle->count > 1 ? 1 : 0);
+}
+
+/**
+ * @brief Обрабатывает команду игрока
+ * @details Команда Pause ставит на паузу всё сражение и снимает с паузы, при
+ * этом время следующего шага всех полей сдвигается, чтобы пауза не сократила
+ * текущий шаг. Команда Terminate исключает игрока из сражения. Команда
+ * HardDrop сразу фиксирует фигуру, и удалённые линии обрабатывает функция
+ * battleLock. Остальные команды передаются полю игрока функцией
+ * tetrisUserInput. Команды полю выполняются, если игрок участвует в
+ * сражении и оно не на паузе
+ * @param battle Указатель на структуру Battle_t
+ * @param player Номер поля
+ * @param action Команда игрока
+ * @param now Текущее время в миллисекундах
+ */
+void battleInput(Battle_t *battle, int player, UserAction_t action,
+                 long long now) {
+  if (action == Pause) {
+    battle->pause = !battle->pause;
+    for (int i = 0; i < battle->count; i++) {
+      battle->boards[i].game_info.pause = battle->pause;
+      if (!battle->pause) {
+        battle->deadlines[i] = now + battle->boards[i].game_info.speed;
+      }
+    }
+  } else if (action == Terminate) {
+    battleEliminate(battle, player);
+  } else if (battle->alive[player] && !battle->pause) {
+    TetrisInfo_t *game_state = &battle->boards[player];
+    if (action == HardDrop) {
+      moveDown(game_state);
+      if (tetrisStep(game_state)) {
+        battleLock(battle, player);
+      }
+    } else {
+      tetrisUserInput(game_state, action);
+    }
+  }
+}
@@ -0,0 +1,53 @@
+/** @file
+ * @brief Заголовочный файл, определяющий режим сражения в Тетрис
+ * @details В сражении несколько полей играют одновременно и шагают по одному
+ * планировщику. Линии, удалённые на одном поле, превращаются в мусорные линии
+ * на поле соперника
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BATTLE_H_
+#define CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BATTLE_H_
+
+#include "tetris_backend.h"
+
+#define BATTLE_MAX_BOARDS 256
+#define BATTLE_NO_WINNER -1
+
+/**
+ * @brief Состояние сражения
+ * @details Данные полей хранятся в отдельных массивах (structure of arrays):
+ * планировщик на каждом такте просматривает только плотные массивы моментов
+ * следующего шага и признаков участия, а к полям обращается лишь тогда, когда
+ * полю пора сделать шаг
+ */
+typedef struct {
+  int count;
+  int alive_count;
+  int winner;
+  int pause;
+  unsigned int seed;
+  TetrisInfo_t *boards;
+  long long *deadlines;
+  int *alive;
+  int *pending;
+  int *sent;
+  Arena_t arena;
+} Battle_t;
+
+// BATTLE INITIALIZATION & REMOVAL FUNCS
+int createBattle(Battle_t *battle, int count, unsigned int seed);
+void dealBoard(TetrisInfo_t *game_state, unsigned int seed);
+void removeBattle(Battle_t *battle);
+
+// BATTLE LOGIC
+int battleStep(Battle_t *battle, long long now);
+void battleLock(Battle_t *battle, int player);
+void battleEliminate(Battle_t *battle, int player);
+int battleTarget(const Battle_t *battle, int player);
+int garbageLines(int cleared);
+bool battleIsOver(const Battle_t *battle);
+
+// USER'S COMMAND HANDLERS
+void battleInput(Battle_t *battle, int player, UserAction_t action,
+                 long long now);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_BRICK_GAME_TETRIS_TETRIS_BATTLE_H_
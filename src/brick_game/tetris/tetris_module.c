@@ -0,0 +1,186 @@
+/** @file
+ * @brief Файл, содержащий игровой модуль Тетриса
+ * @details Модуль работает с собственным экземпляром TetrisInfo_t, так же как
+ * сессия игрового сервера, и не связан с экземпляром, который возвращает
+ * getTetrisInfo_t
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "../api/game_module.h"
+#include "../common/frame_codec.h"
+#include "tetris_battle.h"
+
+/**
+ * @brief Создаёт игру модуля
+ * @details Очерёдность фигур задаётся состоянием генератора seed функцией
+ * dealBoard, поэтому игры с одинаковым seed и одинаковыми командами проходят
+ * одинаково
+ * @param seed Состояние генератора случайных чисел
+ * @return Указатель на TetrisInfo_t или NULL, если память не выделена
+ */
+static void *tetrisModuleCreate(unsigned int seed) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)calloc(1, sizeof(TetrisInfo_t));
+  if (game_state != NULL && createInfo_t(game_state) != START) {
+    free(game_state);
+    game_state = NULL;
+  }
+  if (game_state != NULL) {
+    dealBoard(game_state, seed);
+    game_state->set_time = setTime();
+    setLockDelay(game_state, TETRIS_LOCK_DELAY, TETRIS_LOCK_RESETS);
+  }
+  return game_state;
+}
+
+/**
+ * @brief Удаляет игру модуля
+ * @param state Указатель на TetrisInfo_t
+ */
+static void tetrisModuleDestroy(void *state) {
+  if (state != NULL) {
+    removeInfo_t((TetrisInfo_t *)state);
+    free(state);
+  }
+}
+
+/**
+ * @brief Обработка команды пользователя
+ * @details Команда Terminate сразу завершает игру, остальные команды
+ * выполняются функцией tetrisMove
+ * @param state Указатель на TetrisInfo_t
+ * @param action Команда пользователя
+ * @param hold Не используется
+ */
+static void tetrisModuleInput(void *state, UserAction_t action, bool hold) {
+  (void)hold;
+  TetrisInfo_t *game_state = (TetrisInfo_t *)state;
+  game_state->action = action;
+  if (action == Terminate) {
+    game_state->game_status = kGameOver;
+  } else {
+    tetrisMove(game_state, action, setTime());
+  }
+}
+
+/**
+ * @brief Выполняет один шаг игры без учёта времени
+ * @details Фигура опускается на строку или фиксируется функцией tetrisStep.
+ * Шаг не выполняется во время паузы и после окончания игры
+ * @param state Указатель на TetrisInfo_t
+ */
+static void tetrisModuleStep(void *state) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)state;
+  if (!game_state->game_info.pause && game_state->game_status == kStart) {
+    if (game_state->game_info.score >= TETRIS_MAX_SCORE) {
+      game_state->game_status = kWin;
+    } else {
+      tetrisStep(game_state);
+    }
+  }
+}
+
+/**
+ * @brief Выполняет такт игры по текущему времени
+ * @details Во время паузы и после окончания игры ничего не происходит, иначе
+ * вызывается tetrisMechanics
+ * @param state Указатель на TetrisInfo_t
+ */
+static void tetrisModuleTick(void *state) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)state;
+  if (!game_state->game_info.pause && game_state->game_status == kStart) {
+    tetrisMechanics(game_state);
+  }
+}
+
+/**
+ * @brief Сериализует состояние игры
+ * @param state Указатель на TetrisInfo_t
+ * @param buffer Буфер размером sizeof(TetrisSnapshot_t) байт
+ */
+static void tetrisModuleSerialize(const void *state, uint8_t *buffer) {
+  TetrisSnapshot_t snapshot;
+  tetrisSnapshot((const TetrisInfo_t *)state, &snapshot);
+  memcpy(buffer, &snapshot, sizeof(snapshot));
+}
+
+/**
+ * @brief Восстанавливает состояние игры из буфера
+ * @param state Указатель на TetrisInfo_t
+ * @param buffer Буфер, заполненный функцией tetrisModuleSerialize
+ */
+static void tetrisModuleDeserialize(void *state, const uint8_t *buffer) {
+  TetrisSnapshot_t snapshot;
+  memcpy(&snapshot, buffer, sizeof(snapshot));
+  tetrisRestore((TetrisInfo_t *)state, &snapshot);
+}
+
+/**
+ * @brief Кодирует состояние игры в ключевой кадр
+ * @details Текущая фигура временно рисуется на поле, матрица следующей
+ * фигуры заполняется по очереди фигур
+ * @param state Указатель на TetrisInfo_t
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ * @return Размер кадра в байтах
+ */
+static int tetrisModuleFrame(void *state, uint8_t *frame) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)state;
+  GameInfo_t *stats = &game_state->game_info;
+  prepareNextFigure(game_state, stats);
+  updateField(stats, &game_state->figure, MOVING_CELL);
+  int size = frameEncode(stats, game_state->game_status, frame);
+  updateField(stats, &game_state->figure, EMPTY_CELL);
+  return size;
+}
+
+/**
+ * @brief Геттер статуса игры
+ * @param state Указатель на TetrisInfo_t
+ * @return Статус игры
+ */
+static GameStatus_t tetrisModuleStatus(const void *state) {
+  return ((const TetrisInfo_t *)state)->game_status;
+}
+
+/**
+ * @brief Считает контрольную сумму состояния игры
+ * @param state Указатель на TetrisInfo_t
+ * @return Контрольная сумма (см. tetrisChecksum)
+ */
+static unsigned long long tetrisModuleChecksum(const void *state) {
+  return tetrisChecksum((const TetrisInfo_t *)state);
+}
+
+/**
+ * @brief Подключает игру к журналу событий
+ * @param state Указатель на TetrisInfo_t
+ * @param events Указатель на источник событий или NULL
+ */
+static void tetrisModuleEvents(void *state, GameEvents_t *events) {
+  ((TetrisInfo_t *)state)->events = events;
+}
+
+/**
+ * @brief Возвращает игровой модуль Тетриса
+ * @return Указатель на статический модуль
+ */
+const GameModule_t *tetrisModule(void) {
+  static const GameModule_t module = {
+      GAME_MODULE_TETRIS,
+      "TETRIS",
+      't',
+      sizeof(TetrisSnapshot_t),
+      {true, START_SPEED, "arrows move, space rotates, x drops, c holds"},
+      tetrisModuleCreate,
+      tetrisModuleDestroy,
+      tetrisModuleInput,
+      tetrisModuleStep,
+      tetrisModuleTick,
+      tetrisModuleSerialize,
+      tetrisModuleDeserialize,
+      tetrisModuleFrame,
+      tetrisModuleStatus,
+      tetrisModuleChecksum,
+      tetrisModuleEvents};
+  return &module;
+}
@@ -0,0 +1,96 @@
+/** @file
+ * @brief Файл, содержащий дифференциальную цель фаззинга двух сборок движка
+ * @details Одна и та же игра проводится двумя движками через C ABI: движком,
+ * собранным вместе с целью (с санитайзерами и без оптимизаций), и
+ * оптимизированной сборкой libbrickgame, загруженной через brickGameOpen.
+ * Путь к сборке задаётся переменной окружения BRICKGAME_ENGINE, по
+ * умолчанию FUZZ_ENGINE. После каждой команды и каждого шага контрольные
+ * суммы состояний (см. lockstep.h) должны совпадать, в конце игры - и
+ * ключевые кадры
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "../brick_game/api/brick_game_loader.h"
+#include "../brick_game/common/frame_codec.h"
+#include "fuzz_common.h"
+
+#define FUZZ_ENGINE "build/libbrickgame.so.1"
+
+/**
+ * @brief Возвращает таблицу функций оптимизированной сборки
+ * @details Сборка загружается при первом вызове и остаётся загруженной до
+ * конца работы программы
+ * @return Указатель на таблицу функций загруженной сборки
+ */
+static const BrickGameApi_t *referenceApi() {
+  static BrickGameLib_t lib = {NULL, NULL};
+  if (lib.api == NULL) {
+    const char *engine = getenv("BRICKGAME_ENGINE");
+    fuzzAssert(brickGameOpen(engine != NULL ? engine : FUZZ_ENGINE, &lib) ==
+                       START &&
+                   brickGameHas(lib.api, offsetof(BrickGameApi_t, checksum)),
+               "couldn't load the reference engine");
+  }
+  return lib.api;
+}
+
+/**
+ * @brief Сравнивает состояния двух игр
+ * @param subject Игра движка, собранного с целью
+ * @param reference Игра оптимизированной сборки
+ * @param what Описание проверки
+ */
+static void checkGames(BrickGame_t *subject, BrickGame_t *reference,
+                       const char *what) {
+  const BrickGameApi_t *api = referenceApi();
+  fuzzAssert(brickGameChecksum(subject) == api->checksum(reference) &&
+                 brickGameStatus(subject) == api->status(reference),
+             what);
+}
+
+/**
+ * @brief Дифференциальная цель фаззинга
+ * @details Младший бит первого байта выбирает игру (Тетрис или Змейка).
+ * Нажатие из события входа передаётся игре командой (отпускания не
+ * передаются), затем игра делает ticks шагов
+ * @param data Вход: seed и события ввода (см. fuzz_common.h)
+ * @param size Размер входа в байтах
+ * @return 0
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const BrickGameApi_t *api = referenceApi();
+  int game = size > 0 && data[0] & 1 ? BRICKGAME_SNAKE : BRICKGAME_TETRIS;
+  unsigned int seed = fuzzSeed(data, size);
+  BrickGame_t *subject = brickGameCreate(game, seed);
+  BrickGame_t *reference = api->create(game, seed);
+  if (subject != NULL && reference != NULL) {
+    checkGames(subject, reference, "create");
+    for (size_t i = FUZZ_HEADER_SIZE;
+         i < size && brickGameStatus(subject) == kStart; i++) {
+      FuzzEvent_t event = fuzzEvent(data[i]);
+      if (event.pressed) {
+        brickGameInput(subject, event.action, event.ticks == 0);
+        api->input(reference, event.action, event.ticks == 0);
+        checkGames(subject, reference, "input");
+      }
+      for (int step = 0; step < event.ticks; step++) {
+        brickGameStep(subject);
+        api->step(reference);
+      }
+      checkGames(subject, reference, "step");
+    }
+    uint8_t subject_frame[FRAME_KEY_SIZE];
+    uint8_t reference_frame[FRAME_KEY_SIZE];
+    int subject_size = brickGameFrame(subject, subject_frame);
+    int reference_size = api->frame(reference, reference_frame);
+    fuzzAssert(subject_size == reference_size &&
+                   !memcmp(subject_frame, reference_frame, subject_size),
+               "key frame");
+  }
+  brickGameDestroy(subject);
+  if (reference != NULL) {
+    api->destroy(reference);
+  }
+  return 0;
+}
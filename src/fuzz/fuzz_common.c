@@ -0,0 +1,61 @@
+/** @file
+ * @brief Файл, содержащий общие функции целей фаззинга
+ */
+#include "fuzz_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Читает seed игры из начала входа
+ * @param data Вход цели
+ * @param size Размер входа в байтах
+ * @return Первые FUZZ_HEADER_SIZE байт входа (little-endian), недостающие
+ * байты считаются нулями
+ */
+unsigned int fuzzSeed(const uint8_t *data, size_t size) {
+  unsigned int seed = 0;
+  for (size_t i = 0; i < FUZZ_HEADER_SIZE && i < size; i++) {
+    seed |= (unsigned int)data[i] << (8 * i);
+  }
+  return seed;
+}
+
+/**
+ * @brief Превращает байт входа в событие ввода
+ * @details Младшие 4 бита от 0 до FUZZ_ACTIONS - 1 задают нажатие команды с
+ * этим номером в UserAction_t, остальные значения - отпускание клавиш Left,
+ * Right и Down, от которых зависят автоповтор сдвига Тетриса, мягкое падение
+ * и ускорение Змейки. Старшие 4 бита задают количество единиц времени после
+ * события. Terminate сразу заканчивает игру, поэтому её даёт только байт,
+ * равный Terminate, а остальные байты с тем же номером команды дают Start:
+ * так случайные входы доходят до длинных партий
+ * @param byte Байт входа
+ * @return Событие ввода
+ */
+FuzzEvent_t fuzzEvent(uint8_t byte) {
+  const UserAction_t releases[] = {Left, Right, Down, Left, Right, Down};
+  int code = byte & 0x0F;
+  FuzzEvent_t event = {(UserAction_t)code, true, byte >> 4};
+  if (event.action == Terminate && byte != Terminate) {
+    event.action = Start;
+  } else if (code >= FUZZ_ACTIONS) {
+    event.action = releases[code - FUZZ_ACTIONS];
+    event.pressed = false;
+  }
+  return event;
+}
+
+/**
+ * @brief Проверяет условие цели
+ * @details При нарушении условия выводит его описание и завершает программу
+ * функцией abort, как того ожидают libFuzzer и AFL
+ * @param condition Проверяемое условие
+ * @param what Описание условия
+ */
+void fuzzAssert(bool condition, const char *what) {
+  if (!condition) {
+    fprintf(stderr, "fuzz check failed: %s\n", what);
+    abort();
+  }
+}
@@ -0,0 +1,53 @@
+/** @file
+ * @brief Заголовочный файл, определяющий общие функции целей фаззинга
+ * @details Цель фаззинга - функция LLVMFuzzerTestOneInput, которая получает
+ * произвольные байты, превращает их в seed игры и последовательность событий
+ * ввода и проверяет, что состояние игры после каждого события совпадает с
+ * эталоном. Цели собираются с libFuzzer (clang -fsanitize=fuzzer) или с
+ * драйвером fuzz_driver.c, который подаёт им случайные входы или файлы
+ * (например, из очереди AFL). Первые FUZZ_HEADER_SIZE байт входа - seed,
+ * каждый следующий байт - событие (см. fuzzEvent)
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_FUZZ_FUZZ_COMMON_H_
+#define CPP3_BRICK_GAME_V2_0_1_FUZZ_FUZZ_COMMON_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../brick_game/common/common_specification.h"
+
+#define FUZZ_HEADER_SIZE 4
+#define FUZZ_ACTIONS 10
+#define FUZZ_TIME_UNIT 20
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Событие ввода, полученное из байта входа
+ * @details action - команда, pressed - нажатие (false - отпускание),
+ * ticks - количество единиц времени (FUZZ_TIME_UNIT миллисекунд) или шагов
+ * игры, которые проходят после события
+ */
+typedef struct {
+  UserAction_t action;
+  bool pressed;
+  int ticks;
+} FuzzEvent_t;
+
+// INPUT DECODING
+unsigned int fuzzSeed(const uint8_t *data, size_t size);
+FuzzEvent_t fuzzEvent(uint8_t byte);
+
+// CHECKS
+void fuzzAssert(bool condition, const char *what);
+
+// FUZZ TARGET
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPP3_BRICK_GAME_V2_0_1_FUZZ_FUZZ_COMMON_H_
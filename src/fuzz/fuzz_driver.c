@@ -0,0 +1,145 @@
+/** @file
+ * @brief Файл, содержащий драйвер целей фаззинга для сборки без libFuzzer
+ * @details Если драйверу переданы файлы, то каждый из них подаётся цели как
+ * вход (так воспроизводятся находки и прогоняется очередь AFL). Иначе цели
+ * подаются -runs=N случайных входов длиной до FUZZ_MAX_INPUT байт,
+ * полученных генератором randomNumber с состоянием -seed=S. Если цель
+ * завершается функцией abort (нарушено условие цели или, при
+ * ASAN_OPTIONS=abort_on_error=1, ошибка санитайзера), то текущий вход
+ * записывается в файл FUZZ_CRASH
+ */
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../brick_game/common/common_back.h"
+#include "fuzz_common.h"
+
+#define FUZZ_MAX_INPUT 512
+#define FUZZ_RUNS 10000
+#define FUZZ_CRASH "fuzz-crash.bin"
+
+/** @brief Вход, который сейчас обрабатывает цель */
+static const uint8_t *current_input = NULL;
+/** @brief Размер текущего входа */
+static size_t current_size = 0;
+
+/**
+ * @brief Обработчик SIGABRT: записывает текущий вход в файл FUZZ_CRASH
+ * @param number Номер сигнала
+ */
+static void saveCrash(int number) {
+  int file = open(FUZZ_CRASH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file >= 0) {
+    ssize_t written = write(file, current_input, current_size);
+    (void)written;
+    close(file);
+  }
+  const char message[] = "input saved to " FUZZ_CRASH "\n";
+  ssize_t written = write(STDERR_FILENO, message, sizeof(message) - 1);
+  (void)written;
+  _exit(128 + number);
+}
+
+/**
+ * @brief Подаёт цели вход и запоминает его для обработчика SIGABRT
+ * @param data Вход
+ * @param size Размер входа в байтах
+ */
+static void runInput(const uint8_t *data, size_t size) {
+  current_input = data;
+  current_size = size;
+  LLVMFuzzerTestOneInput(data, size);
+}
+
+/**
+ * @brief Подаёт цели содержимое файла
+ * @param path Путь к файлу
+ * @return START, если файл прочитан, иначе STOP
+ */
+static int runFile(const char *path) {
+  int status = STOP;
+  FILE *file = fopen(path, "rb");
+  if (file != NULL) {
+    uint8_t *data = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    status = START;
+    int byte = fgetc(file);
+    while (byte != EOF && status == START) {
+      if (size == capacity) {
+        capacity = capacity == 0 ? FUZZ_MAX_INPUT : capacity * 2;
+        uint8_t *grown = (uint8_t *)realloc(data, capacity);
+        if (grown == NULL) {
+          status = STOP;
+        } else {
+          data = grown;
+        }
+      }
+      if (status == START) {
+        data[size++] = (uint8_t)byte;
+        byte = fgetc(file);
+      }
+    }
+    fclose(file);
+    if (status == START) {
+      runInput(data, size);
+    }
+    free(data);
+  }
+  return status;
+}
+
+/**
+ * @brief Подаёт цели случайные входы
+ * @param runs Количество входов
+ * @param seed Состояние генератора случайных чисел
+ */
+static void runRandom(long runs, unsigned int seed) {
+  uint8_t data[FUZZ_MAX_INPUT];
+  for (long run = 0; run < runs; run++) {
+    size_t size = FUZZ_HEADER_SIZE + randomNumber(&seed) %
+                                         (FUZZ_MAX_INPUT - FUZZ_HEADER_SIZE);
+    for (size_t i = 0; i < size; i++) {
+      data[i] = (uint8_t)randomNumber(&seed);
+    }
+    runInput(data, size);
+  }
+}
+
+/**
+ * @brief Начало программы
+ * @details Параметры -runs=N и -seed=S совпадают по смыслу с параметрами
+ * libFuzzer, остальные аргументы считаются путями к входам
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ * @return 0, если все входы обработаны, 1, если файл входа не прочитан
+ */
+int main(int argc, char **argv) {
+  long runs = FUZZ_RUNS;
+  unsigned int seed = 1;
+  int files = 0;
+  int result = 0;
+  signal(SIGABRT, saveCrash);
+  for (int i = 1; i < argc && result == 0; i++) {
+    if (!strncmp(argv[i], "-runs=", 6)) {
+      runs = atol(argv[i] + 6);
+    } else if (!strncmp(argv[i], "-seed=", 6)) {
+      seed = (unsigned int)strtoul(argv[i] + 6, NULL, 10);
+    } else {
+      files++;
+      if (runFile(argv[i]) != START) {
+        fprintf(stderr, "couldn't read %s\n", argv[i]);
+        result = 1;
+      }
+    }
+  }
+  if (files == 0) {
+    runRandom(runs, seed);
+    printf("%s: %ld inputs, seed %u\n", argv[0], runs, seed);
+  }
+  return result;
+}
@@ -0,0 +1,89 @@
+/** @file
+ * @brief Файл, содержащий цель фаззинга бэкенда Змейки
+ * @details События входа проходят тот же путь, что и клавиши консольной
+ * версии: очередь ввода, SnakeController::drainInput (команды применяет
+ * SnakeController::userInput) и такт игры (см. SnakeModel::snakeMechanics),
+ * но время задаётся входом, а не часами. После каждого события тело змейки
+ * и яблоко проверяются по правилам игры, а хеш Зобриста и контрольная сумма
+ * модели - по второй модели, восстановленной из снимка
+ */
+#include <set>
+#include <utility>
+
+extern "C" {
+#include "fuzz_common.h"
+}
+#include "../brick_game/snake/snake_controller.h"
+
+/**
+ * @brief Проверяет тело змейки и яблоко
+ * @details Во время игры тело находится в пределах поля и не пересекает
+ * себя, а яблоко не лежит на теле (кроме головы, которая его ещё не съела)
+ * @param model Модель игры
+ */
+static void checkBody(s21::SnakeModel &model) {
+  const auto &body = model.getSnake().getSnakeBody();
+  std::set<std::pair<int, int>> cells(body.begin(), body.end());
+  if (model.getSnakeInfo_t()->game_status == kStart) {
+    fuzzAssert(cells.size() == body.size(), "snake crosses itself");
+    for (const auto &part : body) {
+      fuzzAssert(part.first >= 1 && part.first <= WIDTH * 2 &&
+                     part.second >= 1 && part.second <= HEIGHT,
+                 "snake outside the field");
+    }
+  }
+  s21::SnakeModel::SnakeSnapshot_t snapshot;
+  model.snapshot(&snapshot);
+  for (size_t i = 0; i + 1 < body.size(); i++) {
+    fuzzAssert(body[i].first != snapshot.apple_x ||
+                   body[i].second != snapshot.apple_y,
+               "apple under the snake");
+  }
+}
+
+/**
+ * @brief Проверяет снимок состояния, хеш и контрольную сумму
+ * @param model Модель игры
+ * @param copy Вторая модель, в которую восстанавливается снимок
+ */
+static void checkSnapshot(const s21::SnakeModel &model, s21::SnakeModel &copy) {
+  s21::SnakeModel::SnakeSnapshot_t snapshot;
+  model.snapshot(&snapshot);
+  copy.restore(snapshot);
+  fuzzAssert(copy.getHash() == model.getHash(), "zobrist hash");
+  fuzzAssert(copy.checksum() == model.checksum(), "snapshot round trip");
+}
+
+/**
+ * @brief Цель фаззинга бэкенда Змейки
+ * @param data Вход: seed и события ввода (см. fuzz_common.h)
+ * @param size Размер входа в байтах
+ * @return 0
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  s21::SnakeModel model;
+  s21::SnakeModel copy;
+  s21::SnakeController controller(&model);
+  s21::SnakeModel::SnakeInfo_t *game_state = model.getSnakeInfo_t();
+  model.seedApple(fuzzSeed(data, size));
+  long long now = 0;
+  for (size_t i = FUZZ_HEADER_SIZE;
+       i < size && game_state->game_status == kStart; i++) {
+    FuzzEvent_t event = fuzzEvent(data[i]);
+    pushInput(&game_state->input, event.action, event.pressed, now);
+    now += event.ticks * FUZZ_TIME_UNIT;
+    controller.drainInput();
+    if (!model.getGameInfo_t()->pause && game_state->game_status == kStart) {
+      if (model.getGameInfo_t()->score == SNAKE_MAX_SCORE) {
+        game_state->game_status = kWin;
+      } else if (game_state->action == Terminate) {
+        game_state->game_status = kGameOver;
+      } else {
+        model.snakeTick(now);
+      }
+    }
+    checkBody(model);
+    checkSnapshot(model, copy);
+  }
+  return 0;
+}
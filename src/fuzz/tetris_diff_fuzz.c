@@ -0,0 +1,190 @@
+/** @file
+ * @brief Файл, содержащий дифференциальную цель фаззинга оптимизированных
+ * путей Тетриса
+ * @details Каждый оптимизированный путь сверяется с простой версией того же
+ * алгоритма: пакетный движок TetrisBatch_t (см. tetris_batch.h) - со
+ * скалярной игрой TetrisInfo_t с тем же seed и теми же командами, удаление
+ * линий compactField - с построчным сдвигом поля, которым линии удалялись
+ * раньше, а расстояние падения dropDistance - с пошаговой проверкой
+ * столкновений
+ */
+#include <string.h>
+
+#include "../brick_game/tetris/tetris_backend.h"
+#include "../brick_game/tetris/tetris_batch.h"
+#include "../brick_game/tetris/tetris_battle.h"
+#include "fuzz_common.h"
+
+/**
+ * @brief Удаляет заполненные линии построчным сдвигом поля
+ * @details Простая версия compactField: каждая заполненная линия удаляется
+ * сдвигом всех строк над ней на одну строку вниз, после чего та же строка
+ * проверяется заново
+ * @param field Поле, строки и клетки которого нумеруются с 1
+ * @return Количество удалённых линий
+ */
+static int shiftLines(int **field) {
+  int how_much = 0;
+  for (int y = HEIGHT; y > 0; y--) {
+    bool is_full = true;
+    for (int x = 1; x <= WIDTH; x++) {
+      is_full = is_full && field[y][x] != EMPTY_CELL;
+    }
+    if (is_full) {
+      how_much++;
+      for (int i = y; i > 1; i--) {
+        for (int x = 1; x <= WIDTH; x++) {
+          field[i][x] = field[i - 1][x];
+        }
+      }
+      for (int x = 1; x <= WIDTH; x++) {
+        field[1][x] = EMPTY_CELL;
+      }
+      y++;
+    }
+  }
+  return how_much;
+}
+
+/**
+ * @brief Сверяет compactField с построчным сдвигом поля
+ * @details Поле строится по байтам входа: строка заполнена целиком, если
+ * младший бит байта равен 1, иначе клетки строки берутся из остальных битов
+ * байта. Обе версии получают одинаковые копии поля
+ * @param data Вход: seed и события ввода (см. fuzz_common.h)
+ * @param size Размер входа в байтах
+ */
+static void checkCompact(const uint8_t *data, size_t size) {
+  int cells[2][HEIGHT + 1][WIDTH + 1];
+  int *compacted[HEIGHT + 1];
+  int *shifted[HEIGHT + 1];
+  memset(cells, 0, sizeof(cells));
+  for (int y = 1; y <= HEIGHT; y++) {
+    uint8_t byte = size > 0 ? data[(y - 1) % size] : 0;
+    for (int x = 1; x <= WIDTH; x++) {
+      bool is_static = byte & 1 || (byte >> (x % 7 + 1)) & 1;
+      cells[0][y][x] = is_static ? STATIC_CELL : EMPTY_CELL;
+    }
+  }
+  memcpy(cells[1], cells[0], sizeof(cells[0]));
+  for (int y = 0; y <= HEIGHT; y++) {
+    compacted[y] = cells[0][y];
+    shifted[y] = cells[1][y];
+  }
+  fuzzAssert(compactField(compacted, HEIGHT, WIDTH) == shiftLines(shifted),
+             "cleared lines");
+  for (int y = 1; y <= HEIGHT; y++) {
+    fuzzAssert(!memcmp(&compacted[y][1], &shifted[y][1], WIDTH * sizeof(int)),
+               "compacted field");
+  }
+}
+
+/**
+ * @brief Сверяет dropDistance с пошаговой проверкой столкновений
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+static void checkDrop(TetrisInfo_t *game_state) {
+  if (game_state->game_status == kStart) {
+    int distance = 0;
+    while (!checkCollision(&game_state->game_info, &game_state->figure, 0,
+                           distance + 1)) {
+      distance++;
+    }
+    fuzzAssert(dropDistance(game_state, &game_state->figure) == distance,
+               "drop distance");
+  }
+}
+
+/**
+ * @brief Сверяет поле пакетного движка со скалярной игрой
+ * @details Сравниваются текущая фигура, клетки поля, очередь фигур, seed
+ * генератора, счёт, уровень, скорость, количество удалённых линий и статус
+ * игры
+ * @param batch Указатель на структуру TetrisBatch_t с одним полем
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param what Описание проверки
+ */
+static void checkBatch(const TetrisBatch_t *batch,
+                       const TetrisInfo_t *game_state, const char *what) {
+  const GameInfo_t *stats = &game_state->game_info;
+  Figure_t figure;
+  batchFigure(batch, 0, &figure);
+  bool is_same = figure.x == game_state->figure.x &&
+                 figure.y == game_state->figure.y &&
+                 figure.width == game_state->figure.width &&
+                 figure.height == game_state->figure.height;
+  for (int y = 0; y < figure.height && is_same; y++) {
+    for (int x = 0; x < figure.width; x++) {
+      is_same = is_same && figure.f[y][x] == game_state->figure.f[y][x];
+    }
+  }
+  for (int y = 1; y <= HEIGHT && is_same; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      is_same = is_same && batchCell(batch, 0, y, x) == stats->field[y][x];
+    }
+  }
+  for (int i = 0; i < TETRIS_PREVIEW && is_same; i++) {
+    is_same = batch->queue[(batch->queue_head[0] + i) % TETRIS_QUEUE_SIZE] ==
+              nextFigure(game_state, i);
+  }
+  fuzzAssert(is_same && batch->curr_figure[0] == game_state->curr_figure &&
+                 batch->seed[0] == game_state->seed &&
+                 batch->score[0] == stats->score &&
+                 batch->level[0] == stats->level &&
+                 batch->speed[0] == stats->speed &&
+                 batch->last_cleared[0] == game_state->last_cleared &&
+                 batch->status[0] == game_state->game_status,
+             what);
+}
+
+/**
+ * @brief Дифференциальная цель фаззинга оптимизированных путей Тетриса
+ * @details Нажатие из события входа передаётся обеим играм командой
+ * (отпускания не передаются), затем обе игры делают ticks шагов падения.
+ * Команды, которых нет в пакетном движке (Hold, Pause, Start и Terminate),
+ * заменяются командой Up, которая ничего не делает
+ * @param data Вход: seed и события ввода (см. fuzz_common.h)
+ * @param size Размер входа в байтах
+ * @return 0
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  unsigned int seed = fuzzSeed(data, size);
+  TetrisBatch_t batch;
+  TetrisInfo_t game_state;
+  checkCompact(data, size);
+  bool is_ready = createBatch(&batch, 1, seed) == START;
+  if (is_ready && createInfo_t(&game_state) != START) {
+    removeBatch(&batch);
+    is_ready = false;
+  }
+  if (is_ready) {
+    dealBoard(&game_state, seed);
+    checkBatch(&batch, &game_state, "create");
+    for (size_t i = FUZZ_HEADER_SIZE;
+         i < size && game_state.game_status == kStart; i++) {
+      FuzzEvent_t event = fuzzEvent(data[i]);
+      if (event.pressed) {
+        UserAction_t action = event.action;
+        if (action == Hold || action == Pause || action == Start ||
+            action == Terminate) {
+          action = Up;
+        }
+        tetrisUserInput(&game_state, action);
+        batchInput(&batch, 0, action);
+        checkBatch(&batch, &game_state, "input");
+        checkDrop(&game_state);
+      }
+      for (int step = 0;
+           step < event.ticks && game_state.game_status == kStart; step++) {
+        game_state.set_time = 0;
+        tetrisMechanics(&game_state);
+        batchStep(&batch);
+      }
+      checkBatch(&batch, &game_state, "step");
+      checkDrop(&game_state);
+    }
+    removeInfo_t(&game_state);
+    removeBatch(&batch);
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+/** @file
+ * @brief Файл, содержащий цель фаззинга бэкенда Тетриса
+ * @details События входа проходят тот же путь, что и клавиши консольной
+ * версии: очередь ввода, tetrisDrainInput и такт игры (см. tetrisMechanics),
+ * но время задаётся входом, а не часами, поэтому любой найденный вход
+ * воспроизводится. После каждого события состояние, которое движок
+ * обновляет по частям (высоты столбцов, хеш Зобриста, расстояние падения),
+ * сравнивается с прямым пересчётом по полю, а снимок состояния - с
+ * восстановленной из него игрой
+ */
+#include "../brick_game/tetris/tetris_backend.h"
+#include "../brick_game/tetris/tetris_battle.h"
+#include "fuzz_common.h"
+
+/**
+ * @brief Проверяет высоты столбцов прямым просмотром поля
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+static void checkHeights(const TetrisInfo_t *game_state) {
+  int **field = game_state->game_info.field;
+  for (int x = 1; x <= WIDTH; x++) {
+    int y = 1;
+    while (y <= HEIGHT && field[y][x] != STATIC_CELL) {
+      y++;
+    }
+    fuzzAssert(game_state->heights[x] == y, "column height");
+  }
+  fuzzAssert(game_state->heights[0] == HEIGHT + 1 &&
+                 game_state->heights[WIDTH + 1] == HEIGHT + 1,
+             "wall height");
+}
+
+/**
+ * @brief Проверяет поле, фигуру и хеш Зобриста
+ * @details Поле содержит только пустые и статичные клетки, фигура во время
+ * игры не пересекает поле, расстояние падения dropDistance совпадает с
+ * пошаговой проверкой столкновений, а хеш, обновлённый по частям, - с хешем,
+ * пересчитанным функцией tetrisRehash
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+static void checkBoard(TetrisInfo_t *game_state) {
+  GameInfo_t *stats = &game_state->game_info;
+  Figure_t *figure = &game_state->figure;
+  for (int y = 1; y <= HEIGHT; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      fuzzAssert(stats->field[y][x] == EMPTY_CELL ||
+                     stats->field[y][x] == STATIC_CELL,
+                 "field cell");
+    }
+  }
+  if (game_state->game_status == kStart) {
+    fuzzAssert(!checkCollision(stats, figure, 0, 0), "figure overlaps");
+    int distance = 0;
+    while (!checkCollision(stats, figure, 0, distance + 1)) {
+      distance++;
+    }
+    fuzzAssert(dropDistance(game_state, figure) == distance, "drop distance");
+  }
+  unsigned long long hash = game_state->hash;
+  unsigned long long field_hash = game_state->field_hash;
+  unsigned long long bag_hash = game_state->bag_hash;
+  tetrisRehash(game_state);
+  fuzzAssert(hash == game_state->hash && field_hash == game_state->field_hash &&
+                 bag_hash == game_state->bag_hash,
+             "zobrist hash");
+}
+
+/**
+ * @brief Проверяет снимок состояния
+ * @param game_state Указатель на структуру TetrisInfo_t
+ * @param copy Указатель на вторую игру, в которую восстанавливается снимок
+ */
+static void checkSnapshot(const TetrisInfo_t *game_state, TetrisInfo_t *copy) {
+  TetrisSnapshot_t snapshot;
+  tetrisSnapshot(game_state, &snapshot);
+  tetrisRestore(copy, &snapshot);
+  fuzzAssert(tetrisChecksum(copy) == tetrisChecksum(game_state),
+             "snapshot round trip");
+}
+
+/**
+ * @brief Цель фаззинга бэкенда Тетриса
+ * @param data Вход: seed и события ввода (см. fuzz_common.h)
+ * @param size Размер входа в байтах
+ * @return 0
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  TetrisInfo_t game_state;
+  TetrisInfo_t copy;
+  bool is_ready = createInfo_t(&game_state) == START;
+  if (is_ready && createInfo_t(&copy) != START) {
+    removeInfo_t(&game_state);
+    is_ready = false;
+  }
+  if (is_ready) {
+    dealBoard(&game_state, fuzzSeed(data, size));
+    setLockDelay(&game_state, TETRIS_LOCK_DELAY, TETRIS_LOCK_RESETS);
+    game_state.set_time = 0;
+    long long now = 0;
+    for (size_t i = FUZZ_HEADER_SIZE;
+         i < size && game_state.game_status == kStart; i++) {
+      FuzzEvent_t event = fuzzEvent(data[i]);
+      pushInput(&game_state.input, event.action, event.pressed, now);
+      now += event.ticks * FUZZ_TIME_UNIT;
+      tetrisDrainInput(&game_state, now);
+      if (!game_state.game_info.pause && game_state.game_status == kStart) {
+        if (game_state.game_info.score >= TETRIS_MAX_SCORE) {
+          game_state.game_status = kWin;
+        } else if (game_state.action == Terminate) {
+          game_state.game_status = kGameOver;
+        } else {
+          tetrisTick(&game_state, now);
+        }
+      }
+      checkHeights(&game_state);
+      checkBoard(&game_state);
+      checkSnapshot(&game_state, &copy);
+    }
+    removeInfo_t(&copy);
+    removeInfo_t(&game_state);
+  }
+  return 0;
+}
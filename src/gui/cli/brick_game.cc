@@ -4,15 +4,22 @@
  */
 #include "brick_game.h"
 
+#include <cctype>
+
 /**
  * @brief Начало программы
  * @details Определяет точку входа в программу, инициализирует генератор
  * случайных чисел (для фигур в Тетрисе и яблока в Змейке), устанавливает
- * настройки терминала и запускает меню выбора игры
+ * настройки терминала и запускает меню выбора игры. В сборке с
+ * BRICKGAME_PROFILE (make profile) запускает сэмплер, если задана
+ * переменная окружения PROFILE_ENV (см. profiler.h)
  *
  * @return 0 в случае успеха
  */
 int main() {
+#ifdef BRICKGAME_PROFILE
+  startProfiler(getenv(PROFILE_ENV));
+#endif
   srand(time(NULL));
   initscr();
   noecho();
@@ -27,33 +34,51 @@ int main() {
 /**
  * @brief Входная точка игры
  * @details В зависимости от выбора игрока запускает игровой цикл,
- * соответствующий выбранной игре, или выходит из игры
+ * соответствующий выбранной игре, или выходит из игры. Тетрис и Змейка
+ * запускаются своими игровыми циклами, остальные игры из реестра игровых
+ * модулей - общим циклом moduleCycle. Если переменная окружения
+ * BRICKGAME_EVENTS содержит путь к файлу, события всех игр дописываются в
+ * этот столбцовый журнал (см. event_log.h)
  */
 void brickGame() {
   int status = START;
+  const char *path = getenv(EVENT_LOG_ENV);
+  EventLog_t events;
+  EventLog_t *log =
+      path != nullptr && createEventLog(&events, path) == START ? &events
+                                                                : nullptr;
   while (status != STOP) {
+    const GameModule_t *module = nullptr;
     printStartScreen();
-    status = getStatus();
-    if (status == TETRIS) {
-      tetrisCycle();
-    }
-    if (status == SNAKE) {
+    status = getStatus(&module);
+    if (status == MODULE && module->id == GAME_MODULE_TETRIS) {
+      tetrisCycle(log);
+    } else if (status == MODULE && module->id == GAME_MODULE_SNAKE) {
       s21::SnakeModel snake_model;
       s21::SnakeController snake_controller(&snake_model);
       s21::SnakeView snake_view(&snake_controller);
-      snake_view.snakeCycle();
+      snake_view.snakeCycle(log);
+    } else if (status == MODULE) {
+      moduleCycle(module, log);
+    }
+    if (status == BATTLE) {
+      battleCycle();
     }
     if (status == STOP) {
       printBye();
       break;
     }
   }
+  if (log != nullptr) {
+    removeEventLog(log);
+  }
 }
 
 /**
  * @brief Функция, выводящая стартовый экран
  * @details Функция, которая рисует на экране стартовое меню, состоящее из
- * рамки, надписей с именами игр и возможных опций
+ * рамки, надписей с именами игр и возможных опций. Игры перечисляются в
+ * порядке регистрации в реестре игровых модулей
  */
 void printStartScreen() {
   clearScreen();
@@ -77,9 +102,14 @@ void printStartScreen() {
   drawDPad();
   printRectangle(0, HEIGHT / 2, HEIGHT + 2, HEIGHT * 2 + 3);
   mvprintw(1, HEIGHT + 3, "CHOOSE THE GAME:");
-  mvprintw(3, HEIGHT + 3, "Press T for TETRIS");
-  mvprintw(4, HEIGHT + 3, "Press S for SNAKE");
-  mvprintw(6, HEIGHT + 3, "Press Q to quit");
+  int count = gameModuleCount();
+  for (int i = 0; i < count; i++) {
+    const GameModule_t *module = gameModuleAt(i);
+    mvprintw(3 + i, HEIGHT + 3, "Press %c for %s", toupper(module->key),
+             module->name);
+  }
+  mvprintw(3 + count, HEIGHT + 3, "Press B for BATTLE");
+  mvprintw(4 + count, HEIGHT + 3, "Press Q to quit");
   mvprintw(HEIGHT, HEIGHT + 3, "powered by yajirobh");
   refresh();
 }
@@ -128,32 +158,37 @@ void drawDPad() {
 /**
  * @brief Определение начала или завершения игры
  * @details Функция ожидает команду пользователя:
- * - если пользователь нажал t или T, запускается Тетрис;
- * - если пользователь нажал s или S, запускается Змейка;
+ * - если пользователь нажал b или B, запускается сражение в Тетрисе;
  * - если пользователь нажал ESCAPE, 'q' или 'Q', игра завершается;
+ * - если клавиша выбирает игру из реестра игровых модулей (t - Тетрис, s -
+ * Змейка), запускается эта игра;
  * и возвращает сигнал, соответствующий выбору игрока
+ * @param module Указатель, в который записывается выбранный модуль
  *
- * @return TETRIS если пользователь нажал t или T, SNAKE если пользователь
- * нажал s или S и STOP если пользователь нажал ESCAPE или 'q' или 'Q'
+ * @return MODULE если клавиша выбирает игру из реестра, BATTLE если
+ * пользователь нажал b или B, STOP если пользователь нажал ESCAPE или 'q' или
+ * 'Q' и START в остальных случаях
  */
 
-int getStatus() {
+int getStatus(const GameModule_t **module) {
   int status = START;
   int c = getch();
   switch (c) {
-  case 't':
-  case 'T':
-    status = TETRIS;
-    break;
-  case 's':
-  case 'S':
-    status = SNAKE;
+  case 'b':
+  case 'B':
+    status = BATTLE;
     break;
   case ESCAPE:
   case 'q':
   case 'Q':
     status = STOP;
     break;
+  default:
+    *module = findGameModuleByKey(c);
+    if (*module != nullptr) {
+      status = MODULE;
+    }
+    break;
   }
   return status;
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 extern "C" {
 #endif
 #include "common/common_cli.h"
+#include "module/module.h"
+#include "tetris/battle.h"
 #include "tetris/tetris.h"
 #ifdef __cplusplus
 }
@@ -19,8 +21,8 @@ extern "C" {
 
 #define START 0
 #define STOP 1
-#define TETRIS 2
-#define SNAKE 3
+#define MODULE 2
+#define BATTLE 3
 
 // ENTRY POINT
 void brickGame();
@@ -28,6 +30,6 @@ void printStartScreen();
 void drawDPad();
 
 // GAME SELECTION
-int getStatus();
+int getStatus(const GameModule_t **module);
 
 #endif // CPP3_BRICK_GAME_V2_0_1_GUI_CLI_BRICK_GAME_H_
\ No newline at end of file
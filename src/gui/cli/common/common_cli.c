@@ -69,22 +69,39 @@ void printRectangle(int top_y, int bottom_y, int left_x, int right_x) {
  * @brief Рисует объекты на поле
  * @details Функция рисует объекты (фигуры в Тетрисе и змея и яблоко в Змейке)
  * заданного размера и в заданных координатах. При отрисовке проверяется, чтобы
- * фигура не выходила за пределы поля. Фигура состоит из символов '[]'
+ * фигура не выходила за пределы поля. Фигура состоит из символов '[]',
+ * "призрак" фигуры в Тетрисе - из символов '::'
  * @param stats Указатель на структуру GameInfo_t, содержащую информацию о
  * положении объектов на поле
  */
-void drawObjects(GameInfo_t *stats) {
+void drawObjects(GameInfo_t *stats) { drawObjectsAt(stats, 0); }
+
+/**
+ * @brief Рисует объекты на поле, смещённом по горизонтали
+ * @details Работает так же, как drawObjects, но левая граница поля находится
+ * в столбце left_x экрана. Используется, когда на экране несколько полей
+ * (режим сражения в Тетрисе)
+ * @param stats Указатель на структуру GameInfo_t, содержащую информацию о
+ * положении объектов на поле
+ * @param left_x Столбец экрана, в котором находится левая граница поля
+ */
+void drawObjectsAt(GameInfo_t *stats, int left_x) {
+  PROFILE_ENTER(PROFILE_DRAW_OBJECTS);
   for (int y = 1; y <= HEIGHT; y++) {
     for (int x = 1; x <= WIDTH; x++) {
       if (stats->field[y][x] == MOVING_CELL ||
           stats->field[y][x] == STATIC_CELL) {
         if (x > 0 && x <= WIDTH * 2 && y > 0 && y <= HEIGHT) {
-          mvaddch(y, x * 2 - 1, '[');
-          mvaddch(y, x * 2, ']');
+          mvaddch(y, left_x + x * 2 - 1, '[');
+          mvaddch(y, left_x + x * 2, ']');
         }
+      } else if (stats->field[y][x] == GHOST_CELL) {
+        mvaddch(y, left_x + x * 2 - 1, ':');
+        mvaddch(y, left_x + x * 2, ':');
       }
     }
   }
+  PROFILE_LEAVE();
 }
 
 /**
@@ -5,11 +5,13 @@
 #define CPP3_BRICK_GAME_V2_0_1_GUI_CLI_COMMON_COMMON_CLI_H_
 
 #include "../../../brick_game/common/common_specification.h"
+#include "../../../brick_game/common/profiler.h"
 
 // GAME ELEMENTS DRAWING FUNCS
 void drawBordersAndStats(int level, int score, int high_score);
 void printRectangle(int top_y, int bottom_y, int left_x, int right_x);
 void drawObjects(GameInfo_t *stats);
+void drawObjectsAt(GameInfo_t *stats, int left_x);
 void clearScreen();
 
 // GAME STATE DRAWING FUNCS
@@ -0,0 +1,211 @@
+/** @file
+ * @brief Файл, содержащий общий планировщик кадров игровых циклов
+ */
+#include "frame_loop.h"
+
+#include <ctype.h>
+
+static bool is_hud_shown = false;
+
+/**
+ * @brief Читает нажатые за кадр клавиши
+ * @details Первое чтение ждёт не дольше установленного timeout, остальные
+ * клавиши читаются без ожидания. Время первой клавиши отмечается в
+ * измерителе, клавиша FRAME_HUD_KEY остаётся у планировщика, а остальные
+ * (не больше FRAME_LOOP_KEYS) возвращаются в буфер ncurses в прежнем
+ * порядке. После чтения timeout равен нулю, поэтому функция ввода игры
+ * забирает клавиши из буфера без ожидания
+ * @param meter Указатель на измеритель времени кадров
+ * @return true, если была нажата клавиша индикатора, иначе false
+ */
+static bool readFrameKeys(FrameMeter_t *meter) {
+  int keys[FRAME_LOOP_KEYS];
+  int count = 0;
+  bool is_toggled = false;
+  int key = getch();
+  long long now = frameMeterMicros();
+  timeout(0);
+  while (key != ERR) {
+    if (key == FRAME_HUD_KEY || key == toupper(FRAME_HUD_KEY)) {
+      is_toggled = !is_toggled;
+    } else {
+      keys[count++] = key;
+    }
+    key = count < FRAME_LOOP_KEYS ? getch() : ERR;
+  }
+  if (count > 0) {
+    frameMeterInput(meter, now);
+  }
+  for (int i = count - 1; i >= 0; i--) {
+    ungetch(keys[i]);
+  }
+  return is_toggled;
+}
+
+/**
+ * @brief Обновляет индикатор производительности
+ * @details Индикатор перерисовывается, когда измеритель опубликовал новые
+ * значения или индикатор был показан клавишей, и стирается, когда он
+ * спрятан. Видимость индикатора сохраняется между играми
+ * @param meter Указатель на измеритель времени кадров
+ * @param is_toggled true, если была нажата клавиша индикатора
+ */
+static void updateFrameHud(FrameMeter_t *meter, bool is_toggled) {
+  bool is_published = frameMeterUpdate(meter, frameMeterMicros());
+  if (is_toggled) {
+    is_hud_shown = !is_hud_shown;
+  }
+  if (is_toggled && !is_hud_shown) {
+    clearFrameHud();
+    refresh();
+  } else if (is_hud_shown && (is_toggled || is_published)) {
+    drawFrameHud(&meter->readout);
+    refresh();
+  }
+}
+
+/**
+ * @brief Выполняет такты симуляции, накопившиеся к моменту now
+ * @details Такты идут с шагом FRAME_LOOP_TICK от часов планировщика clock.
+ * Если за кадр накопилось больше FRAME_LOOP_MAX_TICKS тактов, остаток
+ * задержки отбрасывается и учитывается в статистике
+ * @param loop Указатель на функции игры
+ * @param clock Указатель на часы планировщика
+ * @param now Текущее время
+ * @param stats Указатель на статистику кадров
+ * @return Количество выполненных тактов
+ */
+static int runTicks(const FrameLoop_t *loop, long long *clock, long long now,
+                     FrameStats_t *stats) {
+  int ticks = 0;
+  while (*clock + FRAME_LOOP_TICK <= now && ticks < FRAME_LOOP_MAX_TICKS &&
+         !loop->is_over(loop->game)) {
+    *clock += FRAME_LOOP_TICK;
+    loop->tick(loop->game, *clock);
+    ticks++;
+  }
+  if (*clock + FRAME_LOOP_TICK <= now) {
+    stats->dropped += now - *clock;
+    *clock = now;
+  }
+  stats->ticks += ticks;
+  if (ticks > stats->max_ticks) {
+    stats->max_ticks = ticks;
+  }
+  return ticks;
+}
+
+/**
+ * @brief Управление игровым циклом через планировщик кадров
+ * @details Каждый кадр читает ввод (ожидание клавиши ограничено временем до
+ * конца кадра), выполняет накопившиеся такты и рисует экран, если отпечаток
+ * состояния изменился с прошлой отрисовки. Нажатие клавиши прерывает
+ * ожидание, но кадр заканчивается в назначенное время, поэтому частота
+ * тактов от ввода не зависит. Время тактов, отрисовки и показа кадров
+ * передаётся измерителю индикатора производительности. Нажатие, после
+ * которого экран не изменился, в задержку не входит. Цикл заканчивается,
+ * когда игра сообщает об окончании, индикатор при этом стирается
+ * @param loop Указатель на функции игры
+ * @param stats Указатель на статистику кадров, заполняемую циклом
+ */
+void runFrameLoop(const FrameLoop_t *loop, FrameStats_t *stats) {
+  *stats = (FrameStats_t){0};
+  FrameMeter_t meter;
+  startFrameMeter(&meter, frameMeterMicros());
+  long long clock = setTime();
+  long long deadline = clock + FRAME_LOOP_FRAME;
+  unsigned long long shown = 0;
+  bool is_shown = false;
+  while (!loop->is_over(loop->game)) {
+    long long now = setTime();
+    timeout(deadline > now ? (int)(deadline - now) : 0);
+    bool is_toggled = readFrameKeys(&meter);
+    loop->input(loop->game);
+    now = setTime();
+    if (now >= deadline) {
+      deadline += FRAME_LOOP_FRAME;
+      if (deadline <= now) {
+        deadline = now + FRAME_LOOP_FRAME;
+      }
+    }
+    long long start = frameMeterMicros();
+    int ticks = runTicks(loop, &clock, now, stats);
+    long long ticked = frameMeterMicros();
+    frameMeterTicks(&meter, ticks, ticked - start);
+    unsigned long long hash = loop->state_hash(loop->game);
+    if (!is_shown || hash != shown) {
+      PROFILE_ENTER(PROFILE_RENDER);
+      loop->render(loop->game);
+      refresh();
+      PROFILE_LEAVE();
+      long long presented = frameMeterMicros();
+      frameMeterPresent(&meter, presented - ticked, presented);
+      shown = hash;
+      is_shown = true;
+      stats->renders++;
+    } else {
+      frameMeterSkip(&meter);
+      stats->skipped++;
+    }
+    long long work = frameMeterMicros() - start;
+    stats->work_us += work;
+    if (work > stats->max_work_us) {
+      stats->max_work_us = work;
+    }
+    stats->frames++;
+    updateFrameHud(&meter, is_toggled);
+  }
+  if (is_hud_shown) {
+    clearFrameHud();
+  }
+  timeout(FRAME_LOOP_FRAME);
+}
+
+/**
+ * @brief Выводит статистику времени кадров под игровым полем
+ * @details Строка остаётся на экране до следующей игры, меню её не стирает
+ * @param stats Указатель на статистику кадров
+ */
+void printFrameStats(const FrameStats_t *stats) {
+  long long average = stats->frames > 0 ? stats->work_us / stats->frames : 0;
+  move(HEIGHT + 2, 0);
+  clrtoeol();
+  mvprintw(HEIGHT + 2, 0,
+           "frames %lld  drawn %lld  ticks %lld (max %d/frame)  dropped %lld "
+           "ms  work %lld/%lld us",
+           stats->frames, stats->renders, stats->ticks, stats->max_ticks,
+           stats->dropped, average, stats->max_work_us);
+  refresh();
+}
+
+/**
+ * @brief Рисует индикатор производительности справа от игры
+ * @details В рамке выводятся среднее время такта и отрисовки в
+ * микросекундах, частота показанных кадров, средняя и наибольшая задержка
+ * от клавиши до экрана в миллисекундах
+ * @param readout Указатель на опубликованные значения измерителя
+ */
+void drawFrameHud(const FrameReadout_t *readout) {
+  int top = FRAME_HUD_TOP;
+  int left = FRAME_HUD_LEFT;
+  clearFrameHud();
+  printRectangle(top, top + FRAME_HUD_HEIGHT - 1, left,
+                 left + FRAME_HUD_WIDTH - 1);
+  mvprintw(top + 1, left + 2, "TICK %8.1f us", readout->tick_us);
+  mvprintw(top + 2, left + 2, "DRAW %8.1f us", readout->render_us);
+  mvprintw(top + 3, left + 2, "FPS  %8.1f", readout->fps);
+  mvprintw(top + 4, left + 2, "LAG  %8.1f ms", readout->latency_us / 1000);
+  mvprintw(top + 5, left + 2, "MAX  %8.1f ms",
+           readout->max_latency_us / 1000.0);
+}
+
+/**
+ * @brief Стирает индикатор производительности
+ */
+void clearFrameHud() {
+  for (int y = FRAME_HUD_TOP; y < FRAME_HUD_TOP + FRAME_HUD_HEIGHT; y++) {
+    for (int x = FRAME_HUD_LEFT; x < FRAME_HUD_LEFT + FRAME_HUD_WIDTH; x++) {
+      mvaddch(y, x, ' ');
+    }
+  }
+}
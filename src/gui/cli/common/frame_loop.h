@@ -0,0 +1,82 @@
+/** @file
+ * @brief Заголовочный файл, определяющий общий планировщик кадров игровых
+ * циклов консольной версии
+ * @details Кадр состоит из трёх этапов: чтение ввода, такты симуляции и
+ * отрисовка. Такты идут с фиксированным шагом FRAME_LOOP_TICK по
+ * собственным часам планировщика: если кадр задержался, в следующем кадре
+ * выполняется столько тактов, сколько накопилось, поэтому игра не
+ * замедляется после задержки и не ускоряется, когда кадры идут чаще. Больше
+ * FRAME_LOOP_MAX_TICKS тактов за кадр не выполняется, остаток задержки
+ * отбрасывается. Экран рисуется не чаще раза за кадр и только если
+ * изменился отпечаток состояния игры.
+ *
+ * Клавиша FRAME_HUD_KEY показывает и прячет индикатор справа от игры:
+ * среднее время такта и отрисовки, частоту показанных кадров и задержку от
+ * клавиши до экрана (см. frame_meter.h). Для этого планировщик сам читает
+ * нажатые за кадр клавиши, отмечает время первой и возвращает остальные
+ * в буфер ncurses, откуда их читает функция ввода игры
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_GUI_CLI_COMMON_FRAME_LOOP_H_
+#define CPP3_BRICK_GAME_V2_0_1_GUI_CLI_COMMON_FRAME_LOOP_H_
+
+#include "../../../brick_game/common/common_back.h"
+#include "../../../brick_game/common/frame_meter.h"
+#include "common_cli.h"
+
+#define FRAME_LOOP_FRAME 50
+#define FRAME_LOOP_TICK 10
+#define FRAME_LOOP_MAX_TICKS 20
+#define FRAME_LOOP_KEYS 16
+#define FRAME_HUD_KEY 'h'
+#define FRAME_HUD_TOP 0
+#define FRAME_HUD_LEFT (HEIGHT + 25)
+#define FRAME_HUD_WIDTH 19
+#define FRAME_HUD_HEIGHT 7
+
+/**
+ * @brief Функции игры, которые вызывает планировщик кадров
+ * @details input читает нажатые клавиши (первое чтение ждёт не дольше
+ * установленного планировщиком timeout), tick выполняет такт игры на момент
+ * now часов планировщика, render рисует игру, state_hash возвращает
+ * отпечаток состояния, по которому определяется, нужна ли отрисовка,
+ * is_over сообщает об окончании игры. game передаётся в каждую функцию
+ */
+typedef struct {
+  void *game;
+  void (*input)(void *game);
+  void (*tick)(void *game, long long now);
+  void (*render)(void *game);
+  unsigned long long (*state_hash)(void *game);
+  bool (*is_over)(void *game);
+} FrameLoop_t;
+
+/**
+ * @brief Статистика времени кадров
+ * @details frames - количество кадров, ticks - выполненные такты,
+ * max_ticks - наибольшее количество тактов за кадр, renders и skipped -
+ * кадры с отрисовкой и без неё, dropped - отброшенное время задержек в
+ * миллисекундах, work_us и max_work_us - суммарное и наибольшее время
+ * тактов и отрисовки кадра в микросекундах
+ */
+typedef struct {
+  long long frames;
+  long long ticks;
+  int max_ticks;
+  long long renders;
+  long long skipped;
+  long long dropped;
+  long long work_us;
+  long long max_work_us;
+} FrameStats_t;
+
+// MAIN GAME CYCLE
+void runFrameLoop(const FrameLoop_t *loop, FrameStats_t *stats);
+
+// FRAME STATS
+void printFrameStats(const FrameStats_t *stats);
+
+// PERFORMANCE HUD
+void drawFrameHud(const FrameReadout_t *readout);
+void clearFrameHud();
+
+#endif // CPP3_BRICK_GAME_V2_0_1_GUI_CLI_COMMON_FRAME_LOOP_H_
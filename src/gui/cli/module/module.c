@@ -0,0 +1,156 @@
+/** @file
+ * @brief Файл, запускающий общий игровой цикл для игр из реестра игровых
+ * модулей
+ */
+#include "module.h"
+
+/**
+ * @brief Управление игровым циклом игры модуля
+ * @details Создаёт игру модуля и передаёт её планировщику кадров (см.
+ * frame_loop.h). Игра видна интерфейсу только через ключевой кадр, поэтому
+ * цикл подходит любой игре, которая зарегистрирована в реестре. Если игру не
+ * удалось создать, выводится сообщение об ошибке. Если модуль пишет события,
+ * игра подключается к журналу
+ * @param module Игровой модуль
+ * @param log Указатель на открытый журнал событий или NULL
+ */
+void moduleCycle(const GameModule_t *module, EventLog_t *log) {
+  ModuleGame_t game = {module, module->create((unsigned int)setTime()), {0}};
+  GameEvents_t events;
+  if (game.state == NULL) {
+    printStatusScreen(kError);
+  } else {
+    clearScreen();
+    if (log != NULL && module->events != NULL) {
+      startGameEvents(&events, log, (int)(setTime() / SECOND), module->id);
+      module->events(game.state, &events);
+    }
+    FrameLoop_t loop = {&game,             moduleFrameInput, moduleFrameTick,
+                        moduleFrameRender, moduleFrameHash,  moduleFrameIsOver};
+    FrameStats_t stats;
+    runFrameLoop(&loop, &stats);
+    printStatusScreen(module->status(game.state));
+    printFrameStats(&stats);
+    module->destroy(game.state);
+  }
+}
+
+/**
+ * @brief Читает ввод за кадр
+ * @details Каждая нажатая клавиша превращается в команду функцией
+ * setUserAction и передаётся модулю
+ * @param game Указатель на ModuleGame_t
+ */
+void moduleFrameInput(void *game) {
+  ModuleGame_t *module_game = (ModuleGame_t *)game;
+  int key = getch();
+  timeout(0);
+  while (key != ERR) {
+    UserAction_t action = Up;
+    setUserAction(key, &action);
+    if (action != Up) {
+      module_game->module->input(module_game->state, action, false);
+    }
+    key = getch();
+  }
+}
+
+/**
+ * @brief Выполняет такт игры
+ * @details Такт модуля сам читает часы, поэтому время планировщика не
+ * передаётся, и после задержки модуль выполняет не больше одного шага
+ * @param game Указатель на ModuleGame_t
+ * @param now Не используется
+ */
+void moduleFrameTick(void *game, long long now) {
+  (void)now;
+  ModuleGame_t *module_game = (ModuleGame_t *)game;
+  module_game->module->tick(module_game->state);
+}
+
+/**
+ * @brief Отрисовывает кадр игры
+ * @param game Указатель на ModuleGame_t
+ */
+void moduleFrameRender(void *game) {
+  ModuleGame_t *module_game = (ModuleGame_t *)game;
+  module_game->module->frame(module_game->state, module_game->frame);
+  drawFrame(module_game->module, module_game->frame);
+}
+
+/**
+ * @brief Возвращает отпечаток состояния игры для планировщика
+ * @details Состояние кодируется в ключевой кадр, отпечаток - хеш FNV-1a
+ * его байтов
+ * @param game Указатель на ModuleGame_t
+ * @return Отпечаток состояния
+ */
+unsigned long long moduleFrameHash(void *game) {
+  ModuleGame_t *module_game = (ModuleGame_t *)game;
+  module_game->module->frame(module_game->state, module_game->frame);
+  unsigned long long hash = 14695981039346656037ULL;
+  for (int i = 0; i < FRAME_KEY_SIZE; i++) {
+    hash = (hash ^ module_game->frame[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Проверяет, закончена ли игра
+ * @param game Указатель на ModuleGame_t
+ * @return true, если игра проиграна или выиграна, иначе false
+ */
+bool moduleFrameIsOver(void *game) {
+  ModuleGame_t *module_game = (ModuleGame_t *)game;
+  GameStatus_t status = module_game->module->status(module_game->state);
+  return status == kGameOver || status == kWin;
+}
+
+/**
+ * @brief Рисует игру по ключевому кадру
+ * @details Во время паузы выводится экран паузы. Иначе рисуются рамки,
+ * статистика и клетки поля так же, как их рисует drawObjects, а если модуль
+ * сообщает, что у игры есть следующая фигура, - окно следующей фигуры
+ * @param module Игровой модуль
+ * @param frame Ключевой кадр
+ */
+void drawFrame(const GameModule_t *module, const uint8_t *frame) {
+  if (framePause(frame)) {
+    printStatusScreen(kPause);
+  } else {
+    clearScreen();
+    drawBordersAndStats(frameLevel(frame), frameScore(frame),
+                        frameHighScore(frame));
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        int cell = frameCell(frame, y, x);
+        if (cell == MOVING_CELL || cell == STATIC_CELL) {
+          mvaddch(y + 1, x * 2 + 1, '[');
+          mvaddch(y + 1, x * 2 + 2, ']');
+        } else if (cell == GHOST_CELL) {
+          mvaddch(y + 1, x * 2 + 1, ':');
+          mvaddch(y + 1, x * 2 + 2, ':');
+        }
+      }
+    }
+    if (module->hints.has_next) {
+      drawFrameNext(frame);
+    }
+  }
+}
+
+/**
+ * @brief Отображает следующую фигуру из ключевого кадра
+ * @details Окно совпадает с окном следующей фигуры Тетриса, фигура состоит из
+ * символов '#'
+ * @param frame Ключевой кадр
+ */
+void drawFrameNext(const uint8_t *frame) {
+  printRectangle(13, 20, HEIGHT + 3, HEIGHT + 12);
+  mvprintw(14, HEIGHT + 6, "NEXT");
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      mvaddch(16 + y, HEIGHT + 6 + x, frameNext(frame, y, x) ? '#' : ' ');
+    }
+  }
+}
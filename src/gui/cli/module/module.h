@@ -0,0 +1,37 @@
+/** @file
+ * @brief Заголовочный файл, определяющий общий игровой цикл консольной версии
+ * для игр из реестра игровых модулей
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_GUI_CLI_MODULE_MODULE_H_
+#define CPP3_BRICK_GAME_V2_0_1_GUI_CLI_MODULE_MODULE_H_
+
+#include "../../../brick_game/api/game_module.h"
+#include "../../../brick_game/common/frame_codec.h"
+#include "../../../brick_game/tetris/tetris_backend.h"
+#include "../common/common_cli.h"
+#include "../common/frame_loop.h"
+
+/**
+ * @brief Игра модуля в общем игровом цикле
+ * @details state - состояние, созданное модулем, frame - последний
+ * закодированный кадр
+ */
+typedef struct {
+  const GameModule_t *module;
+  void *state;
+  uint8_t frame[FRAME_KEY_SIZE];
+} ModuleGame_t;
+
+// MAIN GAME CYCLE
+void moduleCycle(const GameModule_t *module, EventLog_t *log);
+void moduleFrameInput(void *game);
+void moduleFrameTick(void *game, long long now);
+void moduleFrameRender(void *game);
+unsigned long long moduleFrameHash(void *game);
+bool moduleFrameIsOver(void *game);
+
+// GAME ELEMENTS DRAWING FUNCS
+void drawFrame(const GameModule_t *module, const uint8_t *frame);
+void drawFrameNext(const uint8_t *frame);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_GUI_CLI_MODULE_MODULE_H_
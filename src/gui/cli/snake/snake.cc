@@ -17,36 +17,118 @@ SnakeView::~SnakeView() {}
 
 /**
  * @brief Управление игровым циклом
- * @details Инициализирует начальное состояние игры и входит в цикл обработки
- * ввода и обновления состояния игры. Внутри цикла обрабатывается ввод
- * пользователя, обновляется состояние игры, отрисовываются основные игровые
- * элементы (поле, фигуры и статистика) и проверяется условие паузы или
- * завершения игры
- */
-void SnakeView::snakeCycle() {
-  timeout(50);
+ * @details Инициализирует начальное состояние игры и передаёт его
+ * планировщику кадров (см. frame_loop.h), который читает ввод, выполняет
+ * такты игры и отрисовывает основные игровые элементы (поле, змейку, яблоко
+ * и статистику). После завершения цикла выводит статистику кадров
+ * @param log Указатель на открытый журнал событий или nullptr
+ */
+void SnakeView::snakeCycle(EventLog_t *log) {
   clearScreen();
-  SnakeModel::SnakeInfo_t *game_state =
-      snake_controller_->getModel()->getSnakeInfo_t();
+  SnakeModel *model = snake_controller_->getModel();
+  SnakeModel::SnakeInfo_t *game_state = model->getSnakeInfo_t();
+  GameEvents_t events;
+  if (log != nullptr) {
+    startGameEvents(&events, log, static_cast<int>(setTime() / SECOND),
+                    GAME_MODULE_SNAKE);
+    model->setEvents(&events);
+  }
   game_state->set_time = setTime();
-  while (game_state->game_status != kGameOver &&
-         game_state->game_status != kWin) {
-    snake_controller_->getUserInput();
-    GameInfo_t stats = snake_controller_->updateCurrentState();
-    if (stats.pause) {
-      printStatusScreen(kPause);
-      if (game_state->action == Terminate) {
-        game_state->game_status = kGameOver;
-      }
-      continue;
+  FrameLoop_t loop = {this,        frameInput, frameTick,
+                      frameRender, frameHash,  frameIsOver};
+  FrameStats_t stats;
+  runFrameLoop(&loop, &stats);
+  printStatusScreen(game_state->game_status);
+  printFrameStats(&stats);
+  model->setEvents(nullptr);
+}
+
+/**
+ * @brief Читает ввод за кадр
+ * @details Нажатые клавиши применяются контроллером. Команда завершения
+ * сразу заканчивает игру, в том числе во время паузы
+ * @param view Указатель на SnakeView
+ */
+void SnakeView::frameInput(void *view) {
+  SnakeController *controller =
+      static_cast<SnakeView *>(view)->snake_controller_;
+  SnakeModel::SnakeInfo_t *game_state =
+      controller->getModel()->getSnakeInfo_t();
+  controller->getUserInput();
+  if (game_state->action == Terminate) {
+    game_state->game_status = kGameOver;
+  }
+}
+
+/**
+ * @brief Выполняет такт игры на момент now часов планировщика
+ * @details Во время паузы ничего не происходит, иначе статистика копируется
+ * в SnakeInfo_t и змейка делает шаг функцией snakeTick, если его время
+ * наступило
+ * @param view Указатель на SnakeView
+ * @param now Время такта
+ */
+void SnakeView::frameTick(void *view, long long now) {
+  SnakeModel *model =
+      static_cast<SnakeView *>(view)->snake_controller_->getModel();
+  SnakeModel::SnakeInfo_t *game_state = model->getSnakeInfo_t();
+  GameInfo_t *stats = model->getGameInfo_t();
+  if (!stats->pause && game_state->game_status == kStart) {
+    game_state->game_info = *stats;
+    if (stats->score == SNAKE_MAX_SCORE) {
+      game_state->game_status = kWin;
+    } else {
+      model->snakeTick(now);
     }
+  }
+}
+
+/**
+ * @brief Отрисовывает кадр игры
+ * @details Во время паузы выводится экран паузы, иначе рисуются поле,
+ * змейка, яблоко и статистика
+ * @param view Указатель на SnakeView
+ */
+void SnakeView::frameRender(void *view) {
+  SnakeController *controller =
+      static_cast<SnakeView *>(view)->snake_controller_;
+  GameInfo_t stats = controller->updateCurrentState();
+  if (stats.pause) {
+    printStatusScreen(kPause);
+  } else {
     clearScreen();
     drawBordersAndStats(stats.level, stats.score, stats.high_score);
-    snake_controller_->getModel()->updateField(stats);
+    controller->getModel()->updateField(stats);
     drawObjects(&stats);
-    game_state->game_info = stats;
-    snake_controller_->getModel()->snakeMechanics(game_state->game_status);
   }
-  printStatusScreen(game_state->game_status);
 }
-} // namespace s21
\ No newline at end of file
+
+/**
+ * @brief Возвращает отпечаток состояния игры для планировщика
+ * @details Хеш Зобриста покрывает змейку и яблоко, к нему добавляются пауза и
+ * статус игры. Счёт меняется только вместе со змейкой
+ * @param view Указатель на SnakeView
+ * @return Отпечаток состояния
+ */
+unsigned long long SnakeView::frameHash(void *view) {
+  SnakeModel *model =
+      static_cast<SnakeView *>(view)->snake_controller_->getModel();
+  return model->getHash() ^
+         static_cast<unsigned long long>(model->getGameInfo_t()->pause) << 60 ^
+         static_cast<unsigned long long>(model->getSnakeInfo_t()->game_status)
+             << 56;
+}
+
+/**
+ * @brief Проверяет, закончена ли игра
+ * @param view Указатель на SnakeView
+ * @return true, если игра проиграна или выиграна, иначе false
+ */
+bool SnakeView::frameIsOver(void *view) {
+  GameStatus_t status = static_cast<SnakeView *>(view)
+                            ->snake_controller_->getModel()
+                            ->getSnakeInfo_t()
+                            ->game_status;
+  return status == kGameOver || status == kWin;
+}
+} // namespace s21
@@ -10,9 +10,11 @@
 extern "C" {
 #endif
 #include "../common/common_cli.h"
+#include "../common/frame_loop.h"
 #ifdef __cplusplus
 }
 #endif
+#include "../../../brick_game/api/game_module.h"
 #include "../../../brick_game/snake/snake_controller.h"
 
 namespace s21 {
@@ -30,10 +32,17 @@ public:
   ~SnakeView();
 
   // MAIN GAME CYCLE
-  void snakeCycle();
+  void snakeCycle(EventLog_t *log);
 
 private:
   SnakeController *snake_controller_;
+
+  // FRAME LOOP HOOKS
+  static void frameInput(void *view);
+  static void frameTick(void *view, long long now);
+  static void frameRender(void *view);
+  static unsigned long long frameHash(void *view);
+  static bool frameIsOver(void *view);
 };
 
 } // namespace s21
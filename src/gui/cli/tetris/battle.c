@@ -0,0 +1,187 @@
+/** @file
+ * @brief Файл, запускающий игровой цикл сражения в Тетрисе на одном экране
+ */
+#include "battle.h"
+
+/**
+ * @brief Управление игровым циклом сражения
+ * @details Создаёт сражение двух игроков и входит в цикл, в котором
+ * обрабатываются все нажатые за кадр клавиши обоих игроков, выполняется такт
+ * сражения и отрисовываются поля. Первый игрок управляет клавишами W, A, S,
+ * D, второй - стрелками. Клавиша P ставит сражение на паузу, Q или ESCAPE
+ * завершают его. После окончания сражения выводится его результат и
+ * освобождаются ресурсы
+ */
+void battleCycle() {
+  Battle_t battle;
+  if (createBattle(&battle, BATTLE_PLAYERS, (unsigned int)rand()) != START) {
+    printStatusScreen(kError);
+  } else {
+    bool quit = false;
+    clear();
+    while (!quit && !battleIsOver(&battle)) {
+      timeout(50);
+      int key = getch();
+      long long now = setTime();
+      timeout(0);
+      while (key != ERR && !quit) {
+        int player = 0;
+        UserAction_t action = Up;
+        if (key == ESCAPE || key == 'q' || key == 'Q') {
+          quit = true;
+        } else if (setBattleAction(key, &player, &action)) {
+          battleInput(&battle, player, action, now);
+        }
+        key = getch();
+      }
+      battleStep(&battle, now);
+      drawBattle(&battle);
+    }
+    printBattleResult(quit ? BATTLE_NO_WINNER : battle.winner);
+    clear();
+  }
+  timeout(50);
+  removeBattle(&battle);
+}
+
+/**
+ * @brief Определяет игрока и команду по нажатой клавише
+ * @details Клавиши W, A, S, D - поворот, сдвиг влево, мгновенное падение и
+ * сдвиг вправо фигуры первого игрока, стрелки - те же команды второго игрока.
+ * Клавиша P - пауза сражения
+ * @param key Код нажатой клавиши
+ * @param player Указатель на номер игрока
+ * @param action Указатель на команду
+ * @return true, если клавиша соответствует команде, иначе false
+ */
+bool setBattleAction(int key, int *player, UserAction_t *action) {
+  bool is_action = true;
+  *player = key == KEY_UP || key == KEY_LEFT || key == KEY_DOWN ||
+            key == KEY_RIGHT;
+  switch (key) {
+  case 'w':
+  case 'W':
+  case KEY_UP:
+    *action = Action;
+    break;
+  case 'a':
+  case 'A':
+  case KEY_LEFT:
+    *action = Left;
+    break;
+  case 's':
+  case 'S':
+  case KEY_DOWN:
+    *action = HardDrop;
+    break;
+  case 'd':
+  case 'D':
+  case KEY_RIGHT:
+    *action = Right;
+    break;
+  case 'p':
+  case 'P':
+    *action = Pause;
+    break;
+  default:
+    is_action = false;
+    break;
+  }
+  return is_action;
+}
+
+/**
+ * @brief Отрисовывает сражение
+ * @details Поля игроков рисуются рядом друг с другом, справа от каждого поля -
+ * панель со статистикой игрока. Во время паузы поверх полей выводится
+ * подсказка
+ * @param battle Указатель на структуру Battle_t
+ */
+void drawBattle(Battle_t *battle) {
+  erase();
+  for (int i = 0; i < battle->count; i++) {
+    drawBattleBoard(battle, i);
+  }
+  if (battle->pause) {
+    mvprintw(HEIGHT / 2, WIDTH - 3, "GAME PAUSED");
+    mvprintw(HEIGHT / 2 + 1, WIDTH - 5, "Press P to resume");
+  }
+  refresh();
+}
+
+/**
+ * @brief Отрисовывает поле игрока
+ * @details Рисует границы поля, статичные клетки, падающую фигуру и её
+ * "призрак", как в одиночной игре, и панель со статистикой игрока
+ * @param battle Указатель на структуру Battle_t
+ * @param player Номер игрока
+ */
+void drawBattleBoard(Battle_t *battle, int player) {
+  TetrisInfo_t *game_state = &battle->boards[player];
+  GameInfo_t *stats = &game_state->game_info;
+  int left_x = player * BATTLE_BOARD_WIDTH;
+  printRectangle(0, HEIGHT + 1, left_x, left_x + WIDTH * 2 + 1);
+  if (battle->alive[player]) {
+    Figure_t *figure = &game_state->figure;
+    Figure_t ghost;
+    getGhostFigure(game_state, &ghost);
+    updateField(stats, &ghost, GHOST_CELL);
+    updateField(stats, figure, MOVING_CELL);
+    drawObjectsAt(stats, left_x);
+    updateField(stats, figure, EMPTY_CELL);
+    updateField(stats, &ghost, EMPTY_CELL);
+  } else {
+    drawObjectsAt(stats, left_x);
+    mvprintw(HEIGHT / 2, left_x + WIDTH - 3, "KNOCKED");
+    mvprintw(HEIGHT / 2 + 1, left_x + WIDTH - 1, "OUT");
+  }
+  drawBattlePanel(battle, player, left_x + WIDTH * 2 + 2);
+}
+
+/**
+ * @brief Отрисовывает панель со статистикой игрока
+ * @details Панель показывает номер игрока, счёт, количество ожидающих его
+ * мусорных линий и следующую фигуру
+ * @param battle Указатель на структуру Battle_t
+ * @param player Номер игрока
+ * @param left_x Столбец экрана, в котором находится левая граница панели
+ */
+void drawBattlePanel(Battle_t *battle, int player, int left_x) {
+  TetrisInfo_t *game_state = &battle->boards[player];
+  const Figure_t *figure = figureShape(nextFigure(game_state, 0));
+  printRectangle(0, HEIGHT + 1, left_x, left_x + 11);
+  mvprintw(1, left_x + 2, "PLAYER %d", player + 1);
+  mvprintw(3, left_x + 2, "SCORE");
+  mvprintw(4, left_x + 2, "%d", game_state->game_info.score);
+  mvprintw(6, left_x + 2, "GARBAGE");
+  mvprintw(7, left_x + 2, "%d", battle->pending[player]);
+  mvprintw(9, left_x + 2, "SENT");
+  mvprintw(10, left_x + 2, "%d", battle->sent[player]);
+  mvprintw(12, left_x + 2, "NEXT");
+  for (int y = 0; y < figure->height; y++) {
+    for (int x = 0; x < figure->width; x++) {
+      if (figure->f[y][x] == MOVING_CELL) {
+        mvaddch(14 + y, left_x + 3 + x, '#');
+      }
+    }
+  }
+}
+
+/**
+ * @brief Отображает результат сражения
+ * @details Очищает экран и выводит номер победителя или сообщение о том, что
+ * сражение прервано. Сообщение выводится с задержкой в секунду
+ * @param winner Номер победителя или BATTLE_NO_WINNER
+ */
+void printBattleResult(int winner) {
+  erase();
+  printRectangle(0, HEIGHT + 1, 0, HEIGHT + 1);
+  if (winner == BATTLE_NO_WINNER) {
+    mvprintw(HEIGHT / 2, 4, "BATTLE IS OVER");
+  } else {
+    mvprintw(HEIGHT / 2, 6, "PLAYER %d", winner + 1);
+    mvprintw(HEIGHT / 2 + 1, 8, "WINS!");
+  }
+  refresh();
+  sleep(1);
+}
@@ -0,0 +1,24 @@
+/** @file
+ * @brief Заголовочный файл, определяющий параметры для старта сражения в
+ * Тетрисе на одном экране
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_GUI_CLI_TETRIS_BATTLE_H_
+#define CPP3_BRICK_GAME_V2_0_1_GUI_CLI_TETRIS_BATTLE_H_
+
+#include "../../../brick_game/tetris/tetris_battle.h"
+#include "../common/common_cli.h"
+
+#define BATTLE_PLAYERS 2
+#define BATTLE_BOARD_WIDTH (WIDTH * 2 + 14)
+
+// MAIN GAME CYCLE
+void battleCycle();
+bool setBattleAction(int key, int *player, UserAction_t *action);
+
+// GAME ELEMENTS DRAWING FUNCS
+void drawBattle(Battle_t *battle);
+void drawBattleBoard(Battle_t *battle, int player);
+void drawBattlePanel(Battle_t *battle, int player, int left_x);
+void printBattleResult(int winner);
+
+#endif // CPP3_BRICK_GAME_V2_0_1_GUI_CLI_TETRIS_BATTLE_H_
@@ -5,62 +5,172 @@
 
 /**
  * @brief Управление игровым циклом
- * @details Инициализирует начальное состояние игры и входит в цикл обработки
- * ввода и обновления состояния игры. Если игра не может быть инициализирована,
- * выводит сообщение об ошибке. Внутри цикла обрабатывается ввод пользователя,
- * обновляется состояние игры, отрисовываются основные игровые элементы (поле,
- * фигуры и статистика) и проверяется условие паузы или завершения игры. После
- * завершения цикла, освобождает ресурсы, связанные с состоянием игры
+ * @details Инициализирует начальное состояние игры и передаёт его
+ * планировщику кадров (см. frame_loop.h), который читает ввод, выполняет
+ * такты игры и отрисовывает основные игровые элементы (поле, фигуры,
+ * "призрак" падающей фигуры, статистику, отложенную фигуру и очередь
+ * следующих фигур). Если игра не может быть инициализирована, выводит
+ * сообщение об ошибке. После завершения цикла выводит статистику кадров и
+ * освобождает ресурсы, связанные с состоянием игры
+ * @param log Указатель на открытый журнал событий или NULL
  */
-void tetrisCycle() {
-  timeout(50);
+void tetrisCycle(EventLog_t *log) {
   TetrisInfo_t *game_state = getTetrisInfo_t();
+  GameEvents_t events;
   if (game_state == NULL) {
     printStatusScreen(kError);
   } else {
     clearScreen();
-    game_state->set_time = setTime();
-    while (game_state->game_status != kGameOver &&
-           game_state->game_status != kWin) {
-      getUserInput();
-      GameInfo_t stats = updateCurrentState();
-      if (stats.pause) {
-        printStatusScreen(kPause);
-        if (game_state->action == Terminate) {
-          game_state->game_status = kGameOver;
-        }
-        continue;
-      }
-      Figure_t *figure = &game_state->figure;
-      clearScreen();
-      drawBordersAndStats(stats.level, stats.score, stats.high_score);
-      updateField(&stats, figure, MOVING_CELL);
-      drawObjects(&stats);
-      updateField(&stats, figure, EMPTY_CELL);
-      drawNextFigure(&game_state->next_figure);
-      game_state->game_info = stats;
-      tetrisMechanics(game_state);
+    if (log != NULL) {
+      startGameEvents(&events, log, (int)(setTime() / SECOND),
+                      GAME_MODULE_TETRIS);
+      game_state->events = &events;
     }
+    game_state->set_time = setTime();
+    setLockDelay(game_state, TETRIS_LOCK_DELAY, TETRIS_LOCK_RESETS);
+    FrameLoop_t loop = {game_state,        tetrisFrameInput, tetrisFrameTick,
+                        tetrisFrameRender, tetrisFrameHash,  tetrisFrameIsOver};
+    FrameStats_t stats;
+    runFrameLoop(&loop, &stats);
     printStatusScreen(game_state->game_status);
+    printFrameStats(&stats);
+    game_state->events = NULL;
   }
   removeGameInfo_t();
 }
 
+/**
+ * @brief Читает ввод за кадр
+ * @details Нажатые клавиши применяются функцией getUserInput. Команда
+ * завершения сразу заканчивает игру, в том числе во время паузы
+ * @param game Указатель на структуру TetrisInfo_t
+ */
+void tetrisFrameInput(void *game) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)game;
+  getUserInput();
+  if (game_state->action == Terminate) {
+    game_state->game_status = kGameOver;
+  }
+}
+
+/**
+ * @brief Выполняет такт игры на момент now часов планировщика
+ * @details Во время паузы ничего не происходит, иначе фигура падает или
+ * фиксируется функцией tetrisTick, если их время наступило
+ * @param game Указатель на структуру TetrisInfo_t
+ * @param now Время такта
+ */
+void tetrisFrameTick(void *game, long long now) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)game;
+  if (!game_state->game_info.pause && game_state->game_status == kStart) {
+    if (game_state->game_info.score >= TETRIS_MAX_SCORE) {
+      game_state->game_status = kWin;
+    } else {
+      tetrisTick(game_state, now);
+    }
+  }
+}
+
+/**
+ * @brief Отрисовывает кадр игры
+ * @details Во время паузы выводится экран паузы, иначе рисуются поле с
+ * текущей фигурой и её "призраком", статистика, следующая фигура, отложенная
+ * фигура и очередь
+ * @param game Указатель на структуру TetrisInfo_t
+ */
+void tetrisFrameRender(void *game) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)game;
+  GameInfo_t stats = updateCurrentState();
+  if (stats.pause) {
+    printStatusScreen(kPause);
+  } else {
+    Figure_t *figure = &game_state->figure;
+    Figure_t ghost;
+    getGhostFigure(game_state, &ghost);
+    clearScreen();
+    drawBordersAndStats(stats.level, stats.score, stats.high_score);
+    updateField(&stats, &ghost, GHOST_CELL);
+    updateField(&stats, figure, MOVING_CELL);
+    drawObjects(&stats);
+    updateField(&stats, figure, EMPTY_CELL);
+    updateField(&stats, &ghost, EMPTY_CELL);
+    drawNextFigure(figureShape(nextFigure(game_state, 0)));
+    drawQueue(game_state);
+  }
+}
+
+/**
+ * @brief Возвращает отпечаток состояния игры для планировщика
+ * @details Хеш Зобриста покрывает поле, текущую фигуру, очередь и
+ * отложенную фигуру, к нему добавляются пауза и статус игры. Счёт и
+ * уровень меняются только вместе с полем
+ * @param game Указатель на структуру TetrisInfo_t
+ * @return Отпечаток состояния
+ */
+unsigned long long tetrisFrameHash(void *game) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)game;
+  return game_state->hash ^
+         (unsigned long long)game_state->game_info.pause << 60 ^
+         (unsigned long long)game_state->game_status << 56;
+}
+
+/**
+ * @brief Проверяет, закончена ли игра
+ * @param game Указатель на структуру TetrisInfo_t
+ * @return true, если игра проиграна или выиграна, иначе false
+ */
+bool tetrisFrameIsOver(void *game) {
+  TetrisInfo_t *game_state = (TetrisInfo_t *)game;
+  return game_state->game_status == kGameOver ||
+         game_state->game_status == kWin;
+}
+
 /**
  * @brief Отображает предпросмотр следующей фигуры
  * @details Эта функция отображает предпросмотр следующей фигуры в специальном
  * окне на экране. Фигура состоит из символов '#'
  * @param figure Указатель на структуру Figure_t
  */
-void drawNextFigure(Figure_t *figure) {
+void drawNextFigure(const Figure_t *figure) {
   printRectangle(13, 20, HEIGHT + 3, HEIGHT + 12);
   mvprintw(14, HEIGHT + 6, "NEXT");
+  drawShape(figure, 16, HEIGHT + 6);
+}
+
+/**
+ * @brief Отображает отложенную фигуру и очередь следующих фигур
+ * @details Справа от статистики рисуется окно, в верхней части которого
+ * выводится отложенная фигура, а в нижней - фигуры очереди, которые появятся
+ * после следующей
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void drawQueue(const TetrisInfo_t *game_state) {
+  printRectangle(0, HEIGHT + 1, HEIGHT + 14, HEIGHT + 23);
+  mvprintw(2, HEIGHT + 17, "HOLD");
+  if (game_state->hold != TETRIS_NO_HOLD) {
+    drawShape(figureShape(game_state->hold), 4, HEIGHT + 17);
+  }
+  mvprintw(8, HEIGHT + 17, "QUEUE");
+  for (int i = 1; i < TETRIS_PREVIEW; i++) {
+    drawShape(figureShape(nextFigure(game_state, i)), 7 + i * 3,
+              HEIGHT + 17);
+  }
+}
+
+/**
+ * @brief Отображает фигуру вне поля
+ * @details Фигура состоит из символов '#'
+ * @param figure Указатель на структуру Figure_t
+ * @param top_y Строка экрана, с которой начинается фигура
+ * @param left_x Столбец экрана, с которого начинается фигура
+ */
+void drawShape(const Figure_t *figure, int top_y, int left_x) {
   for (int y = 0; y < figure->height; y++) {
     for (int x = 0; x < figure->width; x++) {
       if (figure->f[y][x] == 1) {
-        mvaddch(16 + y, HEIGHT + 6 + x, '#');
+        mvaddch(top_y + y, left_x + x, '#');
       } else {
-        mvaddch(16 + y, HEIGHT + 6 + x, ' ');
+        mvaddch(top_y + y, left_x + x, ' ');
       }
     }
   }
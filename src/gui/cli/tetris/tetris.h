@@ -4,13 +4,22 @@
 #ifndef CPP3_BRICK_GAME_V2_0_1_GUI_CLI_TETRIS_TETRIS_H_
 #define CPP3_BRICK_GAME_V2_0_1_GUI_CLI_TETRIS_TETRIS_H_
 
+#include "../../../brick_game/api/game_module.h"
 #include "../../../brick_game/tetris/tetris_backend.h"
 #include "../common/common_cli.h"
+#include "../common/frame_loop.h"
 
 // MAIN GAME CYCLE
-void tetrisCycle();
+void tetrisCycle(EventLog_t *log);
+void tetrisFrameInput(void *game);
+void tetrisFrameTick(void *game, long long now);
+void tetrisFrameRender(void *game);
+unsigned long long tetrisFrameHash(void *game);
+bool tetrisFrameIsOver(void *game);
 
 // GAME ELEMENTS DRAWING FUNCS
-void drawNextFigure(Figure_t *figure);
+void drawNextFigure(const Figure_t *figure);
+void drawQueue(const TetrisInfo_t *game_state);
+void drawShape(const Figure_t *figure, int top_y, int left_x);
 
 #endif // CPP3_BRICK_GAME_V2_0_1_GUI_CLI_TETRIS_TETRIS_H_
\ No newline at end of file
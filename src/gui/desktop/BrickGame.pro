@@ -4,7 +4,18 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++20
 
-LIBS += -lncurses
+# The game engines come from libbrickgame (make lib), which is placed next
+# to the desktop binary in build/
+LIBS += -L$$PWD/../../../build -lbrickgame -lncurses
+unix:!mac: QMAKE_LFLAGS += "-Wl,-rpath,\'\$$ORIGIN\'"
+mac: QMAKE_LFLAGS += -Wl,-rpath,@executable_path
+
+# qmake CONFIG+=profile marks the engine phases for the sampling profiler
+# (see profiler.h), libbrickgame has to be built with make profile as well
+profile {
+    DEFINES += BRICKGAME_PROFILE
+    QMAKE_CXXFLAGS += -fno-omit-frame-pointer
+}
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
@@ -13,27 +24,35 @@ LIBS += -lncurses
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
-    ../../brick_game/common/common_back.c \
-    ../../brick_game/tetris/tetris_backend.c \
-    ../../brick_game/snake/snake_controller.cc \
-    ../../brick_game/snake/snake_model.cc \
+    battle_widget.cpp \
     game_widget.cpp \
+    module_widget.cpp \
     snake_widget.cpp \
     tetris_widget.cpp
 
 HEADERS += \
     mainwindow.h \
+    ../../brick_game/api/game_module.h \
     ../../brick_game/common/common_back.h \
     ../../brick_game/common/common_specification.h \
+    ../../brick_game/common/frame_codec.h \
+    ../../brick_game/common/frame_meter.h \
+    ../../brick_game/common/input_queue.h \
+    ../../brick_game/common/profiler.h \
     ../../brick_game/tetris/tetris_backend.h \
+    ../../brick_game/tetris/tetris_battle.h \
     ../../brick_game/snake/snake_controller.h \
     ../../brick_game/snake/snake_model.h \
+    battle_widget.h \
     game_widget.h \
+    module_widget.h \
     snake_widget.h \
     tetris_widget.h
 
 FORMS += \
+    battle_widget.ui \
     mainwindow.ui \
+    module_widget.ui \
     snake_widget.ui \
     tetris_widget.ui
 
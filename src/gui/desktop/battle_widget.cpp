@@ -0,0 +1,220 @@
+/** @file
+ * @brief Файл, содержащий функции для отрисовки сражения в Тетрисе в виджете
+ */
+#include "battle_widget.h"
+
+#include "ui_battle_widget.h"
+
+/**
+ * @brief Конструктор класса BattleWidget
+ * @details Инициализирует компоненты пользовательского интерфейса, создаёт
+ * сражение двух игроков и запускает таймер обновления экрана, который
+ * вызывается каждые 10 миллисекунд
+ * @param parent Родительский виджет
+ */
+BattleWidget::BattleWidget(QWidget *parent)
+    : GameWidget(parent),
+      ui(new Ui::BattleWidget),
+      is_created_(false),
+      is_stopped_(false) {
+  ui->setupUi(this);
+  resize(560, 480);
+  setFixedSize(560, 480);
+  setWindowTitle("Tetris Battle");
+  ui->pauseButton->setFocusPolicy(Qt::NoFocus);
+  ui->closeButton->setFocusPolicy(Qt::NoFocus);
+  is_created_ = createBattle(&battle_, BATTLE_WIDGET_PLAYERS,
+                             static_cast<unsigned int>(rand())) == START;
+  connect(timer, &QTimer::timeout, this, &BattleWidget::updateScreen);
+  timer->start(10);
+}
+
+/**
+ * @brief Деструктор класса BattleWidget
+ * @details Удаляет объекты UI и очищает память, выделенную для сражения
+ */
+BattleWidget::~BattleWidget() {
+  delete ui;
+  if (is_created_) {
+    removeBattle(&battle_);
+  }
+}
+
+/**
+ * @brief Обработчик события перерисовки виджета
+ * @details Выполняет такт сражения и рисует поля обоих игроков и их
+ * статистику. Во время паузы отображается экран паузы, после окончания
+ * сражения - его результат. Время такта и отрисовки передаётся измерителю
+ * индикатора производительности
+ * @param event Событие QPaintEvent, указывающее, что необходимо перерисовать
+ * виджет
+ */
+void BattleWidget::paintEvent(QPaintEvent *event) {
+  Q_UNUSED(event)
+  PROFILE_ENTER(PROFILE_PAINT_EVENT);
+  QPainter painter(this);
+  long long start = frameMeterMicros();
+  long long tick_time = 0;
+  if (is_created_) {
+    bool is_over = is_stopped_ || battleIsOver(&battle_);
+    if (!is_over && !battle_.pause) {
+      battleStep(&battle_, setTime());
+      tick_time = frameMeterMicros() - start;
+      frameMeterTicks(&frame_meter, 1, tick_time);
+    }
+    for (int i = 0; i < battle_.count; i++) {
+      drawBoard(&painter, i);
+      drawStats(&painter, i);
+    }
+    if (battle_.pause) {
+      pauseScreen(&painter);
+    } else if (is_over) {
+      timer->stop();
+      resultScreen(&painter);
+    } else {
+      timer->start(10);
+    }
+  }
+  presentFrame(&painter, start, tick_time);
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Рисует поле игрока
+ * @details Поле рисуется так же, как в одиночной игре: статичные клетки,
+ * падающая фигура и её "призрак". Поле второго игрока смещено вправо на
+ * BATTLE_WIDGET_BOARD_OFFSET клеток
+ * @param painter Указатель на объект QPainter
+ * @param player Номер игрока
+ */
+void BattleWidget::drawBoard(QPainter *painter, int player) {
+  TetrisInfo_t *game_state = &battle_.boards[player];
+  GameInfo_t *stats = &game_state->game_info;
+  int offset_x = player * BATTLE_WIDGET_BOARD_OFFSET;
+  if (battle_.alive[player]) {
+    Figure_t *figure = &game_state->figure;
+    Figure_t ghost;
+    getGhostFigure(game_state, &ghost);
+    updateField(stats, &ghost, GHOST_CELL);
+    updateField(stats, figure, MOVING_CELL);
+    drawCell(painter, stats->field, 1, HEIGHT + 1, 1, WIDTH + 1, 0, offset_x);
+    updateField(stats, figure, EMPTY_CELL);
+    updateField(stats, &ghost, EMPTY_CELL);
+  } else {
+    drawCell(painter, stats->field, 1, HEIGHT + 1, 1, WIDTH + 1, 0, offset_x);
+  }
+}
+
+/**
+ * @brief Рисует статистику игрока
+ * @details Между полями выводятся счёт игрока, количество ожидающих его
+ * мусорных линий и следующая фигура. Статистика первого игрока находится в
+ * верхней половине, второго - в нижней
+ * @param painter Указатель на объект QPainter
+ * @param player Номер игрока
+ */
+void BattleWidget::drawStats(QPainter *painter, int player) {
+  TetrisInfo_t *game_state = &battle_.boards[player];
+  int top = 20 + player * 200;
+  painter->setPen(QColor(0, 143, 17));
+  painter->setFont(QFont("Arial", 12, QFont::Bold));
+  painter->drawText(235, top + 15, QString("PLAYER %1").arg(player + 1));
+  painter->drawText(235, top + 40,
+                    QString("SCORE %1").arg(game_state->game_info.score));
+  painter->drawText(235, top + 60,
+                    QString("GARBAGE %1").arg(battle_.pending[player]));
+  const Figure_t *next = figureShape(nextFigure(game_state, 0));
+  drawCell(painter, next->f, 0, next->height, 0, next->width, top / 20 + 4,
+           13);
+}
+
+/**
+ * @brief Отображает результат сражения
+ * @details Рисует полупрозрачный черный прямоугольник и выводит номер
+ * победителя или сообщение о том, что сражение прервано
+ * @param painter Указатель на объект QPainter
+ */
+void BattleWidget::resultScreen(QPainter *painter) {
+  painter->setBrush(QColor(0, 0, 0, 127));
+  painter->setPen(Qt::NoPen);
+  painter->drawRect(rect());
+  painter->setPen(QColor(255, 255, 255));
+  painter->setFont(QFont("Arial", 20, QFont::Bold));
+  if (battle_.winner == BATTLE_NO_WINNER) {
+    painter->drawText(185, 200, "BATTLE IS OVER");
+  } else {
+    painter->drawText(
+        185, 200, QString("PLAYER %1 WINS!").arg(battle_.winner + 1));
+  }
+  painter->setFont(QFont("Arial", 14, QFont::Bold));
+  painter->drawText(165, 240, "Click QUIT to exit the game");
+}
+
+/**
+ * @brief Обработчик события нажатия клавиши
+ * @details Клавиши W, A, S, D отправляют команды полю первого игрока, стрелки -
+ * полю второго. Клавиша p или P ставит сражение на паузу, q, Q или Escape
+ * прерывают его, H показывает или прячет индикатор производительности
+ * @param event Событие QKeyEvent, указывающее, какая клавиша была нажата
+ */
+void BattleWidget::keyPressEvent(QKeyEvent *event) {
+  int player = 0;
+  UserAction_t action = Up;
+  int key = hudKey(event) ? Qt::Key_unknown : event->key();
+  switch (key) {
+    case Qt::Key_Up:
+      player = 1;
+      [[fallthrough]];
+    case 'w':
+    case 'W':
+      action = Action;
+      break;
+    case Qt::Key_Left:
+      player = 1;
+      [[fallthrough]];
+    case 'a':
+    case 'A':
+      action = Left;
+      break;
+    case Qt::Key_Down:
+      player = 1;
+      [[fallthrough]];
+    case 's':
+    case 'S':
+      action = HardDrop;
+      break;
+    case Qt::Key_Right:
+      player = 1;
+      [[fallthrough]];
+    case 'd':
+    case 'D':
+      action = Right;
+      break;
+    case 'p':
+    case 'P':
+      action = Pause;
+      break;
+    case 'q':
+    case 'Q':
+    case Qt::Key_Escape:
+      is_stopped_ = true;
+      break;
+    default:
+      break;
+  }
+  if (is_created_ && action != Up && !is_stopped_) {
+    battleInput(&battle_, player, action, setTime());
+  }
+  updateScreen();
+}
+
+/**
+ * @brief Обрабатывает событие нажатия кнопки PAUSE
+ * @details Ставит сражение на паузу или снимает с неё и обновляет интерфейс
+ */
+void BattleWidget::on_pauseButton_clicked() {
+  if (is_created_) {
+    battleInput(&battle_, 0, Pause, setTime());
+  }
+  update();
+}
@@ -0,0 +1,56 @@
+/** @file
+ * @brief Заголовочный файл, определяющий функции отрисовки виджета сражения в
+ * Тетрисе
+ */
+#ifndef BATTLE_WIDGET_H_
+#define BATTLE_WIDGET_H_
+
+#include "game_widget.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "../../brick_game/tetris/tetris_battle.h"
+#ifdef __cplusplus
+}
+#endif
+
+#define BATTLE_WIDGET_PLAYERS 2
+#define BATTLE_WIDGET_BOARD_OFFSET 16
+
+namespace Ui {
+class BattleWidget;
+}
+
+/** @class BattleWidget
+ * @brief Класс qt-представления сражения в Тетрисе на одном экране
+ * @details Поля двух игроков рисуются рядом, между ними - статистика игроков.
+ * Первый игрок управляет клавишами W, A, S, D, второй - стрелками
+ * @param GameWidget Родительский виджет
+ */
+class BattleWidget : public GameWidget {
+  Q_OBJECT
+
+ public:
+  explicit BattleWidget(QWidget *parent = nullptr);
+  ~BattleWidget();
+
+ protected:
+  void paintEvent(QPaintEvent *event) override;
+  void keyPressEvent(QKeyEvent *event) override;
+
+ private:
+  Ui::BattleWidget *ui;
+  Battle_t battle_;
+  bool is_created_;
+  bool is_stopped_;
+
+  void drawBoard(QPainter *painter, int player);
+  void drawStats(QPainter *painter, int player);
+  void resultScreen(QPainter *painter);
+
+ private slots:
+  void on_pauseButton_clicked();
+};
+
+#endif  // BATTLE_WIDGET_H_
@@ -10,13 +10,16 @@
  * перерисовки игровой сцены.
  * Конструктор также устанавливает политику фокусировки в Qt::StrongFocus, что
  * означает, что он будет получать все ключевые события, и устанавливает атрибут
- * Qt::WA_DeleteOnClose, который означает, что виджет будет удален при закрытии
+ * Qt::WA_DeleteOnClose, который означает, что виджет будет удален при закрытии.
+ * Измеритель времени кадров начинает работу, индикатор производительности
+ * скрыт
  * @param parent Родительский виджет
  */
 GameWidget::GameWidget(QWidget *parent)
-    : QWidget(parent), timer(new QTimer(this)) {
+    : QWidget(parent), timer(new QTimer(this)), is_hud_shown(false) {
   setFocusPolicy(Qt::StrongFocus);
   setAttribute(Qt::WA_DeleteOnClose, true);
+  startFrameMeter(&frame_meter, frameMeterMicros());
 }
 
 /**
@@ -120,6 +123,68 @@ void GameWidget::winScreen(QPainter *painter) {
   painter->drawText(30, 280, "Click QUIT to exit the game");
 }
 
+/**
+ * @brief Обрабатывает клавишу для индикатора производительности
+ * @details Клавиша GAME_WIDGET_HUD_KEY показывает или прячет индикатор.
+ * Время любой другой клавиши отмечается в измерителе как начало задержки
+ * до экрана. Время, которое событие провело в очереди Qt, не учитывается
+ * @param event Событие QKeyEvent, указывающее, какая клавиша была нажата
+ * @return true, если нажата клавиша индикатора, иначе false
+ */
+bool GameWidget::hudKey(QKeyEvent *event) {
+  bool is_hud_key = event->key() == GAME_WIDGET_HUD_KEY;
+  if (is_hud_key) {
+    is_hud_shown = !is_hud_shown;
+  } else {
+    frameMeterInput(&frame_meter, frameMeterMicros());
+  }
+  return is_hud_key;
+}
+
+/**
+ * @brief Отмечает показ кадра и рисует индикатор производительности
+ * @details Вызывается в конце paintEvent: время отрисовки - время
+ * paintEvent без такта игры. Кадр попадает на экран после выхода из
+ * paintEvent, поэтому момент показа оценивается концом отрисовки
+ * @param painter Указатель на объект QPainter
+ * @param start Время начала paintEvent в микросекундах
+ * @param tick_time Время такта игры в микросекундах
+ */
+void GameWidget::presentFrame(QPainter *painter, long long start,
+                              long long tick_time) {
+  long long now = frameMeterMicros();
+  frameMeterPresent(&frame_meter, now - start - tick_time, now);
+  frameMeterUpdate(&frame_meter, now);
+  if (is_hud_shown) {
+    drawHud(painter);
+  }
+}
+
+/**
+ * @brief Рисует индикатор производительности
+ * @details В левом верхнем углу поля на полупрозрачном прямоугольнике
+ * выводятся среднее время такта и отрисовки, частота кадров, средняя и
+ * наибольшая задержка от клавиши до экрана за прошлую секунду
+ * @param painter Указатель на объект QPainter
+ */
+void GameWidget::drawHud(QPainter *painter) {
+  const FrameReadout_t *readout = &frame_meter.readout;
+  painter->setBrush(QColor(0, 0, 0, 160));
+  painter->setPen(Qt::NoPen);
+  painter->drawRect(20, 20, 160, 90);
+  painter->setPen(QColor(255, 255, 255));
+  painter->setFont(QFont("Courier", 10, QFont::Bold));
+  const QString lines[] = {
+      QString("TICK %1 us").arg(readout->tick_us, 8, 'f', 1),
+      QString("DRAW %1 us").arg(readout->render_us, 8, 'f', 1),
+      QString("FPS  %1").arg(readout->fps, 8, 'f', 1),
+      QString("LAG  %1 ms").arg(readout->latency_us / 1000, 8, 'f', 1),
+      QString("MAX  %1 ms").arg(readout->max_latency_us / 1000.0, 8, 'f', 1)};
+  for (int i = 0; i < 5; i++) {
+    painter->drawText(28, 38 + i * 16, lines[i]);
+  }
+}
+
 /**
  * @brief Обработчик события нажатия кнопки закрытия
  * @details Когда пользователь нажимает кнопку закрытия, он вызывает
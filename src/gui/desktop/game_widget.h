@@ -12,6 +12,10 @@
 #include <QWidget>
 
 #include "../../brick_game/common/common_specification.h"
+#include "../../brick_game/common/frame_meter.h"
+#include "../../brick_game/common/profiler.h"
+
+#define GAME_WIDGET_HUD_KEY Qt::Key_H
 
 /** @class GameWidget
  * @brief Класс qt-представления игры
@@ -29,6 +33,8 @@ class GameWidget : public QWidget {
 
  protected:
   QTimer *timer;
+  FrameMeter_t frame_meter;
+  bool is_hud_shown;
 
   virtual void paintEvent(QPaintEvent *event) override;
   virtual void keyPressEvent(QKeyEvent *event) override;
@@ -38,11 +44,15 @@ class GameWidget : public QWidget {
   void gameoverScreen(QPainter *painter);
   void winScreen(QPainter *painter);
 
+  bool hudKey(QKeyEvent *event);
+  void presentFrame(QPainter *painter, long long start, long long tick_time);
+  void drawHud(QPainter *painter);
+
   /**
    * @brief Рисует клетки на поле
    * @details Рисует ячейку на экране, учитывая матрицу поля (или следующей
    * фигуры в Тетрисе), ее координаты, смещение ячейки и размер ячейки в
-   * пикселях
+   * пикселях. Клетки "призрака" фигуры рисуются приглушённым цветом
    * @param painter Указатель на объект, который используется для рисования
    * @param matrix Матрица игры
    * @param y Начальная координата по оси Y
@@ -59,6 +69,8 @@ class GameWidget : public QWidget {
       for (int j = x; j < max_x; ++j) {
         if (matrix[i][j] == MOVING_CELL || matrix[i][j] == STATIC_CELL) {
           painter->setBrush(QColor(0, 143, 17));
+        } else if (matrix[i][j] == GHOST_CELL) {
+          painter->setBrush(QColor(0, 95, 8));
         } else {
           painter->setBrush(QColor(0, 59, 0));
         }
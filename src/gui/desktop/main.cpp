@@ -3,15 +3,22 @@
  * окно
  */
 #include <QApplication>
+#include <cstdlib>
 
+#include "../../brick_game/common/profiler.h"
 #include "mainwindow.h"
 
 /**
  * @brief Начало программы.
  * @details Эта функция является точкой входа в приложение. Она создает
- * экземпляр приложения, создает главное окно и отображает его
+ * экземпляр приложения, создает главное окно и отображает его. В сборке с
+ * BRICKGAME_PROFILE запускает сэмплер, если задана переменная окружения
+ * PROFILE_ENV (см. profiler.h)
  */
 int main(int argc, char *argv[]) {
+#ifdef BRICKGAME_PROFILE
+  startProfiler(getenv(PROFILE_ENV));
+#endif
   QApplication a(argc, argv);
   MainWindow window;
   window.show();
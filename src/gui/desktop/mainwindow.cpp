@@ -10,7 +10,8 @@
  * @brief Конструктор класса MainWindow.
  * @details Инициализирует главное окно с фиксированным размером 400x400
  * пикселей и задает заголовку окна значение "BrickGame". Настраивает
- * пользовательский интерфейс
+ * пользовательский интерфейс и добавляет в меню кнопки игр из реестра
+ * игровых модулей
  * @param parent Родительский виджет
  */
 MainWindow::MainWindow(QWidget *parent)
@@ -18,34 +19,63 @@ MainWindow::MainWindow(QWidget *parent)
   ui->setupUi(this);
   setFixedSize(400, 400);
   setWindowTitle("BrickGame");
+  addGameButtons();
 }
 
 MainWindow::~MainWindow() { delete ui; }
 
 /**
- * @brief Слот, вызываемый при клике на кнопку "Snake".
- * @details Скрывает главное окно, создает объект SnakeWidget, настраивает
- * сигнал-слот, где сигналом является закрытие SnakeWidget, а слот - отображение
- * главного окна, а затем отображает SnakeWidget
+ * @brief Добавляет в меню кнопки игр из реестра игровых модулей
+ * @details Кнопки идут в порядке регистрации модулей, под ними сдвигаются
+ * кнопки сражения и выхода. Клик по кнопке открывает игру модуля
  */
-void MainWindow::on_snakeButton_clicked() {
+void MainWindow::addGameButtons() {
+  int top = MAIN_WINDOW_MENU_TOP;
+  for (int i = 0; i < gameModuleCount(); i++) {
+    const GameModule_t *module = gameModuleAt(i);
+    QPushButton *button =
+        new QPushButton(QString(module->name).toUpper(), ui->centralwidget);
+    button->setGeometry(100, top, 200, 30);
+    button->setStyleSheet("background-color: rgb(130, 130, 130);");
+    connect(button, &QPushButton::clicked, this,
+            [this, module]() { openGame(module); });
+    top += MAIN_WINDOW_MENU_STEP;
+  }
+  ui->battleButton->move(100, top);
+  ui->closeButton->move(110, top + MAIN_WINDOW_MENU_STEP + 8);
+}
+
+/**
+ * @brief Открывает игру модуля
+ * @details Скрывает главное окно и создаёт виджет игры: TetrisWidget и
+ * SnakeWidget для встроенных игр, ModuleWidget для остальных модулей.
+ * Закрытие виджета снова отображает главное окно
+ * @param module Игровой модуль
+ */
+void MainWindow::openGame(const GameModule_t *module) {
   hide();
-  snake_widget = new SnakeWidget;
-  connect(snake_widget, &SnakeWidget::widgetClosed, this, &MainWindow::show);
-  snake_widget->show();
+  if (module->id == GAME_MODULE_TETRIS) {
+    game_widget = new TetrisWidget;
+  } else if (module->id == GAME_MODULE_SNAKE) {
+    game_widget = new SnakeWidget;
+  } else {
+    game_widget = new ModuleWidget(module);
+  }
+  connect(game_widget, &GameWidget::widgetClosed, this, &MainWindow::show);
+  game_widget->show();
 }
 
 /**
- * @brief Слот, вызываемый при клике на кнопку "Tetris".
- * @details Скрывает главное окно, создает объект TetrisWidget, настраивает
- * сигнал-слот, где сигналом является закрытие TetrisWidget, а слот -
- * отображение главного окна, а затем отображает TetrisWidget
+ * @brief Слот, вызываемый при клике на кнопку "Tetris Battle".
+ * @details Скрывает главное окно, создает объект BattleWidget, настраивает
+ * сигнал-слот, где сигналом является закрытие BattleWidget, а слот -
+ * отображение главного окна, а затем отображает BattleWidget
  */
-void MainWindow::on_tetrisButton_clicked() {
+void MainWindow::on_battleButton_clicked() {
   hide();
-  tetris_widget = new TetrisWidget;
-  connect(tetris_widget, &TetrisWidget::widgetClosed, this, &MainWindow::show);
-  tetris_widget->show();
+  battle_widget = new BattleWidget;
+  connect(battle_widget, &BattleWidget::widgetClosed, this, &MainWindow::show);
+  battle_widget->show();
 }
 
 /**
@@ -7,9 +7,14 @@
 #include <QMainWindow>
 #include <QMessageBox>
 
+#include "battle_widget.h"
+#include "module_widget.h"
 #include "snake_widget.h"
 #include "tetris_widget.h"
 
+#define MAIN_WINDOW_MENU_TOP 110
+#define MAIN_WINDOW_MENU_STEP 32
+
 QT_BEGIN_NAMESPACE
 namespace Ui {
 class MainWindow;
@@ -24,13 +29,15 @@ class MainWindow : public QMainWindow {
   ~MainWindow();
 
  private slots:
-  void on_snakeButton_clicked();
-  void on_tetrisButton_clicked();
+  void on_battleButton_clicked();
   void on_closeButton_clicked();
 
  private:
   Ui::MainWindow *ui;
-  SnakeWidget *snake_widget;
-  TetrisWidget *tetris_widget;
+  GameWidget *game_widget;
+  BattleWidget *battle_widget;
+
+  void addGameButtons();
+  void openGame(const GameModule_t *module);
 };
 #endif  // MAINWINDOW_H
@@ -0,0 +1,222 @@
+/** @file
+ * @brief Файл, содержащий функции для отрисовки игры из реестра игровых
+ * модулей в виджете
+ */
+#include "module_widget.h"
+
+#include "ui_module_widget.h"
+
+/**
+ * @brief Конструктор класса ModuleWidget
+ * @details Инициализирует компоненты пользовательского интерфейса, создаёт
+ * игру модуля и запускает таймер обновления экрана, который вызывается каждые
+ * 10 миллисекунд. Виджет имеет фиксированный размер и называется так же, как
+ * игра в меню
+ * @param module Игровой модуль
+ * @param parent Родительский виджет
+ */
+ModuleWidget::ModuleWidget(const GameModule_t *module, QWidget *parent)
+    : GameWidget(parent),
+      ui(new Ui::ModuleWidget),
+      module_(module),
+      state_(module->create(static_cast<unsigned int>(setTime()))),
+      frame_() {
+  ui->setupUi(this);
+  ui->helpButton->setFocusPolicy(Qt::NoFocus);
+  ui->pauseButton->setFocusPolicy(Qt::NoFocus);
+  ui->closeButton->setFocusPolicy(Qt::NoFocus);
+  resize(435, 480);
+  setFixedSize(435, 480);
+  setWindowTitle(module->name);
+  connect(timer, &QTimer::timeout, this, &ModuleWidget::updateScreen);
+  timer->start(10);
+}
+
+/**
+ * @brief Деструктор класса ModuleWidget
+ * @details Удаляет объекты UI и игру модуля
+ */
+ModuleWidget::~ModuleWidget() {
+  delete ui;
+  if (state_ != nullptr) {
+    module_->destroy(state_);
+  }
+}
+
+/**
+ * @brief Обработчик события перерисовки виджета
+ * @details Игра кодируется в ключевой кадр, по которому рисуются поле,
+ * следующая фигура и статистика. Во время паузы отображается экран паузы,
+ * иначе выполняется такт модуля, а после окончания игры отображается экран
+ * проигрыша или победы. Если игру не удалось создать, отображается экран
+ * проигрыша. Время такта и отрисовки передаётся измерителю индикатора
+ * производительности
+ * @param event Событие QPaintEvent, указывающее, что необходимо перерисовать
+ * виджет
+ */
+void ModuleWidget::paintEvent(QPaintEvent *event) {
+  Q_UNUSED(event)
+  PROFILE_ENTER(PROFILE_PAINT_EVENT);
+  QPainter painter(this);
+  long long start = frameMeterMicros();
+  long long tick_time = 0;
+  if (state_ == nullptr) {
+    timer->stop();
+    gameoverScreen(&painter);
+  } else {
+    module_->frame(state_, frame_);
+    drawFrame(&painter);
+    if (framePause(frame_)) {
+      pauseScreen(&painter);
+    } else {
+      GameStatus_t status = module_->status(state_);
+      if (status != kGameOver && status != kWin) {
+        timer->start(10);
+        long long ticked = frameMeterMicros();
+        module_->tick(state_);
+        tick_time = frameMeterMicros() - ticked;
+        frameMeterTicks(&frame_meter, 1, tick_time);
+        status = module_->status(state_);
+      }
+      if (status == kGameOver) {
+        gameoverScreen(&painter);
+      }
+      if (status == kWin) {
+        winScreen(&painter);
+      }
+    }
+  }
+  presentFrame(&painter, start, tick_time);
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Рисует игру по ключевому кадру
+ * @details Клетки поля рисуются так же, как в Тетрисе и Змейке, статистика
+ * выводится в табло. Если модуль сообщает, что у игры есть следующая
+ * фигура, она рисуется справа от поля
+ * @param painter Указатель на объект QPainter
+ */
+void ModuleWidget::drawFrame(QPainter *painter) {
+  int field[HEIGHT + 1][WIDTH + 1] = {};
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      field[y + 1][x + 1] = frameCell(frame_, y, x);
+    }
+  }
+  drawCell(painter, field, 1, HEIGHT + 1, 1, WIDTH + 1, 0, 0);
+  if (module_->hints.has_next) {
+    int next[4][4] = {};
+    for (int y = 0; y < 4; y++) {
+      for (int x = 0; x < 4; x++) {
+        next[y][x] = frameNext(frame_, y, x) ? MOVING_CELL : EMPTY_CELL;
+      }
+    }
+    painter->setPen(QColor(0, 59, 0));
+    painter->setBrush(QColor(0, 59, 0));
+    painter->drawRect(240, 200, 178, 220);
+    drawCell(painter, next, 0, 4, 0, 4, 13, 15);
+  }
+  ui->level->display(frameLevel(frame_));
+  ui->score->display(frameScore(frame_));
+  ui->high_score->display(frameHighScore(frame_));
+}
+
+/**
+ * @brief Обработчик события нажатия клавиши
+ * @details Клавиша превращается в команду так же, как в консольной версии, и
+ * передаётся модулю. Клавиши, которые не управляют игрой, пропускаются.
+ * Клавиша H показывает или прячет индикатор производительности
+ * @param event Событие QKeyEvent, указывающее, какая клавиша была нажата
+ */
+void ModuleWidget::keyPressEvent(QKeyEvent *event) {
+  if (!hudKey(event) && state_ != nullptr) {
+    UserAction_t action = keyAction(event->key());
+    if (action != Up) {
+      module_->input(state_, action, false);
+    }
+  }
+  updateScreen();
+}
+
+/**
+ * @brief Определяет команду по нажатой клавише
+ * @param key Код клавиши Qt
+ * @return Команда, соответствующая клавише (Up, если клавиша не управляет
+ * игрой)
+ */
+UserAction_t ModuleWidget::keyAction(int key) {
+  UserAction_t action = Up;
+  switch (key) {
+  case Qt::Key_Space:
+  case Qt::Key_Up:
+    action = Action;
+    break;
+  case Qt::Key_Left:
+    action = Left;
+    break;
+  case Qt::Key_Right:
+    action = Right;
+    break;
+  case Qt::Key_Down:
+    action = Down;
+    break;
+  case Qt::Key_X:
+    action = HardDrop;
+    break;
+  case Qt::Key_C:
+    action = Hold;
+    break;
+  case 'p':
+  case 'P':
+    action = Pause;
+    break;
+  case 'q':
+  case 'Q':
+  case Qt::Key_Escape:
+    action = Terminate;
+    break;
+  case Qt::Key_Enter:
+    action = Start;
+    break;
+  default:
+    break;
+  }
+  return action;
+}
+
+/**
+ * @brief Обрабатывает событие нажатия кнопки HELP
+ * @details Отображает окно сообщения с кратким описанием управления, которое
+ * сообщает модуль. На время справки игра приостанавливается
+ */
+void ModuleWidget::on_helpButton_clicked() {
+  bool on_pause = state_ == nullptr || framePause(frame_);
+  if (!on_pause) {
+    on_pauseButton_clicked();
+  }
+  QString help_info = QString("%1\n\nPause/Resume: Press P\n"
+                              "Quit: Press Q or Esc to exit\n"
+                              "Performance HUD: Press H to show or hide\n\n"
+                              "Click OK to return to the game")
+                          .arg(module_->hints.controls != nullptr
+                                   ? module_->hints.controls
+                                   : "");
+  QMessageBox::information(this, "Quick Guide", help_info);
+  if (!on_pause) {
+    on_pauseButton_clicked();
+  }
+  update();
+}
+
+/**
+ * @brief Обрабатывает событие нажатия кнопки PAUSE
+ * @details Передаёт модулю команду паузы, повторное нажатие продолжает игру
+ */
+void ModuleWidget::on_pauseButton_clicked() {
+  if (state_ != nullptr) {
+    module_->input(state_, Pause, false);
+    module_->frame(state_, frame_);
+  }
+  update();
+}
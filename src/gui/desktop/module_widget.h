@@ -0,0 +1,56 @@
+/** @file
+ * @brief Заголовочный файл, определяющий функции отрисовки виджета игры из
+ * реестра игровых модулей
+ */
+#ifndef MODULE_WIDGET_H_
+#define MODULE_WIDGET_H_
+
+#include "game_widget.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "../../brick_game/api/game_module.h"
+#include "../../brick_game/common/common_back.h"
+#include "../../brick_game/common/frame_codec.h"
+#ifdef __cplusplus
+}
+#endif
+
+namespace Ui {
+class ModuleWidget;
+}
+
+/** @class ModuleWidget
+ * @brief Класс qt-представления игры из реестра игровых модулей
+ * @details Игра видна виджету только через ключевой кадр (см. frame_codec.h),
+ * поэтому виджет подходит любой зарегистрированной игре, у которой нет
+ * собственного виджета
+ * @param GameWidget Родительский виджет
+ */
+class ModuleWidget : public GameWidget {
+  Q_OBJECT
+
+ public:
+  explicit ModuleWidget(const GameModule_t *module, QWidget *parent = nullptr);
+  ~ModuleWidget();
+
+ protected:
+  void paintEvent(QPaintEvent *event) override;
+  void keyPressEvent(QKeyEvent *event) override;
+
+ private:
+  Ui::ModuleWidget *ui;
+  const GameModule_t *module_;
+  void *state_;
+  uint8_t frame_[FRAME_KEY_SIZE];
+
+  UserAction_t keyAction(int key);
+  void drawFrame(QPainter *painter);
+
+ private slots:
+  void on_helpButton_clicked();
+  void on_pauseButton_clicked();
+};
+
+#endif  // MODULE_WIDGET_H_
@@ -41,16 +41,23 @@ SnakeWidget::~SnakeWidget() { delete ui; }
 /**
  * @brief Обработчик события перерисовки виджета
  * @details Перерисовывает виджет в зависимости от текущего состояния игры.
- * Если игра приостановлена, то отображается соответствующий экран.
+ * Сначала применяются команды из очереди ввода игры. Если игра
+ * приостановлена, то отображается соответствующий экран.
  * Если игра продолжается, то перерисовывается поле игры, отображается змейка и
  * яблоко, обновляются статистика и счет, а также вызывается механика игры.
  * Если игра проиграна или выиграна, то отображается соответствующий экран.
+ * Время такта и отрисовки передаётся измерителю индикатора
+ * производительности
  * @param event Событие QPaintEvent, указывающее, что необходимо перерисовать
  * виджет
  */
 void SnakeWidget::paintEvent(QPaintEvent *event) {
   Q_UNUSED(event)
+  PROFILE_ENTER(PROFILE_PAINT_EVENT);
   QPainter painter(this);
+  long long start = frameMeterMicros();
+  long long tick_time = 0;
+  snake_controller_.drainInput();
   GameInfo_t stats = snake_controller_.updateCurrentState();
   s21::SnakeModel::SnakeInfo_t *game_state =
       snake_controller_.getModel()->getSnakeInfo_t();
@@ -66,7 +73,10 @@ void SnakeWidget::paintEvent(QPaintEvent *event) {
         game_state->game_status != kWin) {
       timer->start(10);
       game_state->game_info = stats;
+      long long ticked = frameMeterMicros();
       snake_controller_.getModel()->snakeMechanics(game_state->game_status);
+      tick_time = frameMeterMicros() - ticked;
+      frameMeterTicks(&frame_meter, 1, tick_time);
     }
     if (game_state->game_status == kGameOver) {
       gameoverScreen(&painter);
@@ -75,82 +85,85 @@ void SnakeWidget::paintEvent(QPaintEvent *event) {
       winScreen(&painter);
     }
   }
+  presentFrame(&painter, start, tick_time);
+  PROFILE_LEAVE();
 }
 
 /**
  * @brief Обработчик события нажатия клавиши
- * @details Вызывается при нажатии клавиши. Если нажата одна из клавиш
- * управления змейкой (стрелки Left, Right, Up, Down), то соответствующее
- * направление отправляется в контроллер игры. Если нажата клавиша p или P, то
- * игра приостанавливается. Если нажата клавиша q, Q или Escape, то игра
- * завершается. Также проверяется зажата ли клавиша, соответствующая направлению
- * движения, для ускорения движения змейки
+ * @details Вызывается при нажатии клавиши. Клавиша превращается в команду
+ * (стрелки Left, Right, Up, Down - направление движения, пробел, p или P -
+ * пауза, q, Q или Escape - завершение игры), которая кладётся в очередь
+ * ввода игры вместе со временем нажатия. Команды из очереди применяет
+ * paintEvent, в том числе ускоряет змейку, если нажата клавиша текущего
+ * направления. Клавиша H показывает или прячет индикатор производительности
  * @param event Событие QKeyEvent, указывающее, какая клавиша была нажата
  */
 void SnakeWidget::keyPressEvent(QKeyEvent *event) {
-  s21::SnakeModel::SnakeInfo_t *game_state =
-      snake_controller_.getModel()->getSnakeInfo_t();
-  bool hold = false;
+  if (!hudKey(event)) {
+    s21::SnakeModel::SnakeInfo_t *game_state =
+        snake_controller_.getModel()->getSnakeInfo_t();
+    pushInput(&game_state->input, keyAction(event->key()), true, setTime());
+  }
+  updateScreen();
+}
+
+/**
+ * @brief Обработчик события отпускания клавиши
+ * @details Вызывается при отпускании клавиши, что означает необходимость отмены
+ * ускорения. Если отпущена одна из клавиш управления змейкой (стрелки Left,
+ * Right, Up, Down), то в очередь ввода кладётся событие отпускания
+ * @param event Событие QKeyEvent, указывающее, какая клавиша была отпущена
+ */
+void SnakeWidget::keyReleaseEvent(QKeyEvent *event) {
   int key = event->key();
+  if (key == Qt::Key_Up || key == Qt::Key_Left || key == Qt::Key_Right ||
+      key == Qt::Key_Down) {
+    s21::SnakeModel::SnakeInfo_t *game_state =
+        snake_controller_.getModel()->getSnakeInfo_t();
+    pushInput(&game_state->input, keyAction(key), false, setTime());
+  }
+  QWidget::keyReleaseEvent(event);
+}
+
+/**
+ * @brief Определяет команду по нажатой клавише
+ * @param key Код клавиши Qt
+ * @return Команда, соответствующая клавише (Start, если клавиша не управляет
+ * игрой)
+ */
+UserAction_t SnakeWidget::keyAction(int key) {
+  UserAction_t action = Start;
   switch (key) {
   case Qt::Key_Space:
-    game_state->action = Action;
+    action = Action;
     break;
   case Qt::Key_Up:
-    game_state->action = Up;
+    action = Up;
     break;
   case Qt::Key_Left:
-    game_state->action = Left;
+    action = Left;
     break;
   case Qt::Key_Right:
-    game_state->action = Right;
+    action = Right;
     break;
   case Qt::Key_Down:
-    game_state->action = Down;
+    action = Down;
     break;
   case 'p':
   case 'P':
-    game_state->action = Pause;
+    action = Pause;
     break;
   case 'q':
   case 'Q':
   case Qt::Key_Escape:
-    game_state->action = Terminate;
+    action = Terminate;
     break;
   case Qt::Key_Enter:
   default:
-    game_state->action = Start;
     break;
   }
-  s21::Snake::Direction curr_dir =
-      snake_controller_.getModel()->getSnake().getDirection();
-  if ((curr_dir == s21::Snake::kUp && key == Qt::Key_Up) ||
-      (curr_dir == s21::Snake::kDown && key == Qt::Key_Down) ||
-      (curr_dir == s21::Snake::kLeft && key == Qt::Key_Left) ||
-      (curr_dir == s21::Snake::kRight && key == Qt::Key_Right)) {
-    hold = true;
-  }
-  snake_controller_.userInput(game_state->action, hold);
-  updateScreen();
-}
-
-/**
- * @brief Обработчик события отпускания клавиши
- * @details Вызывается при отпускании клавиши, что означает необходимость отмены
- * ускорения. Если отпущена одна из клавиш управления змейкой (стрелки Left,
- * Right, Up, Down), то отправляется соответствующее направление с флагом hold
- * == false
- * @param event Событие QKeyEvent, указывающее, какая клавиша была отпущена
- */
-void SnakeWidget::keyReleaseEvent(QKeyEvent *event) {
-  int key = event->key();
-  if (key == Qt::Key_Up || key == Qt::Key_Left || key == Qt::Key_Right ||
-      key == Qt::Key_Down) {
-    s21::SnakeModel::SnakeInfo_t *game_state =
-        snake_controller_.getModel()->getSnakeInfo_t();
-    snake_controller_.userInput(game_state->action, false);
-  }
-  QWidget::keyReleaseEvent(event);
+  return action;
 }
 
 /**
@@ -177,7 +190,8 @@ void SnakeWidget::on_helpButton_clicked() {
       "Accelerate: Press the arrow key matching your current direction (e.g., "
       "press Right arrow while moving right)\n\n"
       "Pause/Resume: Press P\n"
-      "Quit: Press Q or Esc to exit\n\n"
+      "Quit: Press Q or Esc to exit\n"
+      "Performance HUD: Press H to show or hide\n\n"
       "Gameplay Mechanics:\n"
       "- Apple Consumption: Eating an apple grows the snake by 1 segment\n"
       "- Levels & Speed: Every 5 apples increase your level by 1. Each new "
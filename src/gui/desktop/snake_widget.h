@@ -32,6 +32,8 @@ class SnakeWidget : public GameWidget {
   s21::SnakeModel snake_model_;
   s21::SnakeController snake_controller_;
 
+  UserAction_t keyAction(int key);
+
  private slots:
   void on_helpButton_clicked();
   void on_pauseButton_clicked();
@@ -26,6 +26,10 @@ TetrisWidget::TetrisWidget(QWidget *parent)
   ui->helpButton->setFocusPolicy(Qt::NoFocus);
   ui->pauseButton->setFocusPolicy(Qt::NoFocus);
   ui->closeButton->setFocusPolicy(Qt::NoFocus);
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  if (game_state != nullptr) {
+    setLockDelay(game_state, TETRIS_LOCK_DELAY, TETRIS_LOCK_RESETS);
+  }
   connect(timer, &QTimer::timeout, this, &TetrisWidget::updateScreen);
   timer->start(10);
 }
@@ -42,26 +46,36 @@ TetrisWidget::~TetrisWidget() {
 /**
  * @brief Обработчик события перерисовки виджета
  * @details Перерисовывает виджет в зависимости от текущего состояния игры.
- * Если игра приостановлена, то отображается соответствующий экран.
+ * Сначала применяются команды из очереди ввода игры. Если игра
+ * приостановлена, то отображается соответствующий экран.
  * Если игра продолжается, то перерисовывается поле игры, отображаются текущая
- * фигура и следующая фигура в отдельном окне, обновляются статистика и счет, а
- * также вызывается механика игры. Если игра проиграна или выиграна, то
- * отображается соответствующий экран.
+ * фигура, её "призрак" и следующая фигура в отдельном окне, обновляются
+ * статистика и счет, а также вызывается механика игры. Если игра проиграна
+ * или выиграна, то отображается соответствующий экран. Время такта и
+ * отрисовки передаётся измерителю индикатора производительности
  * @param event Событие QPaintEvent, указывающее, что необходимо перерисовать
  * виджет
  */
 void TetrisWidget::paintEvent(QPaintEvent *event) {
   Q_UNUSED(event)
+  PROFILE_ENTER(PROFILE_PAINT_EVENT);
   QPainter painter(this);
-  GameInfo_t stats = updateCurrentState();
+  long long start = frameMeterMicros();
+  long long tick_time = 0;
   TetrisInfo_t *game_state = getTetrisInfo_t();
+  tetrisDrainInput(game_state, setTime());
+  GameInfo_t stats = updateCurrentState();
   Figure_t *figure = &game_state->figure;
+  Figure_t ghost;
+  getGhostFigure(game_state, &ghost);
   ui->level->display(stats.level);
   ui->score->display(stats.score);
   ui->high_score->display(stats.high_score);
+  updateField(&stats, &ghost, GHOST_CELL);
   updateField(&stats, figure, MOVING_CELL);
   drawCell(&painter, stats.field, 1, 21, 1, 11, 0, 0);
   updateField(&stats, figure, EMPTY_CELL);
+  updateField(&stats, &ghost, EMPTY_CELL);
   painter.setPen(QColor(0, 59, 0));
   painter.setBrush(QColor(0, 59, 0));
   painter.drawRect(240, 200, 178, 220);
@@ -72,10 +86,11 @@ void TetrisWidget::paintEvent(QPaintEvent *event) {
         game_state->game_status != kWin) {
       timer->start(10);
       game_state->game_info = stats;
-      drawCell(&painter, game_state->next_figure.f, 0,
-               game_state->next_figure.height, 0, game_state->next_figure.width,
-               13, 15);
+      drawQueue(&painter, game_state);
+      long long ticked = frameMeterMicros();
       tetrisMechanics(game_state);
+      tick_time = frameMeterMicros() - ticked;
+      frameMeterTicks(&frame_meter, 1, tick_time);
     }
     if (game_state->game_status == kGameOver) {
       gameoverScreen(&painter);
@@ -84,53 +99,107 @@ void TetrisWidget::paintEvent(QPaintEvent *event) {
       winScreen(&painter);
     }
   }
+  presentFrame(&painter, start, tick_time);
+  PROFILE_LEAVE();
+}
+
+/**
+ * @brief Рисует отложенную фигуру и очередь следующих фигур
+ * @details Отложенная фигура выводится над окном следующей фигуры, а в окне
+ * под ней друг под другом выводятся первые фигуры очереди
+ * @param painter Указатель на объект QPainter
+ * @param game_state Указатель на структуру TetrisInfo_t
+ */
+void TetrisWidget::drawQueue(QPainter *painter,
+                             const TetrisInfo_t *game_state) {
+  if (game_state->hold != TETRIS_NO_HOLD) {
+    const Figure_t *hold = figureShape(game_state->hold);
+    drawCell(painter, hold->f, 0, hold->height, 0, hold->width, 10, 15);
+  }
+  for (int i = 0; i < TETRIS_WIDGET_PREVIEW; i++) {
+    const Figure_t *next = figureShape(nextFigure(game_state, i));
+    drawCell(painter, next->f, 0, next->height, 0, next->width, 13 + i * 3,
+             15);
+  }
 }
 
 /**
  * @brief Обработчик события нажатия клавиши
- * @details Вызывается при нажатии клавиши. Если нажата одна из клавиш
- * управления (стрелки Left, Right, Up, Down), то соответствующее
- * направление отправляется в обработчик команд. Если нажата клавиша p или P, то
- * игра приостанавливается. Если нажата клавиша q, Q или Escape, то игра
- * завершается
+ * @details Вызывается при нажатии клавиши. Клавиша превращается в команду
+ * (стрелки Left, Right, Down - сдвиг фигуры, удержание Down - мягкое
+ * падение, X - мгновенное падение, C - отложить фигуру, Up или пробел -
+ * поворот, p или P - пауза, q, Q или Escape - завершение игры), которая
+ * кладётся в очередь ввода игры вместе со временем нажатия. Команды из
+ * очереди применяет paintEvent. Клавиша H показывает или прячет индикатор
+ * производительности
  * @param event Событие QKeyEvent, указывающее, какая клавиша была нажата
  */
 void TetrisWidget::keyPressEvent(QKeyEvent *event) {
-  TetrisInfo_t *game_state = getTetrisInfo_t();
-  bool hold = false;
-  int key = event->key();
+  if (!hudKey(event)) {
+    TetrisInfo_t *game_state = getTetrisInfo_t();
+    pushInput(&game_state->input, keyAction(event->key()), true, setTime());
+  }
+  updateScreen();
+}
+
+/**
+ * @brief Обработчик события отпускания клавиши
+ * @details Кладёт в очередь ввода игры событие отпускания клавиши. Повторы
+ * автоповтора клавиатуры пропускаются, так как клавиша остаётся нажатой
+ * @param event Событие QKeyEvent, указывающее, какая клавиша была отпущена
+ */
+void TetrisWidget::keyReleaseEvent(QKeyEvent *event) {
+  if (!event->isAutoRepeat()) {
+    TetrisInfo_t *game_state = getTetrisInfo_t();
+    pushInput(&game_state->input, keyAction(event->key()), false, setTime());
+  }
+  QWidget::keyReleaseEvent(event);
+}
+
+/**
+ * @brief Определяет команду по нажатой клавише
+ * @param key Код клавиши Qt
+ * @return Команда, соответствующая клавише (Up, если клавиша не управляет
+ * игрой)
+ */
+UserAction_t TetrisWidget::keyAction(int key) {
+  UserAction_t action = Up;
   switch (key) {
   case Qt::Key_Space:
   case Qt::Key_Up:
-    game_state->action = Action;
+    action = Action;
     break;
   case Qt::Key_Left:
-    game_state->action = Left;
+    action = Left;
     break;
   case Qt::Key_Right:
-    game_state->action = Right;
+    action = Right;
     break;
   case Qt::Key_Down:
-    game_state->action = Down;
+    action = Down;
+    break;
+  case Qt::Key_X:
+    action = HardDrop;
+    break;
+  case Qt::Key_C:
+    action = Hold;
     break;
   case 'p':
   case 'P':
-    game_state->action = Pause;
+    action = Pause;
     break;
   case 'q':
   case 'Q':
   case Qt::Key_Escape:
-    game_state->action = Terminate;
+    action = Terminate;
     break;
   case Qt::Key_Enter:
-    game_state->action = Start;
+    action = Start;
     break;
-  default:
-    game_state->action = Up;
+    default:
     break;
   }
-  userInput(game_state->action, hold);
-  updateScreen();
+  return action;
 }
 
 /**
@@ -153,9 +222,12 @@ void TetrisWidget::on_helpButton_clicked() {
       "Movement (use arrow keys):\n"
       "- Left/Right Arrow Keys: Move the figure left or right\n"
       "- Up Arrow / Spacebar: Rotate the figure 90° clockwise\n"
-      "- Down Arrow: Instantly drop the figure to the bottom\n\n"
+      "- Down Arrow: Move the figure down, hold to speed up the fall\n"
+      "- X: Instantly drop the figure to the bottom\n"
+      "- C: Hold the figure for later (once per figure)\n\n"
       "Pause/Resume: Press P\n"
-      "Quit: Press Q or Esc to exit\n\n"
+      "Quit: Press Q or Esc to exit\n"
+      "Performance HUD: Press H to show or hide\n\n"
       "Gameplay Mechanics:\n"
       "- Scoring: Earn points by clearing lines\n"
       "· 1 line - 100 points\n"
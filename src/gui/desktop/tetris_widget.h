@@ -14,6 +14,8 @@ extern "C" {
 }
 #endif
 
+#define TETRIS_WIDGET_PREVIEW 3
+
 namespace Ui {
 class TetrisWidget;
 }
@@ -32,10 +34,14 @@ class TetrisWidget : public GameWidget {
  protected:
   void paintEvent(QPaintEvent *event) override;
   void keyPressEvent(QKeyEvent *event) override;
+  void keyReleaseEvent(QKeyEvent *event) override;
 
  private:
   Ui::TetrisWidget *ui;
 
+  UserAction_t keyAction(int key);
+  void drawQueue(QPainter *painter, const TetrisInfo_t *game_state);
+
  private slots:
   void on_helpButton_clicked();
   void on_pauseButton_clicked();
@@ -0,0 +1,104 @@
+/** @file
+ * @brief Файл, устанавливающий точку входа в игровой сервер
+ */
+#include <getopt.h>
+#include <signal.h>
+
+#include <cstdlib>
+#include <iostream>
+
+#include "game_server.h"
+
+/** @brief Указатель на сервер для обработчика сигналов */
+static s21::GameServer *running_server = nullptr;
+
+/**
+ * @brief Обработчик сигналов завершения
+ * @param signal Номер сигнала
+ */
+static void stopServer(int signal) {
+  (void)signal;
+  if (running_server != nullptr) {
+    running_server->stop();
+  }
+}
+
+/**
+ * @brief Выводит справку по параметрам запуска
+ * @param name Имя программы
+ */
+static void printUsage(const char *name) {
+  std::cout << "Usage: " << name << " [options]" << std::endl
+            << "  -s, --socket PATH      Unix socket path "
+               "(default /tmp/brickgame.sock, empty to disable)"
+            << std::endl
+            << "  -p, --port PORT        loopback TCP port (disabled by "
+               "default)"
+            << std::endl
+            << "  -t, --threads N        worker threads (default 4)"
+            << std::endl
+            << "  -m, --max-sessions N   session limit (default 512)"
+            << std::endl;
+}
+
+/**
+ * @brief Начало программы
+ * @details Разбирает параметры запуска, запускает сервер и обслуживает
+ * клиентов до получения сигнала SIGINT или SIGTERM
+ * @return 0 в случае успеха, 1 в случае ошибки
+ */
+int main(int argc, char **argv) {
+  srand(time(NULL));
+  s21::ServerConfig_t config = {"/tmp/brickgame.sock", -1, 4, 512};
+  const option options[] = {{"socket", required_argument, nullptr, 's'},
+                            {"port", required_argument, nullptr, 'p'},
+                            {"threads", required_argument, nullptr, 't'},
+                            {"max-sessions", required_argument, nullptr, 'm'},
+                            {"help", no_argument, nullptr, 'h'},
+                            {nullptr, 0, nullptr, 0}};
+  int status = START;
+  int opt = getopt_long(argc, argv, "s:p:t:m:h", options, nullptr);
+  while (opt != -1 && status == START) {
+    switch (opt) {
+    case 's':
+      config.socket_path = optarg;
+      break;
+    case 'p':
+      config.tcp_port = atoi(optarg);
+      break;
+    case 't':
+      config.threads = atoi(optarg);
+      break;
+    case 'm':
+      config.max_sessions = atoi(optarg);
+      break;
+    default:
+      printUsage(argv[0]);
+      status = STOP;
+      break;
+    }
+    opt = getopt_long(argc, argv, "s:p:t:m:h", options, nullptr);
+  }
+  if (status == START) {
+    s21::GameServer server(config);
+    status = server.start();
+    if (status == START) {
+      running_server = &server;
+      signal(SIGINT, stopServer);
+      signal(SIGTERM, stopServer);
+      signal(SIGPIPE, SIG_IGN);
+      if (!config.socket_path.empty()) {
+        std::cout << "Listening on " << config.socket_path << std::endl;
+      }
+      if (server.getTcpPort() >= 0) {
+        std::cout << "Listening on 127.0.0.1:" << server.getTcpPort()
+                  << std::endl;
+      }
+      server.run();
+      running_server = nullptr;
+    } else {
+      std::cerr << "Failed to start server" << std::endl;
+    }
+  }
+  return status;
+}
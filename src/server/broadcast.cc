@@ -0,0 +1,253 @@
+/** @file
+ * @brief Файл, содержащий реализацию рассылки кадров игры подписчикам
+ */
+#include "broadcast.h"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace s21 {
+/**
+ * @brief Конструктор класса Subscriber
+ * @param fd Сокет клиента
+ */
+Subscriber::Subscriber(int fd)
+    : fd_(fd), offset_(0), pending_(0), last_tick_(-1), keyframe_only_(false),
+      finished_(false), failed_(false) {}
+
+/**
+ * @brief Добавляет запись в очередь отправки
+ * @details После finish новые записи не принимаются
+ * @param buffer Общий буфер с записью
+ */
+void Subscriber::push(const SharedBuffer &buffer) {
+  if (!finished_) {
+    queue_.push_back(buffer);
+    pending_ += buffer->size();
+  }
+}
+
+/**
+ * @brief Отправляет очередь клиенту
+ * @details Собирает до SERVER_MAX_IOV буферов в один вызов sendmsg и
+ * отправляет их без блокировки, пока очередь не опустеет или сокет не
+ * заполнится. Ошибка отправки помечает подписчика как отключённого
+ */
+void Subscriber::flush() {
+  bool blocked = false;
+  while (!queue_.empty() && !blocked && !failed_) {
+    iovec iov[SERVER_MAX_IOV];
+    int count = 0;
+    for (auto it = queue_.begin(); it != queue_.end() && count < SERVER_MAX_IOV;
+         ++it, ++count) {
+      size_t skip = count == 0 ? offset_ : 0;
+      iov[count].iov_base = const_cast<uint8_t *>((*it)->data()) + skip;
+      iov[count].iov_len = (*it)->size() - skip;
+    }
+    msghdr message = {};
+    message.msg_iov = iov;
+    message.msg_iovlen = count;
+    ssize_t size = sendmsg(fd_, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (size > 0) {
+      consume(size);
+    } else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      blocked = true;
+    } else {
+      failed_ = true;
+    }
+  }
+}
+
+/**
+ * @brief Удаляет из очереди отправленные байты
+ * @param size Количество отправленных байт
+ */
+void Subscriber::consume(size_t size) {
+  pending_ -= size;
+  while (size > 0) {
+    size_t remaining = queue_.front()->size() - offset_;
+    if (size >= remaining) {
+      size -= remaining;
+      queue_.pop_front();
+      offset_ = 0;
+    } else {
+      offset_ += size;
+      size = 0;
+    }
+  }
+}
+
+/**
+ * @brief Удаляет из очереди неотправленные записи
+ * @details Частично отправленная запись остаётся в очереди, иначе клиент
+ * получит обрезанную запись и потеряет границы кадров
+ */
+void Subscriber::dropQueued() {
+  size_t keep = offset_ > 0 ? 1 : 0;
+  while (queue_.size() > keep) {
+    queue_.pop_back();
+  }
+  pending_ = keep ? queue_.front()->size() - offset_ : 0;
+}
+
+/**
+ * @brief Завершает подписку
+ * @details Записи, уже стоящие в очереди, будут отправлены, новые не
+ * принимаются
+ */
+void Subscriber::finish() { finished_ = true; }
+
+/**
+ * @brief Проверяет, пуста ли очередь отправки
+ * @return true, если все записи отправлены, иначе false
+ */
+bool Subscriber::isEmpty() const { return queue_.empty(); }
+
+/**
+ * @brief Проверяет, завершена ли подписка
+ * @return true, если подписка завершена и все записи отправлены, иначе false
+ */
+bool Subscriber::isDone() const { return finished_ && queue_.empty(); }
+
+/**
+ * @brief Проверяет, произошла ли ошибка отправки
+ * @return true, если клиент отключился или отправка завершилась ошибкой
+ */
+bool Subscriber::isFailed() const { return failed_; }
+
+/**
+ * @brief Геттер количества неотправленных байт
+ * @return Количество неотправленных байт
+ */
+size_t Subscriber::getPending() const { return pending_; }
+
+/**
+ * @brief Геттер номера последнего полученного такта
+ * @return Номер такта рассылки, кадр которого поставлен в очередь последним,
+ * или -1, если кадров ещё не было
+ */
+long long Subscriber::getLastTick() const { return last_tick_; }
+
+/**
+ * @brief Сеттер номера последнего полученного такта
+ * @param tick Номер такта рассылки
+ */
+void Subscriber::setLastTick(long long tick) { last_tick_ = tick; }
+
+/**
+ * @brief Проверяет, получает ли подписчик только ключевые кадры
+ * @return true, если подписчик в режиме ключевых кадров, иначе false
+ */
+bool Subscriber::isKeyframeOnly() const { return keyframe_only_; }
+
+/**
+ * @brief Сеттер режима ключевых кадров
+ * @param keyframe_only true, чтобы отправлять подписчику только ключевые
+ * кадры
+ */
+void Subscriber::setKeyframeOnly(bool keyframe_only) {
+  keyframe_only_ = keyframe_only;
+}
+
+/**
+ * @brief Конструктор класса Broadcast
+ */
+Broadcast::Broadcast() : last_frame_{}, has_frame_(false), tick_(0) {}
+
+/**
+ * @brief Добавляет подписчика
+ * @details Новый подписчик получит ключевой кадр на следующем такте
+ * @param subscriber Подписчик
+ */
+void Broadcast::subscribe(Subscriber *subscriber) {
+  subscriber->setLastTick(-1);
+  subscribers_.push_back(subscriber);
+}
+
+/**
+ * @brief Удаляет подписчика
+ * @param subscriber Подписчик
+ */
+void Broadcast::unsubscribe(Subscriber *subscriber) {
+  subscribers_.erase(
+      std::remove(subscribers_.begin(), subscribers_.end(), subscriber),
+      subscribers_.end());
+}
+
+/**
+ * @brief Геттер количества подписчиков
+ * @return Количество подписчиков
+ */
+size_t Broadcast::getSubscriberCount() const { return subscribers_.size(); }
+
+/**
+ * @brief Рассылает кадр такта всем подписчикам
+ * @details Подписчик, получивший кадр предыдущего такта, получает разностный
+ * кадр (или ничего, если кадр не изменился). Новый подписчик и подписчик,
+ * пропустивший такты, получают ключевой кадр. Подписчик, у которого
+ * накопилось больше SERVER_SLOW_PENDING байт, теряет очередь и переходит в
+ * режим ключевых кадров: он получает ключевой кадр, только когда отправит всё
+ * предыдущее, и возвращается к разностным кадрам, когда успевает за тактами.
+ * Последний кадр игры (final) получают все подписчики
+ * @param frame Ключевой кадр такта
+ * @param final true, если это последний кадр игры
+ */
+void Broadcast::publish(const uint8_t *frame, bool final) {
+  tick_++;
+  SharedBuffer key;
+  SharedBuffer delta;
+  if (has_frame_) {
+    uint8_t record[FRAME_DELTA_MAX_SIZE];
+    int size = frameDelta(last_frame_, frame, record);
+    if (size > 0) {
+      delta = makeRecord(record, size);
+    }
+  }
+  for (Subscriber *subscriber : subscribers_) {
+    if (subscriber->getPending() > SERVER_SLOW_PENDING) {
+      subscriber->setKeyframeOnly(true);
+      subscriber->dropQueued();
+      subscriber->setLastTick(-1);
+    }
+    bool current = has_frame_ && subscriber->getLastTick() == tick_ - 1;
+    if (subscriber->isKeyframeOnly() && subscriber->isEmpty() && current) {
+      subscriber->setKeyframeOnly(false);
+    }
+    if (!subscriber->isKeyframeOnly() && current) {
+      if (delta != nullptr) {
+        subscriber->push(delta);
+      }
+      subscriber->setLastTick(tick_);
+    } else if (!subscriber->isKeyframeOnly() || subscriber->isEmpty() ||
+               final) {
+      if (key == nullptr) {
+        key = makeRecord(frame, FRAME_KEY_SIZE);
+      }
+      if (final) {
+        subscriber->dropQueued();
+      }
+      subscriber->push(key);
+      subscriber->setLastTick(tick_);
+    }
+    subscriber->flush();
+  }
+  std::memcpy(last_frame_, frame, FRAME_KEY_SIZE);
+  has_frame_ = true;
+}
+
+/**
+ * @brief Завершает рассылку
+ * @details Все подписчики получают отметку о завершении и удаляются из
+ * рассылки. Уже поставленные в очередь записи будут отправлены
+ */
+void Broadcast::finish() {
+  for (Subscriber *subscriber : subscribers_) {
+    subscriber->finish();
+  }
+  subscribers_.clear();
+}
+} // namespace s21
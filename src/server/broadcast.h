@@ -0,0 +1,89 @@
+/** @file
+ * @brief Заголовочный файл, определяющий рассылку кадров игры подписчикам
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_SERVER_BROADCAST_H_
+#define CPP3_BRICK_GAME_V2_0_1_SERVER_BROADCAST_H_
+
+#include <deque>
+#include <vector>
+
+#include "protocol.h"
+
+#define SERVER_MAX_IOV 64
+#define SERVER_SLOW_PENDING (4 * 1024)
+
+namespace s21 {
+/** @class Subscriber
+ * @brief Очередь отправки одного подключения
+ * @details Хранит ссылки на общие буферы с записями и отправляет их одним
+ * вызовом sendmsg (scatter-gather), не копируя данные. Если клиент не успевает
+ * читать, рассылка переводит его в режим ключевых кадров
+ * @param fd Сокет клиента
+ */
+class Subscriber {
+public:
+  // CONSTRUCTOR
+  explicit Subscriber(int fd);
+
+  // QUEUE FUNCS
+  void push(const SharedBuffer &buffer);
+  void flush();
+  void dropQueued();
+  void finish();
+
+  // GETTERS & SETTERS
+  bool isEmpty() const;
+  bool isDone() const;
+  bool isFailed() const;
+  size_t getPending() const;
+  long long getLastTick() const;
+  void setLastTick(long long tick);
+  bool isKeyframeOnly() const;
+  void setKeyframeOnly(bool keyframe_only);
+
+private:
+  int fd_;
+  std::deque<SharedBuffer> queue_;
+  size_t offset_;
+  size_t pending_;
+  long long last_tick_;
+  bool keyframe_only_;
+  bool finished_;
+  bool failed_;
+
+  void consume(size_t size);
+};
+
+/** @class Broadcast
+ * @brief Рассылка кадров одной сессии всем подписчикам
+ * @details На каждом такте кадр кодируется один раз: разностный кадр
+ * относительно предыдущего такта и, только если он кому-то нужен, ключевой
+ * кадр. Подписчики получают ссылки на одни и те же буферы. Подписчик, у
+ * которого накопилось больше SERVER_SLOW_PENDING неотправленных байт, теряет
+ * очередь и получает только ключевые кадры, пока не догонит рассылку, поэтому
+ * медленный клиент не задерживает сессию и не расходует память без ограничений
+ */
+class Broadcast {
+public:
+  // CONSTRUCTOR
+  Broadcast();
+
+  // SUBSCRIBERS
+  void subscribe(Subscriber *subscriber);
+  void unsubscribe(Subscriber *subscriber);
+  size_t getSubscriberCount() const;
+
+  // PUBLISHING
+  void publish(const uint8_t *frame, bool final);
+  void finish();
+
+private:
+  uint8_t last_frame_[FRAME_KEY_SIZE];
+  bool has_frame_;
+  long long tick_;
+  std::vector<Subscriber *> subscribers_;
+};
+
+} // namespace s21
+
+#endif // CPP3_BRICK_GAME_V2_0_1_SERVER_BROADCAST_H_
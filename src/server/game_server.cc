@@ -0,0 +1,548 @@
+/** @file
+ * @brief Файл, содержащий реализацию игрового сервера
+ */
+#include "game_server.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace s21 {
+/**
+ * @brief Конструктор класса GameServer
+ * @details Сохраняет параметры запуска и создаёт пул потоков. Сокеты и
+ * таймер создаются в методе start
+ * @param config Параметры запуска сервера
+ */
+GameServer::GameServer(const ServerConfig_t &config)
+    : config_(config), pool_(config.threads), next_room_id_(1),
+      waiting_room_id_(0), running_(false), epoll_fd_(-1), unix_fd_(-1),
+      tcp_fd_(-1), timer_fd_(-1), wake_fd_(-1), tcp_port_(-1),
+      session_count_(0) {}
+
+/**
+ * @brief Деструктор класса GameServer
+ * @details Закрывает соединения клиентов, сокеты, таймер и удаляет файл
+ * Unix-сокета
+ */
+GameServer::~GameServer() {
+  for (auto &entry : clients_) {
+    close(entry.first);
+  }
+  clients_.clear();
+  rooms_.clear();
+  channels_.clear();
+  int fds[] = {epoll_fd_, unix_fd_, tcp_fd_, timer_fd_, wake_fd_};
+  for (int fd : fds) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+  if (unix_fd_ >= 0) {
+    unlink(config_.socket_path.c_str());
+  }
+}
+
+/**
+ * @brief Подготавливает сервер к работе
+ * @details Создаёт экземпляр epoll, сокеты для приёма подключений, таймер
+ * тактов и eventfd для остановки сервера из другого потока или обработчика
+ * сигнала
+ * @return START, если подготовка прошла успешно, и STOP в противном случае
+ */
+int GameServer::start() {
+  int status = START;
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_fd_ < 0 || addToEpoll(wake_fd_, EPOLLIN)) {
+    status = STOP;
+  }
+  if (status == START && !config_.socket_path.empty()) {
+    status = listenUnix();
+  }
+  if (status == START && config_.tcp_port >= 0) {
+    status = listenTcp();
+  }
+  if (status == START && unix_fd_ < 0 && tcp_fd_ < 0) {
+    status = STOP;
+  }
+  if (status == START) {
+    status = startTimer();
+  }
+  return status;
+}
+
+/**
+ * @brief Цикл реактора
+ * @details Ожидает события epoll и обрабатывает их: принимает подключения,
+ * читает команды клиентов, дописывает отложенные данные и по таймеру
+ * запускает такт всех сессий. Цикл завершается после вызова stop
+ */
+void GameServer::run() {
+  epoll_event events[SERVER_MAX_EVENTS];
+  running_ = true;
+  while (running_) {
+    int count = epoll_wait(epoll_fd_, events, SERVER_MAX_EVENTS, -1);
+    for (int i = 0; i < count; i++) {
+      int fd = events[i].data.fd;
+      if (fd == wake_fd_) {
+        running_ = false;
+      } else if (fd == unix_fd_ || fd == tcp_fd_) {
+        acceptClients(fd);
+      } else if (fd == timer_fd_) {
+        uint64_t expirations = 0;
+        if (read(timer_fd_, &expirations, sizeof(expirations)) > 0) {
+          tick();
+        }
+      } else {
+        auto it = clients_.find(fd);
+        if (it != clients_.end()) {
+          Client *client = it->second.get();
+          if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            client->closing = true;
+          }
+          if (events[i].events & EPOLLIN) {
+            readClient(client);
+          }
+          if (events[i].events & EPOLLOUT) {
+            flushClient(client);
+            updateEvents(client);
+          }
+        }
+      }
+    }
+    removeClosed();
+  }
+}
+
+/**
+ * @brief Останавливает цикл реактора
+ * @details Записывает значение в eventfd, поэтому метод можно вызывать из
+ * другого потока или из обработчика сигнала
+ */
+void GameServer::stop() {
+  uint64_t value = 1;
+  if (write(wake_fd_, &value, sizeof(value)) < 0) {
+    running_ = false;
+  }
+}
+
+/**
+ * @brief Геттер TCP-порта
+ * @return Номер порта, на котором сервер принимает TCP-подключения, или -1,
+ * если TCP отключён
+ */
+int GameServer::getTcpPort() const { return tcp_port_; }
+
+/**
+ * @brief Геттер количества сессий
+ * @return Количество активных игровых сессий
+ */
+int GameServer::getSessionCount() const { return session_count_; }
+
+/**
+ * @brief Добавляет дескриптор в epoll
+ * @param fd Дескриптор
+ * @param events Ожидаемые события
+ * @return START, если дескриптор добавлен, и STOP в противном случае
+ */
+int GameServer::addToEpoll(int fd, uint32_t events) {
+  epoll_event event = {};
+  event.events = events;
+  event.data.fd = fd;
+  return epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == 0 ? START : STOP;
+}
+
+/**
+ * @brief Создаёт Unix-сокет для приёма подключений
+ * @details Файл сокета с тем же именем, оставшийся от предыдущего запуска,
+ * удаляется
+ * @return START, если сокет создан, и STOP в противном случае
+ */
+int GameServer::listenUnix() {
+  int status = STOP;
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (config_.socket_path.size() < sizeof(address.sun_path)) {
+    std::strcpy(address.sun_path, config_.socket_path.c_str());
+    unix_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(address.sun_path);
+    if (unix_fd_ >= 0 &&
+        bind(unix_fd_, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) == 0 &&
+        listen(unix_fd_, SOMAXCONN) == 0) {
+      status = addToEpoll(unix_fd_, EPOLLIN);
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Создаёт TCP-сокет для приёма подключений
+ * @details Сокет привязывается только к адресу 127.0.0.1, поэтому сервер
+ * доступен лишь с той же машины
+ * @return START, если сокет создан, и STOP в противном случае
+ */
+int GameServer::listenTcp() {
+  int status = STOP;
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(static_cast<uint16_t>(config_.tcp_port));
+  tcp_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  int reuse = 1;
+  if (tcp_fd_ >= 0 &&
+      setsockopt(tcp_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) ==
+          0 &&
+      bind(tcp_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ==
+          0 &&
+      listen(tcp_fd_, SOMAXCONN) == 0) {
+    socklen_t length = sizeof(address);
+    getsockname(tcp_fd_, reinterpret_cast<sockaddr *>(&address), &length);
+    tcp_port_ = ntohs(address.sin_port);
+    status = addToEpoll(tcp_fd_, EPOLLIN);
+  }
+  return status;
+}
+
+/**
+ * @brief Запускает таймер тактов
+ * @details Таймер срабатывает каждые SERVER_TICK_MS миллисекунд. Скорость
+ * игры при этом определяется самими играми: механика игры сдвигает фигуру или
+ * змейку, только если с прошлого шага прошло speed миллисекунд
+ * @return START, если таймер запущен, и STOP в противном случае
+ */
+int GameServer::startTimer() {
+  int status = STOP;
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  itimerspec interval = {};
+  interval.it_interval.tv_nsec = SERVER_TICK_MS * 1000000L;
+  interval.it_value = interval.it_interval;
+  if (timer_fd_ >= 0 &&
+      timerfd_settime(timer_fd_, 0, &interval, nullptr) == 0) {
+    status = addToEpoll(timer_fd_, EPOLLIN);
+  }
+  return status;
+}
+
+/**
+ * @brief Принимает новые подключения
+ * @details Принимает все ожидающие подключения. Если количество клиентов
+ * достигло max_sessions, то подключение сразу закрывается
+ * @param listen_fd Сокет, на котором пришли подключения
+ */
+void GameServer::acceptClients(int listen_fd) {
+  int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+  while (fd >= 0) {
+    if (static_cast<int>(clients_.size()) >= config_.max_sessions ||
+        addToEpoll(fd, EPOLLIN) != START) {
+      close(fd);
+    } else {
+      if (listen_fd == tcp_fd_) {
+        int no_delay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+      }
+      clients_[fd] = std::make_unique<Client>(fd);
+    }
+    fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+  }
+}
+
+/**
+ * @brief Читает команды клиента
+ * @details Читает все доступные данные и разбивает их на сообщения по
+ * MESSAGE_SIZE байт. Неполное сообщение сохраняется до следующего чтения.
+ * Закрытие соединения клиентом или ошибка чтения помечают клиента на удаление
+ * @param client Клиент
+ */
+void GameServer::readClient(Client *client) {
+  uint8_t buffer[SERVER_READ_BUFFER];
+  ssize_t size = recv(client->fd, buffer, sizeof(buffer), 0);
+  while (size > 0 && !client->closing) {
+    for (ssize_t i = 0; i < size && !client->closing; i++) {
+      client->message[client->message_length++] = buffer[i];
+      if (client->message_length == MESSAGE_SIZE) {
+        handleMessage(client);
+        client->message_length = 0;
+      }
+    }
+    size = recv(client->fd, buffer, sizeof(buffer), 0);
+  }
+  if (size == 0 || (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    client->closing = true;
+  }
+}
+
+/**
+ * @brief Обрабатывает сообщение клиента
+ * @details Сообщение kJoin создаёт сессию выбранной игры или занимает место в
+ * ожидающем сражении, kWatch подключает клиента зрителем к полю существующей
+ * сессии. Оба сообщения допустимы, только пока клиент не выбрал сессию.
+ * Сообщения kInput и kInputHold передают команду в поле игрока, если все
+ * места сессии заняты. Любое другое сообщение считается нарушением
+ * протокола, и клиент отключается
+ * @param client Клиент
+ */
+void GameServer::handleMessage(Client *client) {
+  uint8_t type = client->message[0];
+  int value = client->message[1] | (client->message[2] << 8);
+  auto room = rooms_.find(client->room_id);
+  if (type == kJoin && client->room_id == 0) {
+    joinGame(client, value);
+  } else if (type == kWatch && client->room_id == 0) {
+    watchGame(client, value);
+  } else if ((type == kInput || type == kInputHold) && client->is_player &&
+             room != rooms_.end() && value <= Hold) {
+    Room *target = room->second.get();
+    if (target->seated == static_cast<int>(target->channels.size())) {
+      target->session->inputBoard(client->board,
+                                  static_cast<UserAction_t>(value),
+                                  type == kInputHold);
+    }
+  } else {
+    client->closing = true;
+  }
+}
+
+/**
+ * @brief Подключает игрока к сессии
+ * @details Игрок сражения занимает место в ожидающем сражении, если оно есть.
+ * Иначе создаётся новая сессия, если количество сессий не достигло
+ * max_sessions
+ * @param client Клиент
+ * @param game Номер игры (SERVER_TETRIS, SERVER_SNAKE или SERVER_BATTLE)
+ */
+void GameServer::joinGame(Client *client, int game) {
+  Room *room = nullptr;
+  auto waiting = rooms_.find(waiting_room_id_);
+  if (game == SERVER_BATTLE && waiting != rooms_.end()) {
+    room = waiting->second.get();
+  } else if (session_count_ < config_.max_sessions) {
+    room = createRoom(game);
+  }
+  if (room == nullptr) {
+    client->closing = true;
+  } else {
+    takeSeat(client, room);
+  }
+}
+
+/**
+ * @brief Создаёт сессию
+ * @details Выбирает свободные номера для всех полей сессии и создаёт для
+ * каждого поля рассылку. Рассылки запускает обработчик завершения такта
+ * сессии: он кодирует кадр каждого поля и, когда игра окончена, завершает
+ * рассылки
+ * @param game Номер игры
+ * @return Указатель на сессию или nullptr, если игру не удалось создать
+ */
+GameServer::Room *GameServer::createRoom(int game) {
+  auto room = std::make_unique<Room>();
+  room->session = Session::create(game);
+  Room *target = nullptr;
+  if (room->session != nullptr) {
+    target = room.get();
+    target->seated = 0;
+    target->players = 0;
+    target->finished = false;
+    for (int i = 0; i < target->session->getBoardCount(); i++) {
+      while (channels_.count(next_room_id_)) {
+        next_room_id_ = next_room_id_ % SERVER_MAX_ROOM_ID + 1;
+      }
+      target->channels.push_back(next_room_id_);
+      target->broadcasts.push_back(std::make_unique<Broadcast>());
+      channels_[next_room_id_] = {target->channels[0], i};
+      next_room_id_ = next_room_id_ % SERVER_MAX_ROOM_ID + 1;
+    }
+    target->session->setTickHook([target](Session &session) {
+      bool final = session.isOver();
+      for (size_t i = 0; i < target->broadcasts.size(); i++) {
+        uint8_t frame[FRAME_KEY_SIZE];
+        session.renderBoard(static_cast<int>(i), frame);
+        target->broadcasts[i]->publish(frame, final);
+        if (final) {
+          target->broadcasts[i]->finish();
+        }
+      }
+      target->finished = final;
+    });
+    rooms_[target->channels[0]] = std::move(room);
+    session_count_++;
+  }
+  return target;
+}
+
+/**
+ * @brief Занимает место игрока в сессии
+ * @details Игрок получает приветствие с номерами полей (первым - номер своего
+ * поля) и подписывается на рассылку кадров своего поля. Сессия с
+ * незанятыми местами становится ожидающей
+ * @param client Клиент
+ * @param room Сессия
+ */
+void GameServer::takeSeat(Client *client, Room *room) {
+  int boards = static_cast<int>(room->channels.size());
+  client->room_id = room->channels[0];
+  client->board = room->seated++;
+  client->is_player = true;
+  std::vector<int> ids;
+  for (int i = 0; i < boards; i++) {
+    ids.push_back(room->channels[(client->board + i) % boards]);
+  }
+  client->output.push(makeWelcome(ids));
+  room->broadcasts[client->board]->subscribe(&client->output);
+  room->players++;
+  if (room->seated < boards) {
+    waiting_room_id_ = client->room_id;
+  } else if (waiting_room_id_ == client->room_id) {
+    waiting_room_id_ = 0;
+  }
+  flushClient(client);
+}
+
+/**
+ * @brief Подключает клиента зрителем к полю сессии
+ * @details Зритель получает те же кадры поля, что и его игрок, начиная с
+ * ключевого кадра на следующем такте. К завершённой или несуществующей
+ * сессии подключиться нельзя
+ * @param client Клиент
+ * @param channel_id Номер поля
+ */
+void GameServer::watchGame(Client *client, int channel_id) {
+  auto channel = channels_.find(channel_id);
+  auto room = channel == channels_.end() ? rooms_.end()
+                                         : rooms_.find(channel->second.room_id);
+  if (room == rooms_.end() || room->second->finished) {
+    client->closing = true;
+  } else {
+    client->room_id = channel->second.room_id;
+    client->board = channel->second.board;
+    room->second->broadcasts[client->board]->subscribe(&client->output);
+  }
+}
+
+/**
+ * @brief Такт всех сессий
+ * @details Делит незавершённые сессии, все места которых заняты, на части по
+ * числу потоков пула и
+ * передаёт каждую часть в пул. Кадры рассылаются из обработчика завершения
+ * такта в том же потоке, поэтому клиенты одной сессии никогда не
+ * обрабатываются двумя потоками одновременно. После завершения всех задач
+ * обновляет события epoll для клиентов, которым не удалось отправить всё
+ */
+void GameServer::tick() {
+  std::vector<Room *> active;
+  for (auto &entry : rooms_) {
+    Room *room = entry.second.get();
+    if (!room->finished &&
+        room->seated == static_cast<int>(room->channels.size())) {
+      active.push_back(entry.second.get());
+    }
+  }
+  size_t parts = static_cast<size_t>(pool_.size());
+  size_t chunk = (active.size() + parts - 1) / parts;
+  for (size_t begin = 0; begin < active.size(); begin += chunk) {
+    size_t end = begin + chunk < active.size() ? begin + chunk : active.size();
+    pool_.submit([&active, begin, end]() {
+      for (size_t i = begin; i < end; i++) {
+        active[i]->session->tick();
+      }
+    });
+  }
+  pool_.wait();
+  for (auto &entry : clients_) {
+    Client *client = entry.second.get();
+    client->closing = client->closing || client->output.isFailed();
+    updateEvents(client);
+  }
+}
+
+/**
+ * @brief Отправляет клиенту накопленные данные
+ * @details Отправляет данные без блокировки. Неотправленный остаток
+ * сохраняется до события EPOLLOUT. Ошибка отправки помечает клиента на
+ * удаление
+ * @param client Клиент
+ */
+void GameServer::flushClient(Client *client) {
+  client->output.flush();
+  if (client->output.isFailed()) {
+    client->closing = true;
+  }
+}
+
+/**
+ * @brief Обновляет события epoll клиента
+ * @details Подписывает клиента на EPOLLOUT, пока у него есть неотправленные
+ * данные, и отписывает, когда данные отправлены
+ * @param client Клиент
+ */
+void GameServer::updateEvents(Client *client) {
+  uint32_t events = client->output.isEmpty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+  if (events != client->events && !client->closing) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = client->fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client->fd, &event);
+    client->events = events;
+  }
+}
+
+/**
+ * @brief Удаляет отключённых клиентов
+ * @details Удаляет клиентов, помеченных на удаление, и клиентов, подписка
+ * которых завершена, а последний кадр отправлен. Отключившийся игрок
+ * сражения выбывает из него. Сессия удаляется вместе с последним её игроком
+ */
+void GameServer::removeClosed() {
+  for (auto it = clients_.begin(); it != clients_.end();) {
+    Client *client = it->second.get();
+    if (client->closing || client->output.isDone()) {
+      auto room = rooms_.find(client->room_id);
+      if (room != rooms_.end()) {
+        Room *target = room->second.get();
+        target->broadcasts[client->board]->unsubscribe(&client->output);
+        if (client->is_player) {
+          target->session->leave(client->board);
+          if (--target->players == 0) {
+            removeRoom(client->room_id);
+          }
+        }
+      }
+      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, client->fd, nullptr);
+      close(client->fd);
+      it = clients_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+/**
+ * @brief Удаляет сессию
+ * @details Зрители сессии получают отметку о завершении и отключаются после
+ * отправки оставшихся кадров. Номера полей сессии освобождаются
+ * @param room_id Номер сессии
+ */
+void GameServer::removeRoom(int room_id) {
+  auto room = rooms_.find(room_id);
+  for (size_t i = 0; i < room->second->broadcasts.size(); i++) {
+    room->second->broadcasts[i]->finish();
+    channels_.erase(room->second->channels[i]);
+  }
+  if (waiting_room_id_ == room_id) {
+    waiting_room_id_ = 0;
+  }
+  rooms_.erase(room);
+  session_count_--;
+}
+} // namespace s21
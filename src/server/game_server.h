@@ -0,0 +1,152 @@
+/** @file
+ * @brief Заголовочный файл, определяющий игровой сервер
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_SERVER_GAME_SERVER_H_
+#define CPP3_BRICK_GAME_V2_0_1_SERVER_GAME_SERVER_H_
+
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "broadcast.h"
+#include "session.h"
+#include "thread_pool.h"
+
+#define SERVER_TICK_MS 10
+#define SERVER_MAX_EVENTS 64
+#define SERVER_READ_BUFFER 256
+#define SERVER_MAX_ROOM_ID 0xFFFF
+
+namespace s21 {
+/**
+ * @brief Параметры запуска сервера
+ * @details Пустой socket_path отключает Unix-сокет, отрицательный tcp_port
+ * отключает TCP (при нулевом порте система выбирает свободный порт)
+ */
+typedef struct {
+  std::string socket_path;
+  int tcp_port;
+  int threads;
+  int max_sessions;
+} ServerConfig_t;
+
+/** @class GameServer
+ * @brief Сервер, обслуживающий множество игровых сессий
+ * @details Сервер построен на реакторе epoll: один поток принимает
+ * подключения, читает команды клиентов и по таймеру запускает такт всех
+ * сессий. Такты сессий распределяются между потоками пула фиксированного
+ * размера, реактор дожидается их завершения, поэтому состояние сессии никогда
+ * не изменяется из двух потоков одновременно. Кадры каждого поля сессии
+ * кодируются один раз и рассылаются игроку и зрителям через Broadcast.
+ * Сражение ждёт, пока к нему подключатся все игроки. Память на клиента
+ * ограничена: игра хранится в сессии фиксированного размера, а очередь
+ * медленного клиента сбрасывается до одного ключевого кадра
+ * @param config Параметры запуска сервера
+ */
+class GameServer {
+public:
+  // CONSTRUCTOR & DESTRUCTOR
+  explicit GameServer(const ServerConfig_t &config);
+  ~GameServer();
+
+  // SERVER CONTROL
+  int start();
+  void run();
+  void stop();
+
+  // GETTERS
+  int getTcpPort() const;
+  int getSessionCount() const;
+
+private:
+  /**
+   * @brief Состояние подключённого клиента
+   * @details Клиент либо играет за поле board собственной сессии
+   * (is_player), либо смотрит поле board чужой. room_id равен 0, пока клиент
+   * не выбрал сессию
+   */
+  struct Client {
+    explicit Client(int client_fd)
+        : fd(client_fd), room_id(0), board(0), is_player(false),
+          output(client_fd), message{}, message_length(0), events(EPOLLIN),
+          closing(false) {}
+
+    int fd;
+    int room_id;
+    int board;
+    bool is_player;
+    Subscriber output;
+    uint8_t message[MESSAGE_SIZE];
+    int message_length;
+    uint32_t events;
+    bool closing;
+  };
+
+  /**
+   * @brief Игровая сессия и рассылки её полей
+   * @details У каждого поля сессии своя рассылка и свой номер (channels),
+   * номер сессии совпадает с номером её первого поля. Сессия начинает
+   * шагать, когда заняты все места (seated == количество полей), и
+   * существует, пока подключён хотя бы один её игрок (players)
+   */
+  struct Room {
+    std::unique_ptr<Session> session;
+    std::vector<std::unique_ptr<Broadcast>> broadcasts;
+    std::vector<int> channels;
+    int seated;
+    int players;
+    bool finished;
+  };
+
+  /**
+   * @brief Поле сессии, к которому подключаются по номеру
+   */
+  struct Channel {
+    int room_id;
+    int board;
+  };
+
+  ServerConfig_t config_;
+  ThreadPool pool_;
+  std::unordered_map<int, std::unique_ptr<Client>> clients_;
+  std::unordered_map<int, std::unique_ptr<Room>> rooms_;
+  std::unordered_map<int, Channel> channels_;
+  int next_room_id_;
+  int waiting_room_id_;
+  std::atomic<bool> running_;
+  int epoll_fd_;
+  int unix_fd_;
+  int tcp_fd_;
+  int timer_fd_;
+  int wake_fd_;
+  int tcp_port_;
+  std::atomic<int> session_count_;
+
+  // SETUP FUNCS
+  int addToEpoll(int fd, uint32_t events);
+  int listenUnix();
+  int listenTcp();
+  int startTimer();
+
+  // EVENT HANDLERS
+  void acceptClients(int listen_fd);
+  void readClient(Client *client);
+  void handleMessage(Client *client);
+  void joinGame(Client *client, int game);
+  Room *createRoom(int game);
+  void takeSeat(Client *client, Room *room);
+  void watchGame(Client *client, int channel_id);
+  void tick();
+  void flushClient(Client *client);
+  void updateEvents(Client *client);
+  void removeClosed();
+  void removeRoom(int room_id);
+};
+
+} // namespace s21
+
+#endif // CPP3_BRICK_GAME_V2_0_1_SERVER_GAME_SERVER_H_
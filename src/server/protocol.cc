@@ -0,0 +1,53 @@
+/** @file
+ * @brief Файл, содержащий функции кодирования записей для передачи клиентам
+ */
+#include "protocol.h"
+
+namespace s21 {
+/**
+ * @brief Создаёт буфер с записью
+ * @details Записью может быть ключевой или разностный кадр (см.
+ * frame_codec.h) или приветствие. Запись передаётся с префиксом длины
+ * (FRAME_HEADER_SIZE байт, little-endian)
+ * @param data Содержимое записи
+ * @param size Размер записи в байтах
+ * @return Буфер с префиксом длины и записью
+ */
+SharedBuffer makeRecord(const uint8_t *data, int size) {
+  auto buffer = std::make_shared<std::vector<uint8_t>>();
+  buffer->reserve(FRAME_HEADER_SIZE + size);
+  buffer->push_back(static_cast<uint8_t>(size & 0xFF));
+  buffer->push_back(static_cast<uint8_t>(size >> 8));
+  buffer->insert(buffer->end(), data, data + size);
+  return buffer;
+}
+
+/**
+ * @brief Создаёт приветствие для игрока
+ * @details Приветствие - первая запись, которую игрок получает после kJoin:
+ * байт SERVER_WELCOME и 16-битный номер поля сессии, по которому к нему могут
+ * подключиться зрители. Первый байт любого кадра содержит ненулевую версию
+ * формата, поэтому приветствие не спутать с кадром
+ * @param id Номер поля
+ * @return Буфер с приветствием
+ */
+SharedBuffer makeWelcome(int id) { return makeWelcome(std::vector<int>{id}); }
+
+/**
+ * @brief Создаёт приветствие для игрока сессии с несколькими полями
+ * @details После байта SERVER_WELCOME следуют 16-битные номера полей: первым -
+ * номер поля игрока, затем номера полей соперников. Приветствие одиночной
+ * игры занимает WELCOME_SIZE байт
+ * @param ids Номера полей
+ * @return Буфер с приветствием
+ */
+SharedBuffer makeWelcome(const std::vector<int> &ids) {
+  std::vector<uint8_t> data(1 + 2 * ids.size());
+  data[0] = SERVER_WELCOME;
+  for (size_t i = 0; i < ids.size(); i++) {
+    data[1 + 2 * i] = static_cast<uint8_t>(ids[i] & 0xFF);
+    data[2 + 2 * i] = static_cast<uint8_t>(ids[i] >> 8);
+  }
+  return makeRecord(data.data(), static_cast<int>(data.size()));
+}
+} // namespace s21
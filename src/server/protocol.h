@@ -0,0 +1,60 @@
+/** @file
+ * @brief Заголовочный файл, определяющий протокол обмена между игровым
+ * сервером и клиентами
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_SERVER_PROTOCOL_H_
+#define CPP3_BRICK_GAME_V2_0_1_SERVER_PROTOCOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "../brick_game/common/frame_codec.h"
+#ifdef __cplusplus
+}
+#endif
+
+#define SERVER_TETRIS 0
+#define SERVER_SNAKE 1
+#define SERVER_BATTLE 2
+
+#define MESSAGE_SIZE 3
+#define FRAME_HEADER_SIZE 2
+#define SERVER_WELCOME 0
+#define WELCOME_SIZE 3
+
+namespace s21 {
+/**
+ * @brief Типы сообщений клиента
+ * @details Каждое сообщение клиента занимает MESSAGE_SIZE байт: тип сообщения
+ * и 16-битное значение (little-endian). Первым сообщением клиент либо выбирает
+ * игру (kJoin со значением SERVER_TETRIS, SERVER_SNAKE или SERVER_BATTLE),
+ * после чего передаёт команды UserAction_t, либо подключается зрителем к
+ * полю чужой сессии (kWatch с номером поля)
+ */
+typedef enum : uint8_t {
+  kJoin = 1,
+  kInput = 2,
+  kInputHold = 3,
+  kWatch = 4
+} MessageType;
+
+/**
+ * @brief Неизменяемый буфер с закодированной записью
+ * @details Запись кодируется один раз и передаётся всем получателям по
+ * ссылке: буфер освобождается, когда его отправит последний из них
+ */
+typedef std::shared_ptr<const std::vector<uint8_t>> SharedBuffer;
+
+// RECORD ENCODING
+SharedBuffer makeRecord(const uint8_t *data, int size);
+SharedBuffer makeWelcome(int id);
+SharedBuffer makeWelcome(const std::vector<int> &ids);
+
+} // namespace s21
+
+#endif // CPP3_BRICK_GAME_V2_0_1_SERVER_PROTOCOL_H_
@@ -0,0 +1,253 @@
+/** @file
+ * @brief Файл, содержащий реализацию игровых сессий сервера
+ */
+#include "session.h"
+
+namespace s21 {
+/**
+ * @brief Проверяет, завершена ли игра
+ * @return true, если игра проиграна или выиграна, иначе false
+ */
+bool Session::isOver() {
+  GameStatus_t status = getStatus();
+  return status == kGameOver || status == kWin;
+}
+
+/**
+ * @brief Геттер количества полей сессии
+ * @return 1 для одиночной игры
+ */
+int Session::getBoardCount() { return 1; }
+
+/**
+ * @brief Формирует кадр поля
+ * @details В одиночной игре единственное поле - вся игра
+ * @param board Номер поля
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ */
+void Session::renderBoard(int board, uint8_t *frame) {
+  (void)board;
+  render(frame);
+}
+
+/**
+ * @brief Обработка команды игрока поля
+ * @details В одиночной игре команда передаётся в игру
+ * @param board Номер поля
+ * @param action Команда пользователя
+ * @param hold Индикатор зажатия клавиши
+ */
+void Session::inputBoard(int board, UserAction_t action, bool hold) {
+  (void)board;
+  input(action, hold);
+}
+
+/**
+ * @brief Обработка отключения игрока поля
+ * @details Одиночная игра удаляется вместе с игроком, поэтому ничего не
+ * делает
+ * @param board Номер поля
+ */
+void Session::leave(int board) { (void)board; }
+
+/**
+ * @brief Устанавливает обработчик завершения такта
+ * @details Обработчик вызывается в конце каждого такта, после того как
+ * игра обновила своё состояние, в том же потоке, что и сам такт
+ * @param hook Обработчик
+ */
+void Session::setTickHook(TickHook hook) { tick_hook_ = std::move(hook); }
+
+/**
+ * @brief Вызывает обработчик завершения такта, если он установлен
+ */
+void Session::tickCompleted() {
+  if (tick_hook_) {
+    tick_hook_(*this);
+  }
+}
+
+/**
+ * @brief Создаёт сессию выбранной игры
+ * @details Сражение создаётся отдельным классом, остальные игры берутся из
+ * реестра игровых модулей
+ * @param game Номер игры (SERVER_TETRIS, SERVER_SNAKE, SERVER_BATTLE или
+ * номер зарегистрированного модуля)
+ * @return Указатель на сессию или nullptr, если номер игры неизвестен или
+ * игру не удалось создать
+ */
+std::unique_ptr<Session> Session::create(int game) {
+  std::unique_ptr<Session> session;
+  const GameModule_t *module = findGameModule(game);
+  if (game == SERVER_BATTLE) {
+    session = std::make_unique<BattleSession>(SERVER_BATTLE_SEATS);
+  } else if (module != nullptr) {
+    session = std::make_unique<ModuleSession>(module);
+  }
+  if (session != nullptr && !session->isCreated()) {
+    session.reset();
+  }
+  return session;
+}
+
+/**
+ * @brief Конструктор класса ModuleSession
+ * @details Создаёт собственный экземпляр игры модуля. Состояние генератора
+ * берётся из текущего времени, как у сражения
+ * @param module Игровой модуль
+ */
+ModuleSession::ModuleSession(const GameModule_t *module)
+    : module_(module), state_(nullptr) {
+  state_ = module_->create(static_cast<unsigned int>(setTime()));
+}
+
+/**
+ * @brief Деструктор класса ModuleSession
+ * @details Освобождает память, занятую экземпляром игры
+ */
+ModuleSession::~ModuleSession() {
+  if (state_ != nullptr) {
+    module_->destroy(state_);
+  }
+}
+
+/**
+ * @brief Проверяет, создана ли игра
+ * @return true, если модуль создал игру, иначе false
+ */
+bool ModuleSession::isCreated() { return state_ != nullptr; }
+
+/**
+ * @brief Обработка команды пользователя
+ * @details Команда Terminate сразу завершает игру, остальные команды
+ * выполняет модуль
+ * @param action Команда пользователя
+ * @param hold Индикатор зажатия клавиши
+ */
+void ModuleSession::input(UserAction_t action, bool hold) {
+  module_->input(state_, action, hold);
+}
+
+/**
+ * @brief Такт игры
+ * @details Модуль сам определяет, наступило ли время шага, и ничего не
+ * делает во время паузы и после окончания игры
+ */
+void ModuleSession::tick() {
+  module_->tick(state_);
+  tickCompleted();
+}
+
+/**
+ * @brief Формирует кадр игры
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ */
+void ModuleSession::render(uint8_t *frame) { module_->frame(state_, frame); }
+
+/**
+ * @brief Геттер статуса игры
+ * @return Статус игры
+ */
+GameStatus_t ModuleSession::getStatus() { return module_->status(state_); }
+
+/**
+ * @brief Конструктор класса BattleSession
+ * @details Создаёт сражение с собственными полями
+ * @param seats Количество игроков
+ */
+BattleSession::BattleSession(int seats) : battle_{}, created_(false) {
+  created_ =
+      createBattle(&battle_, seats, static_cast<unsigned int>(setTime())) ==
+      START;
+}
+
+/**
+ * @brief Деструктор класса BattleSession
+ * @details Освобождает память, занятую сражением
+ */
+BattleSession::~BattleSession() { removeBattle(&battle_); }
+
+/**
+ * @brief Проверяет, создано ли сражение
+ * @return true, если память под сражение выделена, иначе false
+ */
+bool BattleSession::isCreated() { return created_; }
+
+/**
+ * @brief Обработка команды пользователя
+ * @details Команда относится к первому полю
+ * @param action Команда пользователя
+ * @param hold Не используется
+ */
+void BattleSession::input(UserAction_t action, bool hold) {
+  inputBoard(0, action, hold);
+}
+
+/**
+ * @brief Такт сражения
+ * @details Все поля шагают в одном такте функцией battleStep
+ */
+void BattleSession::tick() {
+  battleStep(&battle_, setTime());
+  tickCompleted();
+}
+
+/**
+ * @brief Формирует кадр первого поля
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ */
+void BattleSession::render(uint8_t *frame) { renderBoard(0, frame); }
+
+/**
+ * @brief Геттер статуса сражения
+ * @return kGameOver, если сражение окончено, иначе kStart
+ */
+GameStatus_t BattleSession::getStatus() {
+  return battleIsOver(&battle_) ? kGameOver : kStart;
+}
+
+/**
+ * @brief Геттер количества полей сессии
+ * @return Количество игроков сражения
+ */
+int BattleSession::getBoardCount() { return battle_.count; }
+
+/**
+ * @brief Формирует кадр поля
+ * @details Временно рисует текущую фигуру поля, заполняет матрицу следующей
+ * фигуры по очереди фигур и кодирует поле в ключевой кадр. Статус кадра -
+ * статус поля: kWin у победителя, kGameOver у выбывших
+ * @param board Номер поля
+ * @param frame Буфер размером FRAME_KEY_SIZE байт
+ */
+void BattleSession::renderBoard(int board, uint8_t *frame) {
+  TetrisInfo_t *game_state = &battle_.boards[board];
+  GameInfo_t *stats = &game_state->game_info;
+  prepareNextFigure(game_state, stats);
+  if (battle_.alive[board]) {
+    updateField(stats, &game_state->figure, MOVING_CELL);
+  }
+  frameEncode(stats, game_state->game_status, frame);
+  if (battle_.alive[board]) {
+    updateField(stats, &game_state->figure, EMPTY_CELL);
+  }
+}
+
+/**
+ * @brief Обработка команды игрока поля
+ * @param board Номер поля
+ * @param action Команда пользователя
+ * @param hold Не используется
+ */
+void BattleSession::inputBoard(int board, UserAction_t action, bool hold) {
+  (void)hold;
+  battleInput(&battle_, board, action, setTime());
+}
+
+/**
+ * @brief Обработка отключения игрока поля
+ * @details Отключившийся игрок выбывает из сражения
+ * @param board Номер поля
+ */
+void BattleSession::leave(int board) { battleEliminate(&battle_, board); }
+} // namespace s21
@@ -0,0 +1,125 @@
+/** @file
+ * @brief Заголовочный файл, определяющий игровые сессии сервера
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_SERVER_SESSION_H_
+#define CPP3_BRICK_GAME_V2_0_1_SERVER_SESSION_H_
+
+#include <functional>
+#include <memory>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "../brick_game/api/game_module.h"
+#include "../brick_game/tetris/tetris_backend.h"
+#include "../brick_game/tetris/tetris_battle.h"
+#ifdef __cplusplus
+}
+#endif
+#include "protocol.h"
+
+#define SERVER_BATTLE_SEATS 2
+
+namespace s21 {
+/** @class Session
+ * @brief Базовый класс игровой сессии сервера
+ * @details Сессия владеет собственным экземпляром игры и работает с ним через
+ * тот же контракт, что и фронтенды: команды пользователя передаются в
+ * userInput, а такт игры выполняется функцией механики игры. После каждого
+ * такта вызывается обработчик, установленный через setTickHook. Сессия может
+ * состоять из нескольких полей (сражение): у каждого поля свой игрок и свой
+ * кадр, одиночная игра - сессия из одного поля
+ */
+class Session {
+public:
+  // DESTRUCTOR
+  virtual ~Session() = default;
+
+  // GAME FUNCS
+  virtual bool isCreated() = 0;
+  virtual void input(UserAction_t action, bool hold) = 0;
+  virtual void tick() = 0;
+  virtual void render(uint8_t *frame) = 0;
+  virtual GameStatus_t getStatus() = 0;
+  bool isOver();
+
+  // BOARDS
+  virtual int getBoardCount();
+  virtual void renderBoard(int board, uint8_t *frame);
+  virtual void inputBoard(int board, UserAction_t action, bool hold);
+  virtual void leave(int board);
+
+  // TICK HOOK
+  typedef std::function<void(Session &)> TickHook;
+  void setTickHook(TickHook hook);
+
+  // FACTORY
+  static std::unique_ptr<Session> create(int game);
+
+protected:
+  void tickCompleted();
+
+private:
+  TickHook tick_hook_;
+};
+
+/** @class ModuleSession
+ * @brief Сессия игры из реестра игровых модулей
+ * @details Команды, такт и кадр выполняются функциями модуля (см.
+ * game_module.h), поэтому любая зарегистрированная игра получает
+ * планировщик тактов, запись кадров и рассылку сервера без отдельного класса
+ * сессии
+ * @param module Игровой модуль
+ */
+class ModuleSession : public Session {
+public:
+  // CONSTRUCTOR & DESTRUCTOR
+  explicit ModuleSession(const GameModule_t *module);
+  ~ModuleSession() override;
+
+  // GAME FUNCS
+  bool isCreated() override;
+  void input(UserAction_t action, bool hold) override;
+  void tick() override;
+  void render(uint8_t *frame) override;
+  GameStatus_t getStatus() override;
+
+private:
+  const GameModule_t *module_;
+  void *state_;
+};
+
+/** @class BattleSession
+ * @brief Сессия сражения в Тетрисе
+ * @details Поля игроков шагают по одному планировщику battleStep, удалённые
+ * линии отправляются соперникам мусорными линиями (см. tetris_battle.h).
+ * Команды без номера поля относятся к первому полю
+ * @param seats Количество игроков
+ */
+class BattleSession : public Session {
+public:
+  // CONSTRUCTOR & DESTRUCTOR
+  explicit BattleSession(int seats);
+  ~BattleSession() override;
+
+  // GAME FUNCS
+  bool isCreated() override;
+  void input(UserAction_t action, bool hold) override;
+  void tick() override;
+  void render(uint8_t *frame) override;
+  GameStatus_t getStatus() override;
+
+  // BOARDS
+  int getBoardCount() override;
+  void renderBoard(int board, uint8_t *frame) override;
+  void inputBoard(int board, UserAction_t action, bool hold) override;
+  void leave(int board) override;
+
+private:
+  Battle_t battle_;
+  bool created_;
+};
+
+} // namespace s21
+
+#endif // CPP3_BRICK_GAME_V2_0_1_SERVER_SESSION_H_
@@ -0,0 +1,93 @@
+/** @file
+ * @brief Файл, содержащий реализацию пула потоков игрового сервера
+ */
+#include "thread_pool.h"
+
+namespace s21 {
+/**
+ * @brief Конструктор класса ThreadPool
+ * @details Запускает заданное количество потоков (не меньше одного), которые
+ * ожидают задачи из очереди
+ * @param threads Количество потоков
+ */
+ThreadPool::ThreadPool(int threads) : running_(0), stop_(false) {
+  if (threads < 1) {
+    threads = 1;
+  }
+  for (int i = 0; i < threads; ++i) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+/**
+ * @brief Деструктор класса ThreadPool
+ * @details Дожидается выполнения оставшихся задач и завершает потоки
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_ready_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+/**
+ * @brief Добавляет задачу в очередь
+ * @param task Задача
+ */
+void ThreadPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push(std::move(task));
+  }
+  task_ready_.notify_one();
+}
+
+/**
+ * @brief Ожидает выполнения всех задач
+ * @details Возвращает управление, когда очередь пуста и ни один поток не
+ * выполняет задачу
+ */
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  all_done_.wait(lock, [this]() { return tasks_.empty() && running_ == 0; });
+}
+
+/**
+ * @brief Геттер количества потоков
+ * @return Количество потоков пула
+ */
+int ThreadPool::size() const { return static_cast<int>(workers_.size()); }
+
+/**
+ * @brief Цикл потока пула
+ * @details Поток берёт задачи из очереди и выполняет их, пока пул не будет
+ * остановлен и очередь не опустеет
+ */
+void ThreadPool::workerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_ready_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (stop_ && tasks_.empty()) {
+        break;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+      running_++;
+    }
+    task();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_--;
+      if (tasks_.empty() && running_ == 0) {
+        all_done_.notify_all();
+      }
+    }
+  }
+}
+} // namespace s21
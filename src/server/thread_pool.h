@@ -0,0 +1,48 @@
+/** @file
+ * @brief Заголовочный файл, определяющий пул потоков игрового сервера
+ */
+#ifndef CPP3_BRICK_GAME_V2_0_1_SERVER_THREAD_POOL_H_
+#define CPP3_BRICK_GAME_V2_0_1_SERVER_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+/** @class ThreadPool
+ * @brief Пул потоков фиксированного размера
+ * @details Потоки создаются один раз в конструкторе и выполняют задачи из
+ * общей очереди. Метод wait позволяет дождаться выполнения всех переданных
+ * задач, что используется сервером для пошагового обновления сессий
+ * @param threads Количество потоков
+ */
+class ThreadPool {
+public:
+  // CONSTRUCTOR & DESTRUCTOR
+  explicit ThreadPool(int threads);
+  ~ThreadPool();
+
+  // TASK FUNCS
+  void submit(std::function<void()> task);
+  void wait();
+  int size() const;
+
+private:
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable task_ready_;
+  std::condition_variable all_done_;
+  int running_;
+  bool stop_;
+
+  // WORKER LOOP
+  void workerLoop();
+};
+
+} // namespace s21
+
+#endif // CPP3_BRICK_GAME_V2_0_1_SERVER_THREAD_POOL_H_
@@ -0,0 +1,306 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../brick_game/api/brick_game_loader.h"
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "../brick_game/api/brick_game_lockstep.h"
+#include "../brick_game/api/brick_game_replay.h"
+#include "../brick_game/api/game_module.h"
+#include "../brick_game/common/frame_codec.h"
+}
+
+#define API_TEST_LIB "build/libbrickgame.so.1"
+
+static void playGame(const BrickGameApi_t *api, BrickGame_t *game,
+                     uint8_t *frame) {
+  const UserAction_t actions[] = {Left, Action, Right, Right, HardDrop};
+  for (int i = 0; i < 200 && api->status(game) == kStart; i++) {
+    api->input(game, actions[i % 5], false);
+    api->step(game);
+  }
+  api->frame(game, frame);
+}
+
+struct CounterGame {
+  GameInfo_t info;
+  GameStatus_t status;
+};
+
+static void *counterCreate(unsigned int seed) {
+  return new CounterGame{{nullptr, nullptr, 0, static_cast<int>(seed % 10), 1,
+                          START_SPEED, 0},
+                         kStart};
+}
+
+static void counterDestroy(void *state) {
+  delete static_cast<CounterGame *>(state);
+}
+
+static void counterInput(void *state, UserAction_t action, bool hold) {
+  (void)hold;
+  if (action == Terminate) {
+    static_cast<CounterGame *>(state)->status = kGameOver;
+  }
+}
+
+static void counterStep(void *state) {
+  static_cast<CounterGame *>(state)->info.score++;
+}
+
+static int counterFrame(void *state, uint8_t *frame) {
+  CounterGame *game = static_cast<CounterGame *>(state);
+  return frameEncode(&game->info, game->status, frame);
+}
+
+static GameStatus_t counterStatus(const void *state) {
+  return static_cast<const CounterGame *>(state)->status;
+}
+
+static const GameModule_t counter_module = {
+    GAME_MODULE_FIRST_FREE, "COUNTER",    'k',          0,
+    {false, START_SPEED, "any key counts"},
+    counterCreate,          counterDestroy, counterInput, counterStep,
+    counterStep,            nullptr,        nullptr,      counterFrame,
+    counterStatus,          nullptr,        nullptr};
+
+TEST(ApiSuite, Version) {
+  const BrickGameApi_t *api = brickGameApi();
+  ASSERT_NE(api, nullptr);
+  EXPECT_EQ(api->version, BRICKGAME_API_VERSION);
+  EXPECT_EQ(api->size, static_cast<int>(sizeof(BrickGameApi_t)));
+  EXPECT_EQ(api->create, brickGameCreate);
+  EXPECT_EQ(brickGameCreate(7, 1), nullptr);
+  brickGameDestroy(nullptr);
+}
+
+TEST(ApiSuite, TetrisIsDeterministic) {
+  const BrickGameApi_t *api = brickGameApi();
+  BrickGame_t *first = api->create(BRICKGAME_TETRIS, 42);
+  BrickGame_t *second = api->create(BRICKGAME_TETRIS, 42);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  uint8_t first_frame[FRAME_KEY_SIZE];
+  uint8_t second_frame[FRAME_KEY_SIZE];
+  EXPECT_EQ(api->frame(second, second_frame), FRAME_KEY_SIZE);
+  api->step(first);
+  api->frame(first, first_frame);
+  EXPECT_NE(std::memcmp(first_frame, second_frame, FRAME_KEY_SIZE), 0);
+  api->destroy(first);
+  first = api->create(BRICKGAME_TETRIS, 42);
+  playGame(api, first, first_frame);
+  playGame(api, second, second_frame);
+  EXPECT_EQ(std::memcmp(first_frame, second_frame, FRAME_KEY_SIZE), 0);
+  int static_cells = 0;
+  for (int x = 0; x < WIDTH; x++) {
+    static_cells += frameCell(first_frame, HEIGHT - 1, x) == STATIC_CELL;
+  }
+  EXPECT_GT(static_cells + frameScore(first_frame), 0);
+  api->destroy(first);
+  api->destroy(second);
+}
+
+TEST(ApiSuite, TerminateAndPause) {
+  BrickGame_t *game = brickGameCreate(BRICKGAME_TETRIS, 3);
+  ASSERT_NE(game, nullptr);
+  uint8_t before[FRAME_KEY_SIZE];
+  uint8_t after[FRAME_KEY_SIZE];
+  brickGameInput(game, Pause, false);
+  brickGameFrame(game, before);
+  brickGameStep(game);
+  brickGameTick(game);
+  brickGameFrame(game, after);
+  EXPECT_EQ(std::memcmp(before, after, FRAME_KEY_SIZE), 0);
+  brickGameInput(game, Terminate, false);
+  EXPECT_EQ(brickGameStatus(game), kGameOver);
+  brickGameDestroy(game);
+}
+
+TEST(ApiSuite, Snake) {
+  BrickGame_t *game = brickGameCreate(BRICKGAME_SNAKE, 5);
+  ASSERT_NE(game, nullptr);
+  uint8_t before[FRAME_KEY_SIZE];
+  uint8_t after[FRAME_KEY_SIZE];
+  EXPECT_EQ(brickGameFrame(game, before), FRAME_KEY_SIZE);
+  brickGameInput(game, Left, false);
+  brickGameStep(game);
+  brickGameFrame(game, after);
+  EXPECT_NE(std::memcmp(before, after, FRAME_KEY_SIZE), 0);
+  for (int i = 0; i < 2 * WIDTH && brickGameStatus(game) == kStart; i++) {
+    brickGameStep(game);
+  }
+  EXPECT_EQ(brickGameStatus(game), kGameOver);
+  brickGameInput(game, Terminate, false);
+  EXPECT_EQ(brickGameStatus(game), kGameOver);
+  brickGameDestroy(game);
+}
+
+TEST(ApiSuite, Loader) {
+  BrickGameLib_t lib;
+  EXPECT_EQ(brickGameOpen("build/no_such_engine.so", &lib), STOP);
+  EXPECT_EQ(lib.handle, nullptr);
+  EXPECT_EQ(lib.api, nullptr);
+  ASSERT_EQ(brickGameOpen(API_TEST_LIB, &lib), START);
+  ASSERT_NE(lib.api, nullptr);
+  EXPECT_EQ(lib.api->version, BRICKGAME_API_VERSION);
+  BrickGame_t *loaded = lib.api->create(BRICKGAME_TETRIS, 9);
+  BrickGame_t *linked = brickGameCreate(BRICKGAME_TETRIS, 9);
+  uint8_t loaded_frame[FRAME_KEY_SIZE];
+  uint8_t linked_frame[FRAME_KEY_SIZE];
+  playGame(lib.api, loaded, loaded_frame);
+  playGame(brickGameApi(), linked, linked_frame);
+  EXPECT_EQ(std::memcmp(loaded_frame, linked_frame, FRAME_KEY_SIZE), 0);
+  lib.api->destroy(loaded);
+  brickGameDestroy(linked);
+  brickGameClose(&lib);
+  EXPECT_EQ(lib.handle, nullptr);
+}
+
+TEST(ApiSuite, Registry) {
+  EXPECT_EQ(findGameModule(BRICKGAME_TETRIS), tetrisModule());
+  EXPECT_EQ(findGameModule(BRICKGAME_SNAKE), snakeModule());
+  EXPECT_EQ(findGameModuleByKey('T'), tetrisModule());
+  EXPECT_EQ(findGameModuleByKey('s'), snakeModule());
+  EXPECT_EQ(findGameModuleByKey('k'), nullptr);
+  EXPECT_EQ(gameModuleCount(), 2);
+  EXPECT_EQ(registerGameModule(nullptr), STOP);
+  EXPECT_EQ(registerGameModule(tetrisModule()), STOP);
+  GameModule_t broken = counter_module;
+  broken.frame = nullptr;
+  EXPECT_EQ(registerGameModule(&broken), STOP);
+  ASSERT_EQ(registerGameModule(&counter_module), START);
+  EXPECT_EQ(registerGameModule(&counter_module), STOP);
+  EXPECT_EQ(gameModuleAt(2), &counter_module);
+  EXPECT_EQ(gameModuleAt(3), nullptr);
+  EXPECT_EQ(findGameModuleByKey('K'), &counter_module);
+
+  BrickGame_t *game = brickGameCreate(GAME_MODULE_FIRST_FREE, 14);
+  ASSERT_NE(game, nullptr);
+  uint8_t frame[FRAME_KEY_SIZE];
+  brickGameStep(game);
+  brickGameTick(game);
+  brickGameFrame(game, frame);
+  EXPECT_EQ(frameScore(frame), 2);
+  EXPECT_EQ(frameHighScore(frame), 4);
+  brickGameInput(game, Terminate, false);
+  EXPECT_EQ(brickGameStatus(game), kGameOver);
+  brickGameDestroy(game);
+}
+
+TEST(ApiSuite, ModuleSerialize) {
+  for (const GameModule_t *module : {tetrisModule(), snakeModule()}) {
+    void *first = module->create(11);
+    void *second = module->create(12);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    for (int i = 0; i < 3; i++) {
+      module->input(first, Left, false);
+      module->step(first);
+    }
+    std::vector<uint8_t> buffer(module->state_size);
+    module->serialize(first, buffer.data());
+    module->deserialize(second, buffer.data());
+    uint8_t first_frame[FRAME_KEY_SIZE];
+    uint8_t second_frame[FRAME_KEY_SIZE];
+    for (int i = 0; i < 20; i++) {
+      module->input(first, Right, false);
+      module->input(second, Right, false);
+      module->step(first);
+      module->step(second);
+    }
+    module->frame(first, first_frame);
+    module->frame(second, second_frame);
+    EXPECT_EQ(std::memcmp(first_frame, second_frame, FRAME_KEY_SIZE), 0);
+    EXPECT_EQ(module->status(first), module->status(second));
+    module->destroy(first);
+    module->destroy(second);
+  }
+}
+
+TEST(ApiSuite, Lockstep) {
+  BrickGame_t *game = brickGameCreate(BRICKGAME_SNAKE, 4);
+  unsigned long long sum = brickGameChecksum(game);
+  EXPECT_NE(sum, 0u);
+  brickGameStep(game);
+  EXPECT_NE(brickGameChecksum(game), sum);
+  brickGameDestroy(game);
+  EXPECT_TRUE(brickGameHas(brickGameApi(), offsetof(BrickGameApi_t, checksum)));
+  BrickGameApi_t old_api = *brickGameApi();
+  old_api.size = BRICKGAME_API_MIN_SIZE;
+  EXPECT_FALSE(brickGameHas(&old_api, offsetof(BrickGameApi_t, checksum)));
+
+  const char *path = "api_lockstep.bin";
+  Lockstep_t record;
+  LockstepPosition_t position = {0, 0, 0};
+  ASSERT_EQ(createLockstep(&record), START);
+  ASSERT_EQ(brickGameLockstepRun(brickGameApi(), 3, 300, &record, &position),
+            START);
+  ASSERT_EQ(lockstepSave(&record, path), START);
+  removeLockstep(&record);
+  EXPECT_EQ(brickGameLockstepRun(&old_api, 3, 300, &record, &position), STOP);
+
+  BrickGameLib_t lib;
+  ASSERT_EQ(brickGameOpen(API_TEST_LIB, &lib), START);
+  Lockstep_t verify;
+  ASSERT_EQ(lockstepLoad(&verify, path), START);
+  EXPECT_EQ(brickGameLockstepRun(lib.api, 3, 300, &verify, &position), START);
+  EXPECT_TRUE(lockstepIsComplete(&verify));
+  removeLockstep(&verify);
+  ASSERT_EQ(lockstepLoad(&verify, path), START);
+  EXPECT_EQ(brickGameLockstep(lib.api, BRICKGAME_SNAKE, 0, 300, &verify,
+                              &position),
+            STOP);
+  EXPECT_EQ(verify.mismatch, 0);
+  EXPECT_EQ(position.game, BRICKGAME_SNAKE);
+  EXPECT_EQ(position.step, 0);
+  removeLockstep(&verify);
+  brickGameClose(&lib);
+  std::remove(path);
+}
+
+TEST(ApiSuite, Replay) {
+  const char *path = "api_replay.bga";
+  Replay_t replay;
+  ArchiveWriter_t writer;
+  ASSERT_EQ(createReplay(&replay, BRICKGAME_TETRIS, 0), START);
+  ASSERT_EQ(createArchiveWriter(&writer, path), START);
+  int scores[6] = {0};
+  for (int id = 0; id < 6; id++) {
+    int game = id % 2 == 0 ? BRICKGAME_TETRIS : BRICKGAME_SNAKE;
+    ASSERT_EQ(brickGameRecord(brickGameApi(), game, id, 400, &replay, nullptr),
+              START);
+    EXPECT_GT(replay.steps, 0);
+    EXPECT_LE(replay.steps, 400);
+    scores[id] = replay.score;
+    ASSERT_EQ(archiveWrite(&writer, id, &replay), START);
+  }
+  ASSERT_EQ(closeArchiveWriter(&writer), START);
+  EXPECT_EQ(brickGameRecord(brickGameApi(), 99, 0, 400, &replay, nullptr),
+            STOP);
+
+  BrickGameLib_t lib;
+  Archive_t archive;
+  ASSERT_EQ(brickGameOpen(API_TEST_LIB, &lib), START);
+  ASSERT_EQ(openArchive(&archive, path, ARCHIVE_RANDOM), START);
+  for (int id = 5; id >= 0; id--) {
+    ArchiveEntry_t entry;
+    int score = -1;
+    ASSERT_EQ(archiveFind(&archive, id, &entry), START);
+    ASSERT_EQ(archiveLoad(&archive, &entry, &replay), START);
+    ASSERT_EQ(brickGamePlay(lib.api, &replay, &score), START);
+    EXPECT_EQ(score, scores[id]);
+    EXPECT_EQ(entry.score, scores[id]);
+  }
+  closeArchive(&archive);
+  brickGameClose(&lib);
+  removeReplay(&replay);
+  std::remove(path);
+}
+
+int main(int argc, char **argv) {
+  std::cout << std::endl << "STARTING API TESTS" << std::endl;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,7 +1,15 @@
 #define _GNU_SOURSE
 #include <check.h>
 
+#include "../brick_game/common/arena.h"
 #include "../brick_game/common/common_back.h"
+#include "../brick_game/common/event_log.h"
+#include "../brick_game/common/frame_codec.h"
+#include "../brick_game/common/frame_meter.h"
+#include "../brick_game/common/input_queue.h"
+#include "../brick_game/common/lockstep.h"
+#include "../brick_game/common/profiler.h"
+#include "../brick_game/common/replay_archive.h"
 
 START_TEST(setTime_test) {
   {
@@ -42,12 +50,466 @@ START_TEST(setSpeed_test) {
 }
 END_TEST
 
+START_TEST(randomNumber_test) {
+  unsigned int seed_a = 21;
+  unsigned int seed_b = 21;
+  for (int i = 0; i < 100; i++) {
+    int number = randomNumber(&seed_a);
+    ck_assert_int_ge(number, 0);
+    ck_assert_int_eq(number, randomNumber(&seed_b));
+  }
+  ck_assert_uint_eq(seed_a, seed_b);
+  unsigned int seed_c = 22;
+  ck_assert_int_ne(randomNumber(&seed_c), randomNumber(&seed_a));
+}
+END_TEST
+
+START_TEST(zobristKey_test) {
+  ck_assert(zobristKey(0, 1, 2) == zobristKey(0, 1, 2));
+  ck_assert(zobristKey(0, 1, 2) != zobristKey(0, 2, 1));
+  ck_assert(zobristKey(0, 1, 2) != zobristKey(1, 1, 2));
+  ck_assert(zobristKey(0, 0, 0) != 0);
+}
+END_TEST
+
+START_TEST(frameCodec_test) {
+  int field_cells[HEIGHT + 1][WIDTH + 1] = {0};
+  int next_cells[4][4] = {0};
+  int *field[HEIGHT + 1];
+  int *next[4];
+  for (int y = 0; y <= HEIGHT; y++) {
+    field[y] = field_cells[y];
+  }
+  for (int y = 0; y < 4; y++) {
+    next[y] = next_cells[y];
+  }
+  GameInfo_t stats = {field, next, 1200, 5000, 3, 800, 0};
+  for (int x = 1; x <= WIDTH; x++) {
+    field_cells[HEIGHT][x] = STATIC_CELL;
+  }
+  field_cells[1][4] = field_cells[1][5] = field_cells[1][6] = MOVING_CELL;
+  field_cells[2][5] = MOVING_CELL;
+  field_cells[HEIGHT - 1][5] = GHOST_CELL;
+  next_cells[0][1] = next_cells[1][1] = MOVING_CELL;
+  uint8_t prev[FRAME_KEY_SIZE];
+  ck_assert_int_eq(frameEncode(&stats, kStart, prev), FRAME_KEY_SIZE);
+  ck_assert_int_lt(FRAME_KEY_SIZE, 64);
+  ck_assert_int_eq(frameCheck(prev, FRAME_KEY_SIZE), START);
+  ck_assert_int_eq(frameVersion(prev), FRAME_VERSION);
+  ck_assert_int_eq(frameCell(prev, 0, 4), MOVING_CELL);
+  ck_assert_int_eq(frameCell(prev, HEIGHT - 1, 0), STATIC_CELL);
+  ck_assert_int_eq(frameCell(prev, HEIGHT - 2, 4), GHOST_CELL);
+  ck_assert_int_eq(frameCell(prev, 5, 5), EMPTY_CELL);
+  ck_assert_int_eq(frameNext(prev, 1, 1), MOVING_CELL);
+  ck_assert_int_eq(frameScore(prev), 1200);
+  ck_assert_int_eq(frameHighScore(prev), 5000);
+  ck_assert_int_eq(frameLevel(prev), 3);
+  ck_assert_int_eq(frameSpeed(prev), 800);
+  ck_assert_int_eq(frameStatus(prev), kStart);
+
+  field_cells[1][4] = field_cells[1][6] = EMPTY_CELL;
+  field_cells[2][4] = field_cells[2][6] = field_cells[3][5] = MOVING_CELL;
+  uint8_t curr[FRAME_KEY_SIZE];
+  frameEncode(&stats, kStart, curr);
+  uint8_t delta[FRAME_DELTA_MAX_SIZE];
+  int size = frameDelta(prev, curr, delta);
+  ck_assert_int_gt(size, 0);
+  ck_assert_int_lt(size, 8);
+  ck_assert_int_eq(frameType(delta), FRAME_DELTA);
+  ck_assert_int_eq(frameDelta(curr, curr, delta + size), 0);
+  ck_assert_int_eq(frameApply(prev, delta, size), START);
+  ck_assert_mem_eq(prev, curr, FRAME_KEY_SIZE);
+
+  stats.score = 1300;
+  stats.pause = 1;
+  frameEncode(&stats, kPause, curr);
+  size = frameDelta(prev, curr, delta);
+  ck_assert_int_eq(size, 1 + FRAME_STATS_SIZE);
+  ck_assert_int_eq(frameType(delta), FRAME_DELTA_STATS);
+  ck_assert_int_eq(frameScore(delta), 1300);
+  ck_assert_int_eq(frameApply(prev, delta, size), START);
+  ck_assert_int_eq(framePause(prev), 1);
+  ck_assert_int_eq(frameStatus(prev), kPause);
+
+  int decoded_cells[HEIGHT + 1][WIDTH + 1] = {0};
+  int decoded_next[4][4] = {0};
+  int *decoded_field[HEIGHT + 1];
+  int *decoded_rows[4];
+  for (int y = 0; y <= HEIGHT; y++) {
+    decoded_field[y] = decoded_cells[y];
+  }
+  for (int y = 0; y < 4; y++) {
+    decoded_rows[y] = decoded_next[y];
+  }
+  GameInfo_t decoded = {decoded_field, decoded_rows, 0, 0, 0, 0, 0};
+  frameDecode(prev, &decoded);
+  ck_assert_mem_eq(decoded_cells, field_cells, sizeof(field_cells));
+  ck_assert_mem_eq(decoded_next, next_cells, sizeof(next_cells));
+  ck_assert_int_eq(decoded.score, 1300);
+  ck_assert_int_eq(decoded.pause, 1);
+}
+END_TEST
+
+START_TEST(frameCheck_test) {
+  uint8_t delta[3] = {FRAME_VERSION << 4 | FRAME_DELTA, 0x01, 0x00};
+  ck_assert_int_eq(frameCheck(delta, 3), START);
+  ck_assert_int_eq(frameCheck(delta, 2), STOP);
+  ck_assert_int_eq(frameCheck(delta, 0), STOP);
+  delta[2] = HEIGHT << 3;
+  ck_assert_int_eq(frameCheck(delta, 3), STOP);
+  delta[2] = 0;
+  delta[0] = (FRAME_VERSION + 1) << 4 | FRAME_DELTA;
+  ck_assert_int_eq(frameCheck(delta, 3), STOP);
+  uint8_t frame[FRAME_KEY_SIZE] = {FRAME_VERSION << 4 | FRAME_KEY, kWin + 1};
+  ck_assert_int_eq(frameCheck(frame, FRAME_KEY_SIZE), STOP);
+  ck_assert_int_eq(frameApply(frame, delta, 3), STOP);
+  frame[1] = kWin;
+  ck_assert_int_eq(frameCheck(frame, FRAME_KEY_SIZE), START);
+  ck_assert_int_eq(frameCheck(frame, FRAME_KEY_SIZE - 1), STOP);
+}
+END_TEST
+
+START_TEST(inputQueue_test) {
+  InputQueue_t queue;
+  InputEvent_t event;
+  initInputQueue(&queue);
+  ck_assert(!popInput(&queue, &event));
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < INPUT_QUEUE_SIZE; i++) {
+      ck_assert_int_eq(pushInput(&queue, i % 2 ? Left : Right, i % 3, i),
+                       START);
+    }
+    ck_assert_int_eq(pushInput(&queue, Down, true, 0), STOP);
+    ck_assert_int_eq(inputCount(&queue), INPUT_QUEUE_SIZE);
+    for (int i = 0; i < INPUT_QUEUE_SIZE; i++) {
+      ck_assert(popInput(&queue, &event));
+      ck_assert_int_eq(event.time, i);
+      ck_assert_int_eq(event.action, i % 2 ? Left : Right);
+      ck_assert_int_eq(event.pressed, i % 3 != 0);
+    }
+    ck_assert(!popInput(&queue, &event));
+    ck_assert_int_eq(pushInput(&queue, Action, true, 7), START);
+    ck_assert(popInput(&queue, &event));
+    ck_assert_int_eq(event.action, Action);
+  }
+  ck_assert_uint_eq(queue.dropped, 3);
+  ck_assert_int_eq(inputCount(&queue), 0);
+}
+END_TEST
+
+START_TEST(lockstep_test) {
+  ck_assert(checksumInt(CHECKSUM_INIT, 1) != checksumInt(CHECKSUM_INIT, 2));
+  ck_assert(checksumInt(checksumInt(CHECKSUM_INIT, 1), 2) !=
+            checksumInt(checksumInt(CHECKSUM_INIT, 2), 1));
+  Lockstep_t record;
+  ck_assert_int_eq(createLockstep(&record), START);
+  for (int i = 0; i < 3000; i++) {
+    ck_assert_int_eq(lockstepPush(&record, checksumInt(CHECKSUM_INIT, i)),
+                     START);
+  }
+  ck_assert_int_eq(record.count, 3000);
+  const char *path = "lockstep_test.bin";
+  ck_assert_int_eq(lockstepSave(&record, path), START);
+
+  Lockstep_t verify;
+  ck_assert_int_eq(lockstepLoad(&verify, path), START);
+  ck_assert_int_eq(verify.mode, LOCKSTEP_VERIFY);
+  ck_assert_int_eq(verify.count, 3000);
+  for (int i = 0; i < 3000; i++) {
+    ck_assert(verify.sums[i] == record.sums[i]);
+    ck_assert_int_eq(lockstepPush(&verify, record.sums[i]), START);
+  }
+  ck_assert(lockstepIsComplete(&verify));
+  ck_assert_int_eq(lockstepPush(&verify, 0), STOP);
+  ck_assert_int_eq(verify.mismatch, 3000);
+  verify.position = 0;
+  verify.mismatch = LOCKSTEP_NO_MISMATCH;
+  ck_assert_int_eq(lockstepPush(&verify, record.sums[0]), START);
+  ck_assert_int_eq(lockstepPush(&verify, record.sums[0]), STOP);
+  ck_assert_int_eq(verify.mismatch, 1);
+  ck_assert(!lockstepIsComplete(&verify));
+  removeLockstep(&verify);
+  removeLockstep(&record);
+
+  FILE *file = fopen(path, "wb");
+  fputs("BGSS", file);
+  fclose(file);
+  ck_assert_int_eq(lockstepLoad(&verify, path), STOP);
+  ck_assert_int_eq(lockstepLoad(&verify, "no_such_dir/lockstep.bin"), STOP);
+  remove(path);
+}
+END_TEST
+
+START_TEST(arena_test) {
+  Arena_t arena;
+  size_t capacity = arenaSize(3) + arenaMatrixSize(5, 7);
+  ck_assert_int_eq(arenaSize(1), ARENA_ALIGN);
+  ck_assert_int_eq(arenaSize(ARENA_ALIGN), ARENA_ALIGN);
+  ck_assert_int_eq(createArena(&arena, capacity), START);
+  for (int round = 0; round < 2; round++) {
+    uint8_t *bytes = (uint8_t *)arenaAlloc(&arena, 3);
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_int_eq(bytes[0] + bytes[1] + bytes[2], 0);
+    bytes[1] = 9;
+    int **matrix = arenaMatrix(&arena, 5, 7);
+    ck_assert_ptr_nonnull(matrix);
+    ck_assert_int_eq((uintptr_t)matrix % ARENA_ALIGN, 0);
+    for (int y = 0; y < 5; y++) {
+      ck_assert_ptr_eq(matrix[y], matrix[0] + y * 7);
+      for (int x = 0; x < 7; x++) {
+        ck_assert_int_eq(matrix[y][x], 0);
+        matrix[y][x] = y * 7 + x + 1;
+      }
+    }
+    ck_assert_int_eq(arena.used, capacity);
+    ck_assert_ptr_null(arenaAlloc(&arena, 1));
+    ck_assert_ptr_null(arenaMatrix(&arena, 1, 1));
+    resetArena(&arena);
+    ck_assert_int_eq(arena.used, 0);
+  }
+  removeArena(&arena);
+  ck_assert_ptr_null(arena.memory);
+  ck_assert_ptr_null(arenaAlloc(&arena, 1));
+}
+END_TEST
+
+START_TEST(replayArchive_test) {
+  uint8_t commands[400];
+  uint8_t data[REPLAY_BOUND(400)];
+  uint8_t unpacked[400];
+  for (int i = 0; i < 400; i++) {
+    commands[i] = i < 300 ? REPLAY_IDLE : (uint8_t)(Left + i % 3);
+  }
+  commands[0] = Down | REPLAY_HOLD;
+  size_t size = replayCompress(commands, 400, data);
+  ck_assert_int_eq(size, 2 + 3 + 100 * 2);
+  ck_assert_int_eq(replayDecompress(data, size, unpacked, 400), START);
+  ck_assert_int_eq(memcmp(commands, unpacked, 400), 0);
+  ck_assert_int_eq(replayDecompress(data, size, unpacked, 399), STOP);
+  ck_assert_int_eq(replayDecompress(data, size, unpacked, 401), STOP);
+  ck_assert_int_eq(replayDecompress(data, 4, unpacked, 400), STOP);
+
+  const char *path = "replay_test.bga";
+  ArchiveWriter_t writer;
+  Replay_t replay;
+  ck_assert_int_eq(createArchiveWriter(&writer, path), START);
+  for (int id = 2; id >= 0; id--) {
+    ck_assert_int_eq(createReplay(&replay, id % 2, 10 + id), START);
+    for (int i = 0; i < 1500 * id; i++) {
+      ck_assert_int_eq(replayPush(&replay, (uint8_t)(i / 7 % 10)), START);
+    }
+    replay.score = 100 * id;
+    ck_assert_int_eq(archiveWrite(&writer, (uint64_t)id * 1000, &replay),
+                     START);
+    removeReplay(&replay);
+  }
+  ck_assert_int_eq(closeArchiveWriter(&writer), START);
+
+  Archive_t archive;
+  ArchiveEntry_t entry;
+  ck_assert_int_eq(openArchive(&archive, path, ARCHIVE_RANDOM), START);
+  ck_assert_int_eq(archive.count, 3);
+  archiveEntry(&archive, 0, &entry);
+  ck_assert_int_eq(entry.id, 0);
+  ck_assert_int_eq(entry.steps, 0);
+  ck_assert_int_eq(archiveFind(&archive, 1500, &entry), STOP);
+  ck_assert_int_eq(archiveFind(&archive, 2000, &entry), START);
+  ck_assert_int_eq(entry.steps, 3000);
+  ck_assert_int_eq(entry.seed, 12);
+  ck_assert_int_eq(entry.score, 200);
+  ck_assert_int_eq(entry.game, 0);
+  ck_assert_int_eq(createReplay(&replay, 0, 0), START);
+  ck_assert_int_eq(archiveLoad(&archive, &entry, &replay), START);
+  ck_assert_int_eq(replay.steps, 3000);
+  ck_assert_int_eq(replay.commands[2999], 2999 / 7 % 10);
+  ck_assert_int_eq(archiveFind(&archive, 1000, &entry), START);
+  ck_assert_int_eq(archiveLoad(&archive, &entry, &replay), START);
+  ck_assert_int_eq(replay.steps, 1500);
+  ck_assert_int_eq(replay.game, 1);
+  entry.size += 1;
+  ck_assert_int_eq(archiveLoad(&archive, &entry, &replay), STOP);
+  removeReplay(&replay);
+  closeArchive(&archive);
+
+  ck_assert_int_eq(createArchiveWriter(&writer, path), START);
+  ck_assert_int_eq(createReplay(&replay, 0, 0), START);
+  ck_assert_int_eq(archiveWrite(&writer, 5, &replay), START);
+  ck_assert_int_eq(archiveWrite(&writer, 5, &replay), START);
+  removeReplay(&replay);
+  ck_assert_int_eq(closeArchiveWriter(&writer), STOP);
+  ck_assert_int_eq(openArchive(&archive, path, ARCHIVE_SCAN), STOP);
+  remove(path);
+  ck_assert_int_eq(openArchive(&archive, path, ARCHIVE_SCAN), STOP);
+}
+END_TEST
+
+START_TEST(eventLog_test) {
+  const char *path = "event_test.bgev";
+  EventLog_t log;
+  GameEvents_t events;
+  remove(path);
+  ck_assert_int_eq(createEventLog(&log, path), START);
+  for (int i = 0; i < EVENT_BLOCK_ROWS + 10; i++) {
+    int32_t row[EVENT_COLUMNS] = {i,  7, 0, EVENT_LOCK, i % 7, 0,
+                                  -i, 0, 0, 0,          0};
+    ck_assert_int_eq(eventLogAppend(&log, row), START);
+  }
+  ck_assert_int_eq(log.rows, 10);
+  ck_assert_int_eq(removeEventLog(&log), START);
+  ck_assert_int_eq(createEventLog(&log, path), START);
+  startGameEvents(&events, &log, 3, 1);
+  events.tick = 42;
+  gameEvent(&events, EVENT_SPAWN, 5, 1, 4, 2, 0, 0);
+  events.tick = 45;
+  gameEvent(&events, EVENT_LOCK, 5, 2, 6, 19, 3, 700);
+  ck_assert_int_eq(removeEventLog(&log), START);
+  events.log = NULL;
+  gameEvent(&events, EVENT_APPLE, 4, 0, 1, 1, 0, 1);
+
+  EventFile_t file;
+  EventBlock_t block;
+  size_t offset = 0;
+  ck_assert_int_eq(openEventFile(&file, path), START);
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), START);
+  ck_assert_int_eq(block.rows, EVENT_BLOCK_ROWS);
+  ck_assert_int_eq(block.min[EVENT_TICK], 0);
+  ck_assert_int_eq(block.max[EVENT_TICK], EVENT_BLOCK_ROWS - 1);
+  ck_assert_int_eq(block.min[EVENT_X], 1 - EVENT_BLOCK_ROWS);
+  ck_assert_int_eq(block.max[EVENT_PIECE], 6);
+  ck_assert_int_eq(block.columns[EVENT_PIECE][100], 100 % 7);
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), START);
+  ck_assert_int_eq(block.rows, 10);
+  ck_assert_int_eq(block.columns[EVENT_TICK][9], EVENT_BLOCK_ROWS + 9);
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), START);
+  ck_assert_int_eq(block.rows, 2);
+  ck_assert_int_eq(block.columns[EVENT_TICK][0], 42);
+  ck_assert_int_eq(block.columns[EVENT_TICK][1], 45);
+  ck_assert_int_eq(block.columns[EVENT_SESSION][1], 3);
+  ck_assert_int_eq(block.columns[EVENT_GAME][1], 1);
+  ck_assert_int_eq(block.columns[EVENT_KIND][0], EVENT_SPAWN);
+  ck_assert_int_eq(block.columns[EVENT_THINK][0], 0);
+  ck_assert_int_eq(block.columns[EVENT_KIND][1], EVENT_LOCK);
+  ck_assert_int_eq(block.columns[EVENT_ROTATION][1], 2);
+  ck_assert_int_eq(block.columns[EVENT_Y][1], 19);
+  ck_assert_int_eq(block.columns[EVENT_LINES][1], 3);
+  ck_assert_int_eq(block.columns[EVENT_SCORE][1], 700);
+  ck_assert_int_eq(block.columns[EVENT_THINK][1], 3);
+  ck_assert_int_eq(block.min[EVENT_SCORE], 0);
+  ck_assert_int_eq(block.max[EVENT_SCORE], 700);
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), STOP);
+  ck_assert_int_eq(offset, file.size);
+  closeEventFile(&file);
+
+  FILE *tail = fopen(path, "ab");
+  ck_assert_ptr_nonnull(tail);
+  fwrite("BGEV", 1, 4, tail);
+  fclose(tail);
+  offset = 0;
+  ck_assert_int_eq(openEventFile(&file, path), START);
+  for (int i = 0; i < 3; i++) {
+    ck_assert_int_eq(eventBlock(&file, &offset, &block), START);
+  }
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), STOP);
+  ck_assert_int_eq(offset, file.size - 4);
+  closeEventFile(&file);
+  remove(path);
+  ck_assert_int_eq(openEventFile(&file, path), STOP);
+}
+END_TEST
+
+START_TEST(frameMeter_test) {
+  FrameMeter_t meter;
+  startFrameMeter(&meter, 1000);
+  ck_assert_int_eq(meter.input, FRAME_METER_NO_INPUT);
+  frameMeterInput(&meter, 2000);
+  frameMeterInput(&meter, 3000);
+  frameMeterTicks(&meter, 4, 400);
+  frameMeterPresent(&meter, 300, 6000);
+  ck_assert_int_eq(meter.input, FRAME_METER_NO_INPUT);
+  frameMeterInput(&meter, 7000);
+  frameMeterSkip(&meter);
+  frameMeterTicks(&meter, 0, 10);
+  frameMeterPresent(&meter, 500, 8000);
+  frameMeterInput(&meter, 9000);
+  frameMeterPresent(&meter, 100, 11000);
+  ck_assert(!frameMeterUpdate(&meter, 500000));
+  ck_assert_double_eq(meter.readout.fps, 0.0);
+  frameMeterInput(&meter, 900000);
+  ck_assert(frameMeterUpdate(&meter, 1001000));
+  ck_assert_double_eq(meter.readout.tick_us, 102.5);
+  ck_assert_double_eq(meter.readout.render_us, 300.0);
+  ck_assert_double_eq(meter.readout.fps, 3.0);
+  ck_assert_double_eq(meter.readout.latency_us, 3000.0);
+  ck_assert_int_eq(meter.readout.max_latency_us, 4000);
+  ck_assert_int_eq(meter.input, 900000);
+  ck_assert_int_eq(meter.renders, 0);
+  ck_assert(!frameMeterUpdate(&meter, 1500000));
+  ck_assert_double_eq(meter.readout.fps, 3.0);
+  frameMeterPresent(&meter, 200, 1600000);
+  ck_assert(frameMeterUpdate(&meter, 2001000));
+  ck_assert_double_eq(meter.readout.tick_us, 0.0);
+  ck_assert_double_eq(meter.readout.render_us, 200.0);
+  ck_assert_double_eq(meter.readout.fps, 1.0);
+  ck_assert_double_eq(meter.readout.latency_us, 700000.0);
+  ck_assert_int_ge(frameMeterMicros(), 1000000);
+}
+END_TEST
+
+START_TEST(profiler_test) {
+  const char *path = "profile_test.folded";
+  profileEnter(PROFILE_TETRIS_MECHANICS);
+  profileSample();
+  profileEnter(PROFILE_LINE_CLEAR);
+  profileSample();
+  profileSample();
+  profileLeave();
+  profileLeave();
+  profileLeave();
+  profileSample();
+  for (int i = 0; i < PROFILE_DEPTH + 2; i++) {
+    profileEnter(PROFILE_GRAVITY);
+  }
+  profileSample();
+  for (int i = 0; i < PROFILE_DEPTH + 2; i++) {
+    profileLeave();
+  }
+  ck_assert_int_eq(writeProfile(path), START);
+  FILE *file = fopen(path, "r");
+  char folded[1024] = {0};
+  size_t size = fread(folded, 1, sizeof(folded) - 1, file);
+  fclose(file);
+  ck_assert_int_gt(size, 0);
+  ck_assert_ptr_nonnull(strstr(folded, "brickgame;tetrisMechanics 1\n"));
+  ck_assert_ptr_nonnull(
+      strstr(folded, "brickgame;tetrisMechanics;removeLine 2\n"));
+  ck_assert_ptr_nonnull(strstr(folded, "brickgame 1\n"));
+  ck_assert_ptr_nonnull(strstr(folded, ";gravity;gravity 1\n"));
+  ck_assert_ptr_null(strstr(folded, "unknown"));
+  ck_assert_str_eq(profilePhaseName(PROFILE_PHASES), "unknown");
+  ck_assert_str_eq(profilePhaseName(PROFILE_PAINT_EVENT), "paintEvent");
+  ck_assert_int_eq(startProfiler(NULL), STOP);
+  ck_assert_int_eq(writeProfile("no_such_dir/profile.folded"), STOP);
+  remove(path);
+}
+END_TEST
+
 Suite *test_suite() {
   Suite *s = suite_create("common_back_tests");
   TCase *test = tcase_create("common_back_tests");
 
   tcase_add_test(test, setTime_test);
   tcase_add_test(test, setSpeed_test);
+  tcase_add_test(test, randomNumber_test);
+  tcase_add_test(test, zobristKey_test);
+  tcase_add_test(test, frameCodec_test);
+  tcase_add_test(test, frameCheck_test);
+  tcase_add_test(test, inputQueue_test);
+  tcase_add_test(test, lockstep_test);
+  tcase_add_test(test, arena_test);
+  tcase_add_test(test, replayArchive_test);
+  tcase_add_test(test, eventLog_test);
+  tcase_add_test(test, frameMeter_test);
+  tcase_add_test(test, profiler_test);
 
   suite_add_tcase(s, test);
   return s;
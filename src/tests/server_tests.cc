@@ -0,0 +1,429 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <cstring>
+#include <thread>
+
+#include "../server/game_server.h"
+#include "gtest/gtest.h"
+
+static bool readRecord(int fd, std::vector<uint8_t> &data) {
+  uint8_t header[FRAME_HEADER_SIZE];
+  bool is_read = recv(fd, header, sizeof(header), MSG_WAITALL) ==
+                 static_cast<ssize_t>(sizeof(header));
+  if (is_read) {
+    int length = header[0] | (header[1] << 8);
+    data.resize(length);
+    is_read = recv(fd, data.data(), length, MSG_WAITALL) == length;
+  }
+  return is_read;
+}
+
+static bool readFrame(int fd, uint8_t *frame) {
+  std::vector<uint8_t> data;
+  return readRecord(fd, data) &&
+         frameApply(frame, data.data(), data.size()) == START;
+}
+
+static int readWelcome(int fd) {
+  std::vector<uint8_t> data;
+  int id = -1;
+  if (readRecord(fd, data) && data.size() == WELCOME_SIZE &&
+      data[0] == SERVER_WELCOME) {
+    id = data[1] | (data[2] << 8);
+  }
+  return id;
+}
+
+static std::vector<int> readBattleWelcome(int fd) {
+  std::vector<uint8_t> data;
+  std::vector<int> ids;
+  if (readRecord(fd, data) && data.size() == 1 + 2 * SERVER_BATTLE_SEATS &&
+      data[0] == SERVER_WELCOME) {
+    for (size_t i = 1; i < data.size(); i += 2) {
+      ids.push_back(data[i] | (data[i + 1] << 8));
+    }
+  }
+  return ids;
+}
+
+static void drainFrames(int fd, std::vector<uint8_t> &stream, uint8_t *frame) {
+  uint8_t buffer[4096];
+  ssize_t size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+  while (size > 0) {
+    stream.insert(stream.end(), buffer, buffer + size);
+    size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+  }
+  size_t offset = 0;
+  while (stream.size() - offset >= FRAME_HEADER_SIZE) {
+    size_t length = stream[offset] | (stream[offset + 1] << 8);
+    if (stream.size() - offset - FRAME_HEADER_SIZE < length) {
+      break;
+    }
+    EXPECT_EQ(frameApply(frame, stream.data() + offset + FRAME_HEADER_SIZE,
+                         length),
+              START);
+    offset += FRAME_HEADER_SIZE + length;
+  }
+  stream.erase(stream.begin(), stream.begin() + offset);
+}
+
+static void sendMessage(int fd, uint8_t type, int value) {
+  uint8_t message[MESSAGE_SIZE] = {type, static_cast<uint8_t>(value & 0xFF),
+                                   static_cast<uint8_t>(value >> 8)};
+  ASSERT_EQ(send(fd, message, sizeof(message), 0), MESSAGE_SIZE);
+}
+
+static int connectUnix(const std::string &path) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, path.c_str());
+  if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address))) {
+    close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+static void setTimeout(int fd) {
+  timeval timeout = {2, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+TEST(Protocol, Records) {
+  uint8_t data[3] = {1, 2, 3};
+  s21::SharedBuffer record = s21::makeRecord(data, 3);
+  ASSERT_EQ(record->size(), static_cast<size_t>(FRAME_HEADER_SIZE + 3));
+  EXPECT_EQ((*record)[0], 3);
+  EXPECT_EQ((*record)[FRAME_HEADER_SIZE + 2], 3);
+  s21::SharedBuffer welcome = s21::makeWelcome(0x1234);
+  ASSERT_EQ(welcome->size(),
+            static_cast<size_t>(FRAME_HEADER_SIZE + WELCOME_SIZE));
+  EXPECT_EQ((*welcome)[FRAME_HEADER_SIZE], SERVER_WELCOME);
+  EXPECT_EQ((*welcome)[FRAME_HEADER_SIZE + 1], 0x34);
+  EXPECT_EQ((*welcome)[FRAME_HEADER_SIZE + 2], 0x12);
+  EXPECT_EQ(frameCheck(welcome->data() + FRAME_HEADER_SIZE, WELCOME_SIZE),
+            STOP);
+  s21::SharedBuffer battle = s21::makeWelcome(std::vector<int>{5, 0x0102});
+  ASSERT_EQ(battle->size(), static_cast<size_t>(FRAME_HEADER_SIZE + 5));
+  EXPECT_EQ((*battle)[FRAME_HEADER_SIZE + 1], 5);
+  EXPECT_EQ((*battle)[FRAME_HEADER_SIZE + 3], 2);
+  EXPECT_EQ((*battle)[FRAME_HEADER_SIZE + 4], 1);
+}
+
+TEST(Broadcast, SharedFramesAndSlowSubscriber) {
+  int fast[2];
+  int slow[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fast), 0);
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, slow), 0);
+  int buffer_size = 4096;
+  setsockopt(slow[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+  s21::Subscriber fast_output(fast[0]);
+  s21::Subscriber slow_output(slow[0]);
+  s21::Broadcast broadcast;
+  broadcast.subscribe(&fast_output);
+  broadcast.subscribe(&slow_output);
+  EXPECT_EQ(broadcast.getSubscriberCount(), 2u);
+
+  auto session = s21::Session::create(SERVER_TETRIS);
+  ASSERT_NE(session, nullptr);
+  uint8_t frame[FRAME_KEY_SIZE];
+  session->render(frame);
+  uint8_t fast_frame[FRAME_KEY_SIZE] = {};
+  uint8_t slow_frame[FRAME_KEY_SIZE] = {};
+  std::vector<uint8_t> fast_stream;
+  std::vector<uint8_t> slow_stream;
+  for (int i = 0; i < 5000; i++) {
+    frame[FRAME_FIELD_OFFSET + i % FRAME_PLANE_SIZE] ^= 1 << (i % 8);
+    broadcast.publish(frame, false);
+    drainFrames(fast[1], fast_stream, fast_frame);
+  }
+  EXPECT_EQ(std::memcmp(fast_frame, frame, FRAME_KEY_SIZE), 0);
+  EXPECT_FALSE(fast_output.isKeyframeOnly());
+  EXPECT_TRUE(slow_output.isKeyframeOnly());
+  EXPECT_LE(slow_output.getPending(),
+            static_cast<size_t>(SERVER_SLOW_PENDING + FRAME_HEADER_SIZE +
+                                FRAME_KEY_SIZE));
+
+  for (int i = 0; i < 3; i++) {
+    drainFrames(slow[1], slow_stream, slow_frame);
+    slow_output.flush();
+    drainFrames(slow[1], slow_stream, slow_frame);
+    broadcast.publish(frame, false);
+  }
+  drainFrames(slow[1], slow_stream, slow_frame);
+  EXPECT_FALSE(slow_output.isKeyframeOnly());
+  EXPECT_EQ(std::memcmp(slow_frame, frame, FRAME_KEY_SIZE), 0);
+
+  frame[FRAME_FIELD_OFFSET] ^= 1;
+  broadcast.publish(frame, true);
+  broadcast.finish();
+  EXPECT_EQ(broadcast.getSubscriberCount(), 0u);
+  drainFrames(fast[1], fast_stream, fast_frame);
+  drainFrames(slow[1], slow_stream, slow_frame);
+  EXPECT_EQ(std::memcmp(fast_frame, frame, FRAME_KEY_SIZE), 0);
+  EXPECT_EQ(std::memcmp(slow_frame, frame, FRAME_KEY_SIZE), 0);
+  EXPECT_TRUE(fast_output.isDone());
+  EXPECT_TRUE(slow_output.isDone());
+  for (int fd : {fast[0], fast[1], slow[0], slow[1]}) {
+    close(fd);
+  }
+}
+
+TEST(Sessions, IndependentTetrisSessions) {
+  auto first = s21::Session::create(SERVER_TETRIS);
+  auto second = s21::Session::create(SERVER_TETRIS);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(s21::Session::create(7), nullptr);
+  uint8_t before[FRAME_KEY_SIZE];
+  uint8_t after[FRAME_KEY_SIZE];
+  uint8_t other[FRAME_KEY_SIZE];
+  second->render(other);
+  first->render(before);
+  first->input(Left, false);
+  first->render(after);
+  EXPECT_NE(std::memcmp(before, after, FRAME_KEY_SIZE), 0);
+  uint8_t other_after[FRAME_KEY_SIZE];
+  second->render(other_after);
+  EXPECT_EQ(std::memcmp(other, other_after, FRAME_KEY_SIZE), 0);
+  int ticks = 0;
+  first->setTickHook([&ticks](s21::Session &session) {
+    ticks++;
+    EXPECT_TRUE(session.isOver());
+  });
+  first->input(Terminate, false);
+  first->tick();
+  EXPECT_EQ(ticks, 1);
+  EXPECT_TRUE(first->isOver());
+  EXPECT_FALSE(second->isOver());
+}
+
+TEST(Sessions, SnakeSession) {
+  auto session = s21::Session::create(SERVER_SNAKE);
+  ASSERT_NE(session, nullptr);
+  uint8_t frame[FRAME_KEY_SIZE];
+  session->render(frame);
+  int cells = 0;
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      cells += frameCell(frame, y, x) == MOVING_CELL;
+    }
+  }
+  EXPECT_EQ(cells, 5);
+  session->input(Pause, false);
+  session->render(frame);
+  EXPECT_EQ(framePause(frame), 1);
+  session->input(Terminate, false);
+  session->tick();
+  EXPECT_TRUE(session->isOver());
+}
+
+TEST(Sessions, BattleSession) {
+  auto session = s21::Session::create(SERVER_BATTLE);
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(session->getBoardCount(), SERVER_BATTLE_SEATS);
+  uint8_t first[FRAME_KEY_SIZE];
+  uint8_t second[FRAME_KEY_SIZE];
+  session->renderBoard(0, first);
+  session->renderBoard(1, second);
+  EXPECT_EQ(std::memcmp(first, second, FRAME_KEY_SIZE), 0);
+  session->inputBoard(1, Left, false);
+  session->renderBoard(1, second);
+  EXPECT_NE(std::memcmp(first, second, FRAME_KEY_SIZE), 0);
+  session->tick();
+  EXPECT_FALSE(session->isOver());
+  session->leave(0);
+  session->renderBoard(0, first);
+  session->renderBoard(1, second);
+  EXPECT_TRUE(session->isOver());
+  EXPECT_EQ(frameStatus(first), kGameOver);
+  EXPECT_EQ(frameStatus(second), kWin);
+}
+
+static void *blinkCreate(unsigned int seed) {
+  (void)seed;
+  return new GameStatus_t(kStart);
+}
+
+static void blinkDestroy(void *state) {
+  delete static_cast<GameStatus_t *>(state);
+}
+
+static void blinkInput(void *state, UserAction_t action, bool hold) {
+  (void)hold;
+  if (action == Terminate) {
+    *static_cast<GameStatus_t *>(state) = kGameOver;
+  }
+}
+
+static void blinkStep(void *state) { (void)state; }
+
+static int blinkFrame(void *state, uint8_t *frame) {
+  GameInfo_t stats = {nullptr, nullptr, 7, 0, 1, START_SPEED, 0};
+  return frameEncode(&stats, *static_cast<GameStatus_t *>(state), frame);
+}
+
+static GameStatus_t blinkStatus(const void *state) {
+  return *static_cast<const GameStatus_t *>(state);
+}
+
+TEST(Sessions, ModuleSession) {
+  static const GameModule_t blink = {
+      GAME_MODULE_FIRST_FREE, "BLINK",      'l',        0,
+      {false, START_SPEED, ""}, blinkCreate, blinkDestroy, blinkInput,
+      blinkStep,              blinkStep,    nullptr,      nullptr,
+      blinkFrame,             blinkStatus,  nullptr,    nullptr};
+  EXPECT_EQ(s21::Session::create(GAME_MODULE_FIRST_FREE), nullptr);
+  ASSERT_EQ(registerGameModule(&blink), START);
+  auto session = s21::Session::create(GAME_MODULE_FIRST_FREE);
+  ASSERT_NE(session, nullptr);
+  uint8_t frame[FRAME_KEY_SIZE];
+  session->render(frame);
+  EXPECT_EQ(frameScore(frame), 7);
+  int ticks = 0;
+  session->setTickHook([&ticks](s21::Session &) { ticks++; });
+  session->tick();
+  EXPECT_FALSE(session->isOver());
+  session->input(Terminate, false);
+  session->tick();
+  EXPECT_EQ(ticks, 2);
+  EXPECT_TRUE(session->isOver());
+}
+
+TEST(Server, BattleRoom) {
+  std::string path = "/tmp/brickgame_battle_" + std::to_string(getpid());
+  s21::ServerConfig_t config = {path, -1, 2, 8};
+  s21::GameServer server(config);
+  ASSERT_EQ(server.start(), START);
+  std::thread reactor([&server]() { server.run(); });
+
+  int first_fd = connectUnix(path);
+  int second_fd = connectUnix(path);
+  ASSERT_GE(first_fd, 0);
+  ASSERT_GE(second_fd, 0);
+  setTimeout(first_fd);
+  setTimeout(second_fd);
+  sendMessage(first_fd, s21::kJoin, SERVER_BATTLE);
+  std::vector<int> first_ids = readBattleWelcome(first_fd);
+  ASSERT_EQ(first_ids.size(), static_cast<size_t>(SERVER_BATTLE_SEATS));
+  uint8_t byte = 0;
+  EXPECT_LT(recv(first_fd, &byte, 1, MSG_DONTWAIT), 0);
+  sendMessage(second_fd, s21::kJoin, SERVER_BATTLE);
+  std::vector<int> second_ids = readBattleWelcome(second_fd);
+  ASSERT_EQ(second_ids.size(), static_cast<size_t>(SERVER_BATTLE_SEATS));
+  EXPECT_EQ(first_ids[0], second_ids[1]);
+  EXPECT_EQ(first_ids[1], second_ids[0]);
+  EXPECT_EQ(server.getSessionCount(), 1);
+
+  int watch_fd = connectUnix(path);
+  ASSERT_GE(watch_fd, 0);
+  setTimeout(watch_fd);
+  sendMessage(watch_fd, s21::kWatch, second_ids[0]);
+  uint8_t first_frame[FRAME_KEY_SIZE] = {};
+  uint8_t second_frame[FRAME_KEY_SIZE] = {};
+  uint8_t watch_frame[FRAME_KEY_SIZE] = {};
+  ASSERT_TRUE(readFrame(first_fd, first_frame));
+  ASSERT_TRUE(readFrame(second_fd, second_frame));
+  ASSERT_TRUE(readFrame(watch_fd, watch_frame));
+  EXPECT_EQ(frameStatus(first_frame), kStart);
+
+  sendMessage(first_fd, s21::kInput, Terminate);
+  while (frameStatus(first_frame) == kStart &&
+         readFrame(first_fd, first_frame)) {
+  }
+  EXPECT_EQ(frameStatus(first_frame), kGameOver);
+  while (frameStatus(second_frame) == kStart &&
+         readFrame(second_fd, second_frame)) {
+  }
+  EXPECT_EQ(frameStatus(second_frame), kWin);
+  while (frameStatus(watch_frame) == kStart &&
+         readFrame(watch_fd, watch_frame)) {
+  }
+  EXPECT_EQ(std::memcmp(watch_frame, second_frame, FRAME_KEY_SIZE), 0);
+  EXPECT_EQ(recv(first_fd, &byte, 1, 0), 0);
+  EXPECT_EQ(recv(second_fd, &byte, 1, 0), 0);
+  EXPECT_EQ(recv(watch_fd, &byte, 1, 0), 0);
+  EXPECT_EQ(server.getSessionCount(), 0);
+
+  close(first_fd);
+  close(second_fd);
+  close(watch_fd);
+  server.stop();
+  reactor.join();
+}
+
+TEST(Server, UnixAndTcpClients) {
+  std::string path = "/tmp/brickgame_test_" + std::to_string(getpid());
+  s21::ServerConfig_t config = {path, 0, 2, 8};
+  s21::GameServer server(config);
+  ASSERT_EQ(server.start(), START);
+  ASSERT_GT(server.getTcpPort(), 0);
+  std::thread reactor([&server]() { server.run(); });
+
+  int unix_fd = connectUnix(path);
+  ASSERT_GE(unix_fd, 0);
+  setTimeout(unix_fd);
+  sendMessage(unix_fd, s21::kJoin, SERVER_TETRIS);
+  int room_id = readWelcome(unix_fd);
+  ASSERT_GT(room_id, 0);
+  uint8_t frame[FRAME_KEY_SIZE] = {};
+  ASSERT_TRUE(readFrame(unix_fd, frame));
+  EXPECT_EQ(frameStatus(frame), kStart);
+
+  int watch_fd = connectUnix(path);
+  ASSERT_GE(watch_fd, 0);
+  setTimeout(watch_fd);
+  sendMessage(watch_fd, s21::kWatch, room_id);
+  uint8_t watch_frame[FRAME_KEY_SIZE] = {};
+  ASSERT_TRUE(readFrame(watch_fd, watch_frame));
+  EXPECT_EQ(frameType(watch_frame), FRAME_KEY);
+
+  int tcp_fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in tcp_address = {};
+  tcp_address.sin_family = AF_INET;
+  tcp_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  tcp_address.sin_port = htons(server.getTcpPort());
+  ASSERT_EQ(connect(tcp_fd, reinterpret_cast<sockaddr *>(&tcp_address),
+                    sizeof(tcp_address)),
+            0);
+  setTimeout(tcp_fd);
+  sendMessage(tcp_fd, s21::kJoin, SERVER_SNAKE);
+  EXPECT_GT(readWelcome(tcp_fd), 0);
+  uint8_t snake_frame[FRAME_KEY_SIZE] = {};
+  ASSERT_TRUE(readFrame(tcp_fd, snake_frame));
+  EXPECT_EQ(server.getSessionCount(), 2);
+
+  sendMessage(unix_fd, s21::kInput, Terminate);
+  while (frameStatus(frame) == kStart && readFrame(unix_fd, frame)) {
+  }
+  EXPECT_EQ(frameStatus(frame), kGameOver);
+  uint8_t byte = 0;
+  EXPECT_EQ(recv(unix_fd, &byte, 1, 0), 0);
+  while (frameStatus(watch_frame) == kStart &&
+         readFrame(watch_fd, watch_frame)) {
+  }
+  EXPECT_EQ(std::memcmp(watch_frame, frame, FRAME_KEY_SIZE), 0);
+  EXPECT_EQ(recv(watch_fd, &byte, 1, 0), 0);
+
+  sendMessage(tcp_fd, 0xFF, 0);
+  while (readFrame(tcp_fd, snake_frame)) {
+  }
+  EXPECT_EQ(recv(tcp_fd, &byte, 1, 0), 0);
+  EXPECT_EQ(server.getSessionCount(), 0);
+
+  close(unix_fd);
+  close(watch_fd);
+  close(tcp_fd);
+  server.stop();
+  reactor.join();
+}
+
+int main(int argc, char **argv) {
+  std::cout << std::endl << "STARTING SERVER TESTS" << std::endl;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
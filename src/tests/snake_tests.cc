@@ -37,6 +37,28 @@ TEST(ClassSnake, Moving) {
   EXPECT_EQ(head.second, 4);
 }
 
+TEST(ClassSnake, Hash) {
+  s21::Snake snake(7, 1);
+  unsigned long long start_hash = snake.getHash();
+  snake.grow();
+  snake.setDirection(s21::Snake::kRight);
+  snake.move();
+  snake.setDirection(s21::Snake::kUp);
+  snake.move();
+  EXPECT_NE(snake.getHash(), start_hash);
+  const auto &body = snake.getSnakeBody();
+  int cells[SNAKE_MAX_LENGTH][2];
+  for (size_t i = 0; i < body.size(); i++) {
+    cells[i][0] = body[i].first;
+    cells[i][1] = body[i].second;
+  }
+  s21::Snake restored(1, 1);
+  restored.restoreBody(cells, body.size(), snake.getDirection());
+  EXPECT_EQ(restored.getHash(), snake.getHash());
+  restored.setDirection(s21::Snake::kLeft);
+  EXPECT_NE(restored.getHash(), snake.getHash());
+}
+
 TEST(ClassApple, ConstructorAndGetters) {
   s21::Apple apple;
   EXPECT_EQ(apple.getAppleX(), 0);
@@ -56,6 +78,24 @@ TEST(ClassApple, AppleSpawning) {
   EXPECT_NE(apple.getAppleY(), 0);
 }
 
+TEST(ClassApple, SeedAndSetter) {
+  s21::Apple apple;
+  std::vector<std::pair<int, int>> snake_body;
+  snake_body.push_back(std::make_pair(1, 1));
+  apple.setApple(3, 5, 42);
+  EXPECT_EQ(apple.getAppleX(), 3);
+  EXPECT_EQ(apple.getAppleY(), 5);
+  EXPECT_EQ(apple.getSeed(), 42u);
+  apple.spawnApple(snake_body);
+  int apple_x = apple.getAppleX();
+  int apple_y = apple.getAppleY();
+  EXPECT_NE(apple.getSeed(), 42u);
+  apple.setApple(0, 0, 42);
+  apple.spawnApple(snake_body);
+  EXPECT_EQ(apple.getAppleX(), apple_x);
+  EXPECT_EQ(apple.getAppleY(), apple_y);
+}
+
 TEST(ClassModel, ConstructorAndGetters) {
   s21::SnakeModel model;
   s21::SnakeModel::SnakeInfo_t *game_state = model.getSnakeInfo_t();
@@ -110,6 +150,37 @@ TEST(ClassModel, MainLogic) {
     EXPECT_NE(game_info->field, nullptr);
     EXPECT_EQ(game_info->field[1][1], 0);
   }
+  {
+    s21::SnakeModel model;
+    s21::SnakeModel::SnakeInfo_t *game_state = model.getSnakeInfo_t();
+    game_state->game_info = *model.getGameInfo_t();
+    game_state->set_time = 1000;
+    int speed = game_state->game_info.speed;
+    unsigned long long hash = model.getHash();
+    model.snakeTick(1000 + speed - 1);
+    EXPECT_EQ(model.getHash(), hash);
+    model.snakeTick(1000 + speed);
+    EXPECT_NE(model.getHash(), hash);
+    EXPECT_EQ(game_state->set_time, 1000 + speed);
+  }
+  {
+    s21::SnakeModel model;
+    s21::SnakeModel::SnakeSnapshot_t snapshot;
+    model.snapshot(&snapshot);
+    for (int i = 0; i < 4; i++) {
+      snapshot.body[i][0] = 7;
+      snapshot.body[i][1] = HEIGHT - 3 + i;
+    }
+    snapshot.length = 4;
+    snapshot.direction = s21::Snake::kDown;
+    snapshot.apple_x = 7;
+    snapshot.apple_y = HEIGHT;
+    model.restore(snapshot);
+    model.snakeStep();
+    EXPECT_EQ(model.getSnakeInfo_t()->game_status, kGameOver);
+    EXPECT_EQ(model.getGameInfo_t()->score, 0);
+    EXPECT_EQ(model.getSnake().getSnakeBody().back().second, HEIGHT);
+  }
 }
 
 TEST(ClassModel, SpeedBoost) {
@@ -150,6 +221,47 @@ TEST(ClassModel, SpeedBoost) {
   }
 }
 
+TEST(ClassModel, SnapshotAndRestore) {
+  s21::SnakeModel model;
+  s21::SnakeModel::SnakeInfo_t *game_state = model.getSnakeInfo_t();
+  GameInfo_t *game_info = model.getGameInfo_t();
+  s21::Snake &snake = model.getSnake();
+  auto body = snake.getSnakeBody();
+  s21::SnakeModel::SnakeSnapshot_t saved;
+  model.snapshot(&saved);
+  EXPECT_EQ(saved.length, 4);
+  EXPECT_EQ(saved.body[3][0], body.back().first);
+  EXPECT_EQ(saved.body[3][1], body.back().second);
+  EXPECT_EQ(saved.direction, s21::Snake::kDown);
+  snake.grow();
+  snake.setDirection(s21::Snake::kRight);
+  snake.move();
+  game_info->score = 5;
+  game_info->level = 2;
+  game_state->game_status = kGameOver;
+  model.restore(saved);
+  EXPECT_EQ(snake.getSnakeBody(), body);
+  EXPECT_EQ(snake.getDirection(), s21::Snake::kDown);
+  EXPECT_EQ(game_info->score, 0);
+  EXPECT_EQ(game_info->level, 1);
+  EXPECT_EQ(game_state->game_info.score, 0);
+  EXPECT_EQ(game_state->game_status, kStart);
+  s21::SnakeModel::SnakeSnapshot_t restored;
+  model.snapshot(&restored);
+  EXPECT_EQ(std::memcmp(&saved, &restored, sizeof(saved)), 0);
+  unsigned long long sum = model.checksum();
+  game_info->high_score = 100;
+  EXPECT_EQ(model.checksum(), sum);
+  model.snakeStep();
+  EXPECT_NE(model.checksum(), sum);
+  model.restore(saved);
+  EXPECT_EQ(model.checksum(), sum);
+  s21::SnakeModel other;
+  model.seedApple(7);
+  other.seedApple(7);
+  EXPECT_EQ(model.checksum(), other.checksum());
+}
+
 TEST(ClassModel, HighScoreGetterAndSetter) {
   {
     s21::SnakeModel model;
@@ -226,6 +338,38 @@ TEST(ClassController, InputProcessing) {
   }
 }
 
+TEST(ClassController, InputQueue) {
+  s21::SnakeModel model;
+  s21::SnakeController controller(&model);
+  s21::SnakeModel::SnakeInfo_t *game_state = model.getSnakeInfo_t();
+  GameInfo_t *game_info = model.getGameInfo_t();
+  game_state->set_time = 0;
+  auto head = model.getSnake().getSnakeBody().back();
+  pushInput(&game_state->input, Left, true, 0);
+  pushInput(&game_state->input, Up, true, START_SPEED);
+  controller.drainInput();
+  auto moved = model.getSnake().getSnakeBody().back();
+  EXPECT_EQ(model.getSnake().getDirection(), s21::Snake::kUp);
+  EXPECT_LT(moved.first, head.first);
+  EXPECT_EQ(moved.second, head.second);
+  EXPECT_EQ(game_state->set_time, START_SPEED);
+  EXPECT_EQ(game_state->action, Up);
+
+  pushInput(&game_state->input, Up, true, START_SPEED);
+  controller.drainInput();
+  EXPECT_LT(game_info->speed, game_state->current_speed);
+  pushInput(&game_state->input, Up, false, START_SPEED);
+  controller.drainInput();
+  EXPECT_EQ(game_info->speed, game_state->current_speed);
+  EXPECT_EQ(game_state->action, Start);
+
+  pushInput(&game_state->input, Terminate, true, START_SPEED);
+  pushInput(&game_state->input, Left, true, START_SPEED);
+  controller.drainInput();
+  EXPECT_EQ(game_state->action, Terminate);
+  EXPECT_EQ(inputCount(&game_state->input), 1);
+}
+
 TEST(ClassController, Getters) {
   {
     s21::SnakeModel model;
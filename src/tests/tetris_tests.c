@@ -3,6 +3,8 @@
 
 #include "../brick_game/common/common_back.h"
 #include "../brick_game/tetris/tetris_backend.h"
+#include "../brick_game/tetris/tetris_batch.h"
+#include "../brick_game/tetris/tetris_battle.h"
 
 START_TEST(getTetrisInfo_t_test) {
   TetrisInfo_t *game_state = getTetrisInfo_t();
@@ -113,7 +115,8 @@ START_TEST(corrSpawn_test) {
   {
     int figures[] = {1, 2, 3, 4, 5};
     int count = 5;
-    corrSpawn(figures, count);
+    unsigned int seed = 21;
+    corrSpawn(figures, count, &seed);
     int is_sorted = 1;
     for (int i = 0; i < count - 1 && !is_sorted; i++) {
       if (figures[i] > figures[i + 1]) {
@@ -125,7 +128,8 @@ START_TEST(corrSpawn_test) {
   {
     int figures_single[] = {1};
     int count_single = 1;
-    corrSpawn(figures_single, count_single);
+    unsigned int seed = 21;
+    corrSpawn(figures_single, count_single, &seed);
     ck_assert_int_eq(figures_single[0], 1);
   }
 }
@@ -133,26 +137,25 @@ END_TEST
 
 START_TEST(spawnFigure_test) {
   TetrisInfo_t *game_state = getTetrisInfo_t();
-  game_state->game_info.next[0][0] = 1;
-  game_state->game_info.next[0][1] = 1;
-  game_state->game_info.next[0][2] = 1;
-  game_state->game_info.next[1][0] = 1;
-  game_state->game_info.next[1][1] = 1;
-  game_state->game_info.next[1][2] = 1;
-  game_state->next_figure.width = 4;
-  game_state->next_figure.height = 2;
+  int head = game_state->queue_head;
+  int last = nextFigure(game_state, TETRIS_PREVIEW - 1);
+  game_state->queue[head] = 4;
   spawnFigure(game_state);
-  ck_assert_int_eq(game_state->figure.f[0][0], MOVING_CELL);
+  ck_assert_int_eq(game_state->figure.f[0][0], EMPTY_CELL);
   ck_assert_int_eq(game_state->figure.f[0][1], MOVING_CELL);
-  ck_assert_int_eq(game_state->figure.f[0][2], 1);
+  ck_assert_int_eq(game_state->figure.f[0][2], EMPTY_CELL);
   ck_assert_int_eq(game_state->figure.f[1][0], MOVING_CELL);
   ck_assert_int_eq(game_state->figure.f[1][1], MOVING_CELL);
-  ck_assert_int_eq(game_state->figure.f[1][2], 1);
+  ck_assert_int_eq(game_state->figure.f[1][2], MOVING_CELL);
   ck_assert_int_eq(game_state->figure.width, 4);
   ck_assert_int_eq(game_state->figure.height, 2);
+  ck_assert_int_eq(game_state->figure.type, 4);
+  ck_assert_int_eq(game_state->figure.rotation, 0);
   ck_assert_int_eq(game_state->figure.x,
                    (WIDTH - game_state->figure.width) / 2 + 1);
   ck_assert_int_eq(game_state->figure.y, 1);
+  ck_assert_int_eq(game_state->queue_head, (head + 1) % TETRIS_QUEUE_SIZE);
+  ck_assert_int_eq(nextFigure(game_state, TETRIS_PREVIEW - 2), last);
   removeGameInfo_t();
 }
 END_TEST
@@ -160,32 +163,21 @@ END_TEST
 START_TEST(initNextFigure_test) {
   GameInfo_t stats;
   TetrisInfo_t *game_state = getTetrisInfo_t();
-  game_state->curr_figure = FIGURES_COUNT;
-  game_state->figures[0] = 0;
-  game_state->next_figure.width = 4;
-  game_state->next_figure.height = 2;
+  int curr_figure = game_state->curr_figure;
+  game_state->queue[game_state->queue_head] = 0;
   stats.next = malloc(4 * sizeof(int *));
   for (int i = 0; i < 4; i++) {
     stats.next[i] = malloc(4 * sizeof(int));
   }
   initNextFigure(&stats);
-  ck_assert_int_eq(stats.next[0][0], game_state->next_figure.f[0][0]);
-  ck_assert_int_eq(stats.next[0][1], game_state->next_figure.f[0][1]);
-  ck_assert_int_eq(stats.next[0][2], game_state->next_figure.f[0][2]);
-  ck_assert_int_eq(stats.next[0][3], game_state->next_figure.f[0][3]);
-  ck_assert_int_eq(stats.next[1][0], game_state->next_figure.f[1][0]);
-  ck_assert_int_eq(stats.next[1][1], game_state->next_figure.f[1][1]);
-  ck_assert_int_eq(stats.next[1][2], game_state->next_figure.f[1][2]);
-  ck_assert_int_eq(stats.next[1][3], game_state->next_figure.f[1][3]);
-  ck_assert_int_eq(stats.next[2][0], game_state->next_figure.f[2][0]);
-  ck_assert_int_eq(stats.next[2][1], game_state->next_figure.f[2][1]);
-  ck_assert_int_eq(stats.next[2][2], game_state->next_figure.f[2][2]);
-  ck_assert_int_eq(stats.next[2][3], game_state->next_figure.f[2][3]);
-  ck_assert_int_eq(stats.next[3][0], game_state->next_figure.f[3][0]);
-  ck_assert_int_eq(stats.next[3][1], game_state->next_figure.f[3][1]);
-  ck_assert_int_eq(stats.next[3][2], game_state->next_figure.f[3][2]);
-  ck_assert_int_eq(stats.next[3][3], game_state->next_figure.f[3][3]);
-  ck_assert_int_eq(game_state->curr_figure, 1);
+  const Figure_t *shape = figureShape(0);
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      ck_assert_int_eq(stats.next[y][x], shape->f[y][x]);
+    }
+  }
+  ck_assert_int_eq(stats.next[0][3], MOVING_CELL);
+  ck_assert_int_eq(game_state->curr_figure, curr_figure);
   removeGameInfo_t();
   removeMatrix(stats.next, 4);
 }
@@ -527,6 +519,112 @@ START_TEST(checkCollision_test) {
 }
 END_TEST
 
+START_TEST(initHeights_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  for (int x = 1; x <= WIDTH; x++) {
+    ck_assert_int_eq(game_state->heights[x], HEIGHT + 1);
+  }
+  game_state->game_info.field[HEIGHT][1] = STATIC_CELL;
+  game_state->game_info.field[5][2] = STATIC_CELL;
+  game_state->game_info.field[HEIGHT][2] = STATIC_CELL;
+  initHeights(game_state);
+  ck_assert_int_eq(game_state->heights[1], HEIGHT);
+  ck_assert_int_eq(game_state->heights[2], 5);
+  ck_assert_int_eq(game_state->heights[3], HEIGHT + 1);
+  removeGameInfo_t();
+}
+END_TEST
+
+START_TEST(updateHeights_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  initFigure(&game_state->figure, 4);
+  game_state->figure.x = 1;
+  game_state->figure.y = HEIGHT - 1;
+  updateField(&game_state->game_info, &game_state->figure, STATIC_CELL);
+  updateHeights(game_state, &game_state->figure);
+  ck_assert_int_eq(game_state->heights[1], HEIGHT);
+  ck_assert_int_eq(game_state->heights[2], HEIGHT - 1);
+  ck_assert_int_eq(game_state->heights[3], HEIGHT);
+  ck_assert_int_eq(game_state->heights[4], HEIGHT + 1);
+  removeGameInfo_t();
+}
+END_TEST
+
+START_TEST(recountHeights_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  for (int x = 1; x <= WIDTH; x++) {
+    game_state->game_info.field[HEIGHT][x] = STATIC_CELL;
+  }
+  game_state->game_info.field[HEIGHT - 1][3] = STATIC_CELL;
+  initHeights(game_state);
+  ck_assert_int_eq(game_state->heights[3], HEIGHT - 1);
+  removeLine(game_state);
+  ck_assert_int_eq(game_state->heights[1], HEIGHT + 1);
+  ck_assert_int_eq(game_state->heights[3], HEIGHT);
+  removeGameInfo_t();
+}
+END_TEST
+
+START_TEST(dropDistance_test) {
+  {
+    TetrisInfo_t *game_state = getTetrisInfo_t();
+    srand(21);
+    for (int y = HEIGHT / 2; y <= HEIGHT; y++) {
+      for (int x = 1; x <= WIDTH; x++) {
+        if (rand() % 3 == 0) {
+          game_state->game_info.field[y][x] = STATIC_CELL;
+        }
+      }
+    }
+    initHeights(game_state);
+    for (int type = 0; type < FIGURES_COUNT; type++) {
+      for (int x = 0; x <= WIDTH; x++) {
+        Figure_t figure;
+        initFigure(&figure, type);
+        figure.x = x;
+        figure.y = 1;
+        if (!checkCollision(&game_state->game_info, &figure, 0, 0)) {
+          int expected = 0;
+          while (!checkCollision(&game_state->game_info, &figure, 0,
+                                 expected + 1)) {
+            expected++;
+          }
+          ck_assert_int_eq(dropDistance(game_state, &figure), expected);
+        }
+      }
+    }
+    removeGameInfo_t();
+  }
+  {
+    TetrisInfo_t *game_state = getTetrisInfo_t();
+    for (int x = 1; x <= WIDTH; x++) {
+      game_state->game_info.field[10][x] = STATIC_CELL;
+    }
+    game_state->game_info.field[10][5] = EMPTY_CELL;
+    initHeights(game_state);
+    initFigure(&game_state->figure, 1);
+    game_state->figure.x = 1;
+    game_state->figure.y = 12;
+    ck_assert_int_eq(dropDistance(game_state, &game_state->figure),
+                     HEIGHT - 13);
+    removeGameInfo_t();
+  }
+}
+END_TEST
+
+START_TEST(getGhostFigure_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  Figure_t ghost;
+  game_state->figure.y = 1;
+  getGhostFigure(game_state, &ghost);
+  ck_assert_int_eq(ghost.x, game_state->figure.x);
+  ck_assert_int_eq(game_state->figure.y, 1);
+  moveDown(game_state);
+  ck_assert_int_eq(ghost.y, game_state->figure.y);
+  removeGameInfo_t();
+}
+END_TEST
+
 START_TEST(getUserInput_test) {
   TetrisInfo_t *game_state = getTetrisInfo_t();
   getUserInput();
@@ -541,6 +639,375 @@ START_TEST(getUserInput_test) {
 }
 END_TEST
 
+START_TEST(tetrisDrainInput_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  Figure_t *figure = &game_state.figure;
+  int x = figure->x;
+  game_state.set_time = 0;
+  tetrisDrainInput(&game_state, 0);
+  ck_assert_int_eq(game_state.action, Up);
+  pushInput(&game_state.input, Left, true, 0);
+  pushInput(&game_state.input, Left, false, 0);
+  for (int i = 0; i < 2; i++) {
+    pushInput(&game_state.input, Right, true, START_SPEED);
+    pushInput(&game_state.input, Right, false, START_SPEED);
+  }
+  tetrisDrainInput(&game_state, START_SPEED);
+  ck_assert_int_eq(figure->x, x + 1);
+  ck_assert_int_eq(figure->y, 2);
+  ck_assert_int_eq(game_state.set_time, START_SPEED);
+  ck_assert_int_eq(game_state.action, Right);
+
+  pushInput(&game_state.input, Pause, true, START_SPEED * 5);
+  pushInput(&game_state.input, Down, true, START_SPEED * 5);
+  tetrisDrainInput(&game_state, START_SPEED * 5);
+  ck_assert_int_eq(game_state.game_info.pause, 1);
+  ck_assert_int_eq(figure->y, 3);
+
+  pushInput(&game_state.input, Terminate, true, START_SPEED * 5);
+  pushInput(&game_state.input, Pause, true, START_SPEED * 5);
+  tetrisDrainInput(&game_state, START_SPEED * 5);
+  ck_assert_int_eq(game_state.action, Terminate);
+  ck_assert_int_eq(game_state.game_info.pause, 1);
+  ck_assert_int_eq(inputCount(&game_state.input), 1);
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(tetrisAutoShift_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  Figure_t *figure = &game_state.figure;
+  initFigure(figure, 0);
+  figure->x = 4;
+  figure->y = 1;
+  game_state.set_time = 0;
+  game_state.game_info.speed = START_SPEED * 100;
+  setAutoShift(&game_state, 100, 20);
+  pushInput(&game_state.input, Left, true, 0);
+  tetrisDrainInput(&game_state, 0);
+  ck_assert_int_eq(figure->x, 3);
+  tetrisDrainInput(&game_state, 99);
+  ck_assert_int_eq(figure->x, 3);
+  tetrisDrainInput(&game_state, 100);
+  ck_assert_int_eq(figure->x, 2);
+  tetrisDrainInput(&game_state, 139);
+  ck_assert_int_eq(figure->x, 1);
+  tetrisDrainInput(&game_state, 1000);
+  ck_assert_int_eq(figure->x, 1);
+  ck_assert_int_eq(game_state.shift_time, 1020);
+
+  pushInput(&game_state.input, Left, true, 1000);
+  pushInput(&game_state.input, Right, true, 1000);
+  pushInput(&game_state.input, Right, false, 1050);
+  tetrisDrainInput(&game_state, 1149);
+  ck_assert_int_eq(figure->x, 2);
+  ck_assert_int_eq(game_state.shift_action, Left);
+  tetrisDrainInput(&game_state, 1150);
+  ck_assert_int_eq(figure->x, 1);
+  pushInput(&game_state.input, Left, false, 1200);
+  tetrisDrainInput(&game_state, 5000);
+  ck_assert_int_eq(game_state.shift_action, Up);
+  ck_assert_int_eq(figure->x, 1);
+
+  setAutoShift(&game_state, 0, 0);
+  pushInput(&game_state.input, Right, true, 5000);
+  tetrisDrainInput(&game_state, 5000);
+  ck_assert_int_eq(figure->x, WIDTH - figure->width + 1);
+  pushInput(&game_state.input, Pause, true, 5000);
+  tetrisDrainInput(&game_state, 5000);
+  ck_assert_int_eq(game_state.shift_held, 0);
+  ck_assert_int_eq(game_state.shift_action, Up);
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(lockDelay_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  GameInfo_t *stats = &game_state.game_info;
+  Figure_t *figure = &game_state.figure;
+  initFigure(figure, 0);
+  figure->x = 4;
+  figure->y = 1;
+  moveDown(&game_state);
+  int y = figure->y;
+  game_state.set_time = 0;
+  stats->speed = START_SPEED * 100;
+  setLockDelay(&game_state, 100, 2);
+  tetrisTick(&game_state, 0);
+  ck_assert_int_eq(game_state.lock_active, 1);
+  ck_assert_int_eq(game_state.lock_time, 100);
+  tetrisTick(&game_state, 99);
+  ck_assert_int_eq(figure->y, y);
+
+  pushInput(&game_state.input, Left, true, 50);
+  pushInput(&game_state.input, Left, false, 50);
+  tetrisDrainInput(&game_state, 50);
+  ck_assert_int_eq(figure->x, 3);
+  ck_assert_int_eq(game_state.lock_time, 150);
+  pushInput(&game_state.input, Down, true, 140);
+  pushInput(&game_state.input, Down, false, 140);
+  tetrisDrainInput(&game_state, 140);
+  ck_assert_int_eq(game_state.lock_resets, 1);
+  pushInput(&game_state.input, Right, true, 140);
+  pushInput(&game_state.input, Right, false, 140);
+  pushInput(&game_state.input, Left, true, 200);
+  pushInput(&game_state.input, Left, false, 200);
+  tetrisDrainInput(&game_state, 200);
+  ck_assert_int_eq(game_state.lock_resets, 2);
+  ck_assert_int_eq(game_state.lock_time, 240);
+  tetrisTick(&game_state, 239);
+  ck_assert_int_eq(figure->y, y);
+  tetrisTick(&game_state, 240);
+  ck_assert_int_lt(figure->y, y);
+  ck_assert_int_eq(game_state.lock_active, 0);
+  ck_assert_int_eq(game_state.lock_resets, 0);
+  int cells = 0;
+  for (int x = 1; x <= WIDTH; x++) {
+    cells += stats->field[HEIGHT][x] == STATIC_CELL;
+  }
+  ck_assert_int_eq(cells, 4);
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(softDrop_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  Figure_t *figure = &game_state.figure;
+  initFigure(figure, 0);
+  figure->x = 4;
+  figure->y = 1;
+  game_state.set_time = 0;
+  ck_assert_int_eq(gravityInterval(&game_state), START_SPEED);
+  pushInput(&game_state.input, Down, true, 0);
+  pushInput(&game_state.input, Down, true, 0);
+  tetrisDrainInput(&game_state, 0);
+  ck_assert_int_eq(figure->y, 2);
+  ck_assert_int_eq(game_state.soft_drop, 1);
+  ck_assert_int_eq(gravityInterval(&game_state),
+                   START_SPEED / TETRIS_SOFT_DROP_FACTOR);
+  tetrisTick(&game_state, START_SPEED / TETRIS_SOFT_DROP_FACTOR);
+  ck_assert_int_eq(figure->y, 3);
+  pushInput(&game_state.input, Down, false, 100);
+  tetrisDrainInput(&game_state, 100);
+  ck_assert_int_eq(figure->y, 4);
+  ck_assert_int_eq(game_state.soft_drop, 0);
+  tetrisTick(&game_state, 200);
+  ck_assert_int_eq(figure->y, 4);
+
+  Figure_t before = *figure;
+  tetrisUserInput(&game_state, HardDrop);
+  ck_assert_int_eq(game_state.game_info.field[HEIGHT][before.x], STATIC_CELL);
+  ck_assert_int_lt(figure->y, before.y);
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(snapshotHeldKeys_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  Figure_t *figure = &game_state.figure;
+  initFigure(figure, 0);
+  figure->x = 4;
+  figure->y = 1;
+  game_state.set_time = 0;
+  setAutoShift(&game_state, 100, 20);
+  TetrisSnapshot_t idle;
+  tetrisSnapshot(&game_state, &idle);
+  pushInput(&game_state.input, Left, true, 0);
+  pushInput(&game_state.input, Down, true, 0);
+  tetrisDrainInput(&game_state, 0);
+  ck_assert_int_eq(game_state.shift_action, Left);
+  ck_assert_int_eq(game_state.soft_drop, 1);
+  tetrisRestore(&game_state, &idle);
+  ck_assert_int_eq(game_state.shift_held, 0);
+  ck_assert_int_eq(game_state.shift_action, Up);
+  ck_assert_int_eq(game_state.soft_drop, 0);
+  ck_assert_int_eq(gravityInterval(&game_state), START_SPEED);
+  tetrisDrainInput(&game_state, 200);
+  tetrisTick(&game_state, START_SPEED - 1);
+  ck_assert_int_eq(figure->x, 4);
+  ck_assert_int_eq(figure->y, 1);
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(inputAfterGameOver_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  for (int i = 0; i < HEIGHT * WIDTH && game_state.game_status == kStart;
+       i++) {
+    tetrisUserInput(&game_state, HardDrop);
+  }
+  ck_assert_int_eq(game_state.game_status, kGameOver);
+  int field[HEIGHT + 1][WIDTH + 1];
+  for (int y = 1; y <= HEIGHT; y++) {
+    memcpy(field[y], game_state.game_info.field[y], sizeof(field[y]));
+  }
+  unsigned long long hash = game_state.hash;
+  unsigned long long checksum = tetrisChecksum(&game_state);
+  for (int i = 0; i < 50; i++) {
+    tetrisUserInput(&game_state, i % 2 ? Hold : HardDrop);
+  }
+  for (int y = 1; y <= HEIGHT; y++) {
+    ck_assert_mem_eq(field[y], game_state.game_info.field[y],
+                     sizeof(field[y]));
+  }
+  ck_assert(hash == game_state.hash);
+  ck_assert(checksum == tetrisChecksum(&game_state));
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(srsRotation_test) {
+  int offset_x = 0;
+  int offset_y = 0;
+  ck_assert(srsOffset(0, 0, 0, &offset_x, &offset_y));
+  ck_assert_int_eq(offset_x, 1);
+  ck_assert_int_eq(offset_y, -1);
+  ck_assert(srsOffset(4, 3, SRS_KICKS - 1, &offset_x, &offset_y));
+  ck_assert_int_eq(offset_x, -1);
+  ck_assert_int_eq(offset_y, -1);
+  ck_assert(!srsOffset(4, 0, SRS_KICKS, &offset_x, &offset_y));
+  ck_assert(!srsOffset(1, 0, 1, &offset_x, &offset_y));
+
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  Figure_t *figure = &game_state.figure;
+  for (int type = 0; type < FIGURES_COUNT; type++) {
+    memset(figure, 0, sizeof(*figure));
+    initFigure(figure, type);
+    figure->x = 4;
+    figure->y = 8;
+    Figure_t start = *figure;
+    for (int i = 0; i < 4; i++) {
+      rotateFigure(&game_state);
+      ck_assert_int_eq(figure->rotation, (i + 1) % 4);
+    }
+    ck_assert_int_eq(figure->x, start.x);
+    ck_assert_int_eq(figure->y, start.y);
+    ck_assert_int_eq(figure->width, start.width);
+    ck_assert_mem_eq(figure->f, start.f, sizeof(start.f));
+  }
+
+  memset(figure, 0, sizeof(*figure));
+  initFigure(figure, 0);
+  figure->x = 4;
+  figure->y = 5;
+  rotateFigure(&game_state);
+  ck_assert_int_eq(figure->x, 5);
+  ck_assert_int_eq(figure->y, 4);
+  figure->x = WIDTH - 1;
+  rotateFigure(&game_state);
+  ck_assert_int_eq(figure->rotation, 2);
+  ck_assert_int_eq(figure->x, WIDTH - 3);
+  ck_assert_int_eq(figure->y, 5);
+
+  for (int y = 1; y <= HEIGHT; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      game_state.game_info.field[y][x] = STATIC_CELL;
+    }
+  }
+  updateField(&game_state.game_info, figure, EMPTY_CELL);
+  Figure_t blocked = *figure;
+  rotateFigure(&game_state);
+  ck_assert_mem_eq(figure, &blocked, sizeof(blocked));
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(holdFigure_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  Figure_t *figure = &game_state.figure;
+  ck_assert_int_eq(game_state.hold, TETRIS_NO_HOLD);
+  int first = figure->type;
+  int second = nextFigure(&game_state, 0);
+  int third = nextFigure(&game_state, 1);
+  moveLeft(&game_state);
+  tetrisUserInput(&game_state, Hold);
+  ck_assert_int_eq(game_state.hold, first);
+  ck_assert_int_eq(game_state.hold_used, 1);
+  ck_assert_int_eq(figure->type, second);
+  ck_assert_int_eq(nextFigure(&game_state, 0), third);
+  tetrisUserInput(&game_state, Hold);
+  ck_assert_int_eq(game_state.hold, first);
+  ck_assert_int_eq(figure->type, second);
+  unsigned long long hash = game_state.hash;
+  tetrisRehash(&game_state);
+  ck_assert(hash == game_state.hash);
+
+  tetrisUserInput(&game_state, HardDrop);
+  ck_assert_int_eq(game_state.hold_used, 0);
+  ck_assert_int_eq(figure->type, third);
+  hash = game_state.hash;
+  tetrisRehash(&game_state);
+  ck_assert(hash == game_state.hash);
+  tetrisUserInput(&game_state, Hold);
+  ck_assert_int_eq(game_state.hold, third);
+  ck_assert_int_eq(figure->type, first);
+  ck_assert_int_eq(figure->rotation, 0);
+  ck_assert_int_eq(figure->x, (WIDTH - figure->width) / 2 + 1);
+  ck_assert_int_eq(figure->y, 1);
+  hash = game_state.hash;
+  tetrisRehash(&game_state);
+  ck_assert(hash == game_state.hash);
+
+  TetrisSnapshot_t saved;
+  tetrisSnapshot(&game_state, &saved);
+  ck_assert_int_eq(saved.hold, third);
+  ck_assert_int_eq(saved.hold_used, 1);
+
+  game_state.hold_used = 0;
+  for (int x = 1; x <= WIDTH; x++) {
+    game_state.game_info.field[1][x] = STATIC_CELL;
+    game_state.game_info.field[2][x] = STATIC_CELL;
+  }
+  tetrisUserInput(&game_state, Hold);
+  ck_assert_int_eq(game_state.game_status, kGameOver);
+  removeInfo_t(&game_state);
+}
+END_TEST
+
+START_TEST(tetrisChecksum_test) {
+  TetrisInfo_t game_state;
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  dealBoard(&game_state, 21);
+  unsigned long long sum = tetrisChecksum(&game_state);
+  ck_assert(sum == tetrisChecksum(&game_state));
+  TetrisSnapshot_t saved;
+  tetrisSnapshot(&game_state, &saved);
+
+  game_state.set_time += SECOND;
+  game_state.game_info.high_score += 100;
+  ck_assert(sum == tetrisChecksum(&game_state));
+  moveLeft(&game_state);
+  ck_assert(sum != tetrisChecksum(&game_state));
+  tetrisRestore(&game_state, &saved);
+  ck_assert(sum == tetrisChecksum(&game_state));
+  tetrisUserInput(&game_state, Hold);
+  ck_assert(sum != tetrisChecksum(&game_state));
+  tetrisRestore(&game_state, &saved);
+  game_state.soft_drop = 1;
+  ck_assert(sum != tetrisChecksum(&game_state));
+  tetrisRestore(&game_state, &saved);
+  game_state.shift_held = TETRIS_SHIFT_LEFT;
+  ck_assert(sum != tetrisChecksum(&game_state));
+  game_state.shift_action = Left;
+  unsigned long long shifting = tetrisChecksum(&game_state);
+  game_state.shift_action = Up;
+  ck_assert(shifting != tetrisChecksum(&game_state));
+  tetrisRestore(&game_state, &saved);
+  ck_assert(sum == tetrisChecksum(&game_state));
+  game_state.game_info.field[HEIGHT][1] = STATIC_CELL;
+  ck_assert(sum != tetrisChecksum(&game_state));
+  removeInfo_t(&game_state);
+}
+END_TEST
+
 START_TEST(setUserAction_test) {
   {
     UserAction_t state;
@@ -572,6 +1039,16 @@ START_TEST(setUserAction_test) {
     setUserAction(KEY_DOWN, &state);
     ck_assert_int_eq(state, Down);
   }
+  {
+    UserAction_t state;
+    setUserAction('x', &state);
+    ck_assert_int_eq(state, HardDrop);
+  }
+  {
+    UserAction_t state;
+    setUserAction('c', &state);
+    ck_assert_int_eq(state, Hold);
+  }
   {
     UserAction_t state;
     setUserAction('p', &state);
@@ -738,6 +1215,45 @@ START_TEST(checkLine_test) {
 }
 END_TEST
 
+START_TEST(compactField_test) {
+  int height = 6;
+  int **field = NULL;
+  createMatrix(height + 1, WIDTH + 1, &field);
+  for (int y = 1; y <= height; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      field[y][x] = STATIC_CELL;
+    }
+  }
+  field[2][1] = EMPTY_CELL;
+  field[4][2] = EMPTY_CELL;
+  int *row_2 = field[2];
+  int *row_4 = field[4];
+  ck_assert_int_eq(compactField(field, height, WIDTH), 4);
+  ck_assert_ptr_eq(field[6], row_4);
+  ck_assert_ptr_eq(field[5], row_2);
+  for (int y = 1; y <= 4; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      ck_assert_int_eq(field[y][x], EMPTY_CELL);
+    }
+  }
+  ck_assert_int_eq(compactField(field, height, WIDTH), 0);
+  ck_assert_ptr_eq(field[6], row_4);
+  removeMatrix(field, height + 1);
+}
+END_TEST
+
+START_TEST(checkRow_test) {
+  int row[WIDTH + 2] = {0};
+  for (int x = 1; x <= WIDTH; x++) {
+    row[x] = STATIC_CELL;
+  }
+  ck_assert_int_eq(checkRow(row, WIDTH), 1);
+  row[WIDTH] = EMPTY_CELL;
+  ck_assert_int_eq(checkRow(row, WIDTH), 0);
+  ck_assert_int_eq(checkRow(row, WIDTH - 1), 1);
+}
+END_TEST
+
 START_TEST(updateScore_test) {
   GameInfo_t stats;
   stats.score = 0;
@@ -780,6 +1296,377 @@ START_TEST(setHighScore_test) {
 }
 END_TEST
 
+START_TEST(snapshotRestore_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  game_state->game_info.field[HEIGHT][3] = STATIC_CELL;
+  initHeights(game_state);
+  moveRight(game_state);
+  game_state->game_info.score = 300;
+  TetrisSnapshot_t saved;
+  tetrisSnapshot(game_state, &saved);
+  ck_assert_int_eq(saved.field[HEIGHT][3], STATIC_CELL);
+  ck_assert_int_eq(saved.figure.x, game_state->figure.x);
+  ck_assert_int_eq(saved.score, 300);
+  Figure_t sequence[2 * FIGURES_COUNT];
+  for (int i = 0; i < 2 * FIGURES_COUNT; i++) {
+    spawnFigure(game_state);
+    sequence[i] = game_state->figure;
+  }
+  game_state->game_info.field[HEIGHT][3] = EMPTY_CELL;
+  game_state->game_info.score = 0;
+  tetrisRestore(game_state, &saved);
+  ck_assert_int_eq(game_state->game_info.field[HEIGHT][3], STATIC_CELL);
+  ck_assert_int_eq(game_state->heights[3], HEIGHT);
+  ck_assert_int_eq(game_state->game_info.score, 300);
+  ck_assert_int_eq(game_state->figure.x, saved.figure.x);
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      ck_assert_int_eq(game_state->game_info.next[y][x],
+                       figureShape(saved.queue[saved.queue_head])->f[y][x]);
+    }
+  }
+  TetrisSnapshot_t restored;
+  tetrisSnapshot(game_state, &restored);
+  ck_assert_int_eq(memcmp(&saved, &restored, sizeof(saved)), 0);
+  for (int i = 0; i < 2 * FIGURES_COUNT; i++) {
+    spawnFigure(game_state);
+    ck_assert_int_eq(memcmp(&game_state->figure, &sequence[i],
+                            sizeof(Figure_t)),
+                     0);
+  }
+  removeGameInfo_t();
+}
+END_TEST
+
+START_TEST(zobristHash_test) {
+  {
+    TetrisInfo_t *game_state = getTetrisInfo_t();
+    unsigned long long start_hash = game_state->hash;
+    srand(21);
+    for (int i = 0; i < 500 && game_state->game_status != kGameOver; i++) {
+      switch (rand() % 5) {
+      case 0:
+        moveLeft(game_state);
+        break;
+      case 1:
+        moveRight(game_state);
+        break;
+      case 2:
+        rotateFigure(game_state);
+        break;
+      case 3:
+        moveDown(game_state);
+        break;
+      default:
+        game_state->set_time = 0;
+        tetrisMechanics(game_state);
+        break;
+      }
+      unsigned long long hash = game_state->hash;
+      tetrisRehash(game_state);
+      ck_assert(hash == game_state->hash);
+    }
+    ck_assert(start_hash != game_state->hash);
+    removeGameInfo_t();
+  }
+  {
+    TetrisInfo_t *game_state = getTetrisInfo_t();
+    for (int x = 1; x <= WIDTH; x++) {
+      game_state->game_info.field[HEIGHT][x] = STATIC_CELL;
+    }
+    game_state->game_info.field[HEIGHT - 1][3] = STATIC_CELL;
+    initHeights(game_state);
+    tetrisRehash(game_state);
+    unsigned long long full_hash = game_state->hash;
+    removeLine(game_state);
+    unsigned long long hash = game_state->hash;
+    ck_assert(hash != full_hash);
+    tetrisRehash(game_state);
+    ck_assert(hash == game_state->hash);
+    removeGameInfo_t();
+  }
+}
+END_TEST
+
+START_TEST(tetrisStep_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  int y = game_state->figure.y;
+  ck_assert(!tetrisStep(game_state));
+  ck_assert_int_eq(game_state->figure.y, y + 1);
+  moveDown(game_state);
+  ck_assert(tetrisStep(game_state));
+  ck_assert_int_eq(game_state->figure.y, 1);
+  ck_assert_int_eq(game_state->last_cleared, 0);
+  unsigned long long hash = game_state->hash;
+  tetrisRehash(game_state);
+  ck_assert(hash == game_state->hash);
+  removeGameInfo_t();
+}
+END_TEST
+
+START_TEST(addGarbage_test) {
+  TetrisInfo_t *game_state = getTetrisInfo_t();
+  GameInfo_t *stats = &game_state->game_info;
+  stats->field[HEIGHT][1] = STATIC_CELL;
+  initHeights(game_state);
+  tetrisRehash(game_state);
+  ck_assert_int_eq(addGarbage(game_state, 2, 4), START);
+  ck_assert_int_eq(stats->field[HEIGHT - 2][1], STATIC_CELL);
+  for (int y = HEIGHT - 1; y <= HEIGHT; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      ck_assert_int_eq(stats->field[y][x], x == 4 ? EMPTY_CELL : STATIC_CELL);
+    }
+  }
+  ck_assert_int_eq(game_state->heights[1], HEIGHT - 2);
+  ck_assert_int_eq(game_state->heights[4], HEIGHT + 1);
+  ck_assert_int_eq(game_state->heights[5], HEIGHT - 1);
+  unsigned long long hash = game_state->hash;
+  tetrisRehash(game_state);
+  ck_assert(hash == game_state->hash);
+  ck_assert_int_eq(addGarbage(game_state, 0, 1), START);
+  ck_assert_int_eq(addGarbage(game_state, HEIGHT - 3, 1), STOP);
+  ck_assert_int_eq(game_state->game_status, kGameOver);
+  removeGameInfo_t();
+}
+END_TEST
+
+START_TEST(garbageLines_test) {
+  ck_assert_int_eq(garbageLines(0), 0);
+  ck_assert_int_eq(garbageLines(1), 0);
+  ck_assert_int_eq(garbageLines(2), 1);
+  ck_assert_int_eq(garbageLines(3), 2);
+  ck_assert_int_eq(garbageLines(4), 4);
+}
+END_TEST
+
+START_TEST(battle_test) {
+  Battle_t battle;
+  ck_assert_int_eq(createBattle(&battle, 0, 1), STOP);
+  ck_assert_int_eq(createBattle(&battle, 3, 7), START);
+  ck_assert_int_eq(battle.alive_count, 3);
+  ck_assert_int_eq(battle.winner, BATTLE_NO_WINNER);
+  ck_assert_int_eq(battle.boards[0].figures[0], battle.boards[2].figures[0]);
+  ck_assert_int_eq(battleTarget(&battle, 0), 1);
+  ck_assert_int_eq(battleTarget(&battle, 2), 0);
+  ck_assert_int_eq(battleStep(&battle, 0), 3);
+  ck_assert_int_eq(battleStep(&battle, 1), 0);
+  battleInput(&battle, 0, Pause, 1);
+  ck_assert_int_eq(battleStep(&battle, START_SPEED * 10), 0);
+  battleInput(&battle, 0, Pause, 1);
+  ck_assert_int_eq(battleStep(&battle, 1 + START_SPEED), 3);
+
+  TetrisInfo_t *board = &battle.boards[0];
+  for (int y = HEIGHT - 1; y <= HEIGHT; y++) {
+    for (int x = 1; x <= WIDTH; x++) {
+      board->game_info.field[y][x] = x == 1 ? EMPTY_CELL : STATIC_CELL;
+    }
+  }
+  initHeights(board);
+  tetrisRehash(board);
+  board->figure.width = 1;
+  board->figure.height = 2;
+  memset(board->figure.f, 0, sizeof(board->figure.f));
+  board->figure.f[0][0] = MOVING_CELL;
+  board->figure.f[1][0] = MOVING_CELL;
+  board->figure.x = 1;
+  board->figure.y = HEIGHT - 1;
+  battle.pending[0] = 3;
+  ck_assert(tetrisStep(board));
+  ck_assert_int_eq(board->last_cleared, 2);
+  battleLock(&battle, 0);
+  ck_assert_int_eq(battle.pending[0], 2);
+  ck_assert_int_eq(battle.pending[1], 0);
+
+  battle.pending[0] = 0;
+  board->last_cleared = 4;
+  battleLock(&battle, 0);
+  ck_assert_int_eq(battle.pending[1], 4);
+  ck_assert_int_eq(battle.sent[0], 4);
+  TetrisInfo_t *target = &battle.boards[1];
+  moveDown(target);
+  ck_assert(tetrisStep(target));
+  battleLock(&battle, 1);
+  ck_assert_int_eq(battle.pending[1], 0);
+  int garbage_cells = 0;
+  for (int x = 1; x <= WIDTH; x++) {
+    garbage_cells += target->game_info.field[HEIGHT - 3][x] == STATIC_CELL;
+  }
+  ck_assert_int_eq(garbage_cells, WIDTH - 1);
+  unsigned long long hash = target->hash;
+  tetrisRehash(target);
+  ck_assert(hash == target->hash);
+
+  battleInput(&battle, 1, Terminate, 0);
+  ck_assert(!battleIsOver(&battle));
+  ck_assert_int_eq(battleTarget(&battle, 0), 2);
+  battleInput(&battle, 2, Terminate, 0);
+  ck_assert(battleIsOver(&battle));
+  ck_assert_int_eq(battle.winner, 0);
+  ck_assert_int_eq(battle.boards[0].game_status, kWin);
+  ck_assert_int_eq(battleStep(&battle, START_SPEED * 100), 0);
+  removeBattle(&battle);
+  ck_assert_ptr_null(battle.boards);
+}
+END_TEST
+
+START_TEST(batchEngine_test) {
+  const UserAction_t actions[] = {Action, Left, Right, Left,    Right,
+                                  Up,     Up,   Down,  HardDrop};
+  TetrisBatch_t batch;
+  ck_assert_int_eq(createBatch(&batch, 0, 1), STOP);
+  for (unsigned int seed = 1; seed <= 4; seed++) {
+    const int board = 0;
+    TetrisInfo_t game_state;
+    ck_assert_int_eq(createBatch(&batch, 1, seed), START);
+    ck_assert_int_eq(createInfo_t(&game_state), START);
+    dealBoard(&game_state, seed);
+    if (seed % 2 == 0) {
+      for (int y = HEIGHT - 3; y <= HEIGHT; y++) {
+        for (int x = 1; x < WIDTH; x++) {
+          game_state.game_info.field[y][x] = STATIC_CELL;
+        }
+        batch.rows[board * BATCH_STRIDE + y - 1] =
+            (uint16_t)(BATCH_FULL_ROW & ~(1 << (WIDTH + BATCH_SHIFT)));
+      }
+      Figure_t line;
+      memset(&line, 0, sizeof(line));
+      initFigure(&line, 0);
+      turnFigure(&line, &game_state.figure);
+      game_state.figure.x = WIDTH - 1;
+      game_state.figure.y = 1;
+      initHeights(&game_state);
+      tetrisRehash(&game_state);
+      batch.type[board] = 0;
+      batch.rotation[board] = 1;
+      batch.x[board] = WIDTH - 1;
+    }
+    unsigned int rng = seed;
+    int locks = 0;
+    for (int step = 0; step < 3000 && game_state.game_status == kStart;
+         step++) {
+      UserAction_t action =
+          step < HEIGHT ? Up : actions[randomNumber(&rng) % 9];
+      tetrisUserInput(&game_state, action);
+      batchInput(&batch, board, action);
+      game_state.set_time = 0;
+      tetrisMechanics(&game_state);
+      locks += batchStep(&batch) > 0;
+      Figure_t figure;
+      batchFigure(&batch, board, &figure);
+      ck_assert_int_eq(figure.x, game_state.figure.x);
+      ck_assert_int_eq(figure.y, game_state.figure.y);
+      ck_assert_int_eq(figure.width, game_state.figure.width);
+      ck_assert_int_eq(figure.height, game_state.figure.height);
+      for (int y = 0; y < figure.height; y++) {
+        for (int x = 0; x < figure.width; x++) {
+          ck_assert_int_eq(figure.f[y][x], game_state.figure.f[y][x]);
+        }
+      }
+      for (int y = 1; y <= HEIGHT; y++) {
+        for (int x = 1; x <= WIDTH; x++) {
+          ck_assert_int_eq(batchCell(&batch, board, y, x),
+                           game_state.game_info.field[y][x]);
+        }
+      }
+      ck_assert_mem_eq(&batch.figures[board * FIGURES_COUNT],
+                       game_state.figures, sizeof(game_state.figures));
+      ck_assert_int_eq(batch.curr_figure[board], game_state.curr_figure);
+      for (int i = 0; i < TETRIS_PREVIEW; i++) {
+        ck_assert_int_eq(batch.queue[board * TETRIS_QUEUE_SIZE +
+                                     (batch.queue_head[board] + i) %
+                                         TETRIS_QUEUE_SIZE],
+                         nextFigure(&game_state, i));
+      }
+      ck_assert_uint_eq(batch.seed[board], game_state.seed);
+      ck_assert_int_eq(batch.score[board], game_state.game_info.score);
+      ck_assert_int_eq(batch.level[board], game_state.game_info.level);
+      ck_assert_int_eq(batch.speed[board], game_state.game_info.speed);
+      ck_assert_int_eq(batch.last_cleared[board], game_state.last_cleared);
+      ck_assert_int_eq(batch.status[board], game_state.game_status);
+    }
+    ck_assert_int_gt(locks, 0);
+    ck_assert_int_eq(game_state.game_info.score >= 1500, seed % 2 == 0);
+    removeInfo_t(&game_state);
+    removeBatch(&batch);
+  }
+
+  ck_assert_int_eq(createBatch(&batch, 2, 5), START);
+  ck_assert_uint_eq(batch.seed[1] != batch.seed[0], 1);
+  batch.score[0] = TETRIS_MAX_SCORE;
+  batchStep(&batch);
+  ck_assert_int_eq(batch.status[0], kWin);
+  int y = batch.y[0];
+  batchStep(&batch);
+  ck_assert_int_eq(batch.y[0], y);
+
+  uint16_t rows[HEIGHT];
+  for (int i = 0; i < HEIGHT; i++) {
+    rows[i] = i % 2 ? BATCH_FULL_ROW : (uint16_t)(BATCH_EMPTY_ROW | i << 4);
+  }
+  ck_assert_int_eq(batchCompact(rows), HEIGHT / 2);
+  ck_assert_uint_eq(rows[HEIGHT / 2 - 1], BATCH_EMPTY_ROW);
+  ck_assert_uint_eq(rows[HEIGHT - 1], BATCH_EMPTY_ROW | (HEIGHT - 2) << 4);
+  removeBatch(&batch);
+  ck_assert_ptr_null(batch.rows);
+}
+END_TEST
+
+START_TEST(tetrisEvents_test) {
+  const char *path = "tetris_events.bgev";
+  TetrisInfo_t game_state;
+  EventLog_t log;
+  GameEvents_t events;
+  remove(path);
+  ck_assert_int_eq(createInfo_t(&game_state), START);
+  ck_assert_ptr_null(game_state.events);
+  ck_assert_int_eq(createEventLog(&log, path), START);
+  startGameEvents(&events, &log, 9, 0);
+  game_state.events = &events;
+  GameInfo_t *stats = &game_state.game_info;
+  Figure_t *figure = &game_state.figure;
+  int first = figure->type;
+  int second = nextFigure(&game_state, 0);
+  Figure_t ghost;
+  getGhostFigure(&game_state, &ghost);
+  updateField(stats, &ghost, GHOST_CELL);
+  for (int x = 1; x <= WIDTH; x++) {
+    stats->field[HEIGHT][x] =
+        stats->field[HEIGHT][x] == GHOST_CELL ? EMPTY_CELL : STATIC_CELL;
+  }
+  updateField(stats, &ghost, EMPTY_CELL);
+  recountHeights(&game_state);
+  tetrisUserInput(&game_state, HardDrop);
+  ck_assert_int_eq(stats->score, 100);
+  ck_assert_int_eq(events.tick, 1);
+  game_state.events = NULL;
+  tetrisUserInput(&game_state, HardDrop);
+  ck_assert_int_eq(events.tick, 1);
+  ck_assert_int_eq(removeEventLog(&log), START);
+  removeInfo_t(&game_state);
+
+  EventFile_t file;
+  EventBlock_t block;
+  size_t offset = 0;
+  ck_assert_int_eq(openEventFile(&file, path), START);
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), START);
+  ck_assert_int_eq(block.rows, 2);
+  ck_assert_int_eq(block.columns[EVENT_KIND][0], EVENT_LOCK);
+  ck_assert_int_eq(block.columns[EVENT_PIECE][0], first);
+  ck_assert_int_eq(block.columns[EVENT_X][0], ghost.x);
+  ck_assert_int_eq(block.columns[EVENT_Y][0], ghost.y);
+  ck_assert_int_eq(block.columns[EVENT_LINES][0], 1);
+  ck_assert_int_eq(block.columns[EVENT_SCORE][0], 100);
+  ck_assert_int_eq(block.columns[EVENT_KIND][1], EVENT_SPAWN);
+  ck_assert_int_eq(block.columns[EVENT_PIECE][1], second);
+  ck_assert_int_eq(block.columns[EVENT_Y][1], 1);
+  ck_assert_int_eq(block.columns[EVENT_SESSION][1], 9);
+  ck_assert_int_eq(block.max[EVENT_TICK], 1);
+  ck_assert_int_eq(eventBlock(&file, &offset, &block), STOP);
+  closeEventFile(&file);
+  remove(path);
+}
+END_TEST
+
 Suite *test_suite() {
   Suite *s = suite_create("tetris_tests");
   TCase *test = tcase_create("tetris_tests");
@@ -807,7 +1694,14 @@ Suite *test_suite() {
   tcase_add_test(test, continueOrNot_test);
   tcase_add_test(test, checkCollision_test);
   tcase_add_test(test, updateField_test);
+  tcase_add_test(test, initHeights_test);
+  tcase_add_test(test, updateHeights_test);
+  tcase_add_test(test, recountHeights_test);
+  tcase_add_test(test, dropDistance_test);
+  tcase_add_test(test, getGhostFigure_test);
   tcase_add_test(test, getUserInput_test);
+  tcase_add_test(test, tetrisDrainInput_test);
+  tcase_add_test(test, tetrisAutoShift_test);
   tcase_add_test(test, setUserAction_test);
   tcase_add_test(test, userInput_test);
   tcase_add_test(test, rotateFigure_test);
@@ -815,10 +1709,27 @@ Suite *test_suite() {
   tcase_add_test(test, moveRight_test);
   tcase_add_test(test, moveDown_test);
   tcase_add_test(test, removeLine_test);
+  tcase_add_test(test, compactField_test);
   tcase_add_test(test, checkLine_test);
+  tcase_add_test(test, checkRow_test);
   tcase_add_test(test, updateScore_test);
   tcase_add_test(test, getHighScore_test);
   tcase_add_test(test, setHighScore_test);
+  tcase_add_test(test, snapshotRestore_test);
+  tcase_add_test(test, zobristHash_test);
+  tcase_add_test(test, tetrisStep_test);
+  tcase_add_test(test, addGarbage_test);
+  tcase_add_test(test, garbageLines_test);
+  tcase_add_test(test, battle_test);
+  tcase_add_test(test, batchEngine_test);
+  tcase_add_test(test, lockDelay_test);
+  tcase_add_test(test, softDrop_test);
+  tcase_add_test(test, srsRotation_test);
+  tcase_add_test(test, holdFigure_test);
+  tcase_add_test(test, tetrisChecksum_test);
+  tcase_add_test(test, tetrisEvents_test);
+  tcase_add_test(test, snapshotHeldKeys_test);
+  tcase_add_test(test, inputAfterGameOver_test);
 
   suite_add_tcase(s, test);
   return s;
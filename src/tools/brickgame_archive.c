@@ -0,0 +1,262 @@
+/** @file
+ * @brief Файл, устанавливающий точку входа в работу с архивом записей игр
+ * @details Режим pack проводит игры сценария проверки детерминизма и
+ * упаковывает их записи в архив (см. replay_archive.h), при необходимости
+ * записывая события игр в столбцовый журнал (см. event_log.h). Режим list
+ * выводит индекс архива, режим scan распаковывает все записи подряд и
+ * сообщает скорость прохода, режим show находит одну запись по номеру,
+ * воспроизводит её и сверяет итоговый счёт с индексом
+ */
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../brick_game/api/brick_game_loader.h"
+#include "../brick_game/api/brick_game_replay.h"
+#include "../brick_game/common/common_back.h"
+
+/**
+ * @brief Выводит справку по параметрам запуска
+ * @param name Имя программы
+ */
+static void printUsage(const char *name) {
+  printf("Usage: %s [options] pack|list|scan FILE\n"
+         "       %s [options] show FILE ID\n"
+         "  -e, --engine PATH   libbrickgame build to play (default: linked)\n"
+         "  -g, --games N       games of each kind to pack (default %d)\n"
+         "  -n, --steps N       step limit per packed game (default %d)\n"
+         "  -o, --events FILE   append events of packed games to FILE\n",
+         name, name, ARCHIVE_GAMES, ARCHIVE_STEPS);
+}
+
+/**
+ * @brief Проводит игры и упаковывает их записи в архив
+ * @details Игра с номером записи id - Тетрис при чётном id и Змейка при
+ * нечётном, seed равен id / 2. В журнале событий номер игры - id
+ * @param api Указатель на таблицу функций библиотеки
+ * @param path Путь к файлу архива
+ * @param games Количество игр каждого вида
+ * @param steps Наибольшее количество шагов одной игры
+ * @param log Указатель на открытый журнал событий или NULL
+ * @return 0, если архив записан, иначе 1
+ */
+static int packArchive(const BrickGameApi_t *api, const char *path, int games,
+                       int steps, EventLog_t *log) {
+  Replay_t replay;
+  ArchiveWriter_t writer;
+  GameEvents_t events;
+  int status = createReplay(&replay, BRICKGAME_TETRIS, 0);
+  if (status == START) {
+    status = createArchiveWriter(&writer, path);
+    for (int id = 0; id < 2 * games && status == START; id++) {
+      int game = id % 2 == 0 ? BRICKGAME_TETRIS : BRICKGAME_SNAKE;
+      startGameEvents(&events, log, id, game);
+      status = brickGameRecord(api, game, (unsigned int)id / 2, steps, &replay,
+                               log != NULL ? &events : NULL);
+      if (status == START) {
+        status = archiveWrite(&writer, (uint64_t)id, &replay);
+      }
+    }
+    int closed = closeArchiveWriter(&writer);
+    status = status == START ? closed : STOP;
+    removeReplay(&replay);
+  }
+  if (status == START) {
+    printf("packed %d replays to %s\n", 2 * games, path);
+  } else {
+    fprintf(stderr, "couldn't pack %s\n", path);
+  }
+  return status == START ? 0 : 1;
+}
+
+/**
+ * @brief Открывает журнал событий и упаковывает игры
+ * @param api Указатель на таблицу функций библиотеки
+ * @param path Путь к файлу архива
+ * @param games Количество игр каждого вида
+ * @param steps Наибольшее количество шагов одной игры
+ * @param events Путь к файлу журнала событий или NULL
+ * @return 0, если архив и журнал записаны, иначе 1
+ */
+static int packGames(const BrickGameApi_t *api, const char *path, int games,
+                     int steps, const char *events) {
+  int result = 1;
+  EventLog_t log;
+  if (events == NULL) {
+    result = packArchive(api, path, games, steps, NULL);
+  } else if (createEventLog(&log, events) != START) {
+    fprintf(stderr, "couldn't open %s\n", events);
+  } else {
+    result = packArchive(api, path, games, steps, &log);
+    if (removeEventLog(&log) != START) {
+      fprintf(stderr, "couldn't write %s\n", events);
+      result = 1;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Выводит индекс архива
+ * @param archive Указатель на открытый архив
+ * @return 0
+ */
+static int listArchive(const Archive_t *archive) {
+  printf("%10s %6s %10s %8s %8s %8s\n", "id", "game", "seed", "score",
+         "steps", "bytes");
+  for (int i = 0; i < archive->count; i++) {
+    ArchiveEntry_t entry;
+    archiveEntry(archive, i, &entry);
+    printf("%10llu %6s %10u %8d %8d %8u\n", (unsigned long long)entry.id,
+           entry.game == BRICKGAME_SNAKE ? "snake" : "tetris", entry.seed,
+           entry.score, entry.steps, entry.size);
+  }
+  return 0;
+}
+
+/**
+ * @brief Распаковывает все записи архива подряд
+ * @param archive Указатель на архив, открытый в режиме ARCHIVE_SCAN
+ * @return 0, если все записи распакованы, иначе 1
+ */
+static int scanArchive(const Archive_t *archive) {
+  Replay_t replay;
+  long long start = setTime();
+  long long steps = 0;
+  uint64_t bytes = 0;
+  int status = createReplay(&replay, BRICKGAME_TETRIS, 0);
+  for (int i = 0; i < archive->count && status == START; i++) {
+    ArchiveEntry_t entry;
+    archiveEntry(archive, i, &entry);
+    status = archiveLoad(archive, &entry, &replay);
+    steps += replay.steps;
+    bytes += entry.size;
+  }
+  removeReplay(&replay);
+  long long time = setTime() - start;
+  if (status == START) {
+    printf("scanned %d replays: %lld steps from %llu bytes in %lld ms\n",
+           archive->count, steps, (unsigned long long)bytes, time);
+  } else {
+    fprintf(stderr, "corrupted replay in archive\n");
+  }
+  return status == START ? 0 : 1;
+}
+
+/**
+ * @brief Воспроизводит одну запись архива
+ * @param api Указатель на таблицу функций библиотеки
+ * @param archive Указатель на архив, открытый в режиме ARCHIVE_RANDOM
+ * @param id Номер записи
+ * @return 0, если счёт воспроизведённой игры совпал с индексом, иначе 1
+ */
+static int showReplay(const BrickGameApi_t *api, const Archive_t *archive,
+                      uint64_t id) {
+  int result = 1;
+  Replay_t replay;
+  ArchiveEntry_t entry;
+  int score = 0;
+  if (archiveFind(archive, id, &entry) != START) {
+    fprintf(stderr, "no replay %llu\n", (unsigned long long)id);
+  } else if (createReplay(&replay, entry.game, entry.seed) == START) {
+    if (archiveLoad(archive, &entry, &replay) != START ||
+        brickGamePlay(api, &replay, &score) != START) {
+      fprintf(stderr, "couldn't play replay %llu\n", (unsigned long long)id);
+    } else {
+      result = score == entry.score ? 0 : 1;
+      printf("%s: %s seed %u, %d steps, score %d (archived %d)\n",
+             result == 0 ? "OK" : "MISMATCH",
+             entry.game == BRICKGAME_SNAKE ? "snake" : "tetris", entry.seed,
+             entry.steps, score, entry.score);
+    }
+    removeReplay(&replay);
+  }
+  return result;
+}
+
+/**
+ * @brief Выполняет режим работы с открытым архивом
+ * @param api Указатель на таблицу функций библиотеки
+ * @param mode Режим list, scan или show
+ * @param path Путь к файлу архива
+ * @param id Номер записи для режима show
+ * @return 0 в случае успеха, иначе 1
+ */
+static int readArchive(const BrickGameApi_t *api, const char *mode,
+                       const char *path, uint64_t id) {
+  int result = 1;
+  Archive_t archive;
+  bool is_show = !strcmp(mode, "show");
+  if (openArchive(&archive, path, is_show ? ARCHIVE_RANDOM : ARCHIVE_SCAN) !=
+      START) {
+    fprintf(stderr, "couldn't read %s\n", path);
+  } else {
+    if (is_show) {
+      result = showReplay(api, &archive, id);
+    } else if (!strcmp(mode, "scan")) {
+      result = scanArchive(&archive);
+    } else {
+      result = listArchive(&archive);
+    }
+    closeArchive(&archive);
+  }
+  return result;
+}
+
+/**
+ * @brief Начало программы
+ * @details Разбирает параметры запуска, при необходимости загружает сборку
+ * библиотеки и выполняет режим
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ * @return 0 в случае успеха, иначе 1
+ */
+int main(int argc, char **argv) {
+  const struct option options[] = {{"engine", required_argument, NULL, 'e'},
+                                   {"games", required_argument, NULL, 'g'},
+                                   {"steps", required_argument, NULL, 'n'},
+                                   {"events", required_argument, NULL, 'o'},
+                                   {NULL, 0, NULL, 0}};
+  const char *engine = NULL;
+  const char *events = NULL;
+  int games = ARCHIVE_GAMES;
+  int steps = ARCHIVE_STEPS;
+  bool is_valid = true;
+  int option = getopt_long(argc, argv, "e:g:n:o:", options, NULL);
+  while (option != -1 && is_valid) {
+    if (option == 'e') {
+      engine = optarg;
+    } else if (option == 'g') {
+      games = atoi(optarg);
+    } else if (option == 'n') {
+      steps = atoi(optarg);
+    } else if (option == 'o') {
+      events = optarg;
+    } else {
+      is_valid = false;
+    }
+    option = getopt_long(argc, argv, "e:g:n:o:", options, NULL);
+  }
+  const char *mode = is_valid && argc - optind >= 2 ? argv[optind] : "";
+  bool is_show = !strcmp(mode, "show");
+  is_valid = games > 0 && steps > 0 && argc - optind == (is_show ? 3 : 2) &&
+             (is_show || !strcmp(mode, "pack") || !strcmp(mode, "list") ||
+              !strcmp(mode, "scan"));
+  int result = 1;
+  BrickGameLib_t lib = {NULL, brickGameApi()};
+  if (!is_valid) {
+    printUsage(argv[0]);
+  } else if (engine != NULL && brickGameOpen(engine, &lib) != START) {
+    fprintf(stderr, "couldn't load %s\n", engine);
+  } else {
+    if (!strcmp(mode, "pack")) {
+      result = packGames(lib.api, argv[optind + 1], games, steps, events);
+    } else {
+      uint64_t id = is_show ? strtoull(argv[optind + 2], NULL, 10) : 0;
+      result = readArchive(lib.api, mode, argv[optind + 1], id);
+    }
+    brickGameClose(&lib);
+  }
+  return result;
+}
@@ -0,0 +1,171 @@
+/** @file
+ * @brief Файл, устанавливающий точку входа в сводку журнала событий
+ * @details Программа проходит по столбцовому журналу событий (см.
+ * event_log.h) и выводит по каждому виду событий количество, сумму
+ * изменений счёта и среднее время на ход, а для фиксаций фигур - количество
+ * удалённых за раз линий. Условие на номер игры проверяется сначала по
+ * наименьшему и наибольшему значениям столбца блока, поэтому блоки другой
+ * игры не читаются
+ */
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../brick_game/common/event_log.h"
+
+#define EVENT_KINDS 3
+#define EVENT_MAX_LINES 4
+#define EVENT_ANY_GAME -1
+
+/**
+ * @brief Сводка журнала
+ * @details count, score и think - количество событий, сумма изменений
+ * счёта и сумма времени на ход в шагах игры по видам событий, lines -
+ * количество фиксаций по числу удалённых линий, blocks и skipped -
+ * прочитанные и пропущенные блоки
+ */
+typedef struct {
+  long long count[EVENT_KINDS];
+  long long score[EVENT_KINDS];
+  long long think[EVENT_KINDS];
+  long long lines[EVENT_MAX_LINES + 1];
+  long long blocks;
+  long long skipped;
+} EventSummary_t;
+
+/**
+ * @brief Выводит справку по параметрам запуска
+ * @param name Имя программы
+ */
+static void printUsage(const char *name) {
+  printf("Usage: %s [options] FILE\n"
+         "  -g, --game N   only events of game module N (default: all)\n",
+         name);
+}
+
+/**
+ * @brief Добавляет блок в сводку
+ * @details Каждый столбец проходится отдельным циклом без ветвлений, условие
+ * на игру и вид события превращается в множитель 0 или 1, поэтому циклы
+ * векторизуются компилятором
+ * @param block Указатель на блок журнала
+ * @param game Номер игры или EVENT_ANY_GAME
+ * @param summary Указатель на сводку
+ */
+static void summarizeBlock(const EventBlock_t *block, int game,
+                           EventSummary_t *summary) {
+  const int32_t *games = block->columns[EVENT_GAME];
+  const int32_t *kinds = block->columns[EVENT_KIND];
+  const int32_t *scores = block->columns[EVENT_SCORE];
+  const int32_t *thinks = block->columns[EVENT_THINK];
+  const int32_t *lines = block->columns[EVENT_LINES];
+  for (int kind = 0; kind < EVENT_KINDS; kind++) {
+    long long count = 0;
+    long long score = 0;
+    long long think = 0;
+    for (int i = 0; i < block->rows; i++) {
+      int32_t is_match =
+          (kinds[i] == kind) & (game == EVENT_ANY_GAME || games[i] == game);
+      count += is_match;
+      score += is_match * scores[i];
+      think += is_match * thinks[i];
+    }
+    summary->count[kind] += count;
+    summary->score[kind] += score;
+    summary->think[kind] += think;
+  }
+  for (int n = 0; n <= EVENT_MAX_LINES; n++) {
+    long long count = 0;
+    for (int i = 0; i < block->rows; i++) {
+      count += (kinds[i] == EVENT_LOCK) & (lines[i] == n) &
+               (game == EVENT_ANY_GAME || games[i] == game);
+    }
+    summary->lines[n] += count;
+  }
+}
+
+/**
+ * @brief Проходит по журналу и составляет сводку
+ * @param file Указатель на открытый журнал
+ * @param game Номер игры или EVENT_ANY_GAME
+ * @param summary Указатель на сводку
+ * @return START, если журнал прочитан до конца, STOP если блок повреждён
+ */
+static int summarizeEvents(const EventFile_t *file, int game,
+                           EventSummary_t *summary) {
+  EventBlock_t block;
+  size_t offset = 0;
+  memset(summary, 0, sizeof(*summary));
+  while (eventBlock(file, &offset, &block) == START) {
+    if (game != EVENT_ANY_GAME &&
+        (game < block.min[EVENT_GAME] || game > block.max[EVENT_GAME])) {
+      summary->skipped++;
+    } else {
+      summarizeBlock(&block, game, summary);
+      summary->blocks++;
+    }
+  }
+  return offset == file->size ? START : STOP;
+}
+
+/**
+ * @brief Выводит сводку
+ * @param summary Указатель на сводку
+ */
+static void printSummary(const EventSummary_t *summary) {
+  const char *names[EVENT_KINDS] = {"spawn", "lock", "apple"};
+  printf("blocks: %lld read, %lld skipped\n", summary->blocks,
+         summary->skipped);
+  printf("%6s %10s %10s %10s\n", "event", "count", "score", "think");
+  for (int kind = 0; kind < EVENT_KINDS; kind++) {
+    long long count = summary->count[kind];
+    printf("%6s %10lld %10lld %10.1f\n", names[kind], count,
+           summary->score[kind],
+           count > 0 ? (double)summary->think[kind] / count : 0.0);
+  }
+  printf("lines cleared per lock:");
+  for (int n = 0; n <= EVENT_MAX_LINES; n++) {
+    printf(" %d:%lld", n, summary->lines[n]);
+  }
+  printf("\n");
+}
+
+/**
+ * @brief Начало программы
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ * @return 0, если журнал прочитан, иначе 1
+ */
+int main(int argc, char **argv) {
+  const struct option options[] = {{"game", required_argument, NULL, 'g'},
+                                   {NULL, 0, NULL, 0}};
+  int game = EVENT_ANY_GAME;
+  bool is_valid = true;
+  int option = getopt_long(argc, argv, "g:", options, NULL);
+  while (option != -1 && is_valid) {
+    if (option == 'g') {
+      game = atoi(optarg);
+    } else {
+      is_valid = false;
+    }
+    option = getopt_long(argc, argv, "g:", options, NULL);
+  }
+  int result = 1;
+  EventFile_t file;
+  if (!is_valid || argc - optind != 1) {
+    printUsage(argv[0]);
+  } else if (openEventFile(&file, argv[optind]) != START) {
+    fprintf(stderr, "couldn't read %s\n", argv[optind]);
+  } else {
+    EventSummary_t summary;
+    if (summarizeEvents(&file, game, &summary) != START) {
+      fprintf(stderr, "corrupted block in %s\n", argv[optind]);
+    } else {
+      printSummary(&summary);
+      result = 0;
+    }
+    closeEventFile(&file);
+  }
+  return result;
+}
@@ -0,0 +1,116 @@
+/** @file
+ * @brief Файл, устанавливающий точку входа в проверку детерминизма сборок
+ * libbrickgame
+ * @details Режим record проводит сценарий проверки (см.
+ * brick_game_lockstep.h) и сохраняет поток контрольных сумм в файл. Режим
+ * verify проводит тот же сценарий и сравнивает каждую сумму с записанной.
+ * Запись одной сборкой и проверка другой (например, -O0 и -O3 или сборки
+ * разных архитектур) доказывает, что они проводят игры бит-в-бит одинаково
+ */
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../brick_game/api/brick_game_loader.h"
+#include "../brick_game/api/brick_game_lockstep.h"
+
+/**
+ * @brief Выводит справку по параметрам запуска
+ * @param name Имя программы
+ */
+static void printUsage(const char *name) {
+  printf("Usage: %s [options] record|verify FILE\n"
+         "  -e, --engine PATH   libbrickgame build to check (default: linked)\n"
+         "  -g, --games N       games of each kind (default %d)\n"
+         "  -n, --steps N       step limit per game (default %d)\n",
+         name, LOCKSTEP_GAMES, LOCKSTEP_STEPS);
+}
+
+/**
+ * @brief Проводит сценарий и сохраняет или проверяет поток
+ * @param api Указатель на таблицу функций библиотеки
+ * @param is_verify true для режима verify
+ * @param path Путь к файлу потока
+ * @param games Количество игр каждого вида
+ * @param steps Наибольшее количество шагов одной игры
+ * @return 0, если поток записан или совпал, иначе 1
+ */
+static int runLockstep(const BrickGameApi_t *api, bool is_verify,
+                       const char *path, int games, int steps) {
+  int result = 1;
+  Lockstep_t lockstep;
+  LockstepPosition_t position = {0, 0, 0};
+  int status = is_verify ? lockstepLoad(&lockstep, path)
+                         : createLockstep(&lockstep);
+  if (status != START) {
+    fprintf(stderr, "couldn't %s %s\n", is_verify ? "read" : "create", path);
+  } else {
+    status = brickGameLockstepRun(api, games, steps, &lockstep, &position);
+    if (!is_verify && status == START) {
+      status = lockstepSave(&lockstep, path);
+      result = status == START ? 0 : 1;
+      printf("recorded %d checksums to %s\n", lockstep.count, path);
+    } else if (status == START && lockstepIsComplete(&lockstep)) {
+      result = 0;
+      printf("OK: %d checksums match\n", lockstep.count);
+    } else if (lockstep.mismatch != LOCKSTEP_NO_MISMATCH) {
+      printf("MISMATCH at checksum %d: %s seed %u step %d\n",
+             lockstep.mismatch,
+             position.game == BRICKGAME_SNAKE ? "snake" : "tetris",
+             position.seed, position.step);
+    } else {
+      printf("MISMATCH: scenario ended after %d of %d checksums\n",
+             lockstep.position, lockstep.count);
+    }
+    removeLockstep(&lockstep);
+  }
+  return result;
+}
+
+/**
+ * @brief Начало программы
+ * @details Разбирает параметры запуска, при необходимости загружает
+ * проверяемую сборку библиотеки и проводит сценарий
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ * @return 0, если поток записан или совпал, иначе 1
+ */
+int main(int argc, char **argv) {
+  const struct option options[] = {{"engine", required_argument, NULL, 'e'},
+                                   {"games", required_argument, NULL, 'g'},
+                                   {"steps", required_argument, NULL, 'n'},
+                                   {NULL, 0, NULL, 0}};
+  const char *engine = NULL;
+  int games = LOCKSTEP_GAMES;
+  int steps = LOCKSTEP_STEPS;
+  bool is_valid = true;
+  int option = getopt_long(argc, argv, "e:g:n:", options, NULL);
+  while (option != -1 && is_valid) {
+    if (option == 'e') {
+      engine = optarg;
+    } else if (option == 'g') {
+      games = atoi(optarg);
+    } else if (option == 'n') {
+      steps = atoi(optarg);
+    } else {
+      is_valid = false;
+    }
+    option = getopt_long(argc, argv, "e:g:n:", options, NULL);
+  }
+  is_valid = is_valid && argc - optind == 2 && games > 0 && steps > 0 &&
+             (!strcmp(argv[optind], "record") ||
+              !strcmp(argv[optind], "verify"));
+  int result = 1;
+  BrickGameLib_t lib = {NULL, brickGameApi()};
+  if (!is_valid) {
+    printUsage(argv[0]);
+  } else if (engine != NULL && brickGameOpen(engine, &lib) != START) {
+    fprintf(stderr, "couldn't load %s\n", engine);
+  } else {
+    result = runLockstep(lib.api, !strcmp(argv[optind], "verify"),
+                         argv[optind + 1], games, steps);
+    brickGameClose(&lib);
+  }
+  return result;
+}